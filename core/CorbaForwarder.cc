@@ -15,12 +15,14 @@
 
 #include <stdexcept>
 #include <string>
-#include <cstring>
 #include <list>
+#include <vector>
 #include <unistd.h>  // For gethostname()
+#include <boost/bind.hpp>
 
 #include "Forwarder.hh"
 #include "ORBMgr.hh"
+#include "ProxyServant.hh"
 #include "common_types.hh"
 
 #include "diet/AgentImpl.hh"
@@ -34,6 +36,7 @@
 #endif
 
 #include "dagda/DagdaImpl.hh"
+#include "dagda/DagdaRelay.hh"
 
 #include "diet/CltWfMgrImpl.hh"
 #include "diet/MaDagImpl.hh"
@@ -50,350 +53,436 @@
 #define MAX_HOSTNAME_LENGTH  255
 #endif
 
-
-/**
- * WARNING: tricky function
- * The function return wheter the object designed by objName is local or remote
- * If the object is local, the prefix 'remote' will be added
- * so that when passed to a remote omniname, it is known as a remote object
- * When remote object, removing the remote prefix to be able to use it locally
- */
-bool
-CorbaForwarder::remoteCall(std::string& objName) {
-  // Looks for a string
-  // that is prefixed by remote:
-  if (objName.find("remote:") != 0) {
-    /* Local network call: need to be forwarded to
-     * the peer forwarder. Add the prefix.
-     */
-    objName = "remote:" + objName;
-    return false;
-  }
-  /* Remote network call. Remove the prefix. */
-  objName = objName.substr(strlen("remote:"));
-  return true;
-}
-
+/* Deferred calls queued per class above which the oneway calls are made
+   by the calling thread. */
+#define ASYNC_PENDING 1024
+
+/* Names of the proxy POAs, per proxy interface. */
+static const char* proxyPOAs[] = {
+  "Agent",
+  "Callback",
+  "LocalAgent",
+  "MasterAgent",
+  "SeD",
+  "Dagda",
+  "CltMan",
+  "MaDag",
+  "WfLogService",
+  "LogCentralComponent",
+  "LogCentralTool",
+  "ComponentConfigurator",
+  "ToolMsgReceiver"
+};
 
 ::CORBA::Object_ptr
-CorbaForwarder::getObjectCache(const std::string& name) {
-  std::map<std::string, ::CORBA::Object_ptr>::iterator it;
+CorbaForwarder::getProxy(ProxyType type, const char* ctxt, const char* name,
+                         ProxyFactory factory) {
+  std::string nm(name);
+  PortableServer::POA_var poa;
+  const char* repoId;
+
+  if (nm.find('/') == std::string::npos) {
+    nm = std::string(ctxt)+"/"+nm;
+  }
 
   mcachesMutex.lock();
-// If the object is in the cache
-  if ((it = mobjectCache.find(name))!=mobjectCache.end()) {
-    mcachesMutex.unlock();
-    return CORBA::Object::_duplicate(it->second);
+  // The first proxy of an interface creates its POA
+  if (CORBA::is_nil(mproxies[type])) {
+    try {
+      Forwarder_var self = _this();
+      PortableServer::ServantBase* servant =
+        factory ? factory(self) : newRelay(type);
+      mrepoIds[type] = servant->_mostDerivedRepoId();
+      mproxies[type] =
+        ORBMgr::getMgr()->createProxyPOA(mname + "/" + proxyPOAs[type],
+                                         servant);
+    } catch (...) {
+      mcachesMutex.unlock();
+      throw;
+    }
   }
-// Return a nil object
+  poa = PortableServer::POA::_duplicate(mproxies[type]);
+  repoId = mrepoIds[type];
   mcachesMutex.unlock();
-  return ::CORBA::Object::_nil();
+
+  return ORBMgr::getMgr()->proxyReference(poa, nm, repoId);
 }
 
-CorbaForwarder::CorbaForwarder(const std::string& name) {
+PortableServer::ServantBase*
+CorbaForwarder::newRelay(ProxyType type) {
+  switch (type) {
+  case PROXY_DAGDA:
+    return new DagdaRelay(*this, mname, false);
+  default:
+    throw CORBA::BAD_PARAM(0, CORBA::COMPLETED_NO);
+  }
+}
+
+CorbaForwarder::CorbaForwarder(const std::string& name)
+  : moctetTransfers(true), mstreamChunk(1024 * 1024), mstreamWindow(8),
+    mstreamWorkers(NULL), mstreamResumes(3), mchunkStore(NULL),
+    mnextStream(0),
+    mstreamCond(&mstreamMutex), mpeerSlots(0), mpeerQueue(0),
+    mreservedStripes(1), mpeerCond(&mpeerMutex) {
   char buffer[MAX_HOSTNAME_LENGTH+1];
   gethostname(buffer, MAX_HOSTNAME_LENGTH);
 
   this->mname = name;
   this->mhost = buffer;
 
+  for (int i = 0; i < PROXY_COUNT; ++i) {
+    mrepoIds[i] = NULL;
+  }
+  for (int i = 0; i < 2; ++i) {
+    masyncPools[i] = NULL;
+    masyncCalls[i] = NULL;
+  }
+
+  mroutes.add(AGENTCTXT, ROUTE_AGENT);
+  mroutes.add(SEDCTXT, ROUTE_SED);
+  mroutes.add(CLIENTCTXT, ROUTE_CLIENT);
+  mroutes.add(WFMGRCTXT, ROUTE_WFMGR);
+  mroutes.add(MADAGCTXT, ROUTE_MADAG);
+  mroutes.add(DAGDACTXT, ROUTE_DAGDA);
+  mroutes.add(LOCALAGENT, ROUTE_LOCALAGENT);
+  mroutes.add(MASTERAGENT, ROUTE_MASTERAGENT);
+
 // Init logger
   mlogger = dadi::LoggerPtr(dadi::Logger::getLogger("org.dadicorba"));
   mlogger->setLevel(dadi::Message::PRIO_TRACE);
   mcc = dadi::ChannelPtr(new dadi::ConsoleChannel);
   mlogger->setChannel(mcc);
-
-  // Wait for the peer init. The unlock will be done on setPeer().
-  mpeerMutex.lock();
 }
 
 
 Dagda_ptr
 CorbaForwarder::getDagda(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
+  OperationStats::Call stats(mstats, "getDagda", true);
+  ProxyFactory factory = NULL;
 
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(DAGDACTXT)+"/"+nm;
+  // The relay serves the proxies itself
+  if (CORBA::is_nil(mdagdaRelay)) {
+    factory = newProxyServant<DagdaFwdrImpl>;
   }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else
-      return Dagda::_duplicate(Dagda::_narrow(object));
-  }
-  DagdaFwdrImpl * dagda = new DagdaFwdrImpl(this->_this(), nm.c_str());
-  ORBMgr::getMgr()->activate(dagda);
-
-  mcachesMutex.lock();
-  mservants[nm] = dagda;
-  mobjectCache[nm] = CORBA::Object::_duplicate(dagda->_this());
-  mcachesMutex.unlock();
-
-  return Dagda::_duplicate(dagda->_this());
+  ::CORBA::Object_var object =
+    getProxy(PROXY_DAGDA, DAGDACTXT, name, factory);
+  return Dagda::_narrow(object);
 }
 
 
 /* Common methods implementations. */
 ::CORBA::Long
 CorbaForwarder::ping(const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "ping", route.remote());
 
-  if (!remoteCall(objString)) {
-    return getPeer()->ping(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->ping(route.peerName());
   }
 
-  name = getName(objString);
-  ctxt = getCtxt(objString);
+  std::string name(route.name());
 
-// Ping agent
-  if (ctxt == std::string(AGENTCTXT)) {
+  switch (route.context()) {
+  case ROUTE_AGENT: {
+    // Ping agent
     Agent_var agent =
       ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
     return agent->ping();
   }
-// Ping client
-  if (ctxt == std::string(CLIENTCTXT)) {
+  case ROUTE_CLIENT: {
+    // Ping client
     Callback_var cb =
       ORBMgr::getMgr()->resolve<Callback, Callback_var>(CLIENTCTXT, name,
                                                         this->mname);
     return cb->ping();
   }
-// Ping workflow
-  if (ctxt == std::string(WFMGRCTXT)) {
+  case ROUTE_WFMGR: {
+    // Ping workflow
     CltMan_var clt =
       ORBMgr::getMgr()->resolve<CltMan, CltMan_var>(WFMGRCTXT, name,
                                                     this->mname);
     return clt->ping();
   }
-// Ping dag
-  if (ctxt == std::string(MADAGCTXT)) {
+  case ROUTE_MADAG: {
+    // Ping dag
     MaDag_var madag =
       ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
     return madag->ping();
   }
-// Ping sed
-  if (ctxt== std::string(SEDCTXT)) {
+  case ROUTE_SED: {
+    // Ping sed
     SeD_var sed = ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name,
                                                           this->mname);
     return sed->ping();
   }
-  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
+  default:
+    break;
+  }
+  throw BadNameException(route.path(), __FUNCTION__, getName());
 }
 
 void
 CorbaForwarder::getRequest(const ::corba_request_t& req, const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
+  if (defer(objName, boost::bind(&CorbaForwarder::getRequest, this, req,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getRequest", route.remote());
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getRequest(req, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getRequest(req, route.peerName());
   }
 
-  name = getName(objString);
-  ctxt = getCtxt(objString);
+  std::string name(route.name());
 
-  if (ctxt == std::string(AGENTCTXT)) {
+  switch (route.context()) {
+  case ROUTE_AGENT: {
     LocalAgent_var agent =
-      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(ctxt, name,
+      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(AGENTCTXT, name,
                                                             this->mname);
     return agent->getRequest(req);
   }
-  if (ctxt == std::string(SEDCTXT)) {
+  case ROUTE_SED: {
     SeD_var sed =
-      ORBMgr::getMgr()->resolve<SeD, SeD_var>(ctxt, name, this->mname);
+      ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
     return sed->getRequest(req);
   }
+  default:
+    break;
+  }
 }
 
 char*
 CorbaForwarder::getHostname(const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
-
-  if (!remoteCall(objString)) {
-    return getPeer()->getHostname(objString.c_str());
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getHostname", route.remote());
+
+  if (!route.remote()) {
+    char* result = findString(routeKey(route), "getHostname");
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getHostname(route.peerName());
+      cacheString(routeKey(route), "getHostname", result, generation);
+    }
+    return result;
   }
 
-  name = objString;
-
-  if (name.find('/') == std::string::npos)
-    throw BadNameException(name.c_str(), __FUNCTION__, getName());
+  if (!route.hasContext())
+    throw BadNameException(route.path(), __FUNCTION__, getName());
 
-  ctxt = getCtxt(objString);
-  name = getName(objString);
+  std::string name(route.name());
 
-  if (ctxt == std::string(AGENTCTXT)) {
+  switch (route.context()) {
+  case ROUTE_AGENT: {
     Agent_var agent =
-      ORBMgr::getMgr()->resolve<Agent, Agent_var>(ctxt, name, this->mname);
+      ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name,
+                                                  this->mname);
     return agent->getHostname();
   }
-
-  if (ctxt == std::string(DAGDACTXT)) {
-    Dagda_var dagda = ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(ctxt, name,
+  case ROUTE_DAGDA: {
+    Dagda_var dagda = ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT,
+                                                                  name,
                                                                   this->mname);
     return dagda->getHostname();
   }
-
-  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
+  default:
+    break;
+  }
+  throw BadNameException(route.path(), __FUNCTION__, getName());
 }
 
 ::CORBA::Long
 CorbaForwarder::bindParent(const char* parentName, const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "bindParent", route.remote());
 
-  if (!remoteCall(objString)) {
-    return getPeer()->bindParent(parentName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->bindParent(parentName, route.peerName());
   }
 
-  name = objString;
-
-  if (name.find('/') == std::string::npos)
-    throw BadNameException(name.c_str(), __FUNCTION__, getName());
+  if (!route.hasContext())
+    throw BadNameException(route.path(), __FUNCTION__, getName());
 
-  ctxt = getCtxt(objString);
-  name = getName(objString);
+  std::string name(route.name());
 
-  if (ctxt == std::string(AGENTCTXT)) {
+  switch (route.context()) {
+  case ROUTE_AGENT: {
     LocalAgent_var agent =
-      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(ctxt, name,
+      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(AGENTCTXT, name,
                                                             this->mname);
     return agent->bindParent(parentName);
   }
-  if (ctxt == std::string(SEDCTXT)) {
+  case ROUTE_SED: {
     SeD_var sed =
-      ORBMgr::getMgr()->resolve<SeD, SeD_var>(ctxt, name, this->mname);
+      ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
     return sed->bindParent(parentName);
   }
-  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
+  default:
+    break;
+  }
+  throw BadNameException(route.path(), __FUNCTION__, getName());
 }
 
 ::CORBA::Long
 CorbaForwarder::disconnect(const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "disconnect", route.remote());
 
-  if (!remoteCall(objString)) {
-    return getPeer()->disconnect(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->disconnect(route.peerName());
   }
 
-  name = objString;
+  if (!route.hasContext())
+    throw BadNameException(route.path(), __FUNCTION__, getName());
 
-  if (name.find('/') == std::string::npos)
-    throw BadNameException(name.c_str(), __FUNCTION__, getName());
+  std::string name(route.name());
 
-  ctxt = getCtxt(objString);
-  name = getName(objString);
-
-  if (ctxt == std::string(AGENTCTXT)) {
+  switch (route.context()) {
+  case ROUTE_AGENT: {
     LocalAgent_var agent =
-      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(ctxt, name,
+      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(AGENTCTXT, name,
                                                             this->mname);
     return agent->disconnect();
   }
-  if (ctxt == std::string(SEDCTXT)) {
-    SeD_var sed = ORBMgr::getMgr()->resolve<SeD, SeD_var>(ctxt, name,
+  case ROUTE_SED: {
+    SeD_var sed = ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name,
                                                           this->mname);
     return sed->disconnect();
   }
-  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
+  default:
+    break;
+  }
+  throw BadNameException(route.path(), __FUNCTION__, getName());
 }
 
 ::CORBA::Long
 CorbaForwarder::removeElement(::CORBA::Boolean recursive, const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "removeElement", route.remote());
 
-  if (!remoteCall(objString)) {
-    return getPeer()->removeElement(recursive, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->removeElement(recursive, route.peerName());
   }
 
-  name = objString;
-
-  if (name.find('/') == std::string::npos) {
-    throw BadNameException(name.c_str(), __FUNCTION__, getName());
+  if (!route.hasContext()) {
+    throw BadNameException(route.path(), __FUNCTION__, getName());
   }
 
-  ctxt = getCtxt(objString);
-  name = getName(objString);
+  std::string name(route.name());
 
-  if (ctxt == std::string(AGENTCTXT)) {
-    Agent_var agent = ORBMgr::getMgr()->resolve<Agent, Agent_var>(ctxt, name,
+  switch (route.context()) {
+  case ROUTE_AGENT: {
+    Agent_var agent = ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT,
+                                                                  name,
                                                                   this->mname);
     return agent->removeElement(recursive);
   }
-  if (ctxt == std::string(SEDCTXT)) {
+  case ROUTE_SED: {
     SeD_var sed =
-      ORBMgr::getMgr()->resolve<SeD, SeD_var>(ctxt, name, this->mname);
+      ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
     return sed->removeElement();
   }
-  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
+  default:
+    break;
+  }
+  throw BadNameException(route.path(), __FUNCTION__, getName());
 }
 
 
 void
 CorbaForwarder::bind(const char* objName, const char* ior) {
-  /* To avoid crashes when the peer forwarder is not ready: */
-  /* If the peer was not initialized, the following call is blocking. */
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "bind", route.remote());
+  bindingChanged(route);
+
+  if (!route.remote()) {
+    mlogger->log(dadi::Message("CorbaForwarder",
+                               "Forward bind to peers ("
+                               + std::string(route.peerName()) + ")\n",
+                               dadi::Message::PRIO_DEBUG));
+    /* Tag the object with this forwarder name, the peers route the calls
+       to the object through this forwarder. */
+    peersBind(route.peerName(), ORBMgr::convertIOR(ior, "@" + mname, 0));
+    return;
+  }
+  std::string ctxt = route.contextName();
+  std::string name(route.name());
+  std::string key = routeKey(route);
+  /* The object is tagged with the name of the peer binding it, the calls
+     to the object go back through this peer, and with the forwarder
+     which bound it first once relayed: "@peer" or "@peer@origin". */
+  std::string hop = ORBMgr::getHost(ior);
+  std::string origin;
+  if (hop.length() > 1 && hop.at(0) == '@') {
+    std::string::size_type at = hop.find('@', 1);
+    if (at == std::string::npos) {
+      hop.erase(0, 1);
+      origin = hop;
+    } else {
+      origin = hop.substr(at + 1);
+      hop = hop.substr(1, at - 1);
+    }
+  } else {
+    hop.clear();
+  }
+  if (origin == mname) {
+    // One of the objects of this side, back through a cycle of peers
+    return;
+  }
+  /* NEW: Tag the object with the forwarder name. */
+  std::string newIOR =
+    ORBMgr::convertIOR(ior, std::string("@") + mname, 0);
+
   mpeerMutex.lock();
+  std::map<std::string, std::string>::iterator imported =
+    mimports.find(key);
+  if (imported != mimports.end() && imported->second == newIOR) {
+    // Received already through another peer, and forwarded then
+    mpeerMutex.unlock();
+    return;
+  }
+  mimports[key] = newIOR;
+  if (!hop.empty()) {
+    mobjectPeers[key] = hop;
+  }
   mpeerMutex.unlock();
 
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
-
-  if (!remoteCall(objString)) {
-      mlogger->log(dadi::Message("CorbaForwarder",
-                                 "Forward bind to peer (" + objString + ")\n",
-                                  dadi::Message::PRIO_DEBUG));
-
-    return getPeer()->bind(objString.c_str(), ior);
-  }
-  ctxt = getCtxt(objString);
-  name = getName(objString);
   mlogger->log(dadi::Message("CorbaForwarder",
-                             "Bind locally (" + objString + ")\n",
+                             "Bind locally (" + std::string(route.path())
+                             + ")\n",
                              dadi::Message::PRIO_DEBUG));
 
-  if (ctxt == LOCALAGENT) {
+  if (route.context() == ROUTE_LOCALAGENT) {
     ctxt = AGENTCTXT;
     /* Specific case for local agent.
-       It is added into the cache to avoid resolution
+       Its kind is kept to avoid resolution
        problems later.
     */
-    LocalAgent_ptr agent = getLocalAgent(name.c_str());
     mcachesMutex.lock();
-    mobjectCache[ctxt+"/"+name] = CORBA::Object::_duplicate(agent);
+    magents[ctxt+"/"+name] = PROXY_LOCALAGENT;
     mcachesMutex.unlock();
   } else {
-    if (ctxt == MASTERAGENT) {
+    if (route.context() == ROUTE_MASTERAGENT) {
       ctxt = AGENTCTXT;
       /* Specific case for master agent.
-         It is added into the cache to avoid resolution
+         Its kind is kept to avoid resolution
          problems later.
       */
-      MasterAgent_ptr agent = getMasterAgent(name.c_str());
       mcachesMutex.lock();
-      mobjectCache[ctxt+"/"+name] = CORBA::Object::_duplicate(agent);
+      magents[ctxt+"/"+name] = PROXY_MASTERAGENT;
       mcachesMutex.unlock();
     }
   }
-  /* NEW: Tag the object with the forwarder name. */
-  std::string newIOR =
-    ORBMgr::convertIOR(ior, std::string("@") + getName(), 0);
-
   ORBMgr::getMgr()->bind(ctxt, name, newIOR, true);
-  // Broadcast the binding to all forwarders.
-  ORBMgr::getMgr()->fwdsBind(ctxt, name, newIOR, this->mname);
+  // Broadcast the binding to all forwarders, without waiting for them.
+  ORBMgr::getMgr()->fwdsBind(ctxt, name, newIOR, this->mname, false);
+  // And to the other peers of this forwarder, keeping the origin
+  if (origin.empty()) {
+    origin = mname;
+  }
+  peersBind(std::string("remote:") + route.path(),
+            ORBMgr::convertIOR(ior, "@" + mname + "@" + origin, 0), hop);
   mlogger->log(dadi::Message("CorbaForwarder",
                              "Binded! (" + ctxt + "/" + name + ")\n",
                              dadi::Message::PRIO_DEBUG));
@@ -404,190 +493,645 @@ CorbaForwarder::bind(const char* objName, const char* ior) {
  */
 SeqString*
 CorbaForwarder::getBindings(const char* ctxt) {
-  std::list<std::string> objects;
-  std::list<std::string>::iterator it;
-  SeqString* result = new SeqString();
+  OperationStats::Call stats(mstats, "getBindings", true);
+  std::vector<ORBMgr::Binding> objects;
+  std::vector<ORBMgr::Binding>::const_iterator it;
+  SeqString* result = findSequence<SeqString>(ctxt, "getBindings");
   unsigned int cmpt = 0;
 
-  objects = ORBMgr::getMgr()->list(ctxt);
+  if (result != NULL) {
+    return sent(stats, result);
+  }
+  unsigned long generation = mresults.generation();
+  result = new SeqString();
+  objects = ORBMgr::getMgr()->bindings(ctxt);
   result->length(objects.size()*2);
 
   for (it = objects.begin(); it != objects.end(); ++it) {
-    try {
-      CORBA::Object_ptr obj =
-        ORBMgr::getMgr()->resolveObject(ctxt, it->c_str(), "no-Forwarder");
-      (*result)[cmpt++] = it->c_str();
-      (*result)[cmpt++] = ORBMgr::getMgr()->getIOR(obj).c_str();
-    } catch (const std::runtime_error& err) {
-      continue;
-    }
+    (*result)[cmpt++] = it->first.c_str();
+    (*result)[cmpt++] = ORBMgr::getMgr()->getIOR(it->second).c_str();
   }
   result->length(cmpt);
-  return result;
+  cacheSequence(ctxt, "getBindings", *result, generation);
+  return sent(stats, result);
 }
 
 void CorbaForwarder::unbind(const char* objName) {
-  std::string objString(objName);
-  std::string name;
-  std::string ctxt;
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "unbind", route.remote());
+  bindingChanged(route);
 
-  if (!remoteCall(objString)) {
-    return getPeer()->unbind(objString.c_str());
+  if (!route.remote()) {
+    peersBind(route.peerName(), "");
+    return;
   }
 
-  name = objString;
-
-  if (name.find('/') == std::string::npos) {
+  if (!route.hasContext()) {
     return;
   }
 
-  ctxt = getCtxt(objString);
-  name = getName(objString);
+  std::string ctxt = route.contextName();
+  std::string name(route.name());
+  std::string key = routeKey(route);
+  std::map<std::string, std::string>::iterator it;
+  std::string origin;
 
-  removeObjectFromCache(name);
+  mpeerMutex.lock();
+  if (mimports.erase(key) == 0) {
+    // Not binded by a peer, or unbinded already through another peer
+    mpeerMutex.unlock();
+    return;
+  }
+  it = mobjectPeers.find(key);
+  if (it != mobjectPeers.end()) {
+    origin = it->second;
+    mobjectPeers.erase(it);
+  }
+  mpeerMutex.unlock();
+
+  removeObjectFromCache(key);
 
   ORBMgr::getMgr()->unbind(ctxt, name);
   // Broadcast the unbinding to all forwarders.
-  ORBMgr::getMgr()->fwdsUnbind(ctxt, name, this->mname);
+  ORBMgr::getMgr()->fwdsUnbind(ctxt, name, this->mname, false);
+  // And to the other peers of this forwarder.
+  peersBind(std::string("remote:") + route.path(), "", origin);
 }
 
 void
 CorbaForwarder::removeObjectFromCache(const std::string& name) {
-  std::map<std::string, ::CORBA::Object_ptr>::iterator it;
-  std::map<std::string, PortableServer::ServantBase*>::iterator jt;
-  /* If the object is in the servant cache. */
   mcachesMutex.lock();
-  if ((jt = mservants.find(name))!=mservants.end()) {
-    /* - Deactivate object. */
-    try {
-      ORBMgr::getMgr()->deactivate(jt->second);
-    } catch (...) {
-      /* There was a problem with the servant. But we want
-       * to remove it...
-       */
+  magents.erase(name);
+  mcachesMutex.unlock();
+}
+
+void
+CorbaForwarder::connectPeer(const char* ior, const char* host,
+                           const ::CORBA::Long port) {
+  OperationStats::Call stats(mstats, "connectPeer", true);
+  std::string converted = ORBMgr::convertIOR(ior, host, port);
+  setPeer(ORBMgr::getMgr()->resolve<Forwarder, Forwarder_ptr>(converted));
+}
+
+void
+CorbaForwarder::connectStripe(const char* ior, const char* host,
+                              const ::CORBA::Long port) {
+  OperationStats::Call stats(mstats, "connectStripe", true);
+  std::string converted = ORBMgr::convertIOR(ior, host, port);
+  Forwarder_var peer =
+    ORBMgr::getMgr()->resolve<Forwarder, Forwarder_var>(converted);
+  addStripe(peer);
+}
+
+::CORBA::Object_ptr
+CorbaForwarder::getDagdaRelay() {
+  OperationStats::Call stats(mstats, "getDagdaRelay", true);
+  return CORBA::Object::_duplicate(mdagdaRelay);
+}
+
+void
+CorbaForwarder::setRelay(const bool relay) {
+  if (!relay) {
+    mdagdaRelay = CORBA::Object::_nil();
+    return;
+  }
+  DagdaRelay* servant = new DagdaRelay(*this, mname, true);
+  ORBMgr::getMgr()->activate(servant);
+  mdagdaRelay = ORBMgr::getMgr()->reference(servant);
+}
+
+::CORBA::Object_ptr
+CorbaForwarder::peerRelay(Forwarder_ptr peer) {
+  CORBA::Object_var relay;
+
+  try {
+    relay = peer->getDagdaRelay();
+  } catch (const CORBA::SystemException& err) {
+    // A peer without relay support
+    return CORBA::Object::_nil();
+  }
+  if (CORBA::is_nil(relay)) {
+    return CORBA::Object::_nil();
+  }
+  // The relay is reached through the endpoint of the peer reference
+  std::string peerIOR = ORBMgr::getMgr()->getIOR(peer);
+  std::string converted =
+    ORBMgr::convertIOR(ORBMgr::getMgr()->getIOR(relay),
+                       ORBMgr::getHost(peerIOR), ORBMgr::getPort(peerIOR));
+  return ORBMgr::getMgr()->resolveObject(converted);
+}
+
+void
+CorbaForwarder::setPeer(Forwarder_ptr peer) {
+  std::map<std::string, PeerLink*>::iterator it;
+  CORBA::String_var name = peer->getName();
+  std::string peerName(name.in());
+  CORBA::Object_var relay = peerRelay(peer);
+  std::vector<Forwarder_var> stripes;
+  PeerLink* link;
+
+  mpeerMutex.lock();
+  it = mpeers.find(peerName);
+  if (it != mpeers.end()) {
+    // The peer reconnects: its stripes are added again below
+    link = it->second;
+    stripes = link->stripePeers();
+    link->setPeer(peer, relay);
+  } else {
+    link = new PeerLink(peerName, peer, relay);
+    link->gate().setLimits(mpeerSlots, mpeerQueue);
+    link->setReserved(mreservedStripes);
+    mpeers[peerName] = link;
+    if (mdefaultPeer.empty()) {
+      mdefaultPeer = peerName;
     }
-    /* - Remove activated servants. */
-    mservants.erase(jt);
   }
-  /* Remove the object from the cache. */
-  if ((it = mobjectCache.find(name))!=mobjectCache.end()){
-    mobjectCache.erase(it);
+  mpeerCond.broadcast();
+  mpeerMutex.unlock();
+  mlogger->log(dadi::Message("CorbaForwarder",
+                             "Peer " + peerName + " connected\n",
+                             dadi::Message::PRIO_DEBUG));
+
+  if (stripes.size() > 1) {
+    // The tunnels of the stripes outlive the peer: each one reaches the
+    // new peer through its endpoint
+    std::string peerIOR = ORBMgr::getMgr()->getIOR(peer);
+    for (unsigned int i = 1; i < stripes.size(); ++i) {
+      std::string stripeIOR = ORBMgr::getMgr()->getIOR(stripes[i]);
+      std::string converted =
+        ORBMgr::convertIOR(peerIOR, ORBMgr::getHost(stripeIOR),
+                           ORBMgr::getPort(stripeIOR));
+      try {
+        Forwarder_var stripe =
+          ORBMgr::getMgr()->resolve<Forwarder, Forwarder_var>(converted);
+        CORBA::Object_var stripeRelay = peerRelay(stripe);
+        link->addStripe(stripe, stripeRelay);
+      } catch (const CORBA::SystemException&) {
+        mlogger->log(dadi::Message("CorbaForwarder",
+                                   "Stripe of peer " + peerName
+                                   + " lost\n",
+                                   dadi::Message::PRIO_DEBUG));
+      }
+    }
   }
+}
 
-  mcachesMutex.unlock();
+Forwarder_var
+CorbaForwarder::getPeer() {
+  PeerLink* link;
+
+  mpeerMutex.lock();
+  // Wait for setPeer
+  while (mpeers.empty()) {
+    mpeerCond.wait();
+  }
+  link = mpeers[mdefaultPeer];
+  mpeerMutex.unlock();
+  return link->peer();
 }
 
-/* Remove non existing objects from the caches. */
 void
-CorbaForwarder::cleanCaches() {
-  std::map<std::string, ::CORBA::Object_ptr>::iterator it;
-  std::list<std::string> invalidObjects;
-  std::list<std::string>::const_iterator jt;
+CorbaForwarder::addStripe(Forwarder_ptr peer) {
+  std::map<std::string, PeerLink*>::iterator it;
+  CORBA::String_var name = peer->getName();
+  PeerLink* link = NULL;
 
-  mcachesMutex.lock();
-// Build a list of invalid object getting transient when using the object
-  for (it = mobjectCache.begin(); it != mobjectCache.end(); ++it) {
-    try {
-      Forwarder_var object = Forwarder::_narrow(it->second);
-      object->getName();
-    } catch (const CORBA::TRANSIENT& err) {
-      invalidObjects.push_back(it->first);
+  mpeerMutex.lock();
+  it = mpeers.find(name.in());
+  if (it != mpeers.end()) {
+    link = it->second;
+  }
+  mpeerMutex.unlock();
+
+  if (link == NULL) {
+    setPeer(peer);
+    return;
+  }
+  CORBA::Object_var relay = peerRelay(peer);
+  if (!link->addStripe(peer, relay)) {
+    return;
+  }
+  mlogger->log(dadi::Message("CorbaForwarder",
+                             "Stripe added to peer " + link->name() + "\n",
+                             dadi::Message::PRIO_DEBUG));
+}
+
+PeerLink::Call
+CorbaForwarder::getPeer(const ObjectRoute& route,
+                        const PeerLink::CallClass callClass,
+                        const bool wait) {
+  std::map<std::string, std::string>::const_iterator it;
+  std::map<std::string, PeerLink*>::const_iterator jt;
+  std::string key = routeKey(route);
+  PeerLink* link;
+
+  mpeerMutex.lock();
+  // Wait for setPeer
+  while (mpeers.empty()) {
+    mpeerCond.wait();
+  }
+  link = mpeers[mdefaultPeer];
+  it = mobjectPeers.find(key);
+  if (it != mobjectPeers.end()) {
+    jt = mpeers.find(it->second);
+    if (jt != mpeers.end()) {
+      link = jt->second;
     }
   }
-  mcachesMutex.unlock();
-// Removing the bad objects
-  for (jt = invalidObjects.begin(); jt != invalidObjects.end(); ++jt)
-    removeObjectFromCache(*jt);
+  mpeerMutex.unlock();
+  // Taking a slot may wait, out of the peers mutex. The control calls are
+  // counted by their class gate, the bulk ones entered it already
+  return PeerLink::Call(*link, callClass, wait,
+                        (callClass == PeerLink::CONTROL_CALL)
+                        ? &mclassGates[PeerLink::CONTROL_CALL] : NULL);
+}
+
+PeerLink::Call
+CorbaForwarder::getBulkPeer(const ObjectRoute& route) {
+  return getPeer(route, PeerLink::BULK_CALL);
 }
 
 void
-CorbaForwarder::connectPeer(const char* ior, const char* host,
-                           const ::CORBA::Long port) {
-  std::string converted = ORBMgr::convertIOR(ior, host, port);
-  setPeer(ORBMgr::getMgr()->resolve<Forwarder, Forwarder_ptr>(converted));
+CorbaForwarder::addRoute(const std::string& name, const std::string& peer,
+                         const std::string& ior) {
+  mpeerMutex.lock();
+  mobjectPeers[name] = peer;
+  mimports[name] = ior;
+  mpeerMutex.unlock();
 }
 
 void
-CorbaForwarder::setPeer(Forwarder_ptr peer) {
-  this->mpeer = Forwarder::_duplicate(Forwarder::_narrow(peer));
-  // Peer was init. The lock was done on the constructor.
+CorbaForwarder::setPeerLimits(const unsigned int slots,
+                              const unsigned int queue) {
+  std::map<std::string, PeerLink*>::iterator it;
+
+  mpeerMutex.lock();
+  mpeerSlots = slots;
+  mpeerQueue = queue;
+  for (it = mpeers.begin(); it != mpeers.end(); ++it) {
+    it->second->gate().setLimits(slots, queue);
+  }
   mpeerMutex.unlock();
 }
 
-Forwarder_var
-CorbaForwarder::getPeer() {
-  // Wait for setPeer
+void
+CorbaForwarder::setReservedStripes(const unsigned int reserved) {
+  std::map<std::string, PeerLink*>::iterator it;
+
   mpeerMutex.lock();
+  mreservedStripes = reserved;
+  for (it = mpeers.begin(); it != mpeers.end(); ++it) {
+    it->second->setReserved(reserved);
+  }
   mpeerMutex.unlock();
-  try {
-    // Check if peer is still alive
-    mpeer->getName();
-  } catch (const CORBA::COMM_FAILURE& err) {
-    // Lock peerMutex, then wait for setPeer
-    // (setPeer() unlock the mutex
-    mpeerMutex.lock();
-    mpeerMutex.lock();
-    mpeerMutex.unlock();
-  } catch (const CORBA::TRANSIENT& err) {
-    // Lock peerMutex, then wait for setPeer
-    // (setPeer() unlock the mutex
-    mpeerMutex.lock();
-    mpeerMutex.lock();
-    mpeerMutex.unlock();
+}
+
+void
+CorbaForwarder::setAsyncWorkers(const unsigned int workers) {
+  if (workers == 0 || masyncPools[0] != NULL) {
+    return;
+  }
+  // A burst of bulk calls cannot take the workers of the control calls
+  for (int i = 0; i < 2; ++i) {
+    masyncPools[i] = new WorkerPool(workers);
+    masyncPools[i]->setFailureReport(deferredFailure, this);
+    masyncCalls[i] = new SerialQueue(*masyncPools[i], ASYNC_PENDING);
+  }
+}
+
+void
+CorbaForwarder::deferredFailure(const std::string& failure,
+                                void* forwarder) {
+  static_cast<CorbaForwarder*>(forwarder)->mlogger->log(
+    dadi::Message("CorbaForwarder", failure + "\n",
+                  dadi::Message::PRIO_DEBUG));
+}
+
+bool
+CorbaForwarder::inDeferredCall() const {
+  for (int i = 0; i < 2; ++i) {
+    if (masyncPools[i] != NULL && masyncPools[i]->isWorker()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void
+CorbaForwarder::setBulkLimits(const unsigned int slots,
+                              const unsigned int queue) {
+  mclassGates[PeerLink::BULK_CALL].setLimits(slots, queue);
+}
+
+const CallGate&
+CorbaForwarder::classGate(const PeerLink::CallClass callClass) const {
+  return mclassGates[callClass];
+}
+
+CorbaForwarder::BulkCall::BulkCall(CorbaForwarder& forwarder,
+                                   const ObjectRoute& route)
+  : mgate(NULL), mentered(false) {
+  // The calls from the peer were admitted by the gate of the peer
+  if (route.remote()) {
+    return;
+  }
+  mgate = &forwarder.mclassGates[PeerLink::BULK_CALL];
+  enter();
+}
+
+CorbaForwarder::BulkCall::~BulkCall() {
+  leave();
+}
+
+void
+CorbaForwarder::BulkCall::leave() {
+  if (mgate != NULL && mentered) {
+    mgate->leave();
+    mentered = false;
   }
-  return mpeer;
 }
 
+void
+CorbaForwarder::BulkCall::enter() {
+  if (mgate != NULL && !mentered) {
+    if (!mgate->enter()) {
+      throw CORBA::TRANSIENT(0, CORBA::COMPLETED_NO);
+    }
+    mentered = true;
+  }
+}
+
+const ObjectRoute::Table&
+CorbaForwarder::getRoutes() const {
+  return mroutes;
+}
+
+std::string
+CorbaForwarder::routeKey(const ObjectRoute& route) const {
+  /* The local and master agents are binded in the agents context. */
+  if (route.context() == ROUTE_LOCALAGENT
+      || route.context() == ROUTE_MASTERAGENT) {
+    return std::string(AGENTCTXT) + "/" + route.name();
+  }
+  return route.path();
+}
+
+void
+CorbaForwarder::peersBind(const std::string& objName, const std::string& ior,
+                          const std::string& except) {
+  std::map<std::string, PeerLink*>::const_iterator it;
+  std::list<PeerLink*> links;
+  std::list<PeerLink*>::const_iterator jt;
+
+  mpeerMutex.lock();
+  // The bindings made on this side wait for setPeer
+  while (except.empty() && mpeers.empty()) {
+    mpeerCond.wait();
+  }
+  for (it = mpeers.begin(); it != mpeers.end(); ++it) {
+    if (it->first != except) {
+      links.push_back(it->second);
+    }
+  }
+  mpeerMutex.unlock();
+
+  for (jt = links.begin(); jt != links.end(); ++jt) {
+    try {
+      PeerLink::Call peer(**jt);
+      if (ior.empty()) {
+        peer->unbind(objName.c_str());
+      } else {
+        peer->bind(objName.c_str(), ior.c_str());
+      }
+    } catch (const CORBA::Exception& err) {
+      mlogger->log(dadi::Message("CorbaForwarder",
+                                 "Unable to forward " + objName
+                                 + " to peer " + (*jt)->name() + "\n",
+                                 dadi::Message::PRIO_DEBUG));
+    }
+  }
+}
 
 char*
 CorbaForwarder::getIOR() {
+  OperationStats::Call stats(mstats, "getIOR", true);
   return CORBA::string_dup(ORBMgr::getMgr()->getIOR(_this()).c_str());
 }
 
 char*
 CorbaForwarder::getName() {
+  OperationStats::Call stats(mstats, "getName", true);
   return CORBA::string_dup(mname.c_str());
 }
 
 char*
 CorbaForwarder::getPeerName() {
+  OperationStats::Call stats(mstats, "getPeerName", false);
   return CORBA::string_dup(getPeer()->getName());
 }
 
 char*
 CorbaForwarder::getHost() {
+  OperationStats::Call stats(mstats, "getHost", true);
   return CORBA::string_dup(mhost.c_str());
 }
 
 char*
 CorbaForwarder::getPeerHost() {
+  OperationStats::Call stats(mstats, "getPeerHost", false);
   return CORBA::string_dup(getPeer()->getHost());
 }
 
+::CORBA::Boolean
+CorbaForwarder::octetTransfers() {
+  OperationStats::Call stats(mstats, "octetTransfers", true);
+  return moctetTransfers;
+}
 
-std::list<std::string>
-CorbaForwarder::otherForwarders() const {
-  ORBMgr* mgr = ORBMgr::getMgr();
-  std::list<std::string> result = mgr->list(FWRDCTXT);
+void
+CorbaForwarder::setOctetTransfers(const bool octets) {
+  moctetTransfers = octets;
+}
 
-  result.remove(mname);
+::CORBA::Boolean
+CorbaForwarder::streamTransfers() {
+  OperationStats::Call stats(mstats, "streamTransfers", true);
+  return true;
+}
+
+::CORBA::Boolean
+CorbaForwarder::resumableStreams() {
+  OperationStats::Call stats(mstats, "resumableStreams", true);
+  return true;
+}
+
+::CORBA::Boolean
+CorbaForwarder::dedupTransfers() {
+  OperationStats::Call stats(mstats, "dedupTransfers", true);
+  return mchunkStore != NULL;
+}
+
+void
+CorbaForwarder::setStreamLimits(const unsigned long chunkSize,
+                                const unsigned int window) {
+  mstreamChunk = chunkSize;
+  mstreamWindow = (window == 0) ? 1 : window;
+}
+
+void
+CorbaForwarder::setStreamSpool(const std::string& directory) {
+  mstreamSpool = directory;
+}
+
+SeqForwarderOpStats_t*
+CorbaForwarder::getStats() {
+  OperationStats::Call stats(mstats, "getStats", true);
+  std::vector<OperationStats::Summary> summaries = mstats.snapshot();
+  SeqForwarderOpStats_t* result = new SeqForwarderOpStats_t;
+
+  result->length(summaries.size());
+  for (CORBA::ULong i = 0; i < summaries.size(); ++i) {
+    forwarder_op_stats_t& op = (*result)[i];
+    op.operation = CORBA::string_dup(summaries[i].operation.c_str());
+    op.local = summaries[i].local;
+    op.calls = summaries[i].calls;
+    op.errors = summaries[i].errors;
+    op.bytesIn = summaries[i].bytesIn;
+    op.bytesOut = summaries[i].bytesOut;
+    op.p50 = summaries[i].p50;
+    op.p99 = summaries[i].p99;
+    op.p999 = summaries[i].p999;
+  }
   return result;
 }
 
-std::string
-CorbaForwarder::getName(const std::string& namectxt) {
-  size_t pos = namectxt.find('/');
-  if (pos == std::string::npos) {
-    return namectxt;
+SeqForwarderClassStats_t*
+CorbaForwarder::getClassStats() {
+  OperationStats::Call stats(mstats, "getClassStats", true);
+  static const char* names[] = {"control", "bulk"};
+  SeqForwarderClassStats_t* result = new SeqForwarderClassStats_t;
+
+  result->length(2);
+  for (CORBA::ULong i = 0; i < 2; ++i) {
+    const CallGate& gate =
+      classGate(static_cast<PeerLink::CallClass>(i));
+    forwarder_class_stats_t& callClass = (*result)[i];
+    callClass.callClass = CORBA::string_dup(names[i]);
+    callClass.inProgress = gate.inProgress();
+    callClass.waiting = gate.waiting();
+    callClass.admitted = gate.entered();
+    callClass.refused = gate.refused();
+    callClass.waitTime = gate.waitTime();
+    callClass.maxWait = gate.maxWait();
   }
-  return namectxt.substr(pos+1);
+  return sent(stats, result);
 }
 
-std::string
-CorbaForwarder::getCtxt(const std::string& namectxt) {
-  size_t pos = namectxt.find('/');
-  if (pos == std::string::npos) {
-    return "";
+void
+CorbaForwarder::setStatsDump(const std::string& path,
+                             const unsigned int period) {
+  mstats.startDump(path, period);
+}
+
+void
+CorbaForwarder::setResultTTL(const unsigned int ttl) {
+  mresults.setTTL(ttl);
+}
+
+char*
+CorbaForwarder::findString(const std::string& target, const char* call) {
+  CachedResult cached;
+  const char* value;
+
+  if (!mresults.find(target, call, cached) || !(cached.value >>= value)) {
+    return NULL;
+  }
+  return CORBA::string_dup(value);
+}
+
+void
+CorbaForwarder::cacheString(const std::string& target, const char* call,
+                            const char* value,
+                            const unsigned long generation) {
+  CachedResult cached;
+
+  cached.value <<= value;
+  cached.length = 0;
+  mresults.insert(target, call, cached, generation);
+}
+
+void
+CorbaForwarder::bindingChanged(const ObjectRoute& route) {
+  mresults.invalidate(routeKey(route));
+  mresults.invalidateCall("getBindings");
+
+  // The object may be bound again to another implementation
+  mbulkDagdasMutex.lock();
+  mbulkDagdas.erase(route.name());
+  mbulkDagdasMutex.unlock();
+}
+
+void
+CorbaForwarder::servicesChanged(const ObjectRoute& route) {
+  mresults.invalidate(routeKey(route));
+  mresults.invalidateCall("getProfiles");
+  mresults.invalidateCall("getSeDProfiles");
+}
+
+bool
+CorbaForwarder::octetHop(const PeerLink::Call& peer) const {
+  return moctetTransfers && peer.supports(PeerLink::OCTET_TRANSFERS);
+}
+
+bool
+CorbaForwarder::streamHop(const PeerLink::Call& peer,
+                          const ::CORBA::ULong length) const {
+  // The chunks are carried as octets
+  return mstreamChunk > 0 && length > mstreamChunk && octetHop(peer)
+    && peer.supports(PeerLink::STREAM_TRANSFERS);
+}
+
+DagdaBulk_ptr
+CorbaForwarder::bulkDagda(const std::string& name, Dagda_ptr dagda) {
+  std::map<std::string, bool>::const_iterator it;
+  bool known = false;
+  bool bulk = false;
+
+  if (!moctetTransfers) {
+    return DagdaBulk::_nil();
+  }
+  mbulkDagdasMutex.lock();
+  it = mbulkDagdas.find(name);
+  if (it != mbulkDagdas.end()) {
+    known = true;
+    bulk = it->second;
+  }
+  mbulkDagdasMutex.unlock();
+
+  if (!known) {
+    // A remote call, made out of the mutex
+    bulk = dagda->_is_a(DagdaBulk::_PD_repoId);
+    mbulkDagdasMutex.lock();
+    mbulkDagdas[name] = bulk;
+    mbulkDagdasMutex.unlock();
   }
-  return namectxt.substr(0, pos);
+  if (!bulk) {
+    return DagdaBulk::_nil();
+  }
+  return DagdaBulk::_unchecked_narrow(dagda);
+}
+
+OperationStats&
+CorbaForwarder::operationStats() {
+  return mstats;
+}
+
+
+std::list<std::string>
+CorbaForwarder::otherForwarders() const {
+  ORBMgr* mgr = ORBMgr::getMgr();
+  std::list<std::string> result = mgr->list(FWRDCTXT);
+
+  result.remove(mname);
+  return result;
 }
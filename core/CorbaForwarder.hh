@@ -16,12 +16,23 @@
 
 #include <list>
 #include <map>
+#include <stdexcept>
 #include <string>
 #include <omnithread.h>
 #include "Forwarder.hh"
 #include "common_types.hh"
 #include "LogTypes.hh"
 #include "response.hh"
+#include "PeerLink.hh"
+#include "utils/CallGate.hh"
+#include "utils/ChunkStore.hh"
+#include "utils/ObjectRoute.hh"
+#include "utils/OperationStats.hh"
+#include "utils/PayloadSize.hh"
+#include "utils/ResultCache.hh"
+#include "utils/SerialQueue.hh"
+#include "utils/StreamJournal.hh"
+#include "utils/WorkerPool.hh"
 #include "dadi/Logging/Logger.hh"
 
 /**
@@ -39,6 +50,59 @@ public:
  */
   explicit CorbaForwarder(const std::string& name);
 
+  /**
+   * @brief A bulk call, data transfer, admitted by the bulk gate of the
+   * forwarder for its duration. The control calls are never gated: the
+   * threads not taken by the bulk calls stay available to them.
+   * Only the calls forwarded to the peer are gated: a transfer passes the
+   * gate of the forwarder it enters, never the one of the peer, which
+   * would wait for a slot while the sender holds its own.
+   * @class BulkCall
+   */
+  class BulkCall {
+  public:
+    /**
+     * @brief Constructor, takes a slot of the bulk gate if the call is
+     *   forwarded to the peer.
+     * @param forwarder The forwarder
+     * @param route The route of the call
+     * @throw CORBA::TRANSIENT if the bulk queue is full
+     */
+    BulkCall(CorbaForwarder& forwarder, const ObjectRoute& route);
+
+    /**
+     * @brief Destructor, releases the slot.
+     */
+    ~BulkCall();
+
+    /**
+     * @brief Release the slot before waiting, without ending the call.
+     */
+    void
+    leave();
+
+    /**
+     * @brief Take a slot again, after leave().
+     * @throw CORBA::TRANSIENT if the bulk queue is full
+     */
+    void
+    enter();
+
+  private:
+    BulkCall(const BulkCall&);
+    BulkCall&
+    operator=(const BulkCall&);
+
+    /**
+     * @brief The bulk gate, NULL for a call from the peer.
+     */
+    CallGate* mgate;
+    /**
+     * @brief Is a slot held?
+     */
+    bool mentered;
+  };
+
   /* DIET object factory methods. */
 
   Agent_ptr
@@ -75,15 +139,6 @@ public:
   ::CORBA::Long
   removeElement(::CORBA::Boolean recursive, const char* objName);
 
-  /*
-   * @brief To determine if the call is from another forwarder and
-   * modify the object name.
-   * @param objName The name of the object to check if local
-   * @return If the call is remote = true
-   */
-  static bool
-  remoteCall(std::string& objName);
-
   /* CORBA remote management implementation. */
   void
   bind(const char* objName, const char* ior);
@@ -93,6 +148,10 @@ public:
   getBindings(const char* ctxt);
   void
   connectPeer(const char* ior, const char* host, const ::CORBA::Long port);
+  void
+  connectStripe(const char* ior, const char* host, const ::CORBA::Long port);
+  ::CORBA::Object_ptr
+  getDagdaRelay();
   char*
   getIOR();
   char*
@@ -103,30 +162,210 @@ public:
   getHost();
   char*
   getPeerHost();
+  SeqForwarderOpStats_t*
+  getStats();
+  SeqForwarderClassStats_t*
+  getClassStats();
+  ::CORBA::Boolean
+  octetTransfers();
+  ::CORBA::Boolean
+  streamTransfers();
+  ::CORBA::Boolean
+  resumableStreams();
+  ::CORBA::Boolean
+  dedupTransfers();
+  /**
+   * @brief Dump the statistics of the calls to a file at a fixed period
+   * (not CORBA).
+   * @param path The file path
+   * @param period The period (s), 0 for no dump
+   */
+  void
+  setStatsDump(const std::string& path, const unsigned int period);
+  /**
+   * @brief Cache the results of the read-only calls forwarded to the peer
+   * (not CORBA): getHostname, getID, getDataManager, getDataMgrID,
+   * getBindName, getProfiles and getSeDProfiles, and the results of
+   * getBindings. The results of an object are dropped when it is bound
+   * or unbound, and the profiles when services are added or removed.
+   * @param ttl The time to live of the results (s), 0 for no cache
+   */
+  void
+  setResultTTL(const unsigned int ttl);
+  /**
+   * @brief To get the statistics of the calls (not CORBA), to count the
+   * calls served outside of the forwarder methods.
+   * @return The statistics
+   */
+  OperationStats&
+  operationStats();
   /**
-   * @brief Set this forwarder peer object (not CORBA).
-   * @param peer The peer to set
+   * @brief Add a peer to this forwarder (not CORBA). A peer already known
+   * under the same name is replaced, its stripes resolved again through
+   * their endpoints. The first peer is the default one.
+   * @param peer The peer to add
    */
   void
   setPeer(Forwarder_ptr peer);
   /**
-   * @brief To get the corresponding peer
-   * @return The corresponding peer
+   * @brief To get the default peer. Waits for the first peer.
+   * @return The default peer
    */
   Forwarder_var
   getPeer();
+  /**
+   * @brief Add a stripe to the link with a peer (not CORBA). An unknown
+   * peer is added as by setPeer().
+   * @param peer The peer, through the stripe endpoint
+   */
+  void
+  addStripe(Forwarder_ptr peer);
+  /**
+   * @brief To get the peer serving an object: the peer that binded it on
+   * this forwarder, or the default peer. Waits for the first peer.
+   * @param route The object route
+   * @param callClass The kind of call, choosing the peer link stripe
+   * @param wait Wait for a slot of the peer link, or give up if none is
+   *   free
+   * @return The call through the peer link, to use as a temporary
+   * @throw CORBA::TRANSIENT if the peer link is saturated
+   */
+  PeerLink::Call
+  getPeer(const ObjectRoute& route,
+          const PeerLink::CallClass callClass = PeerLink::CONTROL_CALL,
+          const bool wait = true);
+  /**
+   * @brief To get the peer serving an object, for a bulk call.
+   * @param route The object route
+   * @return The call through the bulk stripes of the peer link
+   */
+  PeerLink::Call
+  getBulkPeer(const ObjectRoute& route);
+  /**
+   * @brief Route the calls to an object binded by a peer through it.
+   * @param name The object name (context/name)
+   * @param peer The peer name
+   * @param ior The IOR of the object, as binded here
+   */
+  void
+  addRoute(const std::string& name, const std::string& peer,
+           const std::string& ior);
+  /**
+   * @brief Bound the calls in progress through each peer link.
+   * @param slots The maximum number of calls in progress (0: no limit)
+   * @param queue The maximum number of waiting calls (0: no limit)
+   */
+  void
+  setPeerLimits(const unsigned int slots, const unsigned int queue);
+  /**
+   * @brief Set the number of stripes of each peer link reserved to the
+   * control calls.
+   * @param reserved The number of reserved stripes
+   */
+  void
+  setReservedStripes(const unsigned int reserved);
+  /**
+   * @brief Relay the Dagda calls without decoding their data (not CORBA).
+   * Creates the relay given to the peers and serves the Dagda proxies
+   * with relays. To set before the first proxy is created.
+   * @param relay Relay the Dagda calls?
+   */
+  void
+  setRelay(const bool relay);
+  /**
+   * @brief Carry the Dagda transfers as octets when the next hop accepts
+   * them (not CORBA). Enabled by default, disabled to compare with the
+   * transfers as chars; the peer then sends chars too.
+   * @param octets Use the octet transfers?
+   */
+  void
+  setOctetTransfers(const bool octets);
+  /**
+   * @brief Stream the large recordData and writeFile calls to the peer
+   * (not CORBA): the data are sent by chunks, several at once, and the
+   * peer makes the call chunk by chunk. The peer holds at most a window
+   * of chunks per transfer.
+   * @param chunkSize The chunk size (bytes), 0 to send the calls whole
+   * @param window The maximum number of chunks in flight per transfer
+   */
+  void
+  setStreamLimits(const unsigned long chunkSize, const unsigned int window);
+  /**
+   * @brief Spool the chunks of the received streams in a file instead of
+   * the heap (not CORBA): each stream gets a file of a window of chunks,
+   * allocated at once, where the chunks received ahead of their turn are
+   * written to the slot of their index. The calls on the objects read
+   * them back through a mapping of the file, whose pages are released
+   * after each chunk.
+   * @param directory The directory of the files, empty for the heap
+   */
+  void
+  setStreamSpool(const std::string& directory);
+  /**
+   * @brief Resume the recordData streams broken midway (not CORBA). The
+   * receiver journals the chunks made on the objects; when a stream to
+   * the peer fails on a broken link, the sender opens it again and only
+   * sends the chunks not made yet.
+   * @param directory The directory of the journals of the received
+   *   streams, empty to keep them in memory: they then survive a broken
+   *   link but not a restart of this forwarder
+   * @param resumes The number of times a sent stream is resumed
+   */
+  void
+  setStreamResume(const std::string& directory, const unsigned int resumes);
+  /**
+   * @brief Keep the chunks of the received streams in a store (not CORBA),
+   * addressed by their content. The peer offers the digests of the chunks
+   * of a stream before sending them, and only sends the chunks missing
+   * from the store. To set before serving.
+   * @param directory The directory of the store
+   * @param maxSize The maximum size of the store (bytes), the least
+   *   recently used chunks are evicted beyond
+   * @throw std::runtime_error if the directory cannot be read
+   */
+  void
+  setChunkStore(const std::string& directory, const unsigned long maxSize);
+  /**
+   * @brief Forward the oneway calls asynchronously (not CORBA): the
+   * requests complete at once and a pool of workers makes the calls, so
+   * that the ORB threads are not held by slow peers or objects. The calls
+   * to a same object are still made in order. The control and the bulk
+   * calls have their own workers. To set before serving.
+   * @param workers The number of workers of each class of calls, 0 to
+   *   forward synchronously
+   */
+  void
+  setAsyncWorkers(const unsigned int workers);
+  /**
+   * @brief Bound the bulk calls in progress through the forwarder (not
+   * CORBA), the share of the threads left to the data transfers.
+   * @param slots The maximum number of bulk calls in progress (0: no
+   *   limit)
+   * @param queue The maximum number of waiting bulk calls (0: no limit)
+   */
+  void
+  setBulkLimits(const unsigned int slots, const unsigned int queue);
+  /**
+   * @brief To get the gate of a class of calls, and its metrics: queue
+   * depth and waiting times. The control calls are counted, never queued.
+   * @param callClass The class of calls
+   * @return The gate
+   */
+  const CallGate&
+  classGate(const PeerLink::CallClass callClass) const;
+  /**
+   * @brief To get the contexts known by the forwarder.
+   * @return The table of the contexts, to parse the object names
+   */
+  const ObjectRoute::Table&
+  getRoutes() const;
   /* Object caches management functions. */
 /**
- * @brief To remove the object name from the cache
- * @param name The object to remove from the cache
+ * @brief To forget the kind of agent binded with this name
+ * @param name The object name (context/name)
  */
   void
   removeObjectFromCache(const std::string& name);
-/**
- * @brief To clean the caches
- */
-  void
-  cleanCaches();
 
   /* Utility function. */
 
@@ -377,6 +616,101 @@ public:
   void
   unsubscribeParent(const char* objName);
 
+  /* The Dagda transfers as octets. The char and octet versions forward
+     the data as octets when the next hop accepts them. */
+  void
+  lclAddDataOctets(const char* srcDagda,
+                   const ::corba_octet_data_t& data,
+                   const char* objName);
+
+  void
+  lvlAddDataOctets(const char* srcDagda,
+                   const ::corba_octet_data_t& data,
+                   const char* objName);
+
+  void
+  pfmAddDataOctets(const char* srcDagda,
+                   const ::corba_octet_data_t& data,
+                   const char* objName);
+
+  void
+  lclUpdateDataOctets(const char* srcDagda,
+                      const ::corba_octet_data_t& data,
+                      const char* objName);
+
+  void
+  lvlUpdateDataOctets(const char* srcDagda,
+                      const ::corba_octet_data_t& data,
+                      const char* objName);
+
+  void
+  pfmUpdateDataOctets(const char* srcDagda,
+                      const ::corba_octet_data_t& data,
+                      const char* objName);
+
+  char*
+  writeFileOctets(const ::SeqOctet& data,
+                  const char* basename,
+                  ::CORBA::Boolean replace,
+                  const char* objName);
+
+  char*
+  sendFileOctets(const ::corba_octet_data_t& data,
+                 const char* destDagda,
+                 const char* objName);
+
+  char*
+  recordDataOctets(const ::SeqOctet& data,
+                   const ::corba_data_desc_t& dataDesc,
+                   ::CORBA::Boolean replace,
+                   ::CORBA::Long offset,
+                   const char* objName);
+
+  /* The streamed transfers, served by the receiving forwarder. */
+  ::CORBA::Long
+  openRecordStream(const ::corba_data_desc_t& dataDesc,
+                   ::CORBA::Boolean replace,
+                   ::CORBA::Long offset,
+                   ::CORBA::ULong length,
+                   ::CORBA::ULong chunkSize,
+                   const char* objName);
+
+  ::CORBA::Long
+  openWriteStream(const char* basename,
+                  ::CORBA::Boolean replace,
+                  ::CORBA::ULong length,
+                  ::CORBA::ULong chunkSize,
+                  const char* objName);
+
+  ::CORBA::Long
+  resumeRecordStream(const ::corba_data_desc_t& dataDesc,
+                     ::CORBA::Boolean replace,
+                     ::CORBA::Long offset,
+                     ::CORBA::ULong length,
+                     ::CORBA::ULong chunkSize,
+                     const ::SeqULong& checksums,
+                     const char* objName,
+                     ::CORBA::ULong& first);
+
+  void
+  writeChunk(::CORBA::Long stream,
+             ::CORBA::ULong index,
+             const ::SeqOctet& data);
+
+  SeqULong*
+  offerChunks(::CORBA::Long stream,
+              ::CORBA::ULong first,
+              const ::SeqOctet& digests);
+
+  SeqULong*
+  missingChunks(::CORBA::Long stream);
+
+  char*
+  commitStream(::CORBA::Long stream);
+
+  void
+  abortStream(::CORBA::Long stream);
+
 
   /* MaDagFwdr implementation. */
   ::CORBA::Long
@@ -588,13 +922,6 @@ public:
   void
   nodeIsFailed(const char* dagNodeId, const char* wfId, const char* objName);
 
-  /* Utility fonctions to extract name & context from context/name. */
-  static std::string
-  getName(const std::string& namectxt);
-
-  static std::string
-  getCtxt(const std::string& namectxt);
-
   ComponentConfigurator_ptr getCompoConf(const char* name);
   ToolMsgReceiver_ptr getToolMsgReceiver(const char* name);
   LogCentralComponent_ptr getLogCentralComponent(const char* name);
@@ -639,34 +966,550 @@ public:
               const char* objName);
 private:
   /**
-   * @brief When a new forwarder object is created, we cache it.
-   * Because this kind of object contains only the object
-   * name and a reference to this forwarder, there is no
-   * risk to cache it, even if the object is restarted or
-   * disappear.
+   * @brief Identifiers of the contexts in the route table.
    */
-  std::map<std::string, ::CORBA::Object_ptr> mobjectCache;
+  enum RouteContext {
+    ROUTE_AGENT = 1,
+    ROUTE_SED,
+    ROUTE_CLIENT,
+    ROUTE_WFMGR,
+    ROUTE_MADAG,
+    ROUTE_DAGDA,
+    ROUTE_LOCALAGENT,
+    ROUTE_MASTERAGENT
+  };
+
   /**
-   * @brief We also maintain a list of activated servant objects.
+   * @brief The contexts known by the forwarder, used to parse the object
+   * names of the forwarded calls. Filled by the constructor.
    */
-  std::map<std::string, PortableServer::ServantBase*> mservants;
+  ObjectRoute::Table mroutes;
 
+  /**
+   * @brief Interfaces of the proxy objects.
+   */
+  enum ProxyType {
+    PROXY_AGENT = 0,
+    PROXY_CALLBACK,
+    PROXY_LOCALAGENT,
+    PROXY_MASTERAGENT,
+    PROXY_SED,
+    PROXY_DAGDA,
+    PROXY_CLTMAN,
+    PROXY_MADAG,
+    PROXY_WFLOGSERVICE,
+    PROXY_LOGCOMPONENT,
+    PROXY_LOGTOOL,
+    PROXY_COMPOCONF,
+    PROXY_TOOLMSGRECEIVER,
+    PROXY_COUNT
+  };
+
+  /**
+   * @brief Function creating the servant of a proxy POA.
+   */
+  typedef PortableServer::ServantBase* (*ProxyFactory)(Forwarder_ptr fwdr);
+
+  /**
+   * @brief Return the proxy object of a remote object. The proxy objects
+   * of an interface are served by the default servant of a POA, created
+   * on first use, and the object name is their object identifier: a proxy
+   * costs no servant and no activation.
+   * @param type The proxy interface
+   * @param ctxt The context added to a name without context
+   * @param name The remote object name
+   * @param factory The function creating the servant of the proxy POA,
+   *   NULL to serve the proxies with a relay
+   * @return The proxy object
+   */
   ::CORBA::Object_ptr
-  getObjectCache(const std::string& name);
+  getProxy(ProxyType type, const char* ctxt, const char* name,
+           ProxyFactory factory);
+
+  /**
+   * @brief Create the relay serving the proxies of an interface.
+   * @param type The proxy interface
+   * @return The relay servant
+   */
+  PortableServer::ServantBase*
+  newRelay(ProxyType type);
+
+  /**
+   * @brief Get the relay of a peer, reached through the same endpoint as
+   * the peer forwarder.
+   * @param peer The peer forwarder
+   * @return The relay, nil if the peer does not relay
+   */
+  ::CORBA::Object_ptr
+  peerRelay(Forwarder_ptr peer);
+
+  /**
+   * @brief A deferred call, made by the asynchronous workers.
+   */
+  template <class Call>
+  class DeferredCall;
+
+  /**
+   * @brief Defer a oneway call to the asynchronous workers. Nothing is
+   * deferred without workers, nor from a deferred call itself, nor above
+   * a bound of deferred calls: the slow peers then hold the callers.
+   * @param objName The object name, ordering the calls
+   * @param call The call, holding copies of its arguments
+   * @param callClass The class of the call, choosing the workers
+   * @return true if the call was deferred
+   */
+  template <class Call>
+  bool
+  defer(const char* objName, const Call& call,
+        const PeerLink::CallClass callClass = PeerLink::CONTROL_CALL);
+
+  /**
+   * @brief Is the calling thread an asynchronous worker?
+   * @return true when called from a deferred call
+   */
+  bool
+  inDeferredCall() const;
+
+  /**
+   * @brief Log the failure of a deferred call.
+   * @param failure The failure
+   * @param forwarder The forwarder
+   */
+  static void
+  deferredFailure(const std::string& failure, void* forwarder);
+
+  /**
+   * @brief Count a result as the payload returned by a call.
+   * @param stats The call
+   * @param result The result
+   * @return The result
+   */
+  template <class T>
+  static T*
+  sent(OperationStats::Call& stats, T* result);
+
+  /**
+   * @brief Look up a cached string result.
+   * @param target The target object key, as given by routeKey()
+   * @param call The call
+   * @return A copy of the result, NULL if not cached
+   */
+  char*
+  findString(const std::string& target, const char* call);
+
+  /**
+   * @brief Cache a string result.
+   * @param target The target object key, as given by routeKey()
+   * @param call The call
+   * @param value The result
+   * @param generation The cache generation taken before the call
+   */
+  void
+  cacheString(const std::string& target, const char* call,
+              const char* value, const unsigned long generation);
 
   /**
-   * @brief The forwarder associated to this one.
+   * @brief Look up a cached sequence result.
+   * @param target The target object key, as given by routeKey()
+   * @param call The call
+   * @param length The length returned with the sequence, if any
+   * @return A copy of the result, NULL if not cached
    */
-  Forwarder_var mpeer;
+  template <class Seq>
+  Seq*
+  findSequence(const std::string& target, const char* call,
+               ::CORBA::Long* length = NULL);
+
+  /**
+   * @brief Cache a sequence result.
+   * @param target The target object key, as given by routeKey()
+   * @param call The call
+   * @param value The result
+   * @param generation The cache generation taken before the call
+   * @param length The length returned with the sequence, if any
+   */
+  template <class Seq>
+  void
+  cacheSequence(const std::string& target, const char* call,
+                const Seq& value, const unsigned long generation,
+                const ::CORBA::Long length = 0);
+
+  /**
+   * @brief Drop the cached results that a binding change makes stale.
+   * @param route The bound or unbound object
+   */
+  void
+  bindingChanged(const ObjectRoute& route);
+
+  /**
+   * @brief Drop the cached results that a change of the services of an
+   * agent makes stale: its results and all the profiles.
+   * @param route The agent
+   */
+  void
+  servicesChanged(const ObjectRoute& route);
+
+  /**
+   * @brief Get a local Dagda object as a DagdaBulk, if it accepts the
+   * transfers as octets. The answer of each object is kept until it is
+   * bound again.
+   * @param name The object name
+   * @param dagda The object
+   * @return The object, nil if it only accepts chars
+   */
+  DagdaBulk_ptr
+  bulkDagda(const std::string& name, Dagda_ptr dagda);
+
+  /**
+   * @brief Should a transfer to the peer be carried as octets?
+   * @param peer The call to the peer
+   * @return true if both forwarders use the octet transfers
+   */
+  bool
+  octetHop(const PeerLink::Call& peer) const;
+
+  /**
+   * @brief Should a transfer to the peer be streamed?
+   * @param peer The call to the peer
+   * @param length The size of the data
+   * @return true if the data span several chunks and the peer accepts
+   *   the streams
+   */
+  bool
+  streamHop(const PeerLink::Call& peer, const ::CORBA::ULong length) const;
+
+  /* The streams, sent and received, in DagdaStream.cc. */
+  struct Stream;
+  struct StreamSender;
+  class StreamStart;
+  class StreamHelper;
+
+  /**
+   * @brief Stream a recordData call to the peer.
+   * @param route The route of the object
+   * @param bulk The bulk call of the transfer
+   * @param peer The call to the peer
+   * @param data The data
+   * @param dataDesc The data description
+   * @param replace Replace the data?
+   * @param offset The offset of the data
+   * @return The data id
+   */
+  char*
+  streamRecordData(ObjectRoute& route, BulkCall& bulk, PeerLink::Call& peer,
+                   const ::SeqOctet& data,
+                   const ::corba_data_desc_t& dataDesc,
+                   const ::CORBA::Boolean replace,
+                   const ::CORBA::Long offset);
+
+  /**
+   * @brief Stream a writeFile call to the peer.
+   * @param route The route of the object
+   * @param peer The call to the peer
+   * @param data The data
+   * @param basename The file name
+   * @param replace Replace the file?
+   * @return The file path
+   */
+  char*
+  streamWriteFile(ObjectRoute& route, PeerLink::Call& peer,
+                  const ::SeqOctet& data, const char* basename,
+                  const ::CORBA::Boolean replace);
+
+  /**
+   * @brief Stream a recordData call to the peer, resumed as long as the
+   * link breaks, at most mstreamResumes times. The slots of the bulk call
+   * and of the peer call are released while waiting for the peer.
+   * @param route The route of the object
+   * @param bulk The bulk call of the transfer
+   * @param peer The call to the peer
+   * @param data The data
+   * @param dataDesc The data description
+   * @param replace Replace the data?
+   * @param offset The offset of the data
+   * @return The data id
+   */
+  char*
+  resumeRecordData(ObjectRoute& route, BulkCall& bulk, PeerLink::Call& peer,
+                   const ::SeqOctet& data,
+                   const ::corba_data_desc_t& dataDesc,
+                   const ::CORBA::Boolean replace,
+                   const ::CORBA::Long offset);
+
+  /**
+   * @brief Offer the digests of the chunks of an opened stream to the
+   * peer, and mark the chunks it holds as sent.
+   * @param sender The stream being sent
+   * @param peer The call to the peer
+   * @param first The first chunk to send
+   */
+  void
+  dedupChunks(StreamSender& sender, PeerLink::Call& peer,
+              const unsigned long first);
+
+  /**
+   * @brief Send the chunks of an opened stream, from this thread and from
+   * helpers run by the stream workers, then commit it. A helper only
+   * runs with a slot of the peer link free when it is queued.
+   * @param route The route of the object
+   * @param peer The call to the peer
+   * @param stream The stream id
+   * @param data The data
+   * @param first The first chunk to send
+   * @return The result of the call
+   */
+  char*
+  sendStream(const ObjectRoute& route, PeerLink::Call& peer,
+             const ::CORBA::Long stream, const ::SeqOctet& data,
+             const unsigned long first = 0);
+
+  /**
+   * @brief Send chunks until none is left or a send fails.
+   * @param sender The stream being sent
+   * @param peer The call to the peer
+   */
+  void
+  sendChunks(StreamSender& sender, PeerLink::Call& peer);
+
+  /**
+   * @brief Send again the chunks the peer could not take from its chunk
+   * store after all, until it holds them all or a send fails.
+   * @param sender The stream being sent, all its chunks sent
+   * @param peer The call to the peer
+   */
+  void
+  resendChunks(StreamSender& sender, PeerLink::Call& peer);
+
+  /**
+   * @brief Get the workers running the helpers of the sent streams and
+   *   the chunks of the received ones taken from the chunk store,
+   *   started on the first use.
+   * @return The stream workers
+   */
+  WorkerPool&
+  streamWorkers();
+
+  /**
+   * @brief Open a stream on the receiving side. A stream with a key
+   * resumes the earlier attempts of its transfer: they are stopped and
+   * the stream starts after the chunks in the journal of the transfer.
+   * @param stream The stream, owned by the forwarder from now on
+   * @param length The size of the data
+   * @param chunkSize The chunk size
+   * @return The stream id
+   */
+  ::CORBA::Long
+  openStream(Stream* stream, const ::CORBA::ULong length,
+             const ::CORBA::ULong chunkSize);
+
+  /**
+   * @brief Stop a received stream, after waiting for the threads making
+   * its chunks. Called with the lock held. The stream is deleted, unless
+   * it is being committed: the committing thread then deletes it.
+   * @param id The stream id
+   */
+  void
+  stopStream(const ::CORBA::Long id);
+
+  /**
+   * @brief Make the call of a chunk and of the following chunks already
+   * received. The stream is marked as applying by the caller.
+   * @param stream The stream
+   * @param index The chunk index
+   * @param data The chunk, NULL to take it from the chunk store
+   */
+  void
+  applyChunks(Stream& stream, unsigned long index, const ::SeqOctet* data);
+
+  /**
+   * @brief Write a chunk received ahead of its turn to the spool file.
+   *   Called without the lock, the stream counting this thread as a
+   *   writer.
+   * @param stream The stream
+   * @param index The chunk index
+   * @param data The chunk
+   * @return true if the chunk is now to be made by this thread, which
+   *   then holds the lock; false otherwise, without the lock
+   */
+  bool
+  spoolChunk(Stream& stream, unsigned long index, const ::SeqOctet& data);
+
+  /**
+   * @brief The asynchronous workers per class of calls, NULL to forward
+   * synchronously.
+   */
+  WorkerPool* masyncPools[2];
+  /**
+   * @brief The deferred calls per class of calls, ordered per object.
+   */
+  SerialQueue* masyncCalls[2];
+  /**
+   * @brief The gates of the classes of calls. Only the bulk one has
+   * limits, the control one counts the calls forwarded to the peer.
+   */
+  CallGate mclassGates[2];
+  /**
+   * @brief The statistics of the calls per operation.
+   */
+  OperationStats mstats;
+  /**
+   * @brief A cached result, with the length returned by some calls.
+   */
+  struct CachedResult {
+    ::CORBA::Any value;
+    ::CORBA::Long length;
+  };
+  /**
+   * @brief The results of the read-only calls per object.
+   */
+  ResultCache<CachedResult> mresults;
+
+  /**
+   * @brief Do the local Dagda objects accept the octet transfers? Per
+   * object name.
+   */
+  std::map<std::string, bool> mbulkDagdas;
+  /**
+   * @brief Protects the map above.
+   */
+  omni_mutex mbulkDagdasMutex;
+  /**
+   * @brief Are the Dagda transfers carried as octets?
+   */
+  bool moctetTransfers;
+  /**
+   * @brief The chunk size of the sent streams (bytes), 0 for no stream.
+   */
+  unsigned long mstreamChunk;
+  /**
+   * @brief The chunks in flight per sent stream.
+   */
+  unsigned int mstreamWindow;
+  /**
+   * @brief The workers running the helpers of the sent streams, NULL
+   * until the first one.
+   */
+  WorkerPool* mstreamWorkers;
+  /**
+   * @brief The directory of the spool files of the received streams,
+   * empty to keep their chunks on the heap.
+   */
+  std::string mstreamSpool;
+  /**
+   * @brief The directory of the journals of the received streams, empty
+   * to keep them in memory.
+   */
+  std::string mstreamJournal;
+  /**
+   * @brief The number of times a sent stream is resumed.
+   */
+  unsigned int mstreamResumes;
+  /**
+   * @brief The store of the chunks of the received streams, NULL without
+   * store.
+   */
+  ChunkStore* mchunkStore;
+  /**
+   * @brief The received streams, per id.
+   */
+  std::map< ::CORBA::Long, Stream*> mstreams;
+  ::CORBA::Long mnextStream;
+  /**
+   * @brief The journals of the resumable transfers received, owned, per
+   * transfer key.
+   */
+  std::map<std::string, StreamJournal*> mjournals;
+  /**
+   * @brief Protects the received streams.
+   */
+  omni_mutex mstreamMutex;
+  /**
+   * @brief Signals the chunks made on the objects.
+   */
+  omni_condition mstreamCond;
+
+  /**
+   * @brief The relay of the Dagda calls, nil if this forwarder does not
+   * relay.
+   */
+  ::CORBA::Object_var mdagdaRelay;
+
+  /**
+   * @brief The proxy POAs, per interface.
+   */
+  PortableServer::POA_var mproxies[PROXY_COUNT];
+  /**
+   * @brief The repository identifiers of the proxies, per interface.
+   */
+  const char* mrepoIds[PROXY_COUNT];
+  /**
+   * @brief The local and master agents binded through this forwarder.
+   * Their proxy keeps their interface when obtained by getAgent().
+   */
+  std::map<std::string, ProxyType> magents;
+
+  /**
+   * @brief Return the key of an object in the peer routes.
+   * @param route The object route
+   * @return The object name (context/name)
+   */
+  std::string
+  routeKey(const ObjectRoute& route) const;
+
+  /**
+   * @brief Send a binding to the peers, an empty IOR unbinds the object.
+   * The failures are logged, they do not stop the other peers. Without
+   * excluded peer, waits for the first peer.
+   * @param objName The object name, with the "remote:" prefix
+   * @param ior The IOR, tagged with this forwarder name and, once relayed,
+   *   with the name of the forwarder which binded it ("@fwdr@origin")
+   * @param except A peer left out, the one the binding comes from
+   */
+  void
+  peersBind(const std::string& objName, const std::string& ior,
+            const std::string& except = "");
+
+  /**
+   * @brief The peer links, by peer name. The links live as long as the
+   * forwarder.
+   */
+  std::map<std::string, PeerLink*> mpeers;
+  /**
+   * @brief The name of the default peer, the first connected one.
+   */
+  std::string mdefaultPeer;
+  /**
+   * @brief The peer serving each object binded by a peer (context/name).
+   */
+  std::map<std::string, std::string> mobjectPeers;
+  /**
+   * @brief The IOR of each object binded by a peer (context/name). The
+   * peers may form cycles: a binding received again is not forwarded
+   * again, nor an unbinding of an object not binded.
+   */
+  std::map<std::string, std::string> mimports;
+  /**
+   * @brief Limits of the peer links gates.
+   */
+  unsigned int mpeerSlots;
+  unsigned int mpeerQueue;
+  /**
+   * @brief Stripes of the peer links reserved to the control calls.
+   */
+  unsigned int mreservedStripes;
   /* Mutexes */
 /**
- * @brief Mutex to handle the peer
+ * @brief Mutex to handle the peers and their routes
+ */
+  omni_mutex mpeerMutex;
+/**
+ * @brief Signals the first peer
  */
-  omni_mutex mpeerMutex;   // To wait for the peer initialization
+  omni_condition mpeerCond;
 /**
- * @brief Mutex to handle the cache
+ * @brief Mutex to handle the proxies
  */
-  omni_mutex mcachesMutex;  // Protect access to caches
+  omni_mutex mcachesMutex;  // Protect access to proxies and agents
 
 /**
  * @brief Forwarder name
@@ -687,4 +1530,77 @@ private:
   dadi::ChannelPtr mcc;
 };
 
+template <class Call>
+class CorbaForwarder::DeferredCall : public WorkerPool::Task {
+public:
+  DeferredCall(const char* objName, const Call& call)
+    : mobjName(objName), mcall(call) {}
+
+  void
+  run() {
+    try {
+      mcall();
+    } catch (const ::CORBA::Exception& err) {
+      throw std::runtime_error("Deferred call to " + mobjName
+                               + " failed (" + err._name() + ")");
+    }
+  }
+
+private:
+  std::string mobjName;
+  Call mcall;
+};
+
+template <class Call>
+bool
+CorbaForwarder::defer(const char* objName, const Call& call,
+                      const PeerLink::CallClass callClass) {
+  if (masyncCalls[callClass] == NULL || inDeferredCall()) {
+    return false;
+  }
+  DeferredCall<Call>* task = new DeferredCall<Call>(objName, call);
+
+  if (!masyncCalls[callClass]->submit(objName, task)) {
+    delete task;
+    return false;
+  }
+  return true;
+}
+
+template <class T>
+T*
+CorbaForwarder::sent(OperationStats::Call& stats, T* result) {
+  stats.sent(payloadSize(*result));
+  return result;
+}
+
+template <class Seq>
+Seq*
+CorbaForwarder::findSequence(const std::string& target, const char* call,
+                             ::CORBA::Long* length) {
+  CachedResult cached;
+  const Seq* value;
+
+  if (!mresults.find(target, call, cached) || !(cached.value >>= value)) {
+    return NULL;
+  }
+  if (length != NULL) {
+    *length = cached.length;
+  }
+  return new Seq(*value);
+}
+
+template <class Seq>
+void
+CorbaForwarder::cacheSequence(const std::string& target, const char* call,
+                              const Seq& value,
+                              const unsigned long generation,
+                              const ::CORBA::Long length) {
+  CachedResult cached;
+
+  cached.value <<= value;
+  cached.length = length;
+  mresults.insert(target, call, cached, generation);
+}
+
 #endif
@@ -22,6 +22,7 @@
 #include <sstream>
 #include <fstream>
 #include <algorithm>
+#include <vector>
 
 #include <omniORB4/CORBA.h>
 
@@ -65,6 +66,7 @@ connectPeer(const std::string &ior, const std::string &peerIOR,
   try {
     peer->connectPeer(ior.c_str(), remoteHost.c_str(), remotePortFrom);
     forwarder->setPeer(peer);
+    CORBA::String_var peerName = peer->getName();
 
     // Get the existing contexts except the Forwarders one
     std::list<std::string> contexts = mgr->contextList();
@@ -77,20 +79,22 @@ connectPeer(const std::string &ior, const std::string &peerIOR,
     // For each context
     for (std::list<std::string>::const_iterator it = contexts.begin();
          it != contexts.end(); ++it) {
-      // Get the local objects
-      std::list<std::string> objects = mgr->localObjects(*it);
-      // Get the object from other forwarders
-      for (std::list<std::string>::const_iterator jt = fwds.begin();
-           jt != fwds.end(); ++jt) {
-        std::list<std::string> fwdObjects = mgr->forwarderObjects(*jt, *it);
-        objects.insert(objects.end(), fwdObjects.begin(), fwdObjects.end());
-      }
+      // Get the local objects and the objects from other forwarders,
+      // listed with their references at once
+      std::vector<ORBMgr::Binding> bindings = mgr->bindings(*it);
+      std::list<std::string> objects;
 
       // Bind them on the peer
-      for (std::list<std::string>::const_iterator jt = objects.begin();
-           jt != objects.end(); ++jt) {
-        std::string objName = *it +"/" + *jt;
-        std::string ior = mgr->getIOR(*it, *jt);
+      for (std::vector<ORBMgr::Binding>::const_iterator jt = bindings.begin();
+           jt != bindings.end(); ++jt) {
+        std::string ior = mgr->getIOR(jt->second);
+        std::string iorHost = ORBMgr::getHost(ior);
+        if (iorHost.length() > 0 && iorHost.at(0) == '@'
+            && find(fwds.begin(), fwds.end(), iorHost.substr(1)) == fwds.end()) {
+          continue;
+        }
+        objects.push_back(jt->first);
+        std::string objName = *it +"/" + jt->first;
         forwarder->bind(objName.c_str(), ior.c_str());
       }
       // Then, get the objects binded on the peer
@@ -103,6 +107,8 @@ connectPeer(const std::string &ior, const std::string &peerIOR,
           continue;
         }
         std::string newIOR = ORBMgr::convertIOR(ior, fwdTag, 0);
+        // The calls to the object go through the peer it comes from
+        forwarder->addRoute(*it + "/" + name, peerName.in(), newIOR);
         mgr->bind(*it, name, newIOR, true);
         mgr->fwdsBind(*it, name, newIOR, fwdName);
       }
@@ -122,7 +128,35 @@ connectPeer(const std::string &ior, const std::string &peerIOR,
   return 0;
 }
 
+/* Add the stripes to the link with the peer: each stripe tunnel gives
+ * another endpoint to reach the peer, and to be reached by it.
+ */
+void
+connectStripes(const std::string &ior, const std::string &peerIOR,
+               const std::string &newHost, const std::string &remoteHost,
+               const std::vector<SSHTunnel*> &stripes,
+               CorbaForwarder *forwarder, ORBMgr* mgr) {
+  dadi::LoggerPtr logger;
+  logger = dadi::LoggerPtr(dadi::Logger::getLogger("org.dadicorba"));
 
+  Forwarder_var peer = forwarder->getPeer();
+
+  for (std::vector<SSHTunnel*>::const_iterator it = stripes.begin();
+       it != stripes.end(); ++it) {
+    std::string stripeIOR =
+      ORBMgr::convertIOR(peerIOR, newHost, (*it)->getLocalPortFrom());
+    try {
+      Forwarder_var stripe = mgr->resolve<Forwarder, Forwarder_var>(stripeIOR);
+      peer->connectStripe(ior.c_str(), remoteHost.c_str(),
+                          (*it)->getRemotePortFrom());
+      forwarder->addStripe(stripe);
+    } catch (CORBA::SystemException& err) {
+      logger->log(dadi::Message("Fwdr",
+                                "Unable to add a stripe to the remote peer\n",
+                                dadi::Message::PRIO_DEBUG));
+    }
+  }
+}
 
 
 int
@@ -163,6 +197,52 @@ main(int argc, char* argv[], char* envp[]) {
     boost::bind(dadi::setPropertyString, "nb-retry", _1));
   boost::function1<void, std::string> fkey(
     boost::bind(dadi::setPropertyString, "ssh-key", _1));
+  boost::function1<void, std::string> flease(
+    boost::bind(dadi::setPropertyString, "cache-lease", _1));
+  boost::function1<void, std::string> fcallret(
+    boost::bind(dadi::setPropertyString, "call-retries", _1));
+  boost::function1<void, std::string> fcircuit(
+    boost::bind(dadi::setPropertyString, "circuit-threshold", _1));
+  boost::function1<void, std::string> fsweep(
+    boost::bind(dadi::setPropertyString, "sweep-period", _1));
+  boost::function1<void, std::string> fpeercalls(
+    boost::bind(dadi::setPropertyString, "peer-calls", _1));
+  boost::function1<void, std::string> fpeerqueue(
+    boost::bind(dadi::setPropertyString, "peer-queue", _1));
+  boost::function1<void, std::string> fstripes(
+    boost::bind(dadi::setPropertyString, "stripes", _1));
+  boost::function1<void, std::string> freserved(
+    boost::bind(dadi::setPropertyString, "reserved-stripes", _1));
+  boost::function1<void, std::string> fasync(
+    boost::bind(dadi::setPropertyString, "async-workers", _1));
+  boost::function1<void, std::string> fbulkcalls(
+    boost::bind(dadi::setPropertyString, "bulk-calls", _1));
+  boost::function1<void, std::string> fbulkqueue(
+    boost::bind(dadi::setPropertyString, "bulk-queue", _1));
+  boost::function1<void, std::string> fresultttl(
+    boost::bind(dadi::setPropertyString, "result-ttl", _1));
+  boost::function1<void, std::string> fstatsfile(
+    boost::bind(dadi::setPropertyString, "stats-file", _1));
+  boost::function1<void, std::string> fstatsperiod(
+    boost::bind(dadi::setPropertyString, "stats-period", _1));
+  boost::function1<void, std::string> foctets(
+    boost::bind(dadi::setPropertyString, "octets", _1));
+  boost::function1<void, std::string> fstreamchunk(
+    boost::bind(dadi::setPropertyString, "stream-chunk", _1));
+  boost::function1<void, std::string> fstreamwindow(
+    boost::bind(dadi::setPropertyString, "stream-window", _1));
+  boost::function1<void, std::string> fstreamspool(
+    boost::bind(dadi::setPropertyString, "stream-spool", _1));
+  boost::function1<void, std::string> fstreamjournal(
+    boost::bind(dadi::setPropertyString, "stream-journal", _1));
+  boost::function1<void, std::string> fstreamresumes(
+    boost::bind(dadi::setPropertyString, "stream-resumes", _1));
+  boost::function1<void, std::string> fchunkstore(
+    boost::bind(dadi::setPropertyString, "chunk-store", _1));
+  boost::function1<void, std::string> fchunkstoresize(
+    boost::bind(dadi::setPropertyString, "chunk-store-size", _1));
+  boost::function1<void, std::string> frelay(
+    boost::bind(dadi::setPropertyString, "relay", _1));
 
 
   opt.addSwitch("help,h", "display help message", fHelp);
@@ -176,6 +256,29 @@ main(int argc, char* argv[], char* envp[]) {
   opt.addOption("peer-ior,i", "to use a specific ior for the peer", fpior)->default_value("");
   opt.addOption("nb-retry,a", "the number of time to retry again", fret)->default_value("");
   opt.addOption("ssh-key,k", "the ssh key", fkey)->default_value("");
+  opt.addOption("cache-lease", "validity lease (in seconds) of the cached objects", flease)->default_value("");
+  opt.addOption("call-retries", "the number of retries of a failed CORBA call", fcallret)->default_value("");
+  opt.addOption("circuit-threshold", "consecutive failures after which a peer is considered down (0 to disable)", fcircuit)->default_value("");
+  opt.addOption("sweep-period", "period (in seconds) of the background sweeps of the object cache", fsweep)->default_value("");
+  opt.addOption("peer-calls", "maximum number of calls in progress through each peer (0 for no limit)", fpeercalls)->default_value("");
+  opt.addOption("peer-queue", "maximum number of calls waiting for each peer (0 for no limit)", fpeerqueue)->default_value("");
+  opt.addOption("stripes", "number of tunnels to the peer, the additional ones use the next remote ports", fstripes)->default_value("");
+  opt.addOption("reserved-stripes", "number of tunnels reserved to the control calls", freserved)->default_value("");
+  opt.addOption("async-workers", "number of threads forwarding the oneway calls asynchronously (0 to forward them synchronously)", fasync)->default_value("");
+  opt.addOption("bulk-calls", "maximum number of data transfers in progress through the forwarder (0 for no limit)", fbulkcalls)->default_value("");
+  opt.addOption("bulk-queue", "maximum number of data transfers waiting for the forwarder (0 for no limit)", fbulkqueue)->default_value("");
+  opt.addOption("result-ttl", "time to live (in seconds) of the cached results of the read-only calls (0 for no cache)", fresultttl)->default_value("");
+  opt.addOption("stats-file", "file receiving the statistics of the calls", fstatsfile)->default_value("");
+  opt.addOption("stats-period", "period (in seconds) of the dumps of the statistics", fstatsperiod)->default_value("");
+  opt.addOption("octets", "carry the Dagda transfers as octets when the peer accepts them (yes or no)", foctets)->default_value("");
+  opt.addOption("stream-chunk", "size (in KB) of the chunks of the streamed Dagda transfers (0 to send them whole)", fstreamchunk)->default_value("");
+  opt.addOption("stream-window", "number of chunks in flight per streamed Dagda transfer", fstreamwindow)->default_value("");
+  opt.addOption("stream-spool", "directory where the received Dagda streams are spooled (the heap by default)", fstreamspool)->default_value("");
+  opt.addOption("stream-journal", "directory where the chunks of the received Dagda streams are journaled, to resume them after a restart", fstreamjournal)->default_value("");
+  opt.addOption("stream-resumes", "number of times a Dagda stream broken midway is resumed", fstreamresumes)->default_value("");
+  opt.addOption("chunk-store", "directory where the chunks of the received Dagda streams are kept, so that the peer does not send them again", fchunkstore)->default_value("");
+  opt.addOption("chunk-store-size", "maximum size (in MB) of the chunk store", fchunkstoresize)->default_value("");
+  opt.addOption("relay", "relay the Dagda calls without decoding their data (yes or no)", frelay)->default_value("");
 
   opt.parseCommandLine(argc, argv);
   opt.notify();
@@ -223,6 +326,149 @@ main(int argc, char* argv[], char* envp[]) {
   std::string ior;
   int count = 0;
 
+  if (config.get<std::string>("cache-lease")!="") {
+    unsigned int lease = 0;
+    std::istringstream is(config.get<std::string>("cache-lease"));
+    is >> lease;
+    mgr->setCacheLease(lease);
+  }
+
+  if (config.get<std::string>("call-retries")!="") {
+    unsigned int retries = 0;
+    std::istringstream is(config.get<std::string>("call-retries"));
+    is >> retries;
+    mgr->getRetryPolicy().setMaxRetries(retries);
+  }
+
+  if (config.get<std::string>("circuit-threshold")!="") {
+    unsigned int threshold = 0;
+    std::istringstream is(config.get<std::string>("circuit-threshold"));
+    is >> threshold;
+    mgr->getRetryPolicy().setCircuit(threshold, 10);
+  }
+
+  if (config.get<std::string>("sweep-period")!="") {
+    unsigned int period = 0;
+    std::istringstream is(config.get<std::string>("sweep-period"));
+    is >> period;
+    mgr->setSweepPeriod(period);
+  }
+
+  if (config.get<std::string>("peer-calls")!="") {
+    unsigned int slots = 0;
+    unsigned int queue = 0;
+    std::istringstream is(config.get<std::string>("peer-calls"));
+    is >> slots;
+    if (config.get<std::string>("peer-queue")!="") {
+      std::istringstream iq(config.get<std::string>("peer-queue"));
+      iq >> queue;
+    }
+    forwarder->setPeerLimits(slots, queue);
+  }
+
+  unsigned int nbStripes = 1;
+  if (config.get<std::string>("stripes")!="") {
+    std::istringstream is(config.get<std::string>("stripes"));
+    is >> nbStripes;
+  }
+
+  if (config.get<std::string>("reserved-stripes")!="") {
+    unsigned int reserved = 1;
+    std::istringstream is(config.get<std::string>("reserved-stripes"));
+    is >> reserved;
+    forwarder->setReservedStripes(reserved);
+  }
+
+  if (config.get<std::string>("async-workers")!="") {
+    unsigned int workers = 0;
+    std::istringstream is(config.get<std::string>("async-workers"));
+    is >> workers;
+    forwarder->setAsyncWorkers(workers);
+  }
+
+  if (config.get<std::string>("bulk-calls")!="") {
+    unsigned int slots = 0;
+    unsigned int queue = 0;
+    std::istringstream is(config.get<std::string>("bulk-calls"));
+    is >> slots;
+    if (config.get<std::string>("bulk-queue")!="") {
+      std::istringstream iq(config.get<std::string>("bulk-queue"));
+      iq >> queue;
+    }
+    forwarder->setBulkLimits(slots, queue);
+  }
+
+  if (config.get<std::string>("result-ttl")!="") {
+    unsigned int ttl = 0;
+    std::istringstream is(config.get<std::string>("result-ttl"));
+    is >> ttl;
+    forwarder->setResultTTL(ttl);
+  }
+
+  if (config.get<std::string>("stats-file")!="") {
+    unsigned int period = 60;
+    if (config.get<std::string>("stats-period")!="") {
+      std::istringstream is(config.get<std::string>("stats-period"));
+      is >> period;
+    }
+    forwarder->setStatsDump(config.get<std::string>("stats-file"), period);
+  }
+
+  if (config.get<std::string>("octets")=="no") {
+    forwarder->setOctetTransfers(false);
+  }
+
+  if (config.get<std::string>("stream-chunk")!=""
+      || config.get<std::string>("stream-window")!="") {
+    unsigned long chunk = 1024;
+    unsigned int window = 8;
+    if (config.get<std::string>("stream-chunk")!="") {
+      std::istringstream is(config.get<std::string>("stream-chunk"));
+      is >> chunk;
+    }
+    if (config.get<std::string>("stream-window")!="") {
+      std::istringstream iw(config.get<std::string>("stream-window"));
+      iw >> window;
+    }
+    forwarder->setStreamLimits(chunk * 1024, window);
+  }
+
+  if (config.get<std::string>("stream-spool")!="") {
+    forwarder->setStreamSpool(config.get<std::string>("stream-spool"));
+  }
+
+  if (config.get<std::string>("stream-journal")!=""
+      || config.get<std::string>("stream-resumes")!="") {
+    unsigned int resumes = 3;
+    if (config.get<std::string>("stream-resumes")!="") {
+      std::istringstream is(config.get<std::string>("stream-resumes"));
+      is >> resumes;
+    }
+    forwarder->setStreamResume(config.get<std::string>("stream-journal"),
+                               resumes);
+  }
+
+  if (config.get<std::string>("chunk-store")!="") {
+    unsigned long size = 1024;
+    if (config.get<std::string>("chunk-store-size")!="") {
+      std::istringstream is(config.get<std::string>("chunk-store-size"));
+      is >> size;
+    }
+    try {
+      forwarder->setChunkStore(config.get<std::string>("chunk-store"),
+                               size * 1024 * 1024);
+    } catch (std::exception &e) {
+      logger->log(dadi::Message("Fwdr",
+                                e.what(),
+                                dadi::Message::PRIO_DEBUG));
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (config.get<std::string>("relay")=="yes") {
+    forwarder->setRelay(true);
+  }
+
   mgr->activate(forwarder);
   do {
     try {
@@ -381,11 +627,41 @@ main(int argc, char* argv[], char* envp[]) {
     logger->log(dadi::Message("Fwdr",e.what(),dadi::Message::PRIO_DEBUG));
   }
 
+  /* Open the tunnels of the additional stripes. Each one is a distinct
+   * ssh connection, listening on the next remote ports.
+   */
+  std::vector<SSHTunnel*> stripes;
+  if (config.get<std::string>("ssh-host")!="") {
+    for (unsigned int i = 1; i < nbStripes; ++i) {
+      SSHTunnel* stripe = new SSHTunnel();
+      stripe->setSshHost(tunnel.getSshHost());
+      stripe->setSshPath(tunnel.getSshPath());
+      stripe->setSshPort(tunnel.getSshPort());
+      stripe->setSshLogin(tunnel.getSshLogin());
+      stripe->setSshKeyPath(tunnel.getSshKeyPath());
+      stripe->setRemoteHost(tunnel.getRemoteHost());
+      stripe->setRemotePortTo(tunnel.getRemotePortTo());
+      stripe->setRemotePortFrom(tunnel.getRemotePortFrom() + i);
+      stripe->setLocalPortTo(tunnel.getLocalPortTo());
+      stripe->createTunnelTo(true);
+      stripe->createTunnelFrom(true);
+      try {
+        stripe->open();
+        stripes.push_back(stripe);
+      } catch (std::runtime_error &e) {
+        logger->log(dadi::Message("Fwdr", e.what(),
+                                  dadi::Message::PRIO_DEBUG));
+        delete stripe;
+      }
+    }
+  }
+
 
   /* Try to find the peer. */
   bool canLaunch = true;
   if (config.get<std::string>("peer-ior")!="") {
     try {
+      std::string peerHost = "localhost";
       if (connectPeer(ior, config.get<std::string>("peer-ior"),
                       "localhost", tunnel.getRemoteHost(),
                       tunnel.getLocalPortFrom(), tunnel.getRemotePortFrom(),
@@ -396,6 +672,7 @@ main(int argc, char* argv[], char* envp[]) {
         if (tunnel.getRemoteHost() == "localhost") {
           tunnel.setRemoteHost("127.0.0.1");
         }
+        peerHost = "127.0.0.1";
         if (connectPeer(ior, config.get<std::string>("peer-ior"),
                         "127.0.0.1", tunnel.getRemoteHost(),
                         tunnel.getLocalPortFrom(), tunnel.getRemotePortFrom(),
@@ -404,8 +681,13 @@ main(int argc, char* argv[], char* envp[]) {
                                     "Unable to contact remote peer." \
                                     "Waiting for connection...\n",
                                     dadi::Message::PRIO_DEBUG));
+          peerHost.clear();
         }
       }
+      if (!peerHost.empty() && !stripes.empty()) {
+        connectStripes(ior, config.get<std::string>("peer-ior"), peerHost,
+                       tunnel.getRemoteHost(), stripes, forwarder, mgr);
+      }
     } catch (...) {
           logger->log(dadi::Message("Fwdr",
                                     "Error while connecting to remote peer\n",
@@ -430,6 +712,11 @@ main(int argc, char* argv[], char* envp[]) {
    */
   delete ORBMgr::getMgr();
 
+  for (std::vector<SSHTunnel*>::iterator it = stripes.begin();
+       it != stripes.end(); ++it) {
+    delete *it;
+  }
+
     logger->log(dadi::Message("Fwdr",
                               "Forwarder is now terminated",
                                dadi::Message::PRIO_DEBUG));
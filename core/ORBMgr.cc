@@ -11,11 +11,13 @@
  *   |LICENSE|
  */
 
+#include <algorithm>
 #include <list>
 #include <map>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 #include <iostream>
 #include <csignal>
 
@@ -24,12 +26,15 @@
 
 #include "ORBMgr.hh"
 #include "Forwarder.hh"
+#include "utils/HexCodec.hh"
+#include "utils/RetryPolicy.hh"
 
 #include "dadi/Logging/ConsoleChannel.hh"
 #include "dadi/Logging/Logger.hh"
 #include "dadi/Logging/Message.hh"
 
 ORBMgr *ORBMgr::theMgr = NULL;
+ORBMgr *ORBMgr::theHandlerMgr = NULL;
 
 #ifndef __cygwin__
 omni_mutex ORBMgr::waitLock;
@@ -37,78 +42,45 @@ omni_mutex ORBMgr::waitLock;
 sem_t ORBMgr::waitLock;
 #endif
 
-/* Maximum number of retries for communication failures
- * TODO: should be a parameter in the configuration file
- */
-static const unsigned int maxNbRetries = 3;
-
-/* Handler for call resubmission when TRANSIENT exceptions occur */
-CORBA::Boolean
-transientHandler (void* cookie, CORBA::ULong retries,
-                  const CORBA::TRANSIENT& ex) {
-// Logger
-  dadi::LoggerPtr logger;
-  dadi::ChannelPtr cc;
-  logger = dadi::LoggerPtr(dadi::Logger::getLogger("org.dadicorba"));
-  logger->setLevel(dadi::Message::PRIO_TRACE);
-  cc = dadi::ChannelPtr(new dadi::ConsoleChannel);
-  logger->setChannel(cc);
-
-  std::ostringstream strRet;
-  strRet << retries;
-  std::ostringstream strMaxRet;
-  strMaxRet << maxNbRetries;
-
-
-  /* We only retry if the number of retries is lower than maxNbRetries */
-  if (retries < maxNbRetries) {
-    logger->log(dadi::Message("ORBMgr",
-                              "Handler for transient exception called (nb retries: "
-                              + strRet.str() + "/"
-                              + strMaxRet.str() + "). Will now retry.\n",
-                              dadi::Message::PRIO_DEBUG));
-    return 1;           // retry immediately.
-  }
-  logger->log(dadi::Message("ORBMgr",
-                             "Handler for transient exception called (nb retries: "
-                             + strRet.str() + "/" + strMaxRet.str() + ").\n",
-                             dadi::Message::PRIO_DEBUG));
-  return 0;
-}
-
-/* Handler for call resubmission when COMM_FAILURE exceptions occur */
-CORBA::Boolean
-commFailureHandler (void* cookie, CORBA::ULong retries,
-                    const CORBA::COMM_FAILURE& ex) {
-
-// Logger
-  dadi::LoggerPtr logger;
-  dadi::ChannelPtr cc;
-  logger = dadi::LoggerPtr(dadi::Logger::getLogger("org.dadicorba"));
-  logger->setLevel(dadi::Message::PRIO_TRACE);
-  cc = dadi::ChannelPtr(new dadi::ConsoleChannel);
-  logger->setChannel(cc);
-
-  std::ostringstream strRet;
-  strRet << retries;
-  std::ostringstream strMaxRet;
-  strMaxRet << maxNbRetries;
-
-  /* We only retry if the number of retries is lower than maxNbRetries */
-  if (retries < maxNbRetries) {
-    logger->log(dadi::Message("ORBMgr",
-                              "Handler for communication failures exception called (nb retries: "
-                              + strRet.str() + "/" + strMaxRet.str() + "). Will now retry.\n",
-                              dadi::Message::PRIO_DEBUG));
-    return 1;           // retry immediately.
-  }
-  logger->log(dadi::Message("ORBMgr",
-                            "Handler for communication failures exception called (nb retries: "
-                            + strRet.str() + "/"  + strMaxRet.str() + ").\n",
-                            dadi::Message::PRIO_DEBUG));
-  return 0;
-}
-
+/* Number of bindings asked by the first list request, then by each
+ * BindingIterator::next_n call, doubled up to the maximum. */
+static const CORBA::ULong listFirstChunk = 256;
+static const CORBA::ULong listMaxChunk = 4096;
+
+/* Number of deferred resolve requests in flight when listing bindings. */
+static const size_t resolveWindow = 32;
+
+/* Worker threads for the broadcasts to the other forwarders. */
+static const unsigned int fwdsWorkers = 8;
+/* Deadline of a call to another forwarder (ms). */
+static const CORBA::ULong fwdsCallTimeout = 2000;
+/* Time a synchronous broadcast waits for the first attempts (ms). */
+static const unsigned long fwdsWaitTimeout = 10000;
+/* Attempts on an unreachable forwarder, the delay between two attempts
+ * starting at fwdsRetryDelay (ms) and doubling each time. */
+static const unsigned int fwdsMaxAttempts = 5;
+static const unsigned long fwdsRetryDelay = 1000;
+
+/* Probes in flight during a cache sweep, and deadline of a probe (ms). */
+static const unsigned int sweepProbes = 8;
+static const unsigned long sweepProbeTimeout = 1000;
+
+/* Age (in seconds) after which the host index of a context is filled again
+ * from the naming service, objects being also binded by other processes. */
+static const time_t hostIndexTTL = 10;
+
+/* Time (in seconds) a name not found is reported missing without asking
+ * the naming service, and number of missing names above which the expired
+ * ones are purged. */
+static const unsigned int notFoundLease = 2;
+static const size_t notFoundPurge = 1024;
+
+/* Longest wait (in ms) of an exception handler before a retry: the handler
+ * holds the thread making the call. */
+static const unsigned long handlerDelayMax = 500;
+
+/* Maximum number of parsed IORs kept, the cache is emptied when full. */
+static const size_t parsedIORsMax = 4096;
 
 /* Manager initialization. */
 void ORBMgr::init(CORBA::ORB_ptr ORB) {
@@ -140,82 +112,224 @@ void ORBMgr::init(CORBA::ORB_ptr ORB) {
 
   manager->activate();
 
-  /* Install handlers for automatically handle call resubmissions */
-  omniORB::installTransientExceptionHandler(0, transientHandler);
-  omniORB::installCommFailureExceptionHandler(0, commFailureHandler);
+  object = ORB->resolve_initial_references("POACurrent");
+  mcurrent = PortableServer::Current::_narrow(object);
 }
 
-ORBMgr::ORBMgr(int argc, char* argv[]) {
-  const char* opts[][2]= {{0, 0}};
-
-// Init logger
+/* Setup shared by the constructors. */
+void ORBMgr::setup() {
+  // Init logger
   mlogger = dadi::LoggerPtr(dadi::Logger::getLogger("org.dadicorba"));
   mlogger->setLevel(dadi::Message::PRIO_TRACE);
   mcc = dadi::ChannelPtr(new dadi::ConsoleChannel);
   mlogger->setChannel(mcc);
 
+  msweeper.setReport(sweepReport, this);
+  msweeper.setLocalCheck(sweepLocalCheck, this);
+
+  /* Install handlers for automatically handle call resubmissions */
+  theHandlerMgr = this;
+  omniORB::installTransientExceptionHandler(this, transientHandler);
+  omniORB::installCommFailureExceptionHandler(this, commFailureHandler);
+}
+
+ORBMgr::ORBMgr(int argc, char* argv[])
+  : mnbIORs(0), mnextCookie(0), mdefaultLease(0),
+    mnotFoundLease(notFoundLease),
+    msweeper(mcache, sweepProbes, sweepProbeTimeout), mfwdsPool(NULL),
+    mlocalKnown(false) {
+  const char* opts[][2]= {{0, 0}};
+
+  setup();
   mORB = CORBA::ORB_init(argc, argv, "omniORB4", opts);
   init(mORB);
   mdown = false;
 }
 
-ORBMgr::ORBMgr(CORBA::ORB_ptr ORB) {
+ORBMgr::ORBMgr(CORBA::ORB_ptr ORB)
+  : mnbIORs(0), mnextCookie(0), mdefaultLease(0),
+    mnotFoundLease(notFoundLease),
+    msweeper(mcache, sweepProbes, sweepProbeTimeout), mfwdsPool(NULL),
+    mlocalKnown(false) {
+  setup();
   this->mORB = ORB;
   init(ORB);
   mdown = false;
 }
 
-ORBMgr::ORBMgr(CORBA::ORB_ptr ORB, PortableServer::POA_var POA) {
+ORBMgr::ORBMgr(CORBA::ORB_ptr ORB, PortableServer::POA_var POA)
+  : mnbIORs(0), mnextCookie(0), mdefaultLease(0),
+    mnotFoundLease(notFoundLease),
+    msweeper(mcache, sweepProbes, sweepProbeTimeout), mfwdsPool(NULL),
+    mlocalKnown(false) {
+  setup();
   this->mORB = ORB;
   this->mPOA = POA;
+  CORBA::Object_var object = ORB->resolve_initial_references("POACurrent");
+  mcurrent = PortableServer::Current::_narrow(object);
   mdown = false;
 }
 
 ORBMgr::~ORBMgr() {
+  msweeper.stop();
+  /* Pending broadcasts are dropped, the running ones are waited for. */
+  delete mfwdsPool;
+  mfwdsPool = NULL;
   shutdown(true);
+  resetCache();
+  resetNamingContexts();
+  miors.clear();
   mORB->destroy();
   theMgr = NULL;
+  if (theHandlerMgr == this) {
+    theHandlerMgr = NULL;
+  }
 }
 
-void
-ORBMgr::bind(const std::string& ctxt, const std::string& name,
-             CORBA::Object_ptr object, const bool rebind) const {
+CosNaming::NamingContext_ptr
+ORBMgr::rootContext() const {
   CORBA::Object_var obj;
-  CosNaming::NamingContext_var rootContext, context;
-  CosNaming::Name cosName;
+  CosNaming::NamingContext_var root;
+
+  mcontextsMutex.lock();
+  if (!CORBA::is_nil(mrootContext)) {
+    root = CosNaming::NamingContext::_duplicate(mrootContext);
+    mcontextsMutex.unlock();
+    return root._retn();
+  }
+  mcontextsMutex.unlock();
 
   obj = mORB->resolve_initial_references("NameService");
   if (CORBA::is_nil(obj)) {
     throw std::runtime_error("Error resolving initial references");
   }
 
-  rootContext = CosNaming::NamingContext::_narrow(obj);
+  root = CosNaming::NamingContext::_narrow(obj);
 
-  if (CORBA::is_nil(rootContext)) {
+  if (CORBA::is_nil(root)) {
     throw std::runtime_error("Error initializing root context");
   }
 
+  mcontextsMutex.lock();
+  mrootContext = CosNaming::NamingContext::_duplicate(root);
+  mcontextsMutex.unlock();
+  return root._retn();
+}
+
+CosNaming::NamingContext_ptr
+ORBMgr::namingContext(const std::string& ctxt, const bool create) const {
+  std::map<std::string, CosNaming::NamingContext_var>::iterator it;
+  CosNaming::NamingContext_var root, context;
+  CORBA::Object_var obj;
+  CosNaming::Name cosName;
+
+  mcontextsMutex.lock();
+  if ((it = mcontexts.find(ctxt)) != mcontexts.end()) {
+    context = CosNaming::NamingContext::_duplicate(it->second);
+    mcontextsMutex.unlock();
+    return context._retn();
+  }
+  mcontextsMutex.unlock();
+
+  root = rootContext();
+
   cosName.length(1);
   cosName[0].id = ctxt.c_str();
   cosName[0].kind = "";
-  try {
-    context = rootContext->bind_new_context(cosName);
-  } catch (CosNaming::NamingContext::AlreadyBound& err) {
-    obj = rootContext->resolve(cosName);
+  if (create) {
+    try {
+      context = root->bind_new_context(cosName);
+    } catch (CosNaming::NamingContext::AlreadyBound& err) {
+      obj = root->resolve(cosName);
+      context = CosNaming::NamingContext::_narrow(obj);
+    }
+  } else {
+    obj = root->resolve(cosName);
     context = CosNaming::NamingContext::_narrow(obj);
-    if (CORBA::is_nil(context)) {
-      throw std::runtime_error(std::string("Error creating context ") + ctxt);
+  }
+  if (CORBA::is_nil(context)) {
+    throw std::runtime_error(std::string("Error retrieving context ") + ctxt);
+  }
+
+  mcontextsMutex.lock();
+  mcontexts[ctxt] = CosNaming::NamingContext::_duplicate(context);
+  mcontextsMutex.unlock();
+  return context._retn();
+}
+
+void
+ORBMgr::resetNamingContexts() const {
+  mcontextsMutex.lock();
+  mrootContext = CosNaming::NamingContext::_nil();
+  mcontexts.clear();
+  mcontextsMutex.unlock();
+  mlogger->log(dadi::Message("ORBMgr",
+                             "Naming contexts reset\n",
+                             dadi::Message::PRIO_DEBUG));
+}
+
+CORBA::Object_ptr
+ORBMgr::resolveName(const std::string& ctxt, const std::string& name) const {
+  CosNaming::Name cosName;
+
+  cosName.length(1);
+  cosName[0].id   = name.c_str();
+  cosName[0].kind = "";
+
+  /* A stale naming context is acquired again once. */
+  for (unsigned int attempt = 0; ; ++attempt) {
+    try {
+      CosNaming::NamingContext_var context = namingContext(ctxt);
+      return context->resolve(cosName);
+    } catch (const CORBA::TRANSIENT& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
     }
   }
+}
+
+void
+ORBMgr::bind(const std::string& ctxt, const std::string& name,
+             CORBA::Object_ptr object, const bool rebind) const {
+  CosNaming::Name cosName;
+
+  cosName.length(1);
   cosName[0].id = name.c_str();
   cosName[0].kind = "";
-  try {
-    context->bind(cosName, object);
-  } catch (CosNaming::NamingContext::AlreadyBound& err) {
-    if (rebind) {
-      context->rebind(cosName, object);
-    } else {
-      throw std::runtime_error("Already bound!");
+
+  /* A stale naming context is acquired again once. */
+  for (unsigned int attempt = 0; ; ++attempt) {
+    try {
+      CosNaming::NamingContext_var context = namingContext(ctxt, true);
+      try {
+        context->bind(cosName, object);
+      } catch (CosNaming::NamingContext::AlreadyBound& err) {
+        if (rebind) {
+          context->rebind(cosName, object);
+        } else {
+          throw std::runtime_error("Already bound!");
+        }
+      }
+      indexObject(ctxt, name, object);
+      clearNotFound(ctxt + "/" + name);
+      return;
+    } catch (const CORBA::TRANSIENT& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
     }
   }
 }
@@ -225,6 +339,8 @@ ORBMgr::bind(const std::string& ctxt, const std::string& name,
              const std::string& IOR, const bool rebind) const {
   CORBA::Object_ptr object = mORB->string_to_object(IOR.c_str());
 
+  /* Parse the IOR we already have rather than the object's one. */
+  parseIOR(object, IOR);
   bind(ctxt, name, object, rebind);
 }
 
@@ -239,85 +355,247 @@ ORBMgr::rebind(const std::string& ctxt, const std::string& name,
                const std::string& IOR) const {
   CORBA::Object_ptr object = mORB->string_to_object(IOR.c_str());
 
+  parseIOR(object, IOR);
   rebind(ctxt, name, object);
 }
 
 void
 ORBMgr::unbind(const std::string& ctxt, const std::string& name) const {
-  CORBA::Object_var obj;
-  CosNaming::NamingContext_var rootContext, context;
+  CosNaming::NamingContext_var context;
   CosNaming::Name cosName;
-  std::list<std::pair<std::string, std::string> >::iterator it;
-
-  obj = mORB->resolve_initial_references("NameService");
-  rootContext = CosNaming::NamingContext::_narrow(obj);
-
-  cosName.length(1);
-  cosName[0].id = ctxt.c_str();
-  cosName[0].kind = "";
 
-  obj = rootContext->resolve(cosName);
-  context = CosNaming::NamingContext::_narrow(obj);
-  if (CORBA::is_nil(context)) {
-    throw std::runtime_error(std::string("Error retrieving context ") + ctxt);
+  /* A stale naming context is acquired again once. */
+  for (unsigned int attempt = 0; ; ++attempt) {
+    try {
+      context = namingContext(ctxt);
+      break;
+    } catch (CosNaming::NamingContext::NotFound& err) {
+      throw std::runtime_error(std::string("Error retrieving context ")
+                               + ctxt);
+    } catch (const CORBA::TRANSIENT& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    }
   }
 
+  cosName.length(1);
   cosName[0].id = name.c_str();
   cosName[0].kind = "";
   try {
     removeObjectFromCache(ctxt, name);
+    mhostIndexMutex.lock();
+    std::map<std::string, HostIndex>::iterator it = mhostIndex.find(ctxt);
+    if (it != mhostIndex.end()) {
+      it->second.entries.erase(name);
+    }
+    mhostIndexMutex.unlock();
     context->unbind(cosName);
   } catch (CosNaming::NamingContext::NotFound& err) {
     throw std::runtime_error("Object "+name+" not found in " + ctxt +" context");
   } catch (...) {
+    /* The context handle may be stale. */
+    resetNamingContexts();
     mlogger->log(dadi::Message("ORBMgr",
                                "Exception caught while unbinding " + ctxt + "/" + name,
                                dadi::Message::PRIO_DEBUG));
   }
 }
 
-void
-ORBMgr::fwdsBind(const std::string& ctxt, const std::string& name,
-                 const std::string& ior, const std::string& fwName) const {
-  std::list<std::string> forwarders = ORBMgr::list(FWRDCTXT);
-  std::list<std::string>::const_iterator it;
+class ORBMgr::FwdsBroadcast {
+public:
+  FwdsBroadcast(const std::list<std::string>& forwarders)
+    : mcond(&mmutex), mpending(forwarders.size()),
+      mrefs(forwarders.size() + 1) {
+    std::list<std::string>::const_iterator it;
+    for (it = forwarders.begin(); it != forwarders.end(); ++it) {
+      mresults[*it] = FWD_QUEUED;
+    }
+  }
 
-  for (it = forwarders.begin(); it != forwarders.end(); ++it) {
-    if (fwName == *it) {
-      continue;
+  /* Report the outcome of the first attempt on a forwarder and drop the
+   * reference held by its task. */
+  void
+  report(const std::string& fwd, const FwdStatus status) {
+    mmutex.lock();
+    mresults[fwd] = status;
+    --mpending;
+    mcond.broadcast();
+    mmutex.unlock();
+    release();
+  }
+
+  /* Wait for all the first attempts, at most until the deadline. */
+  FwdResults
+  wait(const unsigned long sec, const unsigned long nsec) {
+    FwdResults result;
+
+    mmutex.lock();
+    while (mpending > 0) {
+      if (mcond.timedwait(sec, nsec) == 0) {
+        break;
+      }
+    }
+    result = mresults;
+    mmutex.unlock();
+    return result;
+  }
+
+  void
+  release() {
+    bool last;
+
+    mmutex.lock();
+    last = (--mrefs == 0);
+    mmutex.unlock();
+    if (last) {
+      delete this;
+    }
+  }
+
+private:
+  omni_mutex mmutex;
+  omni_condition mcond;
+  FwdResults mresults;
+  unsigned int mpending;
+  unsigned int mrefs;
+};
+
+class ORBMgr::FwdTask : public WorkerPool::Task {
+public:
+  FwdTask(const ORBMgr* mgr, FwdsBroadcast* broadcast,
+          const std::string& fwd, const std::string& ctxt,
+          const std::string& name, const std::string& ior,
+          const unsigned int attempt)
+    : mmgr(mgr), mbroadcast(broadcast), mfwd(fwd), mctxt(ctxt), mname(name),
+      mior(ior), mattempt(attempt) {}
+
+  ~FwdTask() {
+    /* Dropped by the pool before running. */
+    if (mbroadcast) {
+      mbroadcast->report(mfwd, FWD_FAILED);
     }
-    Forwarder_var fwd = resolve<Forwarder, Forwarder_var>(FWRDCTXT, *it);
-    std::string objName = ctxt + "/" + name;
+  }
+
+  void
+  run() {
+    std::string objName = mctxt + "/" + mname;
+    FwdStatus status = FWD_DONE;
+
+    omniORB::setClientThreadCallTimeout(fwdsCallTimeout);
     try {
-      fwd->bind(objName.c_str(), ior.c_str());
+      Forwarder_var fwd =
+        mmgr->resolve<Forwarder, Forwarder_var>(FWRDCTXT, mfwd);
+      if (mior.empty()) {
+        fwd->unbind(objName.c_str());
+      } else {
+        fwd->bind(objName.c_str(), mior.c_str());
+      }
     } catch (const CORBA::TRANSIENT& err) {
-      continue;
+      status = FWD_QUEUED;
+    } catch (const CORBA::COMM_FAILURE& err) {
+      status = FWD_QUEUED;
     } catch (BadNameException& err) {
+      status = FWD_FAILED;
+    } catch (const CORBA::Exception& err) {
+      status = FWD_FAILED;
+    } catch (const std::runtime_error& err) {
+      /* The forwarder is no longer binded. */
+      status = FWD_FAILED;
+    }
+
+    if (status == FWD_QUEUED) {
+      if (mattempt + 1 < fwdsMaxAttempts) {
+        mmgr->mlogger->log(dadi::Message("ORBMgr",
+                                         "Unable to contact DIET forwarder "
+                                         + mfwd + ", retry queued\n",
+                                         dadi::Message::PRIO_DEBUG));
+        mmgr->fwdsPool()->submit(new FwdTask(mmgr, NULL, mfwd, mctxt, mname,
+                                             mior, mattempt + 1),
+                                 fwdsRetryDelay << mattempt);
+      } else {
+        mmgr->mlogger->log(dadi::Message("ORBMgr",
+                                         "Unable to contact DIET forwarder "
+                                         + mfwd + ", giving up " + objName
+                                         + "\n",
+                                         dadi::Message::PRIO_DEBUG));
+        status = FWD_FAILED;
+      }
+    }
+    if (mbroadcast) {
+      mbroadcast->report(mfwd, status);
+      mbroadcast = NULL;
     }
   }
+
+private:
+  const ORBMgr* mmgr;
+  FwdsBroadcast* mbroadcast;
+  std::string mfwd;
+  std::string mctxt;
+  std::string mname;
+  std::string mior;
+  unsigned int mattempt;
+};
+
+WorkerPool*
+ORBMgr::fwdsPool() const {
+  mfwdsPoolMutex.lock();
+  if (mfwdsPool == NULL) {
+    mfwdsPool = new WorkerPool(fwdsWorkers);
+  }
+  mfwdsPoolMutex.unlock();
+  return mfwdsPool;
 }
 
-void
-ORBMgr::fwdsUnbind(const std::string& ctxt, const std::string& name,
-                   const std::string& fwName) const {
+ORBMgr::FwdResults
+ORBMgr::fwdsBroadcast(const std::string& ctxt, const std::string& name,
+                      const std::string& ior, const std::string& fwName,
+                      const bool wait) const {
   std::list<std::string> forwarders = ORBMgr::list(FWRDCTXT);
   std::list<std::string>::const_iterator it;
+  FwdsBroadcast* broadcast;
+  FwdResults result;
+  unsigned long sec, nsec;
 
+  forwarders.remove(fwName);
+  broadcast = new FwdsBroadcast(forwarders);
   for (it = forwarders.begin(); it != forwarders.end(); ++it) {
-    if (fwName == *it) {
-      continue;
-    }
-    Forwarder_var fwd = resolve<Forwarder, Forwarder_var>(FWRDCTXT, *it);
-    std::string objName = ctxt + "/" + name;
-    try {
-      fwd->unbind(objName.c_str());
-    } catch (const CORBA::TRANSIENT& err) {
-      mlogger->log(dadi::Message("ORBMgr",
-                                 "Unable to contact DIET forwarder " + *it + "\n",
-                                 dadi::Message::PRIO_DEBUG));
-      continue;
+    fwdsPool()->submit(new FwdTask(this, broadcast, *it, ctxt, name, ior, 0));
+  }
+
+  if (wait) {
+    omni_thread::get_time(&sec, &nsec, fwdsWaitTimeout / 1000,
+                          (fwdsWaitTimeout % 1000) * 1000000);
+    result = broadcast->wait(sec, nsec);
+  } else {
+    for (it = forwarders.begin(); it != forwarders.end(); ++it) {
+      result[*it] = FWD_QUEUED;
     }
   }
+  broadcast->release();
+  return result;
+}
+
+ORBMgr::FwdResults
+ORBMgr::fwdsBind(const std::string& ctxt, const std::string& name,
+                 const std::string& ior, const std::string& fwName,
+                 const bool wait) const {
+  /* The other forwarders rebind the object with their own tag. */
+  invalidateHostIndex(ctxt);
+  return fwdsBroadcast(ctxt, name, ior, fwName, wait);
+}
+
+ORBMgr::FwdResults
+ORBMgr::fwdsUnbind(const std::string& ctxt, const std::string& name,
+                   const std::string& fwName, const bool wait) const {
+  return fwdsBroadcast(ctxt, name, "", fwName, wait);
 }
 
 CORBA::Object_ptr
@@ -345,80 +623,97 @@ ORBMgr::resolveObject(const std::string& context, const std::string& name,
   } else if (ctxt2 == LOGTOOLMSGCTXT) {
     ctxt = LOGTOOLCTXT;
   }
-  mcacheMutex.lock();
   /* Use object cache. */
-  if (mcache.find(ctxt+"/"+name) != mcache.end()) {
-    CORBA::Object_ptr ptr = mcache[ctxt+"/"+name];
-    mcacheMutex.unlock();
-
-    try {
+  const std::string key = ctxt + "/" + name;
+  ObjectCache::Entry cached;
+
+  if (mcache.find(key, cached)) {
+    CORBA::Object_ptr ptr = cached.object;
+    /* Fail fast if the object endpoint is known to be down. */
+    admitCall(ptr, cached.endpoint);
+    /* Inside the lease, the object is used without any remote check. */
+    if (cached.expiry != 0 && time(NULL) < cached.expiry) {
       mlogger->log(dadi::Message("ORBMgr",
-                                 "Check if the object is still present\n",
-                                  dadi::Message::PRIO_DEBUG));
-      if (ptr->_non_existent()) {
+                                 "Use leased object from cache (" + key + ")\n",
+                                 dadi::Message::PRIO_DEBUG));
+      return CORBA::Object::_duplicate(ptr);
+    }
+    bool active;
+    /* The objects of this process are checked without any call. */
+    if (localObject(ptr, active)) {
+      if (active) {
         mlogger->log(dadi::Message("ORBMgr",
-                                   "Remove non existing object from cache (" + ctxt
-                                   + "/" + name + ")\n",
+                                   "Use local object from cache (" + key
+                                   + ")\n",
                                    dadi::Message::PRIO_DEBUG));
-        removeObjectFromCache(name);
-      } else {
-      mlogger->log(dadi::Message("ORBMgr",
-                                 "Use object from cache (" + ctxt
-                                 + "/" + name + ")\n",
-                                 dadi::Message::PRIO_DEBUG));
+        if (cached.lease != 0) {
+          mcache.renew(key, ptr, time(NULL) + cached.lease);
+        }
         return CORBA::Object::_duplicate(ptr);
       }
-    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
-      mlogger->log(dadi::Message("ORBMgr",
-                                 "Remove non existing object from cache (" + ctxt
-                                 + "/" + name + ")\n",
-                                 dadi::Message::PRIO_DEBUG));
-      removeObjectFromCache(name);
-    } catch (const CORBA::TRANSIENT& err) {
-      mlogger->log(dadi::Message("ORBMgr",
-                                 "Remove unreachable object from cache (" + ctxt
-                                 + "/" + name + ")\n",
-                                 dadi::Message::PRIO_DEBUG));
-      removeObjectFromCache(name);
-    } catch (const CORBA::COMM_FAILURE& err) {
       mlogger->log(dadi::Message("ORBMgr",
-                                 "Remove unreachable object from cache (" + ctxt
-                                 + "/" + name + ")\n",
+                                 "Remove deactivated object from cache ("
+                                 + key + ")\n",
                                  dadi::Message::PRIO_DEBUG));
-      removeObjectFromCache(name);
-    } catch (...) {
-      mlogger->log(dadi::Message("ORBMgr",
-                                 "Remove unreachable object from cache (" + ctxt
-                                 + "/" + name + ")\n",
-                                 dadi::Message::PRIO_DEBUG));
-      removeObjectFromCache(name);
+      evictObject(key, ptr);
+    } else {
+      try {
+        mlogger->log(dadi::Message("ORBMgr",
+                                   "Check if the object is still present\n",
+                                    dadi::Message::PRIO_DEBUG));
+        bool missing = ptr->_non_existent();
+        /* The endpoint answered: its failures are no longer consecutive. */
+        if (!cached.endpoint.empty()) {
+          mretryPolicy.success(cached.endpoint);
+        }
+        if (missing) {
+          mlogger->log(dadi::Message("ORBMgr",
+                                     "Remove non existing object from cache ("
+                                     + key + ")\n",
+                                     dadi::Message::PRIO_DEBUG));
+          evictObject(key, ptr);
+        } else {
+          mlogger->log(dadi::Message("ORBMgr",
+                                     "Use object from cache (" + key + ")\n",
+                                     dadi::Message::PRIO_DEBUG));
+          /* The object answered: renew its lease. */
+          if (cached.lease != 0) {
+            mcache.renew(key, ptr, time(NULL) + cached.lease);
+          }
+          return CORBA::Object::_duplicate(ptr);
+        }
+      } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+        mlogger->log(dadi::Message("ORBMgr",
+                                   "Remove non existing object from cache ("
+                                   + key + ")\n",
+                                   dadi::Message::PRIO_DEBUG));
+        evictObject(key, ptr);
+      } catch (...) {
+        mlogger->log(dadi::Message("ORBMgr",
+                                   "Remove unreachable object from cache ("
+                                   + key + ")\n",
+                                   dadi::Message::PRIO_DEBUG));
+        evictObject(key, ptr);
+      }
     }
   }
-  mcacheMutex.unlock();
-  CORBA::Object_ptr object = mORB->resolve_initial_references("NameService");
-  CosNaming::NamingContext_var rootContext =
-    CosNaming::NamingContext::_narrow(object);
-  CosNaming::Name cosName;
+  /* A name recently not found is not looked up again. */
+  if (isNotFound(key)) {
+    throw std::runtime_error("Error resolving " + key);
+  }
 
-  cosName.length(2);
-  cosName[0].id   = ctxt.c_str();
-  cosName[0].kind = "";
-  cosName[1].id   = name.c_str();
-  cosName[1].kind = "";
+  std::string endpoint;
+  CORBA::Object_var object;
 
   try {
-    object = rootContext->resolve(cosName);
+    object = resolveName(ctxt, name);
 
     /* If the object is not a forwarder object, then
      * search if we need to use a forwarder to reach it.
      */
     if (ctxt != FWRDCTXT && fwdName!="no-Forwarder") {
-      std::string objIOR = getIOR(object);
-      IOP::IOR ior;
-      makeIOR(objIOR, ior);
-
       // Get the object host to check if it is a forwarder reference
-      std::string objHost = getHost(ior);
+      std::string objHost = parseIOR(object).host;
       try {
         if (objHost.size()>0 && objHost.at(0)=='@') {
           objHost.erase(0, 1);  // Remove '@' before the forwarder name
@@ -483,13 +778,13 @@ ORBMgr::resolveObject(const std::string& context, const std::string& name,
     mlogger->log(dadi::Message("ORBMgr",
                                "Error resolving " + ctxt + "/" + name + "\n",
                                dadi::Message::PRIO_DEBUG));
+    setNotFound(key);
     throw std::runtime_error("Error resolving " + ctxt + "/" + name);
   }
-  mcacheMutex.lock();
-  mcache[ctxt + "/" + name] = CORBA::Object::_duplicate(object);
-  mcacheMutex.unlock();
+  endpoint = cacheObject(context, ctxt, name, fwdName, object);
+  admitCall(object, endpoint);
 
-  return CORBA::Object::_duplicate(object);
+  return object._retn();
 }
 
 /* Resolve objects without invoking forwarders. */
@@ -508,145 +803,219 @@ ORBMgr::simpleResolve(const std::string& context,
     ctxt = AGENTCTXT;
   }
 
-  CORBA::Object_ptr object = mORB->resolve_initial_references("NameService");
-  CosNaming::NamingContext_var rootContext =
-    CosNaming::NamingContext::_narrow(object);
-  CosNaming::Name cosName;
-
-  cosName.length(2);
-  cosName[0].id   = ctxt.c_str();
-  cosName[0].kind = "";
-  cosName[1].id   = name.c_str();
-  cosName[1].kind = "";
-
+  if (isNotFound(ctxt + "/" + name)) {
+    throw std::runtime_error("Error resolving " + ctxt + "/" + name);
+  }
   try {
-    object = rootContext->resolve(cosName);
+    return resolveName(ctxt, name);
   } catch (CosNaming::NamingContext::NotFound& err) {
     mlogger->log(dadi::Message("ORBMgr",
                                "Error resolving " + ctxt + "/" + name + "\n",
                                dadi::Message::PRIO_DEBUG));
+    setNotFound(ctxt + "/" + name);
     throw std::runtime_error("Error resolving " + ctxt + "/" + name);
   }
-  return CORBA::Object::_duplicate(object);
 }
 
 
-std::list<std::string>
-ORBMgr::list(CosNaming::NamingContext_var& ctxt) const {
-  std::list<std::string> result;
-  CosNaming::BindingList_var ctxtList;
+std::vector<std::string>
+ORBMgr::listNames(CosNaming::NamingContext_ptr ctxt,
+                  const CosNaming::BindingType type) const {
+  std::vector<std::string> result;
+  CosNaming::BindingList_var bindingList;
   CosNaming::BindingIterator_var it;
-  CosNaming::Binding_var bv;
+  CORBA::ULong chunk = listFirstChunk;
+  bool more;
 
-  ctxt->list(256, ctxtList, it);
-  for (unsigned int i = 0; i < ctxtList->length(); ++i)
-    if (ctxtList[i].binding_type == CosNaming::nobject) {
-      for (unsigned int j = 0; j < ctxtList[i].binding_name.length(); ++j) {
-        result.push_back(std::string(ctxtList[i].binding_name[j].id));
+  ctxt->list(chunk, bindingList, it);
+  more = !CORBA::is_nil(it);
+  try {
+    for (;;) {
+      for (CORBA::ULong i = 0; i < bindingList->length(); ++i) {
+        if (bindingList[i].binding_type == type) {
+          for (CORBA::ULong j = 0; j < bindingList[i].binding_name.length();
+               ++j) {
+            result.push_back(std::string(bindingList[i].binding_name[j].id));
+          }
+        }
       }
+      if (!more) {
+        break;
+      }
+      if (chunk < listMaxChunk) {
+        chunk *= 2;
+      }
+      more = it->next_n(chunk, bindingList);
     }
-  if (CORBA::is_nil(it)) {
-    return result;
+  } catch (...) {
+    /* Only next_n may throw here, so the iterator is not nil. */
+    try {
+      it->destroy();
+    } catch (...) {
+    }
+    throw;
   }
-  while (it->next_one(bv)) {
-    if (bv->binding_type == CosNaming::nobject) {
-      for (unsigned int j = 0; j < bv->binding_name.length(); ++j) {
-        result.push_back(std::string(bv->binding_name[j].id));
-      }
+  if (!CORBA::is_nil(it)) {
+    try {
+      it->destroy();
+    } catch (...) {
+      /* The iterator will be reclaimed by the naming service. */
     }
   }
   return result;
 }
 
-std::list<std::string>
-ORBMgr::list(const std::string& ctxtName) const {
-  std::list<std::string> result;
+std::vector<ORBMgr::Binding>
+ORBMgr::resolveNames(CosNaming::NamingContext_ptr ctxt,
+                     const std::vector<std::string>& names) const {
+  std::vector<Binding> result;
+  std::vector<CORBA::Request_ptr> window;
+  size_t first, next = 0;
+
+  result.reserve(names.size());
+  window.reserve(resolveWindow);
+  while (next < names.size()) {
+    first = next;
+    for (; next < names.size() && next - first < resolveWindow; ++next) {
+      CosNaming::Name cosName;
+      cosName.length(1);
+      cosName[0].id = names[next].c_str();
+      cosName[0].kind = "";
+
+      CORBA::Request_ptr request = ctxt->_request("resolve");
+      request->add_in_arg() <<= cosName;
+      request->set_return_type(CORBA::_tc_Object);
+      request->exceptions()->add(CosNaming::NamingContext::_tc_NotFound);
+      request->exceptions()->add(CosNaming::NamingContext::_tc_CannotProceed);
+      request->exceptions()->add(CosNaming::NamingContext::_tc_InvalidName);
+      request->send_deferred();
+      window.push_back(request);
+    }
 
-  CORBA::Object_ptr object = mORB->resolve_initial_references("NameService");
-  CosNaming::NamingContext_var rootContext =
-    CosNaming::NamingContext::_narrow(object);
-  CosNaming::BindingList_var bindingList;
-  CosNaming::BindingIterator_var it;
+    for (size_t i = 0; i < window.size(); ++i) {
+      const std::string& name = names[first + i];
+      CORBA::Object_var object;
+      bool systemError = false;
 
-  rootContext->list(256, bindingList, it);
+      try {
+        window[i]->get_response();
+        CORBA::Exception* err = window[i]->env()->exception();
+        if (err == NULL) {
+          window[i]->return_value() >>= CORBA::Any::to_object(object.out());
+        } else if (CORBA::SystemException::_downcast(err) != NULL) {
+          systemError = true;
+        }
+      } catch (const CORBA::SystemException& err) {
+        systemError = true;
+      }
+      CORBA::release(window[i]);
+
+      /* Retry synchronously, so that a failure is reported as usual. */
+      if (systemError) {
+        CosNaming::Name cosName;
+        cosName.length(1);
+        cosName[0].id = name.c_str();
+        cosName[0].kind = "";
+        try {
+          object = ctxt->resolve(cosName);
+        } catch (CosNaming::NamingContext::NotFound& err) {
+          object = CORBA::Object::_nil();
+        }
+      }
+      if (!CORBA::is_nil(object)) {
+        result.push_back(Binding(name, object));
+      }
+    }
+    window.clear();
+  }
+  return result;
+}
 
-  for (unsigned int i = 0; i < bindingList->length(); ++i) {
-    if (bindingList[i].binding_type == CosNaming::ncontext) {
-      if (std::string(bindingList[i].binding_name[0].id) == ctxtName) {
-        std::list<std::string> tmpRes;
-        CORBA::Object_ptr ctxtObj =
-          rootContext->resolve(bindingList[i].binding_name);
-        CosNaming::NamingContext_var ctxt =
-          CosNaming::NamingContext::_narrow(ctxtObj);
+std::list<std::string>
+ORBMgr::list(CosNaming::NamingContext_var& ctxt) const {
+  std::vector<std::string> names = listNames(ctxt, CosNaming::nobject);
+  return std::list<std::string>(names.begin(), names.end());
+}
 
-        tmpRes = list(ctxt);
-        result.insert(result.end(), tmpRes.begin(), tmpRes.end());
+std::list<std::string>
+ORBMgr::list(const std::string& ctxtName) const {
+  /* A stale naming context is acquired again once. */
+  for (unsigned int attempt = 0; ; ++attempt) {
+    try {
+      CosNaming::NamingContext_var ctxt = namingContext(ctxtName);
+      return list(ctxt);
+    } catch (CosNaming::NamingContext::NotFound& err) {
+      return std::list<std::string>();
+    } catch (const CORBA::TRANSIENT& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+      if (attempt > 0) {
+        throw;
       }
+      resetNamingContexts();
     }
   }
-  if (CORBA::is_nil(it)) {
-    return result;
-  }
-
-  CosNaming::Binding_var bv;
-  while (it->next_one(bv)) {
-    if (bv->binding_type == CosNaming::ncontext) {
-      if (std::string(bv->binding_name[0].id) == ctxtName) {
-        std::list<std::string> tmpRes;
-        CORBA::Object_ptr ctxtObj = rootContext->resolve(bv->binding_name);
-        CosNaming::NamingContext_var ctxt =
-          CosNaming::NamingContext::_narrow(ctxtObj);
+}
 
-        tmpRes = list(ctxt);
-        result.insert(result.end(), tmpRes.begin(), tmpRes.end());
+std::vector<ORBMgr::Binding>
+ORBMgr::bindings(const std::string& ctxtName) const {
+  /* A stale naming context is acquired again once. */
+  for (unsigned int attempt = 0; ; ++attempt) {
+    try {
+      CosNaming::NamingContext_var ctxt = namingContext(ctxtName);
+      return resolveNames(ctxt, listNames(ctxt, CosNaming::nobject));
+    } catch (CosNaming::NamingContext::NotFound& err) {
+      return std::vector<Binding>();
+    } catch (const CORBA::TRANSIENT& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+      if (attempt > 0) {
+        throw;
       }
+      resetNamingContexts();
     }
   }
-  return result;
 }
 
 std::list<std::string>
 ORBMgr::contextList() const {
-  std::list<std::string> result;
-
-  CORBA::Object_ptr object = mORB->resolve_initial_references("NameService");
-  CosNaming::NamingContext_var rootContext =
-    CosNaming::NamingContext::_narrow(object);
-  CosNaming::BindingList_var bindingList;
-  CosNaming::BindingIterator_var it;
-
-  rootContext->list(256, bindingList, it);
-
-  for (unsigned int i = 0; i < bindingList->length(); ++i) {
-    if (bindingList[i].binding_type == CosNaming::ncontext) {
-      std::string ctxt = std::string(bindingList[i].binding_name[0].id);
-      result.push_back(ctxt);
-    }
-  }
-  if (CORBA::is_nil(it)) {
-    return result;
-  }
-
-  CosNaming::Binding_var bv;
-  while (it->next_one(bv)) {
-    if (bv->binding_type == CosNaming::ncontext) {
-      result.push_back(std::string(bv->binding_name[0].id));
+  /* A stale root context is acquired again once. */
+  for (unsigned int attempt = 0; ; ++attempt) {
+    try {
+      CosNaming::NamingContext_var root = rootContext();
+      std::vector<std::string> names = listNames(root, CosNaming::ncontext);
+      return std::list<std::string>(names.begin(), names.end());
+    } catch (const CORBA::TRANSIENT& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
+    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
+      if (attempt > 0) {
+        throw;
+      }
+      resetNamingContexts();
     }
   }
-  return result;
 }
 
 bool
 ORBMgr::isLocal(const std::string& ctxt, const std::string& name) const {
   CORBA::Object_ptr obj = simpleResolve(ctxt, name);
-  return getHost(getIOR(obj)).at(0) != '@';
+  return parseIOR(obj).host.at(0) != '@';
 }
 
 std::string
 ORBMgr::forwarderName(const std::string& ctxt, const std::string& name) const {
   CORBA::Object_ptr obj = simpleResolve(ctxt, name);
   std::string host;
-  if ((host = getHost(getIOR(obj))).at(0) != '@') {
+  if ((host = parseIOR(obj).host).at(0) != '@') {
     return "";
   }
 
@@ -655,46 +1024,102 @@ ORBMgr::forwarderName(const std::string& ctxt, const std::string& name) const {
 }
 
 
+void
+ORBMgr::refreshHostIndex(const std::string& ctxt) const {
+  std::map<std::string, HostIndex>::iterator it;
+  std::vector<Binding> objects;
+  std::vector<Binding>::const_iterator jt;
+  HostIndex index;
+
+  mhostIndexMutex.lock();
+  it = mhostIndex.find(ctxt);
+  if (it != mhostIndex.end() && !it->second.stale
+      && time(NULL) < it->second.filled + hostIndexTTL) {
+    mhostIndexMutex.unlock();
+    return;
+  }
+  mhostIndexMutex.unlock();
+
+  /* Fill the index outside the lock from one bulk listing. */
+  index.filled = time(NULL);
+  index.stale = false;
+  objects = bindings(ctxt);
+  for (jt = objects.begin(); jt != objects.end(); ++jt) {
+    ParsedIOR parsed = parseIOR(jt->second);
+    HostEntry& entry = index.entries[jt->first];
+    entry.host = parsed.host;
+    entry.port = parsed.port;
+  }
+
+  mhostIndexMutex.lock();
+  mhostIndex[ctxt] = index;
+  mhostIndexMutex.unlock();
+}
+
+void
+ORBMgr::indexObject(const std::string& ctxt, const std::string& name,
+                    CORBA::Object_ptr object) const {
+  std::map<std::string, HostIndex>::iterator it;
+  ParsedIOR parsed = parseIOR(object);
+  HostEntry entry;
+
+  entry.host = parsed.host;
+  entry.port = parsed.port;
+
+  /* A context not indexed yet is filled on its first query. */
+  mhostIndexMutex.lock();
+  if ((it = mhostIndex.find(ctxt)) != mhostIndex.end()) {
+    it->second.entries[name] = entry;
+  }
+  mhostIndexMutex.unlock();
+}
+
+void
+ORBMgr::invalidateHostIndex(const std::string& ctxt) const {
+  std::map<std::string, HostIndex>::iterator it;
+
+  mhostIndexMutex.lock();
+  if ((it = mhostIndex.find(ctxt)) != mhostIndex.end()) {
+    it->second.stale = true;
+  }
+  mhostIndexMutex.unlock();
+}
+
 std::list<std::string>
 ORBMgr::forwarderObjects(const std::string& fwdName,
                          const std::string& ctxt) const {
-  std::list<std::string> result = list(ctxt);
-  std::list<std::string>::iterator it, next;
+  std::list<std::string> result;
+  std::map<std::string, HostEntry>::const_iterator it;
   std::string fwdTag = '@'+fwdName;
 
-  for (it = result.begin(); it != result.end(); it = next) {
-    std::string ior, iorHost;
-    next = it;
-    ++next;
-    CORBA::Object_ptr obj = simpleResolve(ctxt, *it);
-    ior = getIOR(obj);
-    iorHost = getHost(ior);
-    if (iorHost != fwdTag) {
-      result.erase(it);
+  refreshHostIndex(ctxt);
+
+  mhostIndexMutex.lock();
+  const std::map<std::string, HostEntry>& entries = mhostIndex[ctxt].entries;
+  for (it = entries.begin(); it != entries.end(); ++it) {
+    if (it->second.host == fwdTag) {
+      result.push_back(it->first);
     }
   }
+  mhostIndexMutex.unlock();
   return result;
 }
 
 std::list<std::string>
 ORBMgr::localObjects(const std::string& ctxt) const {
-  std::list<std::string> result = list(ctxt);
-  std::list<std::string>::iterator it, next;
-
-  for (it = result.begin(); it != result.end(); it = next) {
-    std::string ior, iorHost;
-    next = it;
-    ++next;
-    CORBA::Object_ptr obj = simpleResolve(ctxt, *it);
-    ior = getIOR(obj);
-    iorHost = getHost(ior);
-    if (iorHost.length() < 1) {
-      continue;
-    }
-    if (iorHost.at(0) == '@') {
-      result.erase(it);
+  std::list<std::string> result;
+  std::map<std::string, HostEntry>::const_iterator it;
+
+  refreshHostIndex(ctxt);
+
+  mhostIndexMutex.lock();
+  const std::map<std::string, HostEntry>& entries = mhostIndex[ctxt].entries;
+  for (it = entries.begin(); it != entries.end(); ++it) {
+    if (it->second.host.length() < 1 || it->second.host.at(0) != '@') {
+      result.push_back(it->first);
     }
   }
+  mhostIndexMutex.unlock();
   return result;
 }
 
@@ -720,6 +1145,126 @@ void ORBMgr::deactivate(PortableServer::ServantBase* object) const {
   mPOA->deactivate_object(*id);
 }
 
+CORBA::Object_ptr
+ORBMgr::reference(PortableServer::ServantBase* object) const {
+  return mPOA->servant_to_reference(object);
+}
+
+CORBA::NVList_ptr
+ORBMgr::createList(const CORBA::Long count) const {
+  CORBA::NVList_ptr result;
+
+  mORB->create_list(count, result);
+  return result;
+}
+
+PortableServer::POA_ptr
+ORBMgr::createProxyPOA(const std::string& name,
+                       PortableServer::ServantBase* servant) const {
+  PortableServer::POAManager_var manager = mPOA->the_POAManager();
+  PortableServer::POA_var poa;
+  CORBA::PolicyList policies;
+  CORBA::Any policy;
+
+  /* The objects have no servant of their own: each request is served by
+   * the default servant, the target being known from its object id. */
+  policies.length(5);
+  policy <<= BiDirPolicy::BOTH;
+  policies[0] = mORB->create_policy(BiDirPolicy::BIDIRECTIONAL_POLICY_TYPE,
+                                    policy);
+  policies[1] =
+    mPOA->create_request_processing_policy(PortableServer::USE_DEFAULT_SERVANT);
+  policies[2] =
+    mPOA->create_servant_retention_policy(PortableServer::NON_RETAIN);
+  policies[3] = mPOA->create_id_assignment_policy(PortableServer::USER_ID);
+  policies[4] = mPOA->create_id_uniqueness_policy(PortableServer::MULTIPLE_ID);
+
+  // If poa already exist, use the same
+  try {
+    poa = mPOA->create_POA(name.c_str(), manager, policies);
+  } catch (PortableServer::POA::AdapterAlreadyExists &e) {
+    poa = mPOA->find_POA(name.c_str(), false);
+  }
+  for (CORBA::ULong i = 0; i < policies.length(); ++i) {
+    policies[i]->destroy();
+  }
+
+  poa->set_servant(servant);
+  servant->_remove_ref();
+
+  mlocalMutex.lock();
+  mproxyPOAs.push_back(PortableServer::POA::_duplicate(poa));
+  mlocalMutex.unlock();
+  return poa._retn();
+}
+
+CORBA::Object_ptr
+ORBMgr::proxyReference(PortableServer::POA_ptr poa, const std::string& id,
+                       const char* repoId) const {
+  PortableServer::ObjectId_var oid =
+    PortableServer::string_to_ObjectId(id.c_str());
+  return poa->create_reference_with_id(oid, repoId);
+}
+
+bool
+ORBMgr::localObject(CORBA::Object_ptr object, bool& active) const {
+  std::list<PortableServer::POA_var> poas;
+  std::list<PortableServer::POA_var>::const_iterator it;
+  std::string endpoint;
+
+  if (CORBA::is_nil(object)) {
+    return false;
+  }
+  mlocalMutex.lock();
+  if (!mlocalKnown) {
+    try {
+      CORBA::Object_var ref =
+        mPOA->create_reference("IDL:omg.org/CORBA/Object:1.0");
+      mlocalEndpoint = getEndpoint(ref);
+    } catch (...) {
+      // The POA does not create its object ids, nothing is local
+      mlocalEndpoint = "";
+    }
+    mlocalKnown = true;
+  }
+  endpoint = mlocalEndpoint;
+  poas = mproxyPOAs;
+  mlocalMutex.unlock();
+
+  /* The references made by this process all carry its endpoint. */
+  if (endpoint.empty() || getEndpoint(object) != endpoint) {
+    return false;
+  }
+  for (it = poas.begin(); it != poas.end(); ++it) {
+    try {
+      PortableServer::ObjectId_var oid = (*it)->reference_to_id(object);
+      active = true;
+      return true;
+    } catch (const PortableServer::POA::WrongAdapter& err) {
+    } catch (const CORBA::SystemException& err) {
+      // The POA was destroyed
+    }
+  }
+  try {
+    PortableServer::ServantBase* servant = mPOA->reference_to_servant(object);
+    servant->_remove_ref();
+    active = true;
+  } catch (const PortableServer::POA::ObjectNotActive& err) {
+    active = false;
+  } catch (const PortableServer::POA::WrongAdapter& err) {
+    return false;
+  } catch (const PortableServer::POA::WrongPolicy& err) {
+    return false;
+  }
+  return true;
+}
+
+char*
+ORBMgr::currentObjectId() const {
+  PortableServer::ObjectId_var oid = mcurrent->get_object_id();
+  return PortableServer::ObjectId_to_string(oid);
+}
+
 void
 ORBMgr::shutdown(bool waitForCompletion) {
   if (!mdown) {
@@ -789,18 +1334,15 @@ ORBMgr::init(int argc, char* argv[]) {
 void
 ORBMgr::hexStringToBuffer(const char* ptr, const size_t size,
                           cdrMemoryStream& buffer) {
-  std::stringstream ss;
-  int value;
-  CORBA::Octet c;
+  std::vector<CORBA::Octet> bytes(size / 2);
 
-  for (unsigned int i = 0; i < size; i += 2) {
-    ss << ptr[i] << ptr[i+1];
-    ss >> std::hex >> value;
-    c = value;
-    buffer.marshalOctet(c);
-    ss.flush();
-    ss.clear();
+  if (bytes.empty()) {
+    return;
+  }
+  if (!HexCodec::decode(ptr, size, &bytes[0])) {
+    throw std::runtime_error("Bad hexadecimal string");
   }
+  buffer.put_octet_array(&bytes[0], bytes.size());
 }
 
 /* Make an IOP::IOR object using a stringified IOR. */
@@ -832,30 +1374,22 @@ ORBMgr::makeIOR(const std::string& strIOR, IOP::IOR& ior) {
 /* Convert IOP::IOR to a stringified IOR. */
 void
 ORBMgr::makeString(const IOP::IOR& ior, std::string& strIOR) {
-  strIOR = "IOR:";
   cdrMemoryStream buffer(0, true);
-  std::stringstream ss;
-  unsigned char* ptr;
+  size_t size;
 
   buffer.marshalBoolean(omni::myByteOrder);
   buffer.marshalRawString(ior.type_id);
   ior.profiles >>= buffer;
 
   buffer.rewindInputPtr();
-  ptr = static_cast<unsigned char*>(buffer.bufPtr());
-
-  for (unsigned long i = 0; i < buffer.bufSize(); ++ptr, ++i) {
-    std::string str;
-    unsigned char c = *ptr;
-    if (c < 16) {
-      ss << '0';
-    }
-
-    ss << (unsigned short) c;
-    ss >> std::hex >> str;
-    ss.flush();
-    ss.clear();
-    strIOR += str;
+  size = buffer.bufSize();
+
+  /* Encode the bytes in place after the "IOR:" prefix. */
+  strIOR.assign(4 + 2 * size, '0');
+  strIOR.replace(0, 4, "IOR:");
+  if (size > 0) {
+    HexCodec::encode(static_cast<const unsigned char*>(buffer.bufPtr()),
+                     size, &strIOR[4]);
   }
 }
 
@@ -919,6 +1453,54 @@ ORBMgr::getTypeID(const std::string& strIOR) {
   return getTypeID(ior);
 }
 
+ORBMgr::ParsedIOR
+ORBMgr::parseIOR(CORBA::Object_ptr object, const std::string& strIOR) const {
+  /* Bound of CORBA::Object::_hash(), the largest unsigned long. */
+  static const CORBA::ULong hashMax = 0xFFFFFFFFUL;
+  std::map<CORBA::ULong, std::list<ParsedIOREntry> >::const_iterator it;
+  std::list<ParsedIOREntry>::const_iterator jt;
+  std::map<CORBA::ULong, std::list<ParsedIOREntry> > old;
+  ParsedIOREntry entry;
+  CORBA::ULong hash = 0;
+  IOP::IOR ior;
+
+  if (!CORBA::is_nil(object)) {
+    hash = object->_hash(hashMax);
+    miorsMutex.lock();
+    if ((it = miors.find(hash)) != miors.end()) {
+      /* Equivalence is checked locally on the references. */
+      for (jt = it->second.begin(); jt != it->second.end(); ++jt) {
+        if (jt->object->_is_equivalent(object)) {
+          entry.parsed = jt->parsed;
+          miorsMutex.unlock();
+          return entry.parsed;
+        }
+      }
+    }
+    miorsMutex.unlock();
+  }
+
+  makeIOR(strIOR.empty() ? getIOR(object) : strIOR, ior);
+  entry.parsed.host = getHost(ior);
+  entry.parsed.port = getPort(ior);
+  entry.parsed.typeId = getTypeID(ior);
+  if (CORBA::is_nil(object)) {
+    return entry.parsed;
+  }
+  entry.object = CORBA::Object::_duplicate(object);
+
+  /* The dropped references are released outside the lock. */
+  miorsMutex.lock();
+  if (mnbIORs >= parsedIORsMax) {
+    old.swap(miors);
+    mnbIORs = 0;
+  }
+  miors[hash].push_back(entry);
+  ++mnbIORs;
+  miorsMutex.unlock();
+  return entry.parsed;
+}
+
 std::string
 ORBMgr::convertIOR(IOP::IOR& ior, const std::string& host,
                    const unsigned int port) {
@@ -964,20 +1546,20 @@ ORBMgr::convertIOR(const std::string& strIOR, const std::string& host,
 /* Object cache management functions. */
 void
 ORBMgr::resetCache() const {
-  mcacheMutex.lock();
   mcache.clear();
+  mcacheMutex.lock();
+  mcookies.clear();
+  mcookieIds.clear();
   mcacheMutex.unlock();
+  mnotFoundMutex.lock();
+  mnotFound.clear();
+  mnotFoundMutex.unlock();
 }
 
 void
 ORBMgr::removeObjectFromCache(const std::string& name) const {
-  std::map<std::string, CORBA::Object_ptr>::iterator it;
-  mcacheMutex.lock();
-  if ((it = mcache.find(name)) != mcache.end()) {
-    mcache.erase(it);
-  }
-
-  mcacheMutex.unlock();
+  mcache.erase(name);
+  dropCookie(name);
 }
 
 void
@@ -988,25 +1570,433 @@ ORBMgr::removeObjectFromCache(const std::string& ctxt,
 
 void
 ORBMgr::cleanCache() const {
-  std::map<std::string, CORBA::Object_ptr>::iterator it;
-  std::list<std::string> toRemove;
-  std::list<std::string>::const_iterator jt;
+  sweepReport(msweeper.sweep(), const_cast<ORBMgr*>(this));
+}
 
+void
+ORBMgr::setSweepPeriod(const unsigned int period) {
+  msweeper.setPeriod(period);
+  if (period > 0) {
+    msweeper.start();
+  }
+}
+
+unsigned int
+ORBMgr::getSweepPeriod() const {
+  return msweeper.getPeriod();
+}
+
+CacheSweeper::Stats
+ORBMgr::getSweepStats() const {
+  return msweeper.stats();
+}
+
+void
+ORBMgr::setCacheLease(const std::string& ctxt, const unsigned int lease) {
   mcacheMutex.lock();
-  for (it = mcache.begin(); it != mcache.end(); ++it) {
+  mleases[ctxt] = lease;
+  mcacheMutex.unlock();
+  if (lease > 0) {
+    msweeper.start();
+  }
+}
+
+void
+ORBMgr::setCacheLease(const unsigned int lease) {
+  mcacheMutex.lock();
+  mdefaultLease = lease;
+  mcacheMutex.unlock();
+  if (lease > 0) {
+    msweeper.start();
+  }
+}
+
+unsigned int
+ORBMgr::getCacheLease(const std::string& ctxt) const {
+  std::map<std::string, unsigned int>::const_iterator it;
+  unsigned int lease;
+
+  mcacheMutex.lock();
+  if ((it = mleases.find(ctxt)) != mleases.end()) {
+    lease = it->second;
+  } else {
+    lease = mdefaultLease;
+  }
+  mcacheMutex.unlock();
+  return lease;
+}
+
+std::string
+ORBMgr::cacheObject(const std::string& context, const std::string& ctxt,
+                    const std::string& name, const std::string& fwdName,
+                    CORBA::Object_ptr object) const {
+  const std::string key = ctxt + "/" + name;
+  const unsigned int lease = getCacheLease(ctxt);
+  std::map<std::string, unsigned long>::iterator it;
+  unsigned long id;
+  ObjectCache::Entry entry;
+
+  entry.object = CORBA::Object::_duplicate(object);
+  entry.lease = lease;
+  entry.expiry = (lease != 0) ? time(NULL) + lease : 0;
+  entry.endpoint = getEndpoint(object);
+  mcache.put(key, entry);
+
+  mcacheMutex.lock();
+  /* The handlers of the replaced object may still run: its cookie is
+   * dropped, not changed. */
+  it = mcookieIds.find(key);
+  if (it != mcookieIds.end()) {
+    mcookies.erase(it->second);
+  }
+  id = ++mnextCookie;
+  mcookieIds[key] = id;
+  CacheCookie& ck = mcookies[id];
+  ck.context = context;
+  ck.name = name;
+  ck.fwdName = fwdName;
+  ck.endpoint = entry.endpoint;
+  ck.leased = (lease != 0);
+  mcacheMutex.unlock();
+
+  /* The failed calls are accounted to the object endpoint, and a failed
+   * call on a leased object evicts it from the cache. */
+  omniORB::installTransientExceptionHandler(object,
+                                            reinterpret_cast<void*>(id),
+                                            objectTransientHandler);
+  omniORB::installCommFailureExceptionHandler(object,
+                                              reinterpret_cast<void*>(id),
+                                              objectCommFailureHandler);
+  return entry.endpoint;
+}
+
+bool
+ORBMgr::findCookie(const unsigned long id, CacheCookie& cookie) const {
+  std::map<unsigned long, CacheCookie>::const_iterator it;
+  bool found = false;
+
+  mcacheMutex.lock();
+  it = mcookies.find(id);
+  if (it != mcookies.end()) {
+    cookie = it->second;
+    found = true;
+  }
+  mcacheMutex.unlock();
+  return found;
+}
+
+void
+ORBMgr::evictObject(const std::string& key,
+                    CORBA::Object_ptr object) const {
+  if (mcache.erase(key, object)) {
+    dropCookie(key);
+  }
+}
+
+void
+ORBMgr::dropCookie(const std::string& key) const {
+  std::map<std::string, unsigned long>::iterator it;
+
+  mcacheMutex.lock();
+  it = mcookieIds.find(key);
+  if (it != mcookieIds.end()) {
+    mcookies.erase(it->second);
+    mcookieIds.erase(it);
+  }
+  mcacheMutex.unlock();
+}
+
+void
+ORBMgr::purgeCookies() const {
+  std::map<std::string, unsigned long>::iterator it;
+  std::vector<std::pair<std::string, unsigned long> > cookies;
+  ObjectCache::Entry entry;
+
+  mcacheMutex.lock();
+  cookies.assign(mcookieIds.begin(), mcookieIds.end());
+  mcacheMutex.unlock();
+
+  /* Looked up out of the lock: a key cached again meanwhile has a new
+   * cookie, which is kept. */
+  for (unsigned int i = 0; i < cookies.size(); ++i) {
+    if (mcache.find(cookies[i].first, entry)) {
+      continue;
+    }
+    mcacheMutex.lock();
+    it = mcookieIds.find(cookies[i].first);
+    if (it != mcookieIds.end() && it->second == cookies[i].second) {
+      mcookies.erase(it->second);
+      mcookieIds.erase(it);
+    }
+    mcacheMutex.unlock();
+  }
+}
+
+std::string
+ORBMgr::getEndpoint(CORBA::Object_ptr object) const {
+  std::ostringstream endpoint;
+
+  try {
+    ParsedIOR parsed = parseIOR(object);
+    endpoint << parsed.host << ":" << parsed.port;
+  } catch (...) {
+    return "";
+  }
+  return endpoint.str();
+}
+
+void
+ORBMgr::admitCall(CORBA::Object_ptr object,
+                  const std::string& endpoint) const {
+  if (endpoint.empty()) {
+    return;
+  }
+  switch (mretryPolicy.admit(endpoint)) {
+  case RetryPolicy::ADMIT:
+    return;
+  case RetryPolicy::REJECT:
+    mlogger->log(dadi::Message("ORBMgr",
+                               "Endpoint " + endpoint + " is down, "
+                               "call rejected\n",
+                               dadi::Message::PRIO_DEBUG));
+    throw CORBA::TRANSIENT(0, CORBA::COMPLETED_NO);
+  case RetryPolicy::PROBE:
+    /* A failure is accounted by the exception handlers. */
     try {
-      if (it->second->_non_existent()) {
-        toRemove.push_back(it->first);
-      }
-    } catch (const CORBA::OBJECT_NOT_EXIST& err) {
-      toRemove.push_back(it->first);
+      object->_non_existent();
     } catch (...) {
-      toRemove.push_back(it->first);
+      throw CORBA::TRANSIENT(0, CORBA::COMPLETED_NO);
     }
+    mretryPolicy.success(endpoint);
+    mlogger->log(dadi::Message("ORBMgr",
+                               "Endpoint " + endpoint + " is up again\n",
+                               dadi::Message::PRIO_DEBUG));
+    return;
   }
-  mcacheMutex.unlock();
+}
+
+bool
+ORBMgr::retryCall(const std::string& endpoint, const CORBA::ULong retries,
+                  const std::string& failure) const {
+  std::ostringstream msg;
+  bool retry = mretryPolicy.failure(endpoint, retries);
+  unsigned long delay =
+    retry ? std::min(mretryPolicy.backoff(retries), handlerDelayMax) : 0;
+
+  msg << "Handler for " << failure << " exception called (nb retries: "
+      << retries << "/" << mretryPolicy.getMaxRetries() << ")";
+  if (!endpoint.empty()) {
+    msg << " on " << endpoint;
+  }
+  if (retry) {
+    msg << ". Will now retry in " << delay << " ms";
+  }
+  msg << ".\n";
+  mlogger->log(dadi::Message("ORBMgr", msg.str(), dadi::Message::PRIO_DEBUG));
+
+  if (retry) {
+    omni_thread::sleep(delay / 1000, (delay % 1000) * 1000000);
+  }
+  return retry;
+}
+
+void
+ORBMgr::setNotFoundLease(const unsigned int lease) {
+  mnotFoundMutex.lock();
+  mnotFoundLease = lease;
+  mnotFound.clear();
+  mnotFoundMutex.unlock();
+}
+
+unsigned int
+ORBMgr::getNotFoundLease() const {
+  unsigned int lease;
+
+  mnotFoundMutex.lock();
+  lease = mnotFoundLease;
+  mnotFoundMutex.unlock();
+  return lease;
+}
+
+bool
+ORBMgr::isNotFound(const std::string& key) const {
+  std::map<std::string, time_t>::iterator it;
+  bool result = false;
+
+  mnotFoundMutex.lock();
+  if ((it = mnotFound.find(key)) != mnotFound.end()) {
+    if (time(NULL) < it->second) {
+      result = true;
+    } else {
+      mnotFound.erase(it);
+    }
+  }
+  mnotFoundMutex.unlock();
+  if (result) {
+    mlogger->log(dadi::Message("ORBMgr",
+                               "Object " + key + " recently not found\n",
+                               dadi::Message::PRIO_DEBUG));
+  }
+  return result;
+}
+
+void
+ORBMgr::setNotFound(const std::string& key) const {
+  std::map<std::string, time_t>::iterator it;
+  time_t now = time(NULL);
+
+  mnotFoundMutex.lock();
+  if (mnotFoundLease > 0) {
+    /* Many distinct names polled: drop the expired ones. */
+    if (mnotFound.size() >= notFoundPurge) {
+      for (it = mnotFound.begin(); it != mnotFound.end(); ) {
+        if (it->second <= now) {
+          mnotFound.erase(it++);
+        } else {
+          ++it;
+        }
+      }
+    }
+    mnotFound[key] = now + mnotFoundLease;
+  }
+  mnotFoundMutex.unlock();
+}
+
+void
+ORBMgr::clearNotFound(const std::string& key) const {
+  mnotFoundMutex.lock();
+  mnotFound.erase(key);
+  mnotFoundMutex.unlock();
+}
+
+RetryPolicy&
+ORBMgr::getRetryPolicy() const {
+  return mretryPolicy;
+}
+
+bool
+ORBMgr::refreshCachedObject(const CacheCookie& cookie) const {
+  std::string ctxt = cookie.context;
+  ObjectCache::Entry entry;
+  CORBA::Object_var stale;
+  CORBA::Object_var fresh;
+
+  if (ctxt == LOCALAGENT || ctxt == MASTERAGENT) {
+    ctxt = AGENTCTXT;
+  } else if (ctxt == LOGCOMPCONFCTXT) {
+    ctxt = LOGCOMPCTXT;
+  } else if (ctxt == LOGTOOLMSGCTXT) {
+    ctxt = LOGTOOLCTXT;
+  }
+  const std::string key = ctxt + "/" + cookie.name;
+
+  if (mcache.find(key, entry)) {
+    stale = entry.object;
+    evictObject(key, stale);
+  }
+
+  mlogger->log(dadi::Message("ORBMgr",
+                             "Call failed on leased object, evict it ("
+                             + key + ")\n",
+                             dadi::Message::PRIO_DEBUG));
+  /* Resolve the object again. If it is still the same object, retry the
+   * call once, otherwise the next call will use the new reference.
+   */
+  try {
+    fresh = resolveObject(cookie.context, cookie.name, cookie.fwdName);
+    return !CORBA::is_nil(stale) && fresh->_is_equivalent(stale);
+  } catch (...) {
+    return false;
+  }
+}
+
+void
+ORBMgr::sweepReport(const CacheSweeper::Stats& stats, void* mgr) {
+  std::ostringstream msg;
+
+  msg << "Cache sweep " << stats.sweeps << ": " << stats.probed
+      << " objects probed, " << stats.evicted << " evicted in "
+      << stats.duration << " ms (" << stats.totalEvicted
+      << " evicted since start).\n";
+  static_cast<ORBMgr*>(mgr)->mlogger->log(
+    dadi::Message("ORBMgr", msg.str(), dadi::Message::PRIO_DEBUG));
+  static_cast<ORBMgr*>(mgr)->retryReport();
+  static_cast<ORBMgr*>(mgr)->purgeCookies();
+}
+
+void
+ORBMgr::retryReport() const {
+  static const char* states[] = {"closed", "open", "half-open"};
+  std::map<std::string, RetryPolicy::EndpointStats> stats =
+    mretryPolicy.stats();
+  std::map<std::string, RetryPolicy::EndpointStats>::const_iterator it;
+
+  for (it = stats.begin(); it != stats.end(); ++it) {
+    std::ostringstream msg;
+    msg << "Endpoint " << it->first << ": circuit "
+        << states[it->second.state] << ", " << it->second.failures
+        << " failures, " << it->second.retries << " retries, "
+        << it->second.trips << " trips, " << it->second.rejected
+        << " rejected.\n";
+    mlogger->log(dadi::Message("ORBMgr", msg.str(),
+                               dadi::Message::PRIO_DEBUG));
+  }
+}
+
+bool
+ORBMgr::sweepLocalCheck(CORBA::Object_ptr object, bool& active, void* mgr) {
+  return static_cast<ORBMgr*>(mgr)->localObject(object, active);
+}
+
+CORBA::Boolean
+ORBMgr::transientHandler(void* cookie, CORBA::ULong retries,
+                         const CORBA::TRANSIENT& ex) {
+  return static_cast<ORBMgr*>(cookie)->retryCall("", retries, "transient");
+}
+
+CORBA::Boolean
+ORBMgr::commFailureHandler(void* cookie, CORBA::ULong retries,
+                           const CORBA::COMM_FAILURE& ex) {
+  return static_cast<ORBMgr*>(cookie)->retryCall("", retries,
+                                                 "communication failures");
+}
+
+bool
+ORBMgr::retryObjectCall(void* cookie, const CORBA::ULong retries,
+                        const std::string& failure) const {
+  CacheCookie ck;
+
+  /* A copy: the object may be cached again during the call. */
+  if (!findCookie(reinterpret_cast<unsigned long>(cookie), ck)) {
+    /* Evicted since: nothing is known about its endpoint. */
+    return retryCall("", retries, failure);
+  }
+  bool retry = retryCall(ck.endpoint, retries, failure);
+
+  if (retries == 0 && ck.leased) {
+    return refreshCachedObject(ck) && retry;
+  }
+  return retry;
+}
+
+CORBA::Boolean
+ORBMgr::objectTransientHandler(void* cookie, CORBA::ULong retries,
+                               const CORBA::TRANSIENT& ex) {
+  ORBMgr* mgr = theHandlerMgr;
+
+  if (mgr == NULL) {
+    return false;
+  }
+  return mgr->retryObjectCall(cookie, retries, "transient");
+}
+
+CORBA::Boolean
+ORBMgr::objectCommFailureHandler(void* cookie, CORBA::ULong retries,
+                                 const CORBA::COMM_FAILURE& ex) {
+  ORBMgr* mgr = theHandlerMgr;
 
-  for (jt = toRemove.begin(); jt != toRemove.end(); ++jt) {
-    removeObjectFromCache(*jt);
+  if (mgr == NULL) {
+    return false;
   }
+  return mgr->retryObjectCall(cookie, retries, "communication failures");
 }
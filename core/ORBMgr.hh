@@ -14,9 +14,12 @@
 #ifndef ORBMGR_HH
 #define ORBMGR_HH
 
+#include <ctime>
 #include <string>
 #include <map>
 #include <list>
+#include <utility>
+#include <vector>
 
 #include <omniORB4/CORBA.h>
 #include <sys/types.h>
@@ -24,6 +27,10 @@
 #include <omnithread.h>
 
 #include "Forwarder.hh"
+#include "utils/CacheSweeper.hh"
+#include "utils/ObjectCache.hh"
+#include "utils/RetryPolicy.hh"
+#include "utils/WorkerPool.hh"
 #include "dadi/Logging/Logger.hh"
 
 #define DAGDACTXT   "Dagda"
@@ -51,6 +58,28 @@
  */
 class ORBMgr {
 public:
+  /**
+   * @brief An object binding: the object name and its reference.
+   */
+  typedef std::pair<std::string, CORBA::Object_var> Binding;
+
+  /**
+   * @brief Outcome of a broadcast to one forwarder.
+   */
+  enum FwdStatus {
+    /** @brief The forwarder has been updated */
+    FWD_DONE,
+    /** @brief The forwarder was not reached yet, a retry is queued */
+    FWD_QUEUED,
+    /** @brief The forwarder refused the update or was given up */
+    FWD_FAILED
+  };
+
+  /**
+   * @brief Outcome of a broadcast, per forwarder name.
+   */
+  typedef std::map<std::string, FwdStatus> FwdResults;
+
   /**
    * @brief Constructors.
    * @param argc C main parameter
@@ -127,24 +156,33 @@ public:
   unbind(const std::string& ctxt, const std::string& name) const;
 
   /**
-   * @brief Forwarders binding.
+   * @brief Forwarders binding. The other forwarders are contacted
+   *   concurrently; the unreachable ones are retried in background.
    * @param ctxt The context to use
    * @param name The name of the object
    * @param ior The IOR of the object to forward
    * @param fwName The name of the forwarder to use
+   * @param wait Wait for the first attempt on every forwarder
+   * @return The outcome per forwarder, FWD_QUEUED for all of them
+   *   if wait is false
    */
-  void
+  FwdResults
   fwdsBind(const std::string& ctxt, const std::string& name,
-           const std::string& ior, const std::string& fwName = "") const;
+           const std::string& ior, const std::string& fwName = "",
+           const bool wait = true) const;
   /**
-   * @brief Forwarders unbinding.
+   * @brief Forwarders unbinding. The other forwarders are contacted
+   *   concurrently; the unreachable ones are retried in background.
    * @param ctxt The context to use
    * @param name The name of the object
    * @param fwName The name of the forwarder to use
+   * @param wait Wait for the first attempt on every forwarder
+   * @return The outcome per forwarder, FWD_QUEUED for all of them
+   *   if wait is false
    */
-  void
+  FwdResults
   fwdsUnbind(const std::string& ctxt, const std::string& name,
-             const std::string& fwName = "") const;
+             const std::string& fwName = "", const bool wait = true) const;
 
   /**
    * @brief Resolve an object using its IOR.
@@ -191,6 +229,15 @@ public:
   std::list<std::string>
   list(const std::string& ctxtName) const;
 
+  /**
+   * @brief Get the objects binded in the omniNames server for a given
+   *   context, with their references.
+   * @param ctxtName The name of the context to list all the object inside
+   * @return The bindings (name, object) of the context
+   */
+  std::vector<Binding>
+  bindings(const std::string& ctxtName) const;
+
   /**
    * @brief Get the list of declared CORBA contexts.
    * @return A list of all the CORBA context in the omniNames
@@ -275,6 +322,64 @@ public:
   void
   deactivate(PortableServer::ServantBase* object) const;
 
+  /**
+   * @brief Return the reference of an activated object.
+   * @param object The servant of the object
+   * @return The reference
+   */
+  CORBA::Object_ptr
+  reference(PortableServer::ServantBase* object) const;
+
+  /**
+   * @brief Create a list of named values, for the dynamic invocations.
+   * @param count The expected length of the list
+   * @return The list
+   */
+  CORBA::NVList_ptr
+  createList(const CORBA::Long count) const;
+
+  /**
+   * @brief Create a POA serving all its objects with a default servant.
+   * The objects are not activated, their references are created from an
+   * object identifier by proxyReference().
+   * @param name The name of the POA
+   * @param servant The servant of all the objects of the POA
+   * @return The POA
+   */
+  PortableServer::POA_ptr
+  createProxyPOA(const std::string& name,
+                 PortableServer::ServantBase* servant) const;
+
+  /**
+   * @brief Create a reference to an object of a proxy POA.
+   * @param poa The proxy POA
+   * @param id The object identifier
+   * @param repoId The repository identifier of the object interface
+   * @return The reference
+   */
+  CORBA::Object_ptr
+  proxyReference(PortableServer::POA_ptr poa, const std::string& id,
+                 const char* repoId) const;
+
+  /**
+   * @brief Tell if an object is served by this process and, if so, if it
+   * is active. No call is made: the objects of the proxy POAs are active
+   * as long as their POA, the others as long as their servant.
+   * @param object The object
+   * @param active Set to the activation state of a local object
+   * @return true if the object is served by this process
+   */
+  bool
+  localObject(CORBA::Object_ptr object, bool& active) const;
+
+  /**
+   * @brief Return the identifier of the object targeted by the request
+   * this thread is serving.
+   * @return The object identifier, to be freed by the caller
+   */
+  char*
+  currentObjectId() const;
+
   /**
    * @brief Wait for the request on activated objects.
    */
@@ -432,11 +537,83 @@ public:
   removeObjectFromCache(const std::string& ctxt, const std::string& name) const;
 
   /**
-   * @brief Clean the cache
+   * @brief Clean the cache: probe all the cached objects concurrently and
+   * evict the unreachable ones.
    */
   void
   cleanCache() const;
 
+  /**
+   * @brief Set the period of the background cache sweeps.
+   * @param period The period in seconds, 0 disables the periodic sweeps
+   */
+  void
+  setSweepPeriod(const unsigned int period);
+
+  /**
+   * @brief Get the period of the background cache sweeps.
+   * @return The period in seconds
+   */
+  unsigned int
+  getSweepPeriod() const;
+
+  /**
+   * @brief Get the cache sweeper counters (last sweep duration, probed
+   * and evicted objects).
+   * @return The counters
+   */
+  CacheSweeper::Stats
+  getSweepStats() const;
+
+  /**
+   * @brief Set the validity lease of the objects cached for a context.
+   * Cache hits inside the lease are returned without contacting the object.
+   * A null lease makes every hit check the object with _non_existent().
+   * @param ctxt The context (AGENTCTXT, SEDCTXT, DAGDACTXT...)
+   * @param lease The lease length in seconds
+   */
+  void
+  setCacheLease(const std::string& ctxt, const unsigned int lease);
+
+  /**
+   * @brief Set the validity lease used for contexts without specific lease.
+   * @param lease The lease length in seconds
+   */
+  void
+  setCacheLease(const unsigned int lease);
+
+  /**
+   * @brief Get the validity lease of the objects cached for a context.
+   * @param ctxt The context
+   * @return The lease length in seconds
+   */
+  unsigned int
+  getCacheLease(const std::string& ctxt) const;
+
+  /**
+   * @brief Set how long a name not found in the naming service is reported
+   * missing without asking the naming service again. Binding the name in
+   * this process ends it at once.
+   * @param lease The time in seconds, 0 disables the negative cache
+   */
+  void
+  setNotFoundLease(const unsigned int lease);
+
+  /**
+   * @brief Get how long a name not found is reported missing.
+   * @return The time in seconds
+   */
+  unsigned int
+  getNotFoundLease() const;
+
+  /**
+   * @brief Get the retry policy applied to the failed calls, to tune it or
+   *   to read its counters per endpoint.
+   * @return The retry policy
+   */
+  RetryPolicy&
+  getRetryPolicy() const;
+
   /**
    * @brief Translate the string passed as first argument in bytes and
    * record them into the buffer.
@@ -456,6 +633,13 @@ private:
   void
   init(CORBA::ORB_ptr ORB);
 
+  /**
+   * @brief Setup shared by the constructors: the logger, the sweeper
+   *   callbacks and the exception handlers.
+   */
+  void
+  setup();
+
   /**
    * @brief Handler for sigint signal interception
    * @param sig The received signal
@@ -463,6 +647,359 @@ private:
   static void
   sigIntHandler(int sig);
 
+  /**
+   * @brief Get the root naming context. It is resolved and validated once,
+   * then kept until resetNamingContexts() is called.
+   * @return The root naming context
+   */
+  CosNaming::NamingContext_ptr
+  rootContext() const;
+
+  /**
+   * @brief Get the naming context of a context name. The resolved contexts
+   * are cached until resetNamingContexts() is called.
+   * @param ctxt The context name
+   * @param create Create the context if it does not exist
+   * @return The naming context
+   * @throw CosNaming::NamingContext::NotFound if the context does not exist
+   *   and create is false
+   */
+  CosNaming::NamingContext_ptr
+  namingContext(const std::string& ctxt, const bool create = false) const;
+
+  /**
+   * @brief Forget the root and the cached naming contexts, they will be
+   * acquired again on next use.
+   */
+  void
+  resetNamingContexts() const;
+
+  /**
+   * @brief Resolve a name in a context without object caching, acquiring
+   * again the naming contexts once if they are stale.
+   * @param ctxt The context name
+   * @param name The name of the object
+   * @return The object
+   */
+  CORBA::Object_ptr
+  resolveName(const std::string& ctxt, const std::string& name) const;
+
+  /**
+   * @brief List the names binded in a naming context. The bindings are
+   *   pulled in growing chunks and the iterator is destroyed at the end.
+   * @param ctxt The naming context
+   * @param type The type of the bindings to keep
+   * @return The names of the bindings
+   */
+  std::vector<std::string>
+  listNames(CosNaming::NamingContext_ptr ctxt,
+            const CosNaming::BindingType type) const;
+
+  /**
+   * @brief Resolve a set of names of a naming context. The requests are
+   *   sent deferred, a window of them being in flight at the same time.
+   *   The names no longer binded are skipped.
+   * @param ctxt The naming context
+   * @param names The names to resolve
+   * @return The bindings (name, object)
+   */
+  std::vector<Binding>
+  resolveNames(CosNaming::NamingContext_ptr ctxt,
+               const std::vector<std::string>& names) const;
+
+  /**
+   * @brief Identify a leased cache entry for the exception handlers
+   * installed on the cached objects. A cookie is never changed: caching
+   * an object again gives it a new cookie.
+   */
+  struct CacheCookie {
+    /** @brief The context as passed to resolveObject */
+    std::string context;
+    std::string name;
+    std::string fwdName;
+    /** @brief The object endpoint ("host:port") */
+    std::string endpoint;
+    /** @brief Is the object leased? */
+    bool leased;
+  };
+
+  /**
+   * @brief Check whether a name was recently not found.
+   * @param key The name ("context/name")
+   * @return true if the name is known to be missing
+   */
+  bool
+  isNotFound(const std::string& key) const;
+
+  /**
+   * @brief Remember that a name was not found.
+   * @param key The name ("context/name")
+   */
+  void
+  setNotFound(const std::string& key) const;
+
+  /**
+   * @brief Forget that a name was not found, after it was binded.
+   * @param key The name ("context/name")
+   */
+  void
+  clearNotFound(const std::string& key) const;
+
+  /**
+   * @brief Put an object in the cache and start its lease.
+   * @param context The context as passed to resolveObject
+   * @param ctxt The context of the object
+   * @param name The name of the object
+   * @param fwdName The name of the forwarder used to resolve it
+   * @param object The object
+   * @return The endpoint of the object
+   */
+  std::string
+  cacheObject(const std::string& context, const std::string& ctxt,
+              const std::string& name, const std::string& fwdName,
+              CORBA::Object_ptr object) const;
+
+  /**
+   * @brief Shared state of a broadcast to the forwarders.
+   */
+  class FwdsBroadcast;
+  /**
+   * @brief Bind or unbind on one forwarder, run by the broadcast pool.
+   */
+  class FwdTask;
+
+  /**
+   * @brief Send a bind or an unbind to all the other forwarders.
+   * @param ctxt The context to use
+   * @param name The name of the object
+   * @param ior The IOR of the object, empty for an unbind
+   * @param fwName The name of the calling forwarder
+   * @param wait Wait for the first attempt on every forwarder
+   * @return The outcome per forwarder
+   */
+  FwdResults
+  fwdsBroadcast(const std::string& ctxt, const std::string& name,
+                const std::string& ior, const std::string& fwName,
+                const bool wait) const;
+
+  /**
+   * @brief Get the broadcast worker pool, created on first use.
+   * @return The pool
+   */
+  WorkerPool*
+  fwdsPool() const;
+
+  /**
+   * @brief The fields of an IOR used by the manager.
+   */
+  struct ParsedIOR {
+    /** @brief The host of the first profile, or '@' and a forwarder name */
+    std::string host;
+    unsigned int port;
+    std::string typeId;
+  };
+
+  /**
+   * @brief A parsed IOR with its object.
+   */
+  struct ParsedIOREntry {
+    CORBA::Object_var object;
+    ParsedIOR parsed;
+  };
+
+  /**
+   * @brief Get the parsed IOR of an object. The IORs are parsed once and
+   *   cached by object identity (hash then equivalence of the references).
+   * @param object The object
+   * @param strIOR The stringified IOR of the object if the caller has it,
+   *   saving its computation on a cache miss
+   * @return The parsed fields
+   */
+  ParsedIOR
+  parseIOR(CORBA::Object_ptr object, const std::string& strIOR = "") const;
+
+  /**
+   * @brief Where a binded object lives, as parsed from its IOR.
+   */
+  struct HostEntry {
+    /** @brief The host, or '@' and the forwarder name */
+    std::string host;
+    unsigned int port;
+  };
+
+  /**
+   * @brief The host index of a context.
+   */
+  struct HostIndex {
+    std::map<std::string, HostEntry> entries;
+    /** @brief When the index was filled from the naming service */
+    time_t filled;
+    /** @brief Set when other forwarders changed the context bindings */
+    bool stale;
+  };
+
+  /**
+   * @brief Make sure the host index of a context is filled and recent,
+   *   listing the context in bulk if needed.
+   * @param ctxt The context
+   */
+  void
+  refreshHostIndex(const std::string& ctxt) const;
+
+  /**
+   * @brief Update the host index of a context after a bind.
+   * @param ctxt The context
+   * @param name The name of the object
+   * @param object The object
+   */
+  void
+  indexObject(const std::string& ctxt, const std::string& name,
+              CORBA::Object_ptr object) const;
+
+  /**
+   * @brief Mark the host index of a context as stale.
+   * @param ctxt The context
+   */
+  void
+  invalidateHostIndex(const std::string& ctxt) const;
+
+  /**
+   * @brief Evict a leased object after a failed call and resolve it again.
+   * @param cookie The cache entry identification
+   * @return true if the failed call should be retried
+   */
+  bool
+  refreshCachedObject(const CacheCookie& cookie) const;
+
+  /**
+   * @brief Get a copy of the cookie of a cached object.
+   * @param id The cookie id, given to the exception handlers
+   * @param cookie The copy of the cookie, if found
+   * @return false if the object was evicted from the cache since
+   */
+  bool
+  findCookie(const unsigned long id, CacheCookie& cookie) const;
+
+  /**
+   * @brief Remove an object from the cache with its cookie, if the cache
+   *   still holds it.
+   * @param key The object key ("context/name")
+   * @param object The object
+   */
+  void
+  evictObject(const std::string& key, CORBA::Object_ptr object) const;
+
+  /**
+   * @brief Drop the cookie of an evicted object.
+   * @param key The object key ("context/name")
+   */
+  void
+  dropCookie(const std::string& key) const;
+
+  /**
+   * @brief Drop the cookies of the objects evicted by the sweeps.
+   */
+  void
+  purgeCookies() const;
+
+  /**
+   * @brief Account a failed call on a cached object and tell whether to
+   *   retry it, evicting a leased object on the first failure.
+   * @param cookie The cookie id given to the exception handlers
+   * @param retries The number of retries already made
+   * @param failure The failure, for the log
+   * @return true if the call should be retried
+   */
+  bool
+  retryObjectCall(void* cookie, const CORBA::ULong retries,
+                  const std::string& failure) const;
+
+  /**
+   * @brief Log the counters of a background cache sweep.
+   * @param stats The counters
+   * @param mgr The ORB manager
+   */
+  static void
+  sweepReport(const CacheSweeper::Stats& stats, void* mgr);
+
+  /**
+   * @brief Log the counters of the retry policy, per endpoint.
+   */
+  void
+  retryReport() const;
+
+  /**
+   * @brief Tell the sweeper about the objects of this process.
+   * @param object The object
+   * @param active Set to the activation state of a local object
+   * @param mgr The ORB manager
+   * @return true if the object is served by this process
+   */
+  static bool
+  sweepLocalCheck(CORBA::Object_ptr object, bool& active, void* mgr);
+
+  /**
+   * @brief Get the endpoint ("host:port") of an object.
+   * @param object The object
+   * @return The endpoint, empty if the IOR can not be parsed
+   */
+  std::string
+  getEndpoint(CORBA::Object_ptr object) const;
+
+  /**
+   * @brief Check that calls to an endpoint are allowed by the retry policy.
+   * When the endpoint circuit is half-open, the object is probed.
+   * @param object The object about to be called
+   * @param endpoint The object endpoint
+   * @throw CORBA::TRANSIENT if the endpoint is down
+   */
+  void
+  admitCall(CORBA::Object_ptr object, const std::string& endpoint) const;
+
+  /**
+   * @brief Account a failed call and wait before retrying it, as decided by
+   *   the retry policy. The wait is capped: it holds the calling thread.
+   * @param endpoint The endpoint of the call, empty if unknown
+   * @param retries The number of retries already done
+   * @param failure The kind of failure, for the log
+   * @return true if the call should be retried
+   */
+  bool
+  retryCall(const std::string& endpoint, const CORBA::ULong retries,
+            const std::string& failure) const;
+
+  /**
+   * @brief Handler for TRANSIENT exceptions.
+   * @param cookie The ORB manager
+   */
+  static CORBA::Boolean
+  transientHandler(void* cookie, CORBA::ULong retries,
+                   const CORBA::TRANSIENT& ex);
+
+  /**
+   * @brief Handler for COMM_FAILURE exceptions.
+   * @param cookie The ORB manager
+   */
+  static CORBA::Boolean
+  commFailureHandler(void* cookie, CORBA::ULong retries,
+                     const CORBA::COMM_FAILURE& ex);
+
+  /**
+   * @brief Handler for TRANSIENT exceptions on cached objects.
+   * @param cookie The cache entry identification
+   */
+  static CORBA::Boolean
+  objectTransientHandler(void* cookie, CORBA::ULong retries,
+                         const CORBA::TRANSIENT& ex);
+
+  /**
+   * @brief Handler for COMM_FAILURE exceptions on cached objects.
+   * @param cookie The cache entry identification
+   */
+  static CORBA::Boolean
+  objectCommFailureHandler(void* cookie, CORBA::ULong retries,
+                           const CORBA::COMM_FAILURE& ex);
+
   /**
    * @brief The omniORB Object Request Broker for this manager.
    */
@@ -471,25 +1008,137 @@ private:
    * @brief The Portable Object Adaptor.
    */
   PortableServer::POA_var mPOA;
+  /**
+   * @brief The POA current, giving the target of the request being served.
+   */
+  PortableServer::Current_var mcurrent;
 
   /**
    * @brief Is the ORB down?
    */
   bool mdown;
 
+  /**
+   * @brief The root naming context.
+   */
+  mutable CosNaming::NamingContext_var mrootContext;
+  /**
+   * @brief The naming contexts already resolved (dietAgent, dietSeD...).
+   */
+  mutable std::map<std::string, CosNaming::NamingContext_var> mcontexts;
+  /**
+   * @brief Naming contexts mutex.
+   */
+  mutable omni_mutex mcontextsMutex;
+
+  /**
+   * @brief Host index of the binded objects, per context.
+   */
+  mutable std::map<std::string, HostIndex> mhostIndex;
+  /**
+   * @brief Host index mutex.
+   */
+  mutable omni_mutex mhostIndexMutex;
+
+  /**
+   * @brief Parsed IORs per object hash.
+   */
+  mutable std::map<CORBA::ULong, std::list<ParsedIOREntry> > miors;
+  /**
+   * @brief Number of parsed IORs in miors.
+   */
+  mutable size_t mnbIORs;
+  /**
+   * @brief Parsed IORs mutex.
+   */
+  mutable omni_mutex miorsMutex;
+
   /**
    * @brief Object cache to avoid to contact OmniNames too many times.
    */
-  mutable std::map<std::string, CORBA::Object_ptr> mcache;
+  mutable ObjectCache mcache;
+  /**
+   * @brief Cookies of the cached objects, per id. The exception handlers
+   * of an object are given the id of its cookie: the object can outlive
+   * its cache entry, its id is then unknown.
+   */
+  mutable std::map<unsigned long, CacheCookie> mcookies;
+  /**
+   * @brief The cookie id of each cached object, per key.
+   */
+  mutable std::map<std::string, unsigned long> mcookieIds;
+  mutable unsigned long mnextCookie;
+  /**
+   * @brief Lease length of the cached objects per context.
+   */
+  std::map<std::string, unsigned int> mleases;
+  /**
+   * @brief Lease length for the contexts not in mleases.
+   */
+  unsigned int mdefaultLease;
   /**
-   * @brief Cache mutex.
+   * @brief Cookies and leases mutex.
    */
   mutable omni_mutex mcacheMutex;
 
+  /**
+   * @brief End of the not found lease of the recently missing names.
+   */
+  mutable std::map<std::string, time_t> mnotFound;
+  /**
+   * @brief Length of the not found leases.
+   */
+  unsigned int mnotFoundLease;
+  /**
+   * @brief Not found names mutex.
+   */
+  mutable omni_mutex mnotFoundMutex;
+
+  /**
+   * @brief Retry policy of the exception handlers.
+   */
+  mutable RetryPolicy mretryPolicy;
+
+  /**
+   * @brief Sweeper of the cache, also renewing the leases.
+   */
+  mutable CacheSweeper msweeper;
+
+  /**
+   * @brief Workers for the broadcasts to the forwarders.
+   */
+  mutable WorkerPool* mfwdsPool;
+  /**
+   * @brief Broadcast pool creation mutex.
+   */
+  mutable omni_mutex mfwdsPoolMutex;
+
+  /**
+   * @brief Is the endpoint of the references of this process known?
+   */
+  mutable bool mlocalKnown;
+  /**
+   * @brief The endpoint of the references of this process.
+   */
+  mutable std::string mlocalEndpoint;
+  /**
+   * @brief The proxy POAs created by the manager.
+   */
+  mutable std::list<PortableServer::POA_var> mproxyPOAs;
+  /**
+   * @brief Local endpoint and proxy POAs mutex.
+   */
+  mutable omni_mutex mlocalMutex;
+
   /**
    * @brief The manager instance.
    */
   static ORBMgr* theMgr;
+  /**
+   * @brief The manager of the exception handlers of the cached objects,
+   *   the last one built.
+   */
+  static ORBMgr* theHandlerMgr;
 
   /**
    * @brief Logger to send all log messages
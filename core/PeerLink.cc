@@ -0,0 +1,242 @@
+/**
+ * @file PeerLink.cc
+ *
+ * @brief  Link between a forwarder and one of its peers
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "PeerLink.hh"
+
+PeerLink::Call::Call(PeerLink& link, const CallClass callClass,
+                     const bool wait, CallGate* classGate)
+  : mlink(&link), mentered(false), mclassGate(NULL) {
+  if (!(wait ? link.gate().enter() : link.gate().tryEnter())) {
+    throw CORBA::TRANSIENT(0, CORBA::COMPLETED_NO);
+  }
+  mentered = true;
+  if (classGate != NULL) {
+    if (!(wait ? classGate->enter() : classGate->tryEnter())) {
+      link.gate().leave();
+      throw CORBA::TRANSIENT(0, CORBA::COMPLETED_NO);
+    }
+    mclassGate = classGate;
+  }
+  link.peer(callClass, mpeer, mrelay);
+}
+
+PeerLink::Call::Call(const Call& other)
+  : mlink(other.mlink), mentered(other.mentered),
+    mclassGate(other.mclassGate), mpeer(other.mpeer), mrelay(other.mrelay) {
+  other.mlink = NULL;
+  other.mclassGate = NULL;
+}
+
+PeerLink::Call::~Call() {
+  if (mlink && mentered) {
+    mlink->gate().leave();
+  }
+  if (mclassGate != NULL) {
+    mclassGate->leave();
+  }
+}
+
+Forwarder_ptr
+PeerLink::Call::operator->() const {
+  return mpeer.in();
+}
+
+CORBA::Object_ptr
+PeerLink::Call::relay() const {
+  if (CORBA::is_nil(mrelay)) {
+    return mpeer.in();
+  }
+  return mrelay.in();
+}
+
+bool
+PeerLink::Call::supports(const Feature feature) const {
+  if (mlink == NULL) {
+    return false;
+  }
+  return mlink->supports(feature, mpeer.in());
+}
+
+void
+PeerLink::Call::refresh(const CallClass callClass) {
+  if (mlink != NULL) {
+    mlink->peer(callClass, mpeer, mrelay);
+  }
+}
+
+void
+PeerLink::Call::leave() {
+  if (mlink != NULL && mentered) {
+    mlink->gate().leave();
+    mentered = false;
+  }
+}
+
+void
+PeerLink::Call::enter() {
+  if (mlink != NULL && !mentered) {
+    if (!mlink->gate().enter()) {
+      throw CORBA::TRANSIENT(0, CORBA::COMPLETED_NO);
+    }
+    mentered = true;
+  }
+}
+
+PeerLink::PeerLink(const std::string& name, Forwarder_ptr peer,
+                   CORBA::Object_ptr relay)
+  : mname(name), mreserved(1), mnextControl(0), mnextBulk(0) {
+  for (int i = 0; i < FEATURE_COUNT; ++i) {
+    msupport[i] = SUPPORT_UNKNOWN;
+  }
+  mstripes.push_back(Forwarder::_duplicate(peer));
+  mrelays.push_back(CORBA::Object::_duplicate(relay));
+}
+
+const std::string&
+PeerLink::name() const {
+  return mname;
+}
+
+Forwarder_var
+PeerLink::peer(const CallClass callClass) {
+  Forwarder_var result;
+  CORBA::Object_var relay;
+
+  peer(callClass, result, relay);
+  return result;
+}
+
+void
+PeerLink::peer(const CallClass callClass, Forwarder_var& peer,
+               CORBA::Object_var& relay) {
+  unsigned int count, reserved, index;
+
+  mmutex.lock();
+  count = mstripes.size();
+  if (count == 1) {
+    index = 0;
+  } else {
+    reserved = mreserved;
+    if (reserved == 0) {
+      reserved = 1;
+    } else if (reserved >= count) {
+      reserved = count - 1;
+    }
+    if (callClass == BULK_CALL) {
+      index = reserved + (mnextBulk++ % (count - reserved));
+    } else {
+      index = mnextControl++ % reserved;
+    }
+  }
+  peer = Forwarder::_duplicate(mstripes[index]);
+  relay = CORBA::Object::_duplicate(mrelays[index]);
+  mmutex.unlock();
+}
+
+void
+PeerLink::setPeer(Forwarder_ptr peer, CORBA::Object_ptr relay) {
+  mmutex.lock();
+  mstripes.clear();
+  mrelays.clear();
+  mstripes.push_back(Forwarder::_duplicate(peer));
+  mrelays.push_back(CORBA::Object::_duplicate(relay));
+  // The peer may have restarted with another version
+  for (int i = 0; i < FEATURE_COUNT; ++i) {
+    msupport[i] = SUPPORT_UNKNOWN;
+  }
+  mmutex.unlock();
+}
+
+bool
+PeerLink::addStripe(Forwarder_ptr peer, CORBA::Object_ptr relay) {
+  mmutex.lock();
+  // Both sides add the stripes again when the peer reconnects
+  for (unsigned int i = 0; i < mstripes.size(); ++i) {
+    if (mstripes[i]->_is_equivalent(peer)) {
+      mmutex.unlock();
+      return false;
+    }
+  }
+  mstripes.push_back(Forwarder::_duplicate(peer));
+  mrelays.push_back(CORBA::Object::_duplicate(relay));
+  mmutex.unlock();
+  return true;
+}
+
+std::vector<Forwarder_var>
+PeerLink::stripePeers() const {
+  std::vector<Forwarder_var> result;
+
+  mmutex.lock();
+  result = mstripes;
+  mmutex.unlock();
+  return result;
+}
+
+unsigned int
+PeerLink::stripes() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mstripes.size();
+  mmutex.unlock();
+  return result;
+}
+
+void
+PeerLink::setReserved(const unsigned int reserved) {
+  mmutex.lock();
+  mreserved = reserved;
+  mmutex.unlock();
+}
+
+CallGate&
+PeerLink::gate() {
+  return mgate;
+}
+
+bool
+PeerLink::supports(const Feature feature, Forwarder_ptr peer) {
+  Support support;
+  bool supported;
+
+  mmutex.lock();
+  support = msupport[feature];
+  mmutex.unlock();
+  if (support != SUPPORT_UNKNOWN) {
+    return support == SUPPORTED;
+  }
+
+  // Asked out of the mutex, concurrent calls may ask twice
+  try {
+    switch (feature) {
+    case OCTET_TRANSFERS:
+      supported = peer->octetTransfers();
+      break;
+    case STREAM_TRANSFERS:
+      supported = peer->streamTransfers();
+      break;
+    case RESUMABLE_STREAMS:
+      supported = peer->resumableStreams();
+      break;
+    case DEDUP_TRANSFERS:
+      supported = peer->dedupTransfers();
+      break;
+    default:
+      supported = false;
+    }
+  } catch (CORBA::BAD_OPERATION&) {
+    // A peer older than the feature
+    supported = false;
+  }
+  mmutex.lock();
+  msupport[feature] = supported ? SUPPORTED : UNSUPPORTED;
+  mmutex.unlock();
+  return supported;
+}
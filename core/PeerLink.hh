@@ -0,0 +1,301 @@
+/**
+ * @file PeerLink.hh
+ *
+ * @brief  Link between a forwarder and one of its peers
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef PEERLINK_HH
+#define PEERLINK_HH
+
+#include <string>
+#include <vector>
+#include <omnithread.h>
+#include "Forwarder.hh"
+#include "utils/CallGate.hh"
+
+/**
+ * @brief A peer forwarder and the gate bounding the calls made to it. Each
+ * peer has its own link, so that a slow peer only holds the threads of its
+ * own calls.
+ * A link may have several stripes: references to the peer through distinct
+ * endpoints, each one with its own connections (its own ssh tunnel). The
+ * first stripes are reserved to the control calls, the bulk calls are
+ * spread over the others.
+ * @class PeerLink
+ */
+class PeerLink {
+public:
+  /**
+   * @brief Kind of call, choosing the stripes used.
+   */
+  enum CallClass {
+    /** @brief Short, latency sensitive call */
+    CONTROL_CALL,
+    /** @brief Call carrying or waiting for a data transfer */
+    BULK_CALL
+  };
+
+  /**
+   * @brief Features that the peer may lack, when it is older.
+   */
+  enum Feature {
+    /** @brief The Dagda transfers as octets */
+    OCTET_TRANSFERS,
+    /** @brief The streamed Dagda transfers */
+    STREAM_TRANSFERS,
+    /** @brief The resumed recordData streams */
+    RESUMABLE_STREAMS,
+    /** @brief The chunks of the streams taken from a store */
+    DEDUP_TRANSFERS,
+    FEATURE_COUNT
+  };
+
+  /**
+   * @brief A call in progress through a link: holds a slot of the link
+   * gate until its destruction. Used as a temporary, the slot is released
+   * once the call made through operator-> returns.
+   * @class Call
+   */
+  class Call {
+  public:
+    /**
+     * @brief Constructor, takes a slot of the link gate.
+     * @param link The link
+     * @param callClass The kind of call
+     * @param wait Wait for a slot (true), or give up if none is free
+     * @param classGate A gate counting the calls of the class, entered
+     *   after the link gate, NULL for none
+     * @throw CORBA::TRANSIENT if a gate refuses the call
+     */
+    explicit Call(PeerLink& link, const CallClass callClass = CONTROL_CALL,
+                  const bool wait = true, CallGate* classGate = NULL);
+
+    /**
+     * @brief Copy constructor, the copy takes over the slot.
+     * @param other The copied call
+     */
+    Call(const Call& other);
+
+    /**
+     * @brief Destructor, releases the slot.
+     */
+    ~Call();
+
+    /**
+     * @brief Access the peer.
+     * @return The peer forwarder
+     */
+    Forwarder_ptr
+    operator->() const;
+
+    /**
+     * @brief Get the relay of the peer, to send it a request as it was
+     *   received.
+     * @return The relay, the peer forwarder itself if it has none
+     */
+    CORBA::Object_ptr
+    relay() const;
+
+    /**
+     * @brief Does the peer support a feature?
+     * @param feature The feature
+     * @return true if the operations of the feature may be called
+     */
+    bool
+    supports(const Feature feature) const;
+
+    /**
+     * @brief Get the peer again from the link, after it reconnected. The
+     *   slot is kept.
+     * @param callClass The kind of call
+     */
+    void
+    refresh(const CallClass callClass);
+
+    /**
+     * @brief Release the slot before waiting, without ending the call.
+     */
+    void
+    leave();
+
+    /**
+     * @brief Take a slot again, after leave().
+     * @throw CORBA::TRANSIENT if the link refuses the call
+     */
+    void
+    enter();
+
+  private:
+    Call&
+    operator=(const Call&);
+
+    /**
+     * @brief The link, NULL once the slot was taken over by a copy.
+     */
+    mutable PeerLink* mlink;
+    /**
+     * @brief Is a slot held?
+     */
+    bool mentered;
+    /**
+     * @brief The gate of the class of the call, NULL for none or once
+     * taken over by a copy.
+     */
+    mutable CallGate* mclassGate;
+    /**
+     * @brief The peer.
+     */
+    Forwarder_var mpeer;
+    /**
+     * @brief The relay of the peer, nil if it has none.
+     */
+    CORBA::Object_var mrelay;
+  };
+
+  /**
+   * @brief Constructor
+   * @param name The peer name
+   * @param peer The peer forwarder
+   * @param relay The relay of the peer, nil if it has none
+   */
+  PeerLink(const std::string& name, Forwarder_ptr peer,
+           CORBA::Object_ptr relay);
+
+  /**
+   * @brief Get the peer name.
+   * @return The peer name
+   */
+  const std::string&
+  name() const;
+
+  /**
+   * @brief Get the peer forwarder, through the next stripe of a kind of
+   *   call.
+   * @param callClass The kind of call
+   * @return The peer forwarder
+   */
+  Forwarder_var
+  peer(const CallClass callClass = CONTROL_CALL);
+
+  /**
+   * @brief Get the peer forwarder and its relay, through the next stripe
+   *   of a kind of call.
+   * @param callClass The kind of call
+   * @param peer The peer forwarder
+   * @param relay The relay of the peer, nil if it has none
+   */
+  void
+  peer(const CallClass callClass, Forwarder_var& peer,
+       CORBA::Object_var& relay);
+
+  /**
+   * @brief Replace the peer forwarder, when the peer reconnects. The
+   *   other stripes are dropped, to be added again.
+   * @param peer The new peer forwarder
+   * @param relay The relay of the peer, nil if it has none
+   */
+  void
+  setPeer(Forwarder_ptr peer, CORBA::Object_ptr relay);
+
+  /**
+   * @brief Add a stripe to the link.
+   * @param peer The peer forwarder, through the stripe endpoint
+   * @param relay The relay of the peer, through the stripe endpoint
+   * @return false if the link already has the stripe
+   */
+  bool
+  addStripe(Forwarder_ptr peer, CORBA::Object_ptr relay);
+
+  /**
+   * @brief Get the peer forwarder through each stripe.
+   * @return The references, the first one given to setPeer
+   */
+  std::vector<Forwarder_var>
+  stripePeers() const;
+
+  /**
+   * @brief Get the number of stripes.
+   * @return The number of stripes
+   */
+  unsigned int
+  stripes() const;
+
+  /**
+   * @brief Set the number of stripes reserved to the control calls. At
+   *   least one stripe is reserved, and one is left to the bulk calls
+   *   when there are several.
+   * @param reserved The number of reserved stripes
+   */
+  void
+  setReserved(const unsigned int reserved);
+
+  /**
+   * @brief Get the gate of the link.
+   * @return The call gate
+   */
+  CallGate&
+  gate();
+
+  /**
+   * @brief Does the peer support a feature? The peer is asked once, the
+   *   answer is kept until it reconnects.
+   * @param feature The feature
+   * @param peer The peer forwarder, asked if the answer is not known
+   * @return true if the operations of the feature may be called
+   */
+  bool
+  supports(const Feature feature, Forwarder_ptr peer);
+
+private:
+  /**
+   * @brief The support of a feature by the peer.
+   */
+  enum Support {
+    SUPPORT_UNKNOWN,
+    SUPPORTED,
+    UNSUPPORTED
+  };
+
+  PeerLink(const PeerLink&);
+  PeerLink&
+  operator=(const PeerLink&);
+
+  /**
+   * @brief The peer name.
+   */
+  std::string mname;
+  /**
+   * @brief The peer forwarder, through each stripe.
+   */
+  std::vector<Forwarder_var> mstripes;
+  /**
+   * @brief The relay of the peer, through each stripe.
+   */
+  std::vector<CORBA::Object_var> mrelays;
+  /**
+   * @brief Number of stripes reserved to the control calls.
+   */
+  unsigned int mreserved;
+  /**
+   * @brief Next stripe for each kind of call, round robin.
+   */
+  unsigned int mnextControl;
+  unsigned int mnextBulk;
+  /**
+   * @brief The support of each feature by the peer.
+   */
+  Support msupport[FEATURE_COUNT];
+  /**
+   * @brief Protects the stripes and the features support.
+   */
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Bounds the calls in progress through the link.
+   */
+  CallGate mgate;
+};
+
+#endif
@@ -0,0 +1,17 @@
+/**
+ * @file ProxyServant.cc
+ *
+ * @brief  Base of the forwarder proxy servants
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "ProxyServant.hh"
+
+#include "ORBMgr.hh"
+
+CORBA::String_var
+ProxyServant::objName() const {
+  return ORBMgr::getMgr()->currentObjectId();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file ProxyServant.hh
+ *
+ * @brief  Base of the forwarder proxy servants
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef PROXYSERVANT_HH
+#define PROXYSERVANT_HH
+
+#include <omniORB4/CORBA.h>
+#include "Forwarder.hh"
+
+/**
+ * @brief Base of the servants forwarding the calls made on remote objects.
+ * A proxy servant is the default servant of a forwarder POA: it serves all
+ * the objects of an interface, the name of the remote object being the
+ * identifier of the object targeted by the request.
+ * @class ProxyServant
+ */
+class ProxyServant {
+protected:
+  /**
+   * @brief Return the name of the object targeted by the current request.
+   * @return The object name
+   */
+  CORBA::String_var
+  objName() const;
+};
+
+/**
+ * @brief Create a proxy servant.
+ * @param fwdr The forwarder the servant calls
+ * @return The servant
+ */
+template <class Servant>
+PortableServer::ServantBase*
+newProxyServant(Forwarder_ptr fwdr) {
+  return new Servant(fwdr);
+}
+
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file RelayServant.cc
+ *
+ * @brief  Dynamic servant relaying the requests without decoding them
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "RelayServant.hh"
+
+#include "ORBMgr.hh"
+
+RelaySignature::RelaySignature()
+  : mresult(CORBA::_tc_void), moneway(false), mbulk(false) {
+}
+
+RelaySignature&
+RelaySignature::in(CORBA::TypeCode_ptr type) {
+  marguments.push_back(std::make_pair(type, CORBA::Flags(CORBA::ARG_IN)));
+  return *this;
+}
+
+RelaySignature&
+RelaySignature::inout(CORBA::TypeCode_ptr type) {
+  marguments.push_back(std::make_pair(type, CORBA::Flags(CORBA::ARG_INOUT)));
+  return *this;
+}
+
+RelaySignature&
+RelaySignature::returns(CORBA::TypeCode_ptr type) {
+  mresult = type;
+  return *this;
+}
+
+RelaySignature&
+RelaySignature::raises(CORBA::TypeCode_ptr type) {
+  mexceptions.push_back(type);
+  return *this;
+}
+
+RelaySignature&
+RelaySignature::oneway() {
+  moneway = true;
+  return *this;
+}
+
+RelaySignature&
+RelaySignature::bulk() {
+  mbulk = true;
+  return *this;
+}
+
+CORBA::NVList_ptr
+RelaySignature::arguments(const bool named) const {
+  std::vector<std::pair<CORBA::TypeCode_ptr, CORBA::Flags> >::const_iterator
+    it;
+  CORBA::NVList_ptr result =
+    ORBMgr::getMgr()->createList(marguments.size() + (named ? 1 : 0));
+
+  // Empty values of the arguments types: the request is read in them
+  for (it = marguments.begin(); it != marguments.end(); ++it) {
+    CORBA::Any value;
+    value.replace(it->first, 0);
+    result->add_value("", value, it->second);
+  }
+  if (named) {
+    CORBA::Any value;
+    value.replace(CORBA::_tc_string, 0);
+    result->add_value("", value, CORBA::ARG_IN);
+  }
+  return result;
+}
+
+CORBA::ULong
+RelaySignature::size() const {
+  return marguments.size();
+}
+
+CORBA::TypeCode_ptr
+RelaySignature::result() const {
+  return mresult;
+}
+
+const std::vector<CORBA::TypeCode_ptr>&
+RelaySignature::exceptions() const {
+  return mexceptions;
+}
+
+bool
+RelaySignature::isOneway() const {
+  return moneway;
+}
+
+bool
+RelaySignature::isBulk() const {
+  return mbulk;
+}
+
+
+RelayServant::RelayServant(const char* repoId, const bool named)
+  : mrepoId(repoId), mnamed(named) {
+}
+
+void
+RelayServant::invoke(CORBA::ServerRequest_ptr request) {
+  std::map<std::string, RelaySignature>::const_iterator it;
+
+  it = mtable.find(request->operation());
+  if (it == mtable.end()) {
+    throw CORBA::BAD_OPERATION(0, CORBA::COMPLETED_NO);
+  }
+  // The request takes the ownership of the list
+  CORBA::NVList_ptr args = it->second.arguments(mnamed);
+  request->arguments(args);
+  relay(request, it->second, args);
+}
+
+CORBA::RepositoryId
+RelayServant::_primary_interface(const PortableServer::ObjectId& oid,
+                                 PortableServer::POA_ptr poa) {
+  return CORBA::string_dup(mrepoId.c_str());
+}
+
+const char*
+RelayServant::_mostDerivedRepoId() {
+  return mrepoId.c_str();
+}
+
+bool
+RelayServant::named() const {
+  return mnamed;
+}
+
+std::string
+RelayServant::objectName(const RelaySignature& signature,
+                         CORBA::NVList_ptr args) const {
+  const char* name = "";
+
+  if (mnamed) {
+    *args->item(signature.size())->value() >>= name;
+  }
+  return name;
+}
+
+void
+RelayServant::forward(CORBA::ServerRequest_ptr request,
+                      const RelaySignature& signature,
+                      CORBA::NVList_ptr args, CORBA::Object_ptr target,
+                      const char* name) const {
+  std::vector<CORBA::TypeCode_ptr>::const_iterator it;
+  CORBA::Request_var call = target->_request(request->operation());
+  CORBA::NVList_ptr callArgs = call->arguments();
+
+  // The values are copied in their marshalled form
+  for (CORBA::ULong i = 0; i < signature.size(); ++i) {
+    CORBA::NamedValue_ptr arg = args->item(i);
+    callArgs->add_value("", *arg->value(), arg->flags());
+  }
+  if (name != NULL) {
+    CORBA::Any value;
+    value <<= name;
+    callArgs->add_value("", value, CORBA::ARG_IN);
+  }
+  call->set_return_type(signature.result());
+  for (it = signature.exceptions().begin();
+       it != signature.exceptions().end(); ++it) {
+    call->exceptions()->add(*it);
+  }
+
+  if (signature.isOneway()) {
+    call->send_oneway();
+    return;
+  }
+  call->invoke();
+
+  CORBA::Exception* error = call->env()->exception();
+  if (error != NULL) {
+    CORBA::UnknownUserException* user =
+      CORBA::UnknownUserException::_downcast(error);
+    if (user != NULL) {
+      request->set_exception(user->exception());
+      return;
+    }
+    error->_raise();
+  }
+
+  for (CORBA::ULong i = 0; i < signature.size(); ++i) {
+    if (args->item(i)->flags() & CORBA::ARG_INOUT) {
+      *args->item(i)->value() = *callArgs->item(i)->value();
+    }
+  }
+  if (signature.result()->kind() != CORBA::tk_void) {
+    request->set_result(call->return_value());
+  }
+}
@@ -0,0 +1,228 @@
+/**
+ * @file RelayServant.hh
+ *
+ * @brief  Dynamic servant relaying the requests without decoding them
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef RELAYSERVANT_HH
+#define RELAYSERVANT_HH
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <omniORB4/CORBA.h>
+
+/**
+ * @brief Signature of an operation: the types of its arguments, result and
+ * user exceptions. This is all a relay needs to read a request and send it
+ * again, without the generated stubs and skeletons.
+ * @class RelaySignature
+ */
+class RelaySignature {
+public:
+  /**
+   * @brief Constructor, for an operation without argument nor result.
+   */
+  RelaySignature();
+
+  /**
+   * @brief Add an "in" argument.
+   * @param type The argument type
+   * @return The signature
+   */
+  RelaySignature&
+  in(CORBA::TypeCode_ptr type);
+
+  /**
+   * @brief Add an "inout" argument.
+   * @param type The argument type
+   * @return The signature
+   */
+  RelaySignature&
+  inout(CORBA::TypeCode_ptr type);
+
+  /**
+   * @brief Set the result type.
+   * @param type The result type
+   * @return The signature
+   */
+  RelaySignature&
+  returns(CORBA::TypeCode_ptr type);
+
+  /**
+   * @brief Add a user exception.
+   * @param type The exception type
+   * @return The signature
+   */
+  RelaySignature&
+  raises(CORBA::TypeCode_ptr type);
+
+  /**
+   * @brief Mark the operation as oneway.
+   * @return The signature
+   */
+  RelaySignature&
+  oneway();
+
+  /**
+   * @brief Mark the operation as a bulk one, carrying or waiting for a
+   * data transfer.
+   * @return The signature
+   */
+  RelaySignature&
+  bulk();
+
+  /**
+   * @brief Create the argument list of a request, the values being empty
+   * values of the argument types.
+   * @param named Add a last "in string" argument, the object name
+   * @return The list
+   */
+  CORBA::NVList_ptr
+  arguments(const bool named) const;
+
+  /**
+   * @brief Get the number of arguments.
+   * @return The number of arguments, without the object name
+   */
+  CORBA::ULong
+  size() const;
+
+  /**
+   * @brief Get the result type.
+   * @return The result type, CORBA::_tc_void if there is no result
+   */
+  CORBA::TypeCode_ptr
+  result() const;
+
+  /**
+   * @brief Get the user exceptions.
+   * @return The exceptions types
+   */
+  const std::vector<CORBA::TypeCode_ptr>&
+  exceptions() const;
+
+  /**
+   * @brief Is the operation oneway?
+   * @return true for a oneway operation
+   */
+  bool
+  isOneway() const;
+
+  /**
+   * @brief Is the operation a bulk one?
+   * @return true for a bulk operation
+   */
+  bool
+  isBulk() const;
+
+private:
+  /**
+   * @brief The arguments types and modes.
+   */
+  std::vector<std::pair<CORBA::TypeCode_ptr, CORBA::Flags> > marguments;
+  /**
+   * @brief The user exceptions types.
+   */
+  std::vector<CORBA::TypeCode_ptr> mexceptions;
+  /**
+   * @brief The result type.
+   */
+  CORBA::TypeCode_ptr mresult;
+  bool moneway;
+  bool mbulk;
+};
+
+/**
+ * @brief Base of the servants relaying the requests made on an interface.
+ * The arguments of a request are read as values of their types, which the
+ * ORB keeps in their marshalled form, and sent again as they are: the data
+ * are copied but neither decoded nor encoded.
+ * A named relay reads the name of the target object in a last argument,
+ * as the forwarders operations do.
+ * @class RelayServant
+ */
+class RelayServant : public PortableServer::DynamicImplementation {
+public:
+  /**
+   * @brief Constructor
+   * @param repoId The repository identifier of the relayed interface
+   * @param named Do the requests end with the object name?
+   */
+  RelayServant(const char* repoId, const bool named);
+
+  /**
+   * @brief Relay a request.
+   * @param request The request
+   */
+  void
+  invoke(CORBA::ServerRequest_ptr request);
+
+  CORBA::RepositoryId
+  _primary_interface(const PortableServer::ObjectId& oid,
+                     PortableServer::POA_ptr poa);
+
+  const char*
+  _mostDerivedRepoId();
+
+protected:
+  /**
+   * @brief Relay a request whose arguments were read.
+   * @param request The request
+   * @param signature The operation signature
+   * @param args The request arguments
+   */
+  virtual void
+  relay(CORBA::ServerRequest_ptr request, const RelaySignature& signature,
+        CORBA::NVList_ptr args) = 0;
+
+  /**
+   * @brief Do the requests end with the object name?
+   * @return true for a named relay
+   */
+  bool
+  named() const;
+
+  /**
+   * @brief Return the object name ending the arguments of a named request.
+   * @param signature The operation signature
+   * @param args The request arguments
+   * @return The object name
+   */
+  std::string
+  objectName(const RelaySignature& signature, CORBA::NVList_ptr args) const;
+
+  /**
+   * @brief Send a request to its target and set its outcome.
+   * @param request The request
+   * @param signature The operation signature
+   * @param args The request arguments
+   * @param target The object receiving the request
+   * @param name The object name added as last argument, NULL for none
+   */
+  void
+  forward(CORBA::ServerRequest_ptr request, const RelaySignature& signature,
+          CORBA::NVList_ptr args, CORBA::Object_ptr target,
+          const char* name) const;
+
+  /**
+   * @brief The relayed operations, filled by the derived classes.
+   */
+  std::map<std::string, RelaySignature> mtable;
+
+private:
+  /**
+   * @brief The repository identifier of the relayed interface.
+   */
+  std::string mrepoId;
+  /**
+   * @brief Do the requests end with the object name?
+   */
+  bool mnamed;
+};
+
+#endif
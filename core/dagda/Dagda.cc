@@ -12,20 +12,23 @@
 
 #include "CorbaForwarder.hh"
 #include "ORBMgr.hh"
+#include "OctetView.hh"
 #include <string>
 #include <iostream>
+#include <boost/bind.hpp>
 
 
 ::CORBA::Boolean
 CorbaForwarder::lclIsDataPresent(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclIsDataPresent", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclIsDataPresent(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lclIsDataPresent(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -34,14 +37,15 @@ CorbaForwarder::lclIsDataPresent(const char* dataID, const char* objName) {
 
 ::CORBA::Boolean
 CorbaForwarder::lvlIsDataPresent(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lvlIsDataPresent", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlIsDataPresent(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lvlIsDataPresent(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -50,83 +54,126 @@ CorbaForwarder::lvlIsDataPresent(const char* dataID, const char* objName) {
 
 ::CORBA::Boolean
 CorbaForwarder::pfmIsDataPresent(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "pfmIsDataPresent", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmIsDataPresent(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->pfmIsDataPresent(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
   return dagda->pfmIsDataPresent(dataID);
   }
 
-void CorbaForwarder::lclAddData(const char* srcDagda,
-                               const ::corba_data_t& data,
-                               const char* objName) {
-  std::string objString(objName);
+void
+CorbaForwarder::lclAddData(const char* srcDagda,
+                           const ::corba_data_t& data,
+                           const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lclAddData", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclAddData(srcDagda, data, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lclAddDataOctets(srcDagda, octetView(data, view),
+                                    route.peerName());
+    }
+    return peer->lclAddData(srcDagda, data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
-  Dagda_var dagda = ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name,
-                                                                this->mname);
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lclAddDataOctets(srcDagda, octetView(data, view));
+  }
   return dagda->lclAddData(srcDagda, data);
 }
 
 void
 CorbaForwarder::lvlAddData(const char* srcDagda,
-                          const ::corba_data_t& data,
-                          const char* objName) {
-  std::string objString(objName);
+                           const ::corba_data_t& data,
+                           const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lvlAddData", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlAddData(srcDagda, data, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lvlAddDataOctets(srcDagda, octetView(data, view),
+                                    route.peerName());
+    }
+    return peer->lvlAddData(srcDagda, data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lvlAddDataOctets(srcDagda, octetView(data, view));
+  }
   return dagda->lvlAddData(srcDagda, data);
 }
 
 void
 CorbaForwarder::pfmAddData(const char* srcDagda,
-                          const ::corba_data_t& data,
-                          const char* objName) {
-  std::string objString(objName);
+                           const ::corba_data_t& data,
+                           const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "pfmAddData", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmAddData(srcDagda, data, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->pfmAddDataOctets(srcDagda, octetView(data, view),
+                                    route.peerName());
+    }
+    return peer->pfmAddData(srcDagda, data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->pfmAddDataOctets(srcDagda, octetView(data, view));
+  }
   return dagda->pfmAddData(srcDagda, data);
 }
 
 void
 CorbaForwarder::registerFile(const ::corba_data_t& data, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "registerFile", route.remote());
+  stats.received(data.value.length());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->registerFile(data, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->registerFile(data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda = ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name,
                                                                 this->mname);
@@ -139,15 +186,16 @@ CorbaForwarder::lclAddContainerElt(const char* containerID,
                                   ::CORBA::Long index,
                                   ::CORBA::Long flag,
                                   const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclAddContainerElt", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclAddContainerElt(containerID, dataID, index,
-                                         flag, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lclAddContainerElt(containerID, dataID, index,
+                                                flag, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -157,14 +205,15 @@ CorbaForwarder::lclAddContainerElt(const char* containerID,
 ::CORBA::Long
 CorbaForwarder::lclGetContainerSize(const char* containerID,
                                    const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclGetContainerSize", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclGetContainerSize(containerID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lclGetContainerSize(containerID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -177,32 +226,35 @@ CorbaForwarder::lclGetContainerElts(const char* containerID,
                                    ::SeqLong& flagSeq,
                                    ::CORBA::Boolean ordered,
                                    const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclGetContainerElts", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclGetContainerElts(containerID, dataIDSeq,
-                                          flagSeq, ordered,
-                                          objString.c_str());
-  }
-
-  name = getName(objString);
+  if (!route.remote()) {
+    getPeer(route)->lclGetContainerElts(containerID, dataIDSeq, flagSeq,
+                                        ordered, route.peerName());
+  } else {
+    name = route.name();
 
-  Dagda_var dagda =
-    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->lclGetContainerElts(containerID, dataIDSeq, flagSeq, ordered);
+    Dagda_var dagda =
+      ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name,
+                                                  this->mname);
+    dagda->lclGetContainerElts(containerID, dataIDSeq, flagSeq, ordered);
+  }
+  stats.sent(payloadSize(dataIDSeq) + payloadSize(flagSeq));
 }
 
 void
 CorbaForwarder::lclRemData(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclRemData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclRemData(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lclRemData(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -211,14 +263,15 @@ CorbaForwarder::lclRemData(const char* dataID, const char* objName) {
 
 void
 CorbaForwarder::lvlRemData(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lvlRemData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlRemData(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lvlRemData(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -227,14 +280,15 @@ CorbaForwarder::lvlRemData(const char* dataID, const char* objName) {
 
 void
 CorbaForwarder::pfmRemData(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "pfmRemData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmRemData(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->pfmRemData(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -243,152 +297,200 @@ CorbaForwarder::pfmRemData(const char* dataID, const char* objName) {
 
 void
 CorbaForwarder::lclUpdateData(const char* srcDagda,
-                             const ::corba_data_t& data,
-                             const char* objName) {
-  std::string objString(objName);
+                              const ::corba_data_t& data,
+                              const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lclUpdateData", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclUpdateData(srcDagda, data, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lclUpdateDataOctets(srcDagda, octetView(data, view),
+                                       route.peerName());
+    }
+    return peer->lclUpdateData(srcDagda, data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lclUpdateDataOctets(srcDagda, octetView(data, view));
+  }
   return dagda->lclUpdateData(srcDagda, data);
 }
 
 void
 CorbaForwarder::lvlUpdateData(const char* srcDagda,
-                             const ::corba_data_t& data,
-                             const char* objName) {
-  std::string objString(objName);
+                              const ::corba_data_t& data,
+                              const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lvlUpdateData", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlUpdateData(srcDagda, data, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lvlUpdateDataOctets(srcDagda, octetView(data, view),
+                                       route.peerName());
+    }
+    return peer->lvlUpdateData(srcDagda, data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lvlUpdateDataOctets(srcDagda, octetView(data, view));
+  }
   return dagda->lvlUpdateData(srcDagda, data);
 }
 
 void
 CorbaForwarder::pfmUpdateData(const char* srcDagda,
-                             const ::corba_data_t& data,
-                             const char* objName) {
-  std::string objString(objName);
+                              const ::corba_data_t& data,
+                              const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "pfmUpdateData", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmUpdateData(srcDagda, data, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->pfmUpdateDataOctets(srcDagda, octetView(data, view),
+                                       route.peerName());
+    }
+    return peer->pfmUpdateData(srcDagda, data, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->pfmUpdateDataOctets(srcDagda, octetView(data, view));
+  }
   return dagda->pfmUpdateData(srcDagda, data);
 }
 
 SeqCorbaDataDesc_t*
 CorbaForwarder::lclGetDataDescList(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclGetDataDescList", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclGetDataDescList(objString.c_str());
+  if (!route.remote()) {
+    return sent(stats, getPeer(route)->lclGetDataDescList(route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->lclGetDataDescList();
+  return sent(stats, dagda->lclGetDataDescList());
 }
 
 SeqCorbaDataDesc_t*
 CorbaForwarder::lvlGetDataDescList(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lvlGetDataDescList", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlGetDataDescList(objString.c_str());
+  if (!route.remote()) {
+    return sent(stats, getPeer(route)->lvlGetDataDescList(route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->lvlGetDataDescList();
+  return sent(stats, dagda->lvlGetDataDescList());
 }
 
 SeqCorbaDataDesc_t*
 CorbaForwarder::pfmGetDataDescList(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "pfmGetDataDescList", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmGetDataDescList(objString.c_str());
+  if (!route.remote()) {
+    return sent(stats, getPeer(route)->pfmGetDataDescList(route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->pfmGetDataDescList();
+  return sent(stats, dagda->pfmGetDataDescList());
 }
 
 corba_data_desc_t*
 CorbaForwarder::lclGetDataDesc(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclGetDataDesc", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclGetDataDesc(dataID, objString.c_str());
+  if (!route.remote()) {
+    return sent(stats,
+                getPeer(route)->lclGetDataDesc(dataID, route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->lclGetDataDesc(dataID);
+  return sent(stats, dagda->lclGetDataDesc(dataID));
 }
 
 corba_data_desc_t*
 CorbaForwarder::lvlGetDataDesc(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lvlGetDataDesc", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlGetDataDesc(dataID, objString.c_str());
+  if (!route.remote()) {
+    return sent(stats,
+                getPeer(route)->lvlGetDataDesc(dataID, route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda = ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name,
                                                                 this->mname);
-  return dagda->lvlGetDataDesc(dataID);
+  return sent(stats, dagda->lvlGetDataDesc(dataID));
 }
 
 corba_data_desc_t*
 CorbaForwarder::pfmGetDataDesc(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "pfmGetDataDesc", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmGetDataDesc(dataID, objString.c_str());
+  if (!route.remote()) {
+    return sent(stats,
+                getPeer(route)->pfmGetDataDesc(dataID, route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->pfmGetDataDesc(dataID);
+  return sent(stats, dagda->pfmGetDataDesc(dataID));
 }
 
 void
@@ -397,15 +499,22 @@ CorbaForwarder::lclReplicate(const char* dataID,
                             const char* pattern,
                             ::CORBA::Boolean replace,
                             const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::lclReplicate, this,
+                                 CORBA::String_var(dataID), ruleTarget,
+                                 CORBA::String_var(pattern), replace,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lclReplicate", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lclReplicate(dataID, ruleTarget, pattern, replace,
-                                   objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lclReplicate(dataID, ruleTarget, pattern, replace,
+                                          route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -418,15 +527,22 @@ CorbaForwarder::lvlReplicate(const char* dataID,
                             const char* pattern,
                             ::CORBA::Boolean replace,
                             const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::lvlReplicate, this,
+                                 CORBA::String_var(dataID), ruleTarget,
+                                 CORBA::String_var(pattern), replace,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lvlReplicate", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlReplicate(dataID, ruleTarget, pattern, replace,
-                                   objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lvlReplicate(dataID, ruleTarget, pattern, replace,
+                                          route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -439,15 +555,22 @@ CorbaForwarder::pfmReplicate(const char* dataID,
                             const char* pattern,
                             ::CORBA::Boolean replace,
                             const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::pfmReplicate, this,
+                                 CORBA::String_var(dataID), ruleTarget,
+                                 CORBA::String_var(pattern), replace,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "pfmReplicate", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmReplicate(dataID, ruleTarget, pattern, replace,
-                                   objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->pfmReplicate(dataID, ruleTarget, pattern, replace,
+                                          route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -456,59 +579,107 @@ CorbaForwarder::pfmReplicate(const char* dataID,
 
 char*
 CorbaForwarder::writeFile(const ::SeqChar& data,
-                         const char* basename,
-                         ::CORBA::Boolean replace,
-                         const char* objName) {
-  std::string objString(objName);
+                          const char* basename,
+                          ::CORBA::Boolean replace,
+                          const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "writeFile", route.remote());
+  stats.received(data.length());
+  ::SeqOctet view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->writeFile(data, basename, replace, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (streamHop(peer, data.length())) {
+      return streamWriteFile(route, peer, octetView(data, view), basename,
+                             replace);
+    }
+    if (octetHop(peer)) {
+      return peer->writeFileOctets(octetView(data, view), basename, replace,
+                                   route.peerName());
+    }
+    return peer->writeFile(data, basename, replace, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->writeFileOctets(octetView(data, view), basename,
+                                       replace);
+  }
   return dagda->writeFile(data, basename, replace);
 }
 
 char*
 CorbaForwarder::sendFile(const ::corba_data_t& data,
-                        const char* destDagda,
-                        const char* objName) {
-  std::string objString(objName);
+                         const char* destDagda,
+                         const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "sendFile", route.remote());
+  stats.received(data.value.length());
+  ::corba_octet_data_t view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->sendFile(data, destDagda, objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->sendFileOctets(octetView(data, view), destDagda,
+                                  route.peerName());
+    }
+    return peer->sendFile(data, destDagda, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->sendFileOctets(octetView(data, view), destDagda);
+  }
   return dagda->sendFile(data, destDagda);
 }
 
 char*
 CorbaForwarder::recordData(const ::SeqChar& data,
-                          const ::corba_data_desc_t& dataDesc,
-                          ::CORBA::Boolean replace,
-                          ::CORBA::Long offset,
-                          const char* objName) {
-  std::string objString(objName);
+                           const ::corba_data_desc_t& dataDesc,
+                           ::CORBA::Boolean replace,
+                           ::CORBA::Long offset,
+                           const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "recordData", route.remote());
+  stats.received(data.length());
+  ::SeqOctet view;
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->recordData(data, dataDesc, replace, offset,
-                                 objString.c_str());
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (streamHop(peer, data.length())) {
+      return streamRecordData(route, bulk, peer, octetView(data, view),
+                              dataDesc, replace, offset);
+    }
+    if (octetHop(peer)) {
+      return peer->recordDataOctets(octetView(data, view), dataDesc, replace,
+                                    offset, route.peerName());
+    }
+    return peer->recordData(data, dataDesc, replace, offset, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->recordDataOctets(octetView(data, view), dataDesc,
+                                        replace, offset);
+  }
   return dagda->recordData(data, dataDesc, replace, offset);
 }
 
@@ -516,14 +687,16 @@ char*
 CorbaForwarder::sendData(const char* ID,
                         const char* destDagda,
                         const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "sendData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->sendData(ID, destDagda, objString.c_str());
+  if (!route.remote()) {
+    return getBulkPeer(route)->sendData(ID, destDagda, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -535,15 +708,17 @@ CorbaForwarder::sendContainer(const char* ID,
                              const char* destDagda,
                              ::CORBA::Boolean sendElements,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "sendContainer", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->sendContainer(ID, destDagda, sendElements,
-                                    objString.c_str());
+  if (!route.remote()) {
+    return getBulkPeer(route)->sendContainer(ID, destDagda, sendElements,
+                                               route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -552,45 +727,50 @@ CorbaForwarder::sendContainer(const char* ID,
 
 SeqString*
 CorbaForwarder::lvlGetDataManagers(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lvlGetDataManagers", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lvlGetDataManagers(dataID, objString.c_str());
+  if (!route.remote()) {
+    return sent(stats,
+                getPeer(route)->lvlGetDataManagers(dataID, route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->lvlGetDataManagers(dataID);
+  return sent(stats, dagda->lvlGetDataManagers(dataID));
 }
 
 SeqString*
 CorbaForwarder::pfmGetDataManagers(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "pfmGetDataManagers", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->pfmGetDataManagers(dataID, objString.c_str());
+  if (!route.remote()) {
+    return sent(stats,
+                getPeer(route)->pfmGetDataManagers(dataID, route.peerName()));
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
-  return dagda->pfmGetDataManagers(dataID);
+  return sent(stats, dagda->pfmGetDataManagers(dataID));
 }
 
 void
 CorbaForwarder::subscribe(const char* dagdaName, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "subscribe", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->subscribe(dagdaName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->subscribe(dagdaName, route.peerName());
   }
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -599,14 +779,15 @@ CorbaForwarder::subscribe(const char* dagdaName, const char* objName) {
 
 void
 CorbaForwarder::unsubscribe(const char* dagdaName, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "unsubscribe", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->unsubscribe(dagdaName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->unsubscribe(dagdaName, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -615,14 +796,21 @@ CorbaForwarder::unsubscribe(const char* dagdaName, const char* objName) {
 
 char*
 CorbaForwarder::getID(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getID", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getID(objString.c_str());
+  if (!route.remote()) {
+    char* result = findString(routeKey(route), "getID");
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getID(route.peerName());
+      cacheString(routeKey(route), "getID", result, generation);
+    }
+    return result;
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -631,14 +819,15 @@ CorbaForwarder::getID(const char* objName) {
 
 void
 CorbaForwarder::lockData(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "lockData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->lockData(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->lockData(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -647,14 +836,15 @@ CorbaForwarder::lockData(const char* dataID, const char* objName) {
 
 void
 CorbaForwarder::unlockData(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "unlockData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->unlockData(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->unlockData(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -663,14 +853,15 @@ CorbaForwarder::unlockData(const char* dataID, const char* objName) {
 
 Dagda::dataStatus
 CorbaForwarder::getDataStatus(const char* dataID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getDataStatus", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getDataStatus(dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getDataStatus(dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -681,14 +872,15 @@ char*
 CorbaForwarder::getBestSource(const char* destDagda,
                              const char* dataID,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getBestSource", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getBestSource(destDagda, dataID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getBestSource(destDagda, dataID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -697,14 +889,15 @@ CorbaForwarder::getBestSource(const char* destDagda,
 
 void
 CorbaForwarder::checkpointState(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "checkpointState", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->checkpointState(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->checkpointState(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -713,14 +906,15 @@ CorbaForwarder::checkpointState(const char* objName) {
 
 void
 CorbaForwarder::subscribeParent(const char* parentID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "subscribeParent", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->subscribeParent(parentID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->subscribeParent(parentID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
@@ -729,17 +923,303 @@ CorbaForwarder::subscribeParent(const char* parentID, const char* objName) {
 
 void
 CorbaForwarder::unsubscribeParent(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "unsubscribeParent", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->unsubscribeParent(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->unsubscribeParent(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Dagda_var dagda =
     ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
   return dagda->unsubscribeParent();
 }
 
+void
+CorbaForwarder::lclAddDataOctets(const char* srcDagda,
+                                 const ::corba_octet_data_t& data,
+                                 const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lclAddDataOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lclAddDataOctets(srcDagda, data, route.peerName());
+    }
+    return peer->lclAddData(srcDagda, charView(data, view), route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lclAddDataOctets(srcDagda, data);
+  }
+  return dagda->lclAddData(srcDagda, charView(data, view));
+}
+
+void
+CorbaForwarder::lvlAddDataOctets(const char* srcDagda,
+                                 const ::corba_octet_data_t& data,
+                                 const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lvlAddDataOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lvlAddDataOctets(srcDagda, data, route.peerName());
+    }
+    return peer->lvlAddData(srcDagda, charView(data, view), route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lvlAddDataOctets(srcDagda, data);
+  }
+  return dagda->lvlAddData(srcDagda, charView(data, view));
+}
+
+void
+CorbaForwarder::pfmAddDataOctets(const char* srcDagda,
+                                 const ::corba_octet_data_t& data,
+                                 const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "pfmAddDataOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->pfmAddDataOctets(srcDagda, data, route.peerName());
+    }
+    return peer->pfmAddData(srcDagda, charView(data, view), route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->pfmAddDataOctets(srcDagda, data);
+  }
+  return dagda->pfmAddData(srcDagda, charView(data, view));
+}
+
+void
+CorbaForwarder::lclUpdateDataOctets(const char* srcDagda,
+                                    const ::corba_octet_data_t& data,
+                                    const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lclUpdateDataOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lclUpdateDataOctets(srcDagda, data, route.peerName());
+    }
+    return peer->lclUpdateData(srcDagda, charView(data, view),
+                               route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lclUpdateDataOctets(srcDagda, data);
+  }
+  return dagda->lclUpdateData(srcDagda, charView(data, view));
+}
+
+void
+CorbaForwarder::lvlUpdateDataOctets(const char* srcDagda,
+                                    const ::corba_octet_data_t& data,
+                                    const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "lvlUpdateDataOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->lvlUpdateDataOctets(srcDagda, data, route.peerName());
+    }
+    return peer->lvlUpdateData(srcDagda, charView(data, view),
+                               route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->lvlUpdateDataOctets(srcDagda, data);
+  }
+  return dagda->lvlUpdateData(srcDagda, charView(data, view));
+}
+
+void
+CorbaForwarder::pfmUpdateDataOctets(const char* srcDagda,
+                                    const ::corba_octet_data_t& data,
+                                    const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "pfmUpdateDataOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->pfmUpdateDataOctets(srcDagda, data, route.peerName());
+    }
+    return peer->pfmUpdateData(srcDagda, charView(data, view),
+                               route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->pfmUpdateDataOctets(srcDagda, data);
+  }
+  return dagda->pfmUpdateData(srcDagda, charView(data, view));
+}
+
+char*
+CorbaForwarder::writeFileOctets(const ::SeqOctet& data,
+                                const char* basename,
+                                ::CORBA::Boolean replace,
+                                const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "writeFileOctets", route.remote());
+  stats.received(data.length());
+  ::SeqChar view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (streamHop(peer, data.length())) {
+      return streamWriteFile(route, peer, data, basename, replace);
+    }
+    if (octetHop(peer)) {
+      return peer->writeFileOctets(data, basename, replace, route.peerName());
+    }
+    return peer->writeFile(charView(data, view), basename, replace,
+                           route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->writeFileOctets(data, basename, replace);
+  }
+  return dagda->writeFile(charView(data, view), basename, replace);
+}
+
+char*
+CorbaForwarder::sendFileOctets(const ::corba_octet_data_t& data,
+                               const char* destDagda,
+                               const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "sendFileOctets", route.remote());
+  stats.received(data.value.length());
+  ::corba_data_t view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (octetHop(peer)) {
+      return peer->sendFileOctets(data, destDagda, route.peerName());
+    }
+    return peer->sendFile(charView(data, view), destDagda, route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->sendFileOctets(data, destDagda);
+  }
+  return dagda->sendFile(charView(data, view), destDagda);
+}
+
+char*
+CorbaForwarder::recordDataOctets(const ::SeqOctet& data,
+                                 const ::corba_data_desc_t& dataDesc,
+                                 ::CORBA::Boolean replace,
+                                 ::CORBA::Long offset,
+                                 const char* objName) {
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "recordDataOctets", route.remote());
+  stats.received(data.length());
+  ::SeqChar view;
+  std::string name;
+
+  if (!route.remote()) {
+    PeerLink::Call peer(getBulkPeer(route));
+    if (streamHop(peer, data.length())) {
+      return streamRecordData(route, bulk, peer, data, dataDesc, replace,
+                              offset);
+    }
+    if (octetHop(peer)) {
+      return peer->recordDataOctets(data, dataDesc, replace, offset,
+                                    route.peerName());
+    }
+    return peer->recordData(charView(data, view), dataDesc, replace, offset,
+                            route.peerName());
+  }
+
+  name = route.name();
+
+  Dagda_var dagda =
+    ORBMgr::getMgr()->resolve<Dagda, Dagda_var>(DAGDACTXT, name, this->mname);
+  DagdaBulk_var octetDagda = bulkDagda(name, dagda);
+  if (!CORBA::is_nil(octetDagda)) {
+    return octetDagda->recordDataOctets(data, dataDesc, replace, offset);
+  }
+  return dagda->recordData(charView(data, view), dataDesc, replace, offset);
+}
@@ -44,104 +44,103 @@
 
 /* Forwarder part*/
 
-DagdaFwdrImpl::DagdaFwdrImpl(Forwarder_ptr fwdr, const char* objName) {
+DagdaFwdrImpl::DagdaFwdrImpl(Forwarder_ptr fwdr) {
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 void
 DagdaFwdrImpl::subscribe(const char* name) {
-  mforwarder->subscribe(name, mobjName);
+  mforwarder->subscribe(name, objName());
 }
 
 void
 DagdaFwdrImpl::unsubscribe(const char* name) {
-  mforwarder->unsubscribe(name, mobjName);
+  mforwarder->unsubscribe(name, objName());
 }
 
 void
 DagdaFwdrImpl::subscribeParent(const char * parentID) {
-  mforwarder->subscribeParent(parentID, mobjName);
+  mforwarder->subscribeParent(parentID, objName());
 }
 
 void
 DagdaFwdrImpl::unsubscribeParent() {
-  mforwarder->unsubscribeParent(mobjName);
+  mforwarder->unsubscribeParent(objName());
 }
 
 
 char*
 DagdaFwdrImpl::writeFile(const SeqChar& data, const char* basename,
                          CORBA::Boolean replace) {
-  return mforwarder->writeFile(data, basename, replace, mobjName);
+  return mforwarder->writeFile(data, basename, replace, objName());
 }
 
 char*
 DagdaFwdrImpl::sendFile(const corba_data_t &data, const char* dest) {
-  return mforwarder->sendFile(data, dest, mobjName);
+  return mforwarder->sendFile(data, dest, objName());
 }
 
 char*
 DagdaFwdrImpl::recordData(const SeqChar& data, const corba_data_desc_t& dataDesc,
                           CORBA::Boolean replace, CORBA::Long offset) {
-  return mforwarder->recordData(data, dataDesc, replace, offset, mobjName);
+  return mforwarder->recordData(data, dataDesc, replace, offset, objName());
 }
 
 char*
 DagdaFwdrImpl::sendData(const char* ID, const char* dest) {
-  return mforwarder->sendData(ID, dest, mobjName);
+  return mforwarder->sendData(ID, dest, objName());
 }
 
 char*
 DagdaFwdrImpl::sendContainer(const char* containerID, const char* dest,
                              CORBA::Boolean sendElements) {
-  return mforwarder->sendContainer(containerID, dest, sendElements, mobjName);
+  return mforwarder->sendContainer(containerID, dest, sendElements, objName());
 }
 
 void
 DagdaFwdrImpl::lockData(const char* dataID) {
-  mforwarder->lockData(dataID, mobjName);
+  mforwarder->lockData(dataID, objName());
 }
 
 void
 DagdaFwdrImpl::unlockData(const char* dataID) {
-  mforwarder->unlockData(dataID, mobjName);
+  mforwarder->unlockData(dataID, objName());
 }
 
 Dagda::dataStatus DagdaFwdrImpl::getDataStatus(const char* dataID) {
-  return mforwarder->getDataStatus(dataID, mobjName);
+  return mforwarder->getDataStatus(dataID, objName());
 }
 
 CORBA::Boolean DagdaFwdrImpl::lclIsDataPresent(const char* dataID) {
-  return mforwarder->lclIsDataPresent(dataID, mobjName);
+  return mforwarder->lclIsDataPresent(dataID, objName());
 }
 
 CORBA::Boolean DagdaFwdrImpl::lvlIsDataPresent(const char* dataID) {
-  return mforwarder->lvlIsDataPresent(dataID, mobjName);
+  return mforwarder->lvlIsDataPresent(dataID, objName());
 }
 
 CORBA::Boolean DagdaFwdrImpl::pfmIsDataPresent(const char* dataID) {
-  return mforwarder->pfmIsDataPresent(dataID, mobjName);
+  return mforwarder->pfmIsDataPresent(dataID, objName());
 }
 
 void
 DagdaFwdrImpl::lclAddData(const char* src, const corba_data_t& data) {
-  mforwarder->lclAddData(src, data, mobjName);
+  mforwarder->lclAddData(src, data, objName());
 }
 
 void
 DagdaFwdrImpl::lvlAddData(const char* src, const corba_data_t& data) {
-  mforwarder->lvlAddData(src, data, mobjName);
+  mforwarder->lvlAddData(src, data, objName());
 }
 
 void
 DagdaFwdrImpl::pfmAddData(const char* src, const corba_data_t& data) {
-  mforwarder->pfmAddData(src, data, mobjName);
+  mforwarder->pfmAddData(src, data, objName());
 }
 
 void
 DagdaFwdrImpl::registerFile(const corba_data_t& data) {
-  mforwarder->registerFile(data, mobjName);
+  mforwarder->registerFile(data, objName());
 }
 
 void
@@ -150,11 +149,11 @@ DagdaFwdrImpl::lclAddContainerElt(const char* containerID,
                                   CORBA::Long index,
                                   CORBA::Long flag)
 {
-  mforwarder->lclAddContainerElt(containerID, dataID, index, flag, mobjName);
+  mforwarder->lclAddContainerElt(containerID, dataID, index, flag, objName());
 }
 
 CORBA::Long DagdaFwdrImpl::lclGetContainerSize(const char* containerID) {
-  return mforwarder->lclGetContainerSize(containerID, mobjName);
+  return mforwarder->lclGetContainerSize(containerID, objName());
 }
 
 void
@@ -163,112 +162,169 @@ DagdaFwdrImpl::lclGetContainerElts(const char* containerID,
                                    SeqLong& flagSeq,
                                    CORBA::Boolean ordered)
 {
-  mforwarder->lclGetContainerElts(containerID, dataIDSeq, flagSeq, ordered, mobjName);
+  mforwarder->lclGetContainerElts(containerID, dataIDSeq, flagSeq, ordered,
+                                  objName());
 }
 
 void
 DagdaFwdrImpl::lclRemData(const char* dataID) {
-  mforwarder->lclRemData(dataID, mobjName);
+  mforwarder->lclRemData(dataID, objName());
 }
 
 void
 DagdaFwdrImpl::lvlRemData(const char* dataID) {
-  mforwarder->lvlRemData(dataID, mobjName);
+  mforwarder->lvlRemData(dataID, objName());
 }
 
 void
 DagdaFwdrImpl::pfmRemData(const char* dataID) {
-  mforwarder->pfmRemData(dataID, mobjName);
+  mforwarder->pfmRemData(dataID, objName());
 }
 
 void
 DagdaFwdrImpl::lclUpdateData(const char* src, const corba_data_t& data) {
-  mforwarder->lclUpdateData(src, data, mobjName);
+  mforwarder->lclUpdateData(src, data, objName());
 }
 
 void
 DagdaFwdrImpl::lvlUpdateData(const char* src, const corba_data_t& data) {
-  mforwarder->lvlUpdateData(src, data, mobjName);
+  mforwarder->lvlUpdateData(src, data, objName());
 }
 
 void
 DagdaFwdrImpl::pfmUpdateData(const char* src, const corba_data_t& data) {
-  mforwarder->pfmUpdateData(src, data, mobjName);
+  mforwarder->pfmUpdateData(src, data, objName());
 }
 
 void
 DagdaFwdrImpl::lclReplicate(const char* dataID, CORBA::Long target,
                             const char* pattern, bool replace)
 {
-  mforwarder->lclReplicate(dataID, target, pattern, replace, mobjName);
+  mforwarder->lclReplicate(dataID, target, pattern, replace, objName());
 }
 
 void
 DagdaFwdrImpl::lvlReplicate(const char* dataID, CORBA::Long target,
                             const char* pattern, bool replace)
 {
-  mforwarder->lvlReplicate(dataID, target, pattern, replace, mobjName);
+  mforwarder->lvlReplicate(dataID, target, pattern, replace, objName());
 }
 
 void
 DagdaFwdrImpl::pfmReplicate(const char* dataID, CORBA::Long target,
                             const char* pattern, bool replace)
 {
-  mforwarder->pfmReplicate(dataID, target, pattern, replace, mobjName);
+  mforwarder->pfmReplicate(dataID, target, pattern, replace, objName());
 }
 
 SeqCorbaDataDesc_t* DagdaFwdrImpl::lclGetDataDescList() {
-  return mforwarder->lclGetDataDescList(mobjName);
+  return mforwarder->lclGetDataDescList(objName());
 }
 
 SeqCorbaDataDesc_t* DagdaFwdrImpl::lvlGetDataDescList() {
-  return mforwarder->lvlGetDataDescList(mobjName);
+  return mforwarder->lvlGetDataDescList(objName());
 }
 
 SeqCorbaDataDesc_t* DagdaFwdrImpl::pfmGetDataDescList() {
-  return mforwarder->pfmGetDataDescList(mobjName);
+  return mforwarder->pfmGetDataDescList(objName());
 }
 
 corba_data_desc_t* DagdaFwdrImpl::lclGetDataDesc(const char* dataID) {
-  return mforwarder->lclGetDataDesc(dataID, mobjName);
+  return mforwarder->lclGetDataDesc(dataID, objName());
 }
 
 corba_data_desc_t*
 DagdaFwdrImpl::lvlGetDataDesc(const char* dataID) {
-  return mforwarder->lvlGetDataDesc(dataID, mobjName);
+  return mforwarder->lvlGetDataDesc(dataID, objName());
 }
 
 corba_data_desc_t*
 DagdaFwdrImpl::pfmGetDataDesc(const char* dataID) {
-  return mforwarder->pfmGetDataDesc(dataID, mobjName);
+  return mforwarder->pfmGetDataDesc(dataID, objName());
 }
 
 SeqString*
 DagdaFwdrImpl::lvlGetDataManagers(const char* dataID) {
-  return mforwarder->lvlGetDataManagers(dataID, mobjName);
+  return mforwarder->lvlGetDataManagers(dataID, objName());
 }
 
 SeqString*
 DagdaFwdrImpl::pfmGetDataManagers(const char* dataID) {
-  return mforwarder->pfmGetDataManagers(dataID, mobjName);
+  return mforwarder->pfmGetDataManagers(dataID, objName());
 }
 
 char*
 DagdaFwdrImpl::getBestSource(const char* dest, const char* dataID) {
-  return mforwarder->getBestSource(dest, dataID, mobjName);
+  return mforwarder->getBestSource(dest, dataID, objName());
 }
 
 char*
 DagdaFwdrImpl::getID() {
-  return mforwarder->getID(mobjName);
+  return mforwarder->getID(objName());
 }
 
 void
 DagdaFwdrImpl::checkpointState() {
-  mforwarder->checkpointState(mobjName);
+  mforwarder->checkpointState(objName());
 }
 
 char*
 DagdaFwdrImpl::getHostname() {
-  return mforwarder->getHostname(mobjName);
+  return mforwarder->getHostname(objName());
+}
+
+void
+DagdaFwdrImpl::lclAddDataOctets(const char* src,
+                                const corba_octet_data_t& data) {
+  mforwarder->lclAddDataOctets(src, data, objName());
+}
+
+void
+DagdaFwdrImpl::lvlAddDataOctets(const char* src,
+                                const corba_octet_data_t& data) {
+  mforwarder->lvlAddDataOctets(src, data, objName());
+}
+
+void
+DagdaFwdrImpl::pfmAddDataOctets(const char* src,
+                                const corba_octet_data_t& data) {
+  mforwarder->pfmAddDataOctets(src, data, objName());
+}
+
+void
+DagdaFwdrImpl::lclUpdateDataOctets(const char* src,
+                                   const corba_octet_data_t& data) {
+  mforwarder->lclUpdateDataOctets(src, data, objName());
+}
+
+void
+DagdaFwdrImpl::lvlUpdateDataOctets(const char* src,
+                                   const corba_octet_data_t& data) {
+  mforwarder->lvlUpdateDataOctets(src, data, objName());
+}
+
+void
+DagdaFwdrImpl::pfmUpdateDataOctets(const char* src,
+                                   const corba_octet_data_t& data) {
+  mforwarder->pfmUpdateDataOctets(src, data, objName());
+}
+
+char*
+DagdaFwdrImpl::writeFileOctets(const SeqOctet& data, const char* basename,
+                               CORBA::Boolean replace) {
+  return mforwarder->writeFileOctets(data, basename, replace, objName());
+}
+
+char*
+DagdaFwdrImpl::sendFileOctets(const corba_octet_data_t& data,
+                              const char* dest) {
+  return mforwarder->sendFileOctets(data, dest, objName());
+}
+
+char*
+DagdaFwdrImpl::recordDataOctets(const SeqOctet& data,
+                                const corba_data_desc_t& dataDesc,
+                                CORBA::Boolean replace, CORBA::Long offset) {
+  return mforwarder->recordDataOctets(data, dataDesc, replace, offset,
+                                      objName());
 }
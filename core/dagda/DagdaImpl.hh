@@ -30,6 +30,7 @@
 #endif
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "DagdaFwdr.hh"
 
 typedef enum {DGD_CLIENT_MNGR,
@@ -41,9 +42,10 @@ typedef enum {DGD_CLIENT_MNGR,
  * @class DagdaFwdrImpl
  */
 class DagdaFwdrImpl : public POA_DagdaFwdr,
-                      public PortableServer::RefCountServantBase {
+                      public PortableServer::RefCountServantBase,
+                      public ProxyServant {
 public:
-  DagdaFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit DagdaFwdrImpl(Forwarder_ptr fwdr);
 
   virtual void
   subscribe(const char* name);
@@ -189,8 +191,37 @@ public:
   virtual char*
   getHostname();
 
+  /* ------------ */
+  virtual void
+  lclAddDataOctets(const char* src, const corba_octet_data_t& data);
+
+  virtual void
+  lvlAddDataOctets(const char* src, const corba_octet_data_t& data);
+
+  virtual void
+  pfmAddDataOctets(const char* src, const corba_octet_data_t& data);
+
+  virtual void
+  lclUpdateDataOctets(const char* src, const corba_octet_data_t& data);
+
+  virtual void
+  lvlUpdateDataOctets(const char* src, const corba_octet_data_t& data);
+
+  virtual void
+  pfmUpdateDataOctets(const char* src, const corba_octet_data_t& data);
+
+  virtual char*
+  writeFileOctets(const SeqOctet& data, const char* basename,
+                  CORBA::Boolean replace);
+
+  virtual char*
+  sendFileOctets(const corba_octet_data_t& data, const char* dest);
+
+  virtual char*
+  recordDataOctets(const SeqOctet& data, const corba_data_desc_t& dataDesc,
+                   CORBA::Boolean replace, CORBA::Long offset);
+
 private:
   Forwarder_ptr mforwarder;
-  char* mobjName;
 };
 #endif
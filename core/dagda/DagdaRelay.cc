@@ -0,0 +1,137 @@
+/**
+ * @file DagdaRelay.cc
+ *
+ * @brief  Relay of the Dagda calls through the forwarders
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "DagdaRelay.hh"
+
+#include <string>
+
+#include "CorbaForwarder.hh"
+#include "ORBMgr.hh"
+#include "Dagda.hh"
+#include "common_types.hh"
+
+DagdaRelay::DagdaRelay(CorbaForwarder& forwarder, const std::string& fwdName,
+                       const bool named)
+  : RelayServant(Dagda::_PD_repoId, named), mforwarder(forwarder),
+    mfwdName(fwdName) {
+  const char* levels[] = {"lcl", "lvl", "pfm"};
+
+  for (unsigned int i = 0; i < 3; ++i) {
+    std::string level(levels[i]);
+
+    mtable[level + "IsDataPresent"]
+      .in(CORBA::_tc_string).returns(CORBA::_tc_boolean);
+    mtable[level + "AddData"]
+      .in(CORBA::_tc_string).in(_tc_corba_data_t)
+      .raises(Dagda::_tc_InvalidPathName).raises(Dagda::_tc_ReadError)
+      .raises(Dagda::_tc_WriteError).raises(Dagda::_tc_NotEnoughSpace)
+      .bulk();
+    mtable[level + "RemData"].in(CORBA::_tc_string);
+    mtable[level + "UpdateData"]
+      .in(CORBA::_tc_string).in(_tc_corba_data_t).bulk();
+    mtable[level + "GetDataDescList"].returns(_tc_SeqCorbaDataDesc_t);
+    mtable[level + "GetDataDesc"]
+      .in(CORBA::_tc_string).returns(_tc_corba_data_desc_t)
+      .raises(Dagda::_tc_DataNotFound);
+    mtable[level + "Replicate"]
+      .in(CORBA::_tc_string).in(CORBA::_tc_long).in(CORBA::_tc_string)
+      .in(CORBA::_tc_boolean).oneway();
+  }
+  mtable["lvlGetDataManagers"]
+    .in(CORBA::_tc_string).returns(_tc_SeqString);
+  mtable["pfmGetDataManagers"]
+    .in(CORBA::_tc_string).returns(_tc_SeqString);
+
+  mtable["registerFile"]
+    .in(_tc_corba_data_t)
+    .raises(Dagda::_tc_InvalidPathName).raises(Dagda::_tc_UnreachableFile);
+  mtable["lclAddContainerElt"]
+    .in(CORBA::_tc_string).in(CORBA::_tc_string).in(CORBA::_tc_long)
+    .in(CORBA::_tc_long).raises(Dagda::_tc_DataNotFound);
+  mtable["lclGetContainerSize"]
+    .in(CORBA::_tc_string).returns(CORBA::_tc_long);
+  mtable["lclGetContainerElts"]
+    .in(CORBA::_tc_string).inout(_tc_SeqString).inout(_tc_SeqLong)
+    .in(CORBA::_tc_boolean);
+
+  mtable["writeFile"]
+    .in(_tc_SeqChar).in(CORBA::_tc_string).in(CORBA::_tc_boolean)
+    .returns(CORBA::_tc_string)
+    .raises(Dagda::_tc_InvalidPathName).raises(Dagda::_tc_WriteError)
+    .raises(Dagda::_tc_NotEnoughSpace).bulk();
+  mtable["sendFile"]
+    .in(_tc_corba_data_t).in(CORBA::_tc_string).returns(CORBA::_tc_string)
+    .raises(Dagda::_tc_InvalidPathName).raises(Dagda::_tc_ReadError)
+    .raises(Dagda::_tc_WriteError).bulk();
+  mtable["recordData"]
+    .in(_tc_SeqChar).in(_tc_corba_data_desc_t).in(CORBA::_tc_boolean)
+    .in(CORBA::_tc_long).returns(CORBA::_tc_string)
+    .raises(Dagda::_tc_NotEnoughSpace).bulk();
+  mtable["sendData"]
+    .in(CORBA::_tc_string).in(CORBA::_tc_string).returns(CORBA::_tc_string)
+    .raises(Dagda::_tc_DataNotFound).bulk();
+  mtable["sendContainer"]
+    .in(CORBA::_tc_string).in(CORBA::_tc_string).in(CORBA::_tc_boolean)
+    .returns(CORBA::_tc_string).raises(Dagda::_tc_DataNotFound).bulk();
+
+  mtable["subscribe"].in(CORBA::_tc_string);
+  mtable["unsubscribe"].in(CORBA::_tc_string);
+  mtable["getID"].returns(CORBA::_tc_string);
+  mtable["getHostname"].returns(CORBA::_tc_string);
+  mtable["lockData"].in(CORBA::_tc_string);
+  mtable["unlockData"].in(CORBA::_tc_string);
+  mtable["getDataStatus"]
+    .in(CORBA::_tc_string).returns(Dagda::_tc_dataStatus);
+  mtable["getBestSource"]
+    .in(CORBA::_tc_string).in(CORBA::_tc_string).returns(CORBA::_tc_string)
+    .raises(Dagda::_tc_DataNotFound);
+  mtable["checkpointState"];
+  mtable["subscribeParent"].in(CORBA::_tc_string);
+  mtable["unsubscribeParent"];
+}
+
+void
+DagdaRelay::relay(CORBA::ServerRequest_ptr request,
+                  const RelaySignature& signature, CORBA::NVList_ptr args) {
+  std::string name;
+
+  if (named()) {
+    name = objectName(signature, args);
+  } else {
+    CORBA::String_var id = objName();
+    name = id.in();
+  }
+  ObjectRoute target(name.c_str(), mforwarder.getRoutes());
+  if (signature.isBulk()) {
+    CorbaForwarder::BulkCall bulk(mforwarder, target);
+    route(request, signature, args, target);
+  } else {
+    route(request, signature, args, target);
+  }
+}
+
+void
+DagdaRelay::route(CORBA::ServerRequest_ptr request,
+                  const RelaySignature& signature, CORBA::NVList_ptr args,
+                  const ObjectRoute& target) {
+  OperationStats::Call stats(mforwarder.operationStats(),
+                             request->operation(), target.remote());
+
+  if (!target.remote()) {
+    PeerLink::Call peer(
+      mforwarder.getPeer(target, signature.isBulk() ? PeerLink::BULK_CALL
+                                                   : PeerLink::CONTROL_CALL));
+    forward(request, signature, args, peer.relay(), target.peerName());
+    return;
+  }
+
+  CORBA::Object_var dagda =
+    ORBMgr::getMgr()->resolveObject(DAGDACTXT, target.name(), mfwdName);
+  forward(request, signature, args, dagda, NULL);
+}
@@ -0,0 +1,68 @@
+/**
+ * @file DagdaRelay.hh
+ *
+ * @brief  Relay of the Dagda calls through the forwarders
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef _DAGDARELAY_HH_
+#define _DAGDARELAY_HH_
+
+#include <string>
+#include "RelayServant.hh"
+#include "ProxyServant.hh"
+#include "utils/ObjectRoute.hh"
+
+class CorbaForwarder;
+
+/**
+ * @brief Relay of the Dagda calls. As a proxy servant (not named), it
+ * receives the calls made on the Dagda proxies and sends them to the peer
+ * relay with the object name. As the forwarder relay (named), it receives
+ * these calls and sends them to the local Dagda object, or again to a peer.
+ * The data carried by the calls are copied in their marshalled form, they
+ * are never decoded by the forwarders.
+ * @class DagdaRelay
+ */
+class DagdaRelay : public RelayServant,
+                   public ProxyServant {
+public:
+  /**
+   * @brief Constructor
+   * @param forwarder The forwarder, giving the routes and the peers
+   * @param fwdName The forwarder name
+   * @param named Do the calls end with the object name?
+   */
+  DagdaRelay(CorbaForwarder& forwarder, const std::string& fwdName,
+             const bool named);
+
+protected:
+  void
+  relay(CORBA::ServerRequest_ptr request, const RelaySignature& signature,
+        CORBA::NVList_ptr args);
+
+private:
+  /**
+   * @brief Forward a call to the next hop on the route of its object.
+   * @param request The received request
+   * @param signature The signature of the operation
+   * @param args The decoded arguments
+   * @param target The route of the object
+   */
+  void
+  route(CORBA::ServerRequest_ptr request, const RelaySignature& signature,
+        CORBA::NVList_ptr args, const ObjectRoute& target);
+
+  /**
+   * @brief The forwarder.
+   */
+  CorbaForwarder& mforwarder;
+  /**
+   * @brief The forwarder name, to resolve the local objects.
+   */
+  std::string mfwdName;
+};
+
+#endif
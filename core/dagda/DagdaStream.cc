@@ -0,0 +1,1087 @@
+/**
+ * @file DagdaStream.cc
+ *
+ * @brief  DIET forwarder implementation - Streamed Dagda transfers
+ *         between two forwarders
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "CorbaForwarder.hh"
+#include "ORBMgr.hh"
+#include <algorithm>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "utils/ChunkWindow.hh"
+#include "utils/FileSpool.hh"
+#include "utils/Sha256.hh"
+
+/* Time after which a stream without any chunk is dropped (s). */
+#define STREAM_IDLE 600
+/* Time after which the journal of a transfer never resumed is dropped (s). */
+#define STREAM_JOURNAL_IDLE (24 * 3600)
+
+/**
+ * @brief A stream received from the peer: the call to make on the object
+ * and the chunks received ahead of their turn, on the heap or in a spool
+ * file.
+ */
+struct CorbaForwarder::Stream {
+  Stream()
+    : record(false), replace(false), offset(0), length(0), chunkSize(0),
+      count(0), next(0), applying(false), committing(false), writers(0),
+      spool(NULL), mapping(NULL), slots(0), journal(NULL), store(NULL),
+      error(NULL), lastUse(time(NULL)) {}
+
+  ~Stream() {
+    std::map<unsigned long, SeqOctet*>::iterator it;
+    std::map<unsigned long, std::string>::iterator held;
+
+    for (it = pending.begin(); it != pending.end(); ++it) {
+      delete it->second;
+    }
+    for (held = stored.begin(); held != stored.end(); ++held) {
+      store->release(held->second);
+    }
+    delete spool;
+    delete error;
+  }
+
+  /**
+   * @brief The object name, as given by the peer.
+   */
+  std::string objName;
+  /**
+   * @brief recordData (true) or writeFile (false).
+   */
+  bool record;
+  corba_data_desc_t desc;
+  std::string basename;
+  bool replace;
+  ::CORBA::Long offset;
+  unsigned long length;
+  unsigned long chunkSize;
+  unsigned long count;
+  /**
+   * @brief The next chunk to write to the object.
+   */
+  unsigned long next;
+  /**
+   * @brief Is a thread writing chunks to the object?
+   */
+  bool applying;
+  bool committing;
+  /**
+   * @brief The number of threads writing a chunk to the spool file.
+   */
+  unsigned int writers;
+  /**
+   * @brief The chunks received ahead of their turn, owned, without spool.
+   */
+  std::map<unsigned long, SeqOctet*> pending;
+  /**
+   * @brief The spool file, owned, NULL to keep the chunks on the heap.
+   */
+  FileSpool* spool;
+  const char* mapping;
+  /**
+   * @brief The number of chunks the spool file holds, a chunk being
+   * written to the slot of its index modulo this number.
+   */
+  unsigned long slots;
+  /**
+   * @brief The chunks written to the spool file ahead of their turn.
+   */
+  std::set<unsigned long> spooled;
+  /**
+   * @brief The transfer key of a resumable stream, empty otherwise.
+   */
+  std::string key;
+  /**
+   * @brief The checksums of the chunks, given by the sender of a
+   * resumable stream.
+   */
+  std::vector<unsigned long> checksums;
+  /**
+   * @brief The journal of the transfer, owned by the forwarder, NULL if
+   * the stream is not resumable.
+   */
+  StreamJournal* journal;
+  /**
+   * @brief The digests of the chunks offered by the sender, empty if it
+   * made no offer.
+   */
+  std::vector<std::string> digests;
+  /**
+   * @brief The chunks taken from the chunk store, pinned there, with
+   * their digest.
+   */
+  std::map<unsigned long, std::string> stored;
+  ChunkStore* store;
+  /**
+   * @brief The result of the last call made on the object.
+   */
+  ::CORBA::String_var result;
+  /**
+   * @brief The first error met, owned.
+   */
+  ::CORBA::Exception* error;
+  time_t lastUse;
+};
+
+/**
+ * @brief A stream sent to the peer, shared by the threads sending it.
+ * It is held by the sending thread and by its queued helpers, the last
+ * one deletes it: a helper run after the end of the transfer only finds
+ * the window closed.
+ */
+struct CorbaForwarder::StreamSender {
+  StreamSender(CorbaForwarder& forwarder, const ::CORBA::Long stream,
+               const ::SeqOctet& data, const unsigned long chunkSize,
+               const unsigned int window, const unsigned long first)
+    : forwarder(forwarder), stream(stream), data(data),
+      chunkSize(chunkSize),
+      window((data.length() + chunkSize - 1) / chunkSize, window, first),
+      error(NULL), refs(1) {}
+
+  ~StreamSender() {
+    delete error;
+  }
+
+  void
+  hold() {
+    mutex.lock();
+    ++refs;
+    mutex.unlock();
+  }
+
+  void
+  release() {
+    bool last;
+
+    mutex.lock();
+    last = (--refs == 0);
+    mutex.unlock();
+    if (last) {
+      delete this;
+    }
+  }
+
+  CorbaForwarder& forwarder;
+  ::CORBA::Long stream;
+  const ::SeqOctet& data;
+  unsigned long chunkSize;
+  ChunkWindow window;
+  /**
+   * @brief The chunks held by the peer, not to send, empty if the peer
+   * has no chunk store.
+   */
+  std::vector<bool> held;
+  /**
+   * @brief The first error met, owned.
+   */
+  ::CORBA::Exception* error;
+  /**
+   * @brief The number of holders.
+   */
+  unsigned int refs;
+  /**
+   * @brief Protects the error and the holders.
+   */
+  omni_mutex mutex;
+};
+
+/**
+ * @brief A helper sending the chunks of a stream, with its own slot of
+ * the peer link, taken when it was queued.
+ * @class CorbaForwarder::StreamHelper
+ */
+class CorbaForwarder::StreamHelper : public WorkerPool::Task {
+public:
+  StreamHelper(StreamSender* sender, const PeerLink::Call& peer)
+    : msender(sender), mpeer(peer) {
+    msender->hold();
+  }
+
+  ~StreamHelper() {
+    msender->release();
+  }
+
+  void
+  run() {
+    // The transfer may have ended while the helper was queued
+    if (msender->window.enter()) {
+      msender->forwarder.sendChunks(*msender, mpeer);
+      msender->window.leave();
+    }
+  }
+
+private:
+  StreamSender* msender;
+  PeerLink::Call mpeer;
+};
+
+/* Is a failure the one of a broken link, or of a restarted peer which
+   forgot the stream? */
+static bool
+brokenLink(const ::CORBA::SystemException& err) {
+  return ::CORBA::TRANSIENT::_downcast(&err) != NULL
+    || ::CORBA::COMM_FAILURE::_downcast(&err) != NULL
+    || ::CORBA::OBJECT_NOT_EXIST::_downcast(&err) != NULL;
+}
+
+/**
+ * @brief A task making the chunks of a received stream from the first
+ * one, when it is taken from the chunk store.
+ * @class CorbaForwarder::StreamStart
+ */
+class CorbaForwarder::StreamStart : public WorkerPool::Task {
+public:
+  StreamStart(CorbaForwarder& forwarder, Stream& stream,
+              const unsigned long index)
+    : mforwarder(forwarder), mstream(stream), mindex(index) {}
+
+  void
+  run() {
+    mforwarder.applyChunks(mstream, mindex, NULL);
+  }
+
+private:
+  CorbaForwarder& mforwarder;
+  Stream& mstream;
+  unsigned long mindex;
+};
+
+char*
+CorbaForwarder::streamRecordData(ObjectRoute& route, BulkCall& bulk,
+                                 PeerLink::Call& peer,
+                                 const ::SeqOctet& data,
+                                 const ::corba_data_desc_t& dataDesc,
+                                 const ::CORBA::Boolean replace,
+                                 const ::CORBA::Long offset) {
+  if (peer.supports(PeerLink::RESUMABLE_STREAMS)) {
+    return resumeRecordData(route, bulk, peer, data, dataDesc, replace,
+                            offset);
+  }
+  ::CORBA::Long stream =
+    peer->openRecordStream(dataDesc, replace, offset, data.length(),
+                           mstreamChunk, route.peerName());
+  return sendStream(route, peer, stream, data);
+}
+
+char*
+CorbaForwarder::resumeRecordData(ObjectRoute& route, BulkCall& bulk,
+                                 PeerLink::Call& peer,
+                                 const ::SeqOctet& data,
+                                 const ::corba_data_desc_t& dataDesc,
+                                 const ::CORBA::Boolean replace,
+                                 const ::CORBA::Long offset) {
+  unsigned long count = (data.length() + mstreamChunk - 1) / mstreamChunk;
+  SeqULong checksums;
+
+  checksums.length(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    unsigned long begin = i * mstreamChunk;
+    checksums[i] =
+      StreamJournal::checksum(data.get_buffer() + begin,
+                              std::min<unsigned long>(mstreamChunk,
+                                                      data.length() - begin));
+  }
+
+  for (unsigned int resumes = 0; ; ++resumes) {
+    try {
+      ::CORBA::ULong first = 0;
+      ::CORBA::Long stream =
+        peer->resumeRecordStream(dataDesc, replace, offset, data.length(),
+                                 mstreamChunk, checksums, route.peerName(),
+                                 first);
+      return sendStream(route, peer, stream, data, first);
+    } catch (const ::CORBA::SystemException& err) {
+      if (resumes >= mstreamResumes || !brokenLink(err)) {
+        throw;
+      }
+    }
+    // Leave the peer the time to come back, then resume the transfer. The
+    // slots are left meanwhile for the other calls
+    unsigned long delay =
+      ORBMgr::getMgr()->getRetryPolicy().backoff(resumes);
+    peer.leave();
+    bulk.leave();
+    omni_thread::sleep(delay / 1000, (delay % 1000) * 1000000);
+    bulk.enter();
+    peer.enter();
+    peer.refresh(PeerLink::BULK_CALL);
+  }
+}
+
+char*
+CorbaForwarder::streamWriteFile(ObjectRoute& route,
+                                PeerLink::Call& peer,
+                                const ::SeqOctet& data, const char* basename,
+                                const ::CORBA::Boolean replace) {
+  ::CORBA::Long stream =
+    peer->openWriteStream(basename, replace, data.length(), mstreamChunk,
+                          route.peerName());
+  return sendStream(route, peer, stream, data);
+}
+
+char*
+CorbaForwarder::sendStream(const ObjectRoute& route, PeerLink::Call& peer,
+                           const ::CORBA::Long stream,
+                           const ::SeqOctet& data,
+                           const unsigned long first) {
+  StreamSender* sender =
+    new StreamSender(*this, stream, data, mstreamChunk, mstreamWindow,
+                     first);
+  unsigned long count = (data.length() + mstreamChunk - 1) / mstreamChunk;
+  unsigned long left = (first < count) ? count - first : 0;
+  unsigned long helpers;
+  std::auto_ptr< ::CORBA::Exception> error;
+
+  if (left > 0 && peer.supports(PeerLink::DEDUP_TRANSFERS)) {
+    try {
+      dedupChunks(*sender, peer, first);
+      left = std::count(sender->held.begin() + first, sender->held.end(),
+                        false);
+    } catch (const ::CORBA::Exception& err) {
+      sender->error = err._NP_duplicate();
+      sender->window.fail();
+    }
+  }
+  helpers = (left > 1) ? std::min<unsigned long>(mstreamWindow, left) - 1 : 0;
+
+  for (unsigned long i = 0; i < helpers; ++i) {
+    try {
+      // Never waits for a slot: this thread holds one, and sends the
+      // chunks left by the missing helpers
+      PeerLink::Call helper(getPeer(route, PeerLink::BULK_CALL, false));
+      streamWorkers().submit(new StreamHelper(sender, helper));
+    } catch (const ::CORBA::TRANSIENT&) {
+      break;
+    }
+  }
+  sendChunks(*sender, peer);
+  // Only waits for the helpers already sending
+  sender->window.join();
+  if (sender->error == NULL && !sender->held.empty()) {
+    resendChunks(*sender, peer);
+  }
+  error.reset(sender->error);
+  sender->error = NULL;
+  sender->release();
+
+  if (error.get() != NULL) {
+    try {
+      peer->abortStream(stream);
+    } catch (const ::CORBA::Exception&) {
+    }
+    error->_raise();
+  }
+  return peer->commitStream(stream);
+}
+
+WorkerPool&
+CorbaForwarder::streamWorkers() {
+  mstreamMutex.lock();
+  if (mstreamWorkers == NULL) {
+    mstreamWorkers = new WorkerPool(mstreamWindow);
+  }
+  mstreamMutex.unlock();
+  return *mstreamWorkers;
+}
+
+void
+CorbaForwarder::dedupChunks(StreamSender& sender, PeerLink::Call& peer,
+                            const unsigned long first) {
+  unsigned long length = sender.data.length();
+  unsigned long count = (length + sender.chunkSize - 1) / sender.chunkSize;
+  ::SeqOctet digests;
+
+  digests.length((count - first) * Sha256::DIGEST_SIZE);
+  for (unsigned long i = first; i < count; ++i) {
+    unsigned long begin = i * sender.chunkSize;
+    Sha256::digest(sender.data.get_buffer() + begin,
+                   std::min<unsigned long>(sender.chunkSize, length - begin),
+                   digests.get_buffer()
+                   + (i - first) * Sha256::DIGEST_SIZE);
+  }
+
+  SeqULong_var missing = peer->offerChunks(sender.stream, first, digests);
+  sender.held.assign(count, true);
+  for (::CORBA::ULong i = 0; i < missing->length(); ++i) {
+    if (missing[i] < count) {
+      sender.held[missing[i]] = false;
+    }
+  }
+}
+
+void
+CorbaForwarder::sendChunks(StreamSender& sender, PeerLink::Call& peer) {
+  ::CORBA::Octet* buffer =
+    const_cast< ::CORBA::Octet*>(sender.data.get_buffer());
+  unsigned long index;
+
+  while (sender.window.next(index)) {
+    if (!sender.held.empty() && sender.held[index]) {
+      // Taken by the peer from its chunk store
+      sender.window.done(index);
+      continue;
+    }
+    unsigned long begin = index * sender.chunkSize;
+    unsigned long length =
+      std::min<unsigned long>(sender.chunkSize,
+                              sender.data.length() - begin);
+    // A view of the slice of the data, without copy
+    SeqOctet chunk(length, length, buffer + begin, false);
+
+    try {
+      peer->writeChunk(sender.stream, index, chunk);
+    } catch (const ::CORBA::Exception& err) {
+      sender.mutex.lock();
+      if (sender.error == NULL) {
+        sender.error = err._NP_duplicate();
+      }
+      sender.mutex.unlock();
+      sender.window.fail();
+      return;
+    }
+    sender.window.done(index);
+  }
+}
+
+void
+CorbaForwarder::resendChunks(StreamSender& sender, PeerLink::Call& peer) {
+  ::CORBA::Octet* buffer =
+    const_cast< ::CORBA::Octet*>(sender.data.get_buffer());
+  unsigned long length = sender.data.length();
+  unsigned long count = (length + sender.chunkSize - 1) / sender.chunkSize;
+
+  try {
+    // Each round makes at least the first chunk missing
+    for (;;) {
+      SeqULong_var missing = peer->missingChunks(sender.stream);
+      if (missing->length() == 0) {
+        return;
+      }
+      for (::CORBA::ULong i = 0; i < missing->length(); ++i) {
+        unsigned long index = missing[i];
+        if (index >= count) {
+          throw ::CORBA::BAD_PARAM(0, ::CORBA::COMPLETED_NO);
+        }
+        unsigned long begin = index * sender.chunkSize;
+        unsigned long size =
+          std::min<unsigned long>(sender.chunkSize, length - begin);
+        SeqOctet chunk(size, size, buffer + begin, false);
+
+        peer->writeChunk(sender.stream, index, chunk);
+      }
+    }
+  } catch (const ::CORBA::Exception& err) {
+    sender.mutex.lock();
+    if (sender.error == NULL) {
+      sender.error = err._NP_duplicate();
+    }
+    sender.mutex.unlock();
+  }
+}
+
+::CORBA::Long
+CorbaForwarder::openStream(Stream* stream, const ::CORBA::ULong length,
+                           const ::CORBA::ULong chunkSize) {
+  std::map< ::CORBA::Long, Stream*>::iterator it;
+  std::map<std::string, StreamJournal*>::iterator journal;
+  time_t now = time(NULL);
+  ::CORBA::Long result;
+
+  if (chunkSize == 0) {
+    delete stream;
+    throw ::CORBA::BAD_PARAM(0, ::CORBA::COMPLETED_NO);
+  }
+  stream->length = length;
+  stream->chunkSize = chunkSize;
+  stream->count =
+    (static_cast<unsigned long>(length) + chunkSize - 1) / chunkSize;
+  if (!mstreamSpool.empty() && stream->count > 1) {
+    // A window of chunks, not the whole transfer
+    stream->slots =
+      std::min<unsigned long>(stream->count, mstreamWindow);
+    try {
+      stream->spool =
+        new FileSpool(mstreamSpool, stream->slots * chunkSize);
+      stream->mapping = stream->spool->map();
+    } catch (const std::runtime_error&) {
+      // No room in the spool directory: the chunks stay on the heap
+      delete stream->spool;
+      stream->spool = NULL;
+    }
+  }
+
+  mstreamMutex.lock();
+  // Drop the streams left by a sender gone without aborting them
+  for (it = mstreams.begin(); it != mstreams.end(); ) {
+    Stream* idle = it->second;
+    if (!idle->applying && !idle->committing && idle->writers == 0
+        && idle->lastUse + STREAM_IDLE < now) {
+      delete idle;
+      mstreams.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  // Drop the journals of the transfers never resumed
+  for (journal = mjournals.begin(); journal != mjournals.end(); ) {
+    bool used = false;
+    for (it = mstreams.begin(); it != mstreams.end() && !used; ++it) {
+      used = (it->second->journal == journal->second);
+    }
+    if (!used && journal->second->lastUse() + STREAM_JOURNAL_IDLE < now) {
+      journal->second->remove();
+      delete journal->second;
+      mjournals.erase(journal++);
+    } else {
+      ++journal;
+    }
+  }
+
+  if (!stream->key.empty()) {
+    // Stop the earlier attempts of the transfer: their chunks would be
+    // made after the journal is read
+    for (it = mstreams.begin(); it != mstreams.end(); ) {
+      if (it->second->key == stream->key) {
+        stopStream(it->first);
+        it = mstreams.begin();
+      } else {
+        ++it;
+      }
+    }
+    journal = mjournals.find(stream->key);
+    if (journal == mjournals.end()) {
+      StreamJournal* created;
+      try {
+        created = new StreamJournal(mstreamJournal, stream->key);
+      } catch (const std::runtime_error&) {
+        // The journal directory is not writable: kept in memory
+        created = new StreamJournal("", stream->key);
+      }
+      journal = mjournals.insert(std::make_pair(stream->key, created)).first;
+    }
+    stream->journal = journal->second;
+    stream->next = stream->journal->resumePoint(stream->checksums);
+    if (stream->count > 0 && stream->next >= stream->count) {
+      // All the chunks were made: the last one is made again, for the
+      // result of the call
+      stream->next = stream->count - 1;
+    }
+  }
+  result = ++mnextStream;
+  mstreams[result] = stream;
+  mstreamMutex.unlock();
+  return result;
+}
+
+void
+CorbaForwarder::stopStream(const ::CORBA::Long id) {
+  std::map< ::CORBA::Long, Stream*>::iterator it = mstreams.find(id);
+  Stream* stream;
+
+  if (it == mstreams.end()) {
+    return;
+  }
+  stream = it->second;
+  mstreams.erase(it);
+  if (stream->error == NULL) {
+    // Stops the thread writing the chunks, if any
+    stream->error = new ::CORBA::TRANSIENT(0, ::CORBA::COMPLETED_NO);
+  }
+  // Wakes the chunks waiting for their slot
+  mstreamCond.broadcast();
+  while (stream->applying || stream->writers > 0) {
+    mstreamCond.wait();
+  }
+  if (!stream->committing) {
+    delete stream;
+  }
+}
+
+::CORBA::Long
+CorbaForwarder::openRecordStream(const ::corba_data_desc_t& dataDesc,
+                                 ::CORBA::Boolean replace,
+                                 ::CORBA::Long offset,
+                                 ::CORBA::ULong length,
+                                 ::CORBA::ULong chunkSize,
+                                 const char* objName) {
+  OperationStats::Call stats(mstats, "openRecordStream", true);
+  Stream* stream = new Stream;
+
+  stream->objName = objName;
+  stream->record = true;
+  stream->desc = dataDesc;
+  stream->replace = replace;
+  stream->offset = offset;
+  return openStream(stream, length, chunkSize);
+}
+
+::CORBA::Long
+CorbaForwarder::openWriteStream(const char* basename,
+                                ::CORBA::Boolean replace,
+                                ::CORBA::ULong length,
+                                ::CORBA::ULong chunkSize,
+                                const char* objName) {
+  OperationStats::Call stats(mstats, "openWriteStream", true);
+  Stream* stream = new Stream;
+
+  stream->objName = objName;
+  stream->record = false;
+  stream->basename = basename;
+  stream->replace = replace;
+  return openStream(stream, length, chunkSize);
+}
+
+::CORBA::Long
+CorbaForwarder::resumeRecordStream(const ::corba_data_desc_t& dataDesc,
+                                   ::CORBA::Boolean replace,
+                                   ::CORBA::Long offset,
+                                   ::CORBA::ULong length,
+                                   ::CORBA::ULong chunkSize,
+                                   const ::SeqULong& checksums,
+                                   const char* objName,
+                                   ::CORBA::ULong& first) {
+  OperationStats::Call stats(mstats, "resumeRecordStream", true);
+  std::ostringstream key;
+  Stream* stream;
+  ::CORBA::Long result;
+
+  if (chunkSize == 0
+      || checksums.length()
+      != (static_cast<unsigned long>(length) + chunkSize - 1) / chunkSize) {
+    throw ::CORBA::BAD_PARAM(0, ::CORBA::COMPLETED_NO);
+  }
+  key << objName << " " << dataDesc.id.idNumber << " " << offset
+      << " " << length << " " << chunkSize;
+
+  stream = new Stream;
+  stream->objName = objName;
+  stream->record = true;
+  stream->desc = dataDesc;
+  stream->replace = replace;
+  stream->offset = offset;
+  stream->key = key.str();
+  stream->checksums.assign(checksums.get_buffer(),
+                           checksums.get_buffer() + checksums.length());
+  result = openStream(stream, length, chunkSize);
+  // The sender does not know the stream yet: nothing else touches it
+  first = stream->next;
+  return result;
+}
+
+void
+CorbaForwarder::setChunkStore(const std::string& directory,
+                              const unsigned long maxSize) {
+  mchunkStore = new ChunkStore(directory, maxSize);
+}
+
+void
+CorbaForwarder::setStreamResume(const std::string& directory,
+                                const unsigned int resumes) {
+  mstreamJournal = directory;
+  mstreamResumes = resumes;
+  if (!directory.empty()) {
+    StreamJournal::purge(directory, STREAM_JOURNAL_IDLE);
+  }
+}
+
+void
+CorbaForwarder::writeChunk(::CORBA::Long id,
+                           ::CORBA::ULong index,
+                           const ::SeqOctet& data) {
+  std::map< ::CORBA::Long, Stream*>::iterator it;
+  OperationStats::Call stats(mstats, "writeChunk", true);
+  stats.received(data.length());
+  Stream* stream;
+
+  mstreamMutex.lock();
+  it = mstreams.find(id);
+  if (it == mstreams.end()) {
+    // Aborted, or forgotten by a restart: the sender may resume it
+    mstreamMutex.unlock();
+    throw ::CORBA::OBJECT_NOT_EXIST(0, ::CORBA::COMPLETED_NO);
+  }
+  stream = it->second;
+  stream->lastUse = time(NULL);
+  // The chunks held by the chunk store do not bound the ones sent: wait
+  // for the thread writing them to make room, counted as a writer so that
+  // the stream is kept. A spooled chunk waits until the chunk using its
+  // slot is written.
+  ++stream->writers;
+  while (stream->error == NULL && stream->applying
+         && index != stream->next
+         && ((stream->spool == NULL
+              && stream->pending.size() >= mstreamWindow)
+             || (stream->spool != NULL
+                 && index >= stream->next + stream->slots))) {
+    mstreamCond.wait();
+  }
+  --stream->writers;
+  if (stream->error != NULL || index < stream->next
+      || index >= stream->count || stream->pending.count(index) > 0
+      || stream->spooled.count(index) > 0
+      || stream->stored.count(index) > 0) {
+    // Failed stream or chunk already received
+    mstreamCond.broadcast();
+    mstreamMutex.unlock();
+    return;
+  }
+  if (index != stream->next || stream->applying) {
+    if (stream->spool == NULL || index >= stream->next + stream->slots) {
+      // Kept until its turn, at most a window of chunks while they are
+      // made. Its slot of the spool file is still used if the chunk taken
+      // from the chunk store was missing
+      stream->pending[index] = new SeqOctet(data);
+      mstreamMutex.unlock();
+      return;
+    }
+    // Written to the spool file, out of the lock
+    ++stream->writers;
+    mstreamMutex.unlock();
+    if (!spoolChunk(*stream, index, data)) {
+      return;
+    }
+  }
+  stream->applying = true;
+  mstreamMutex.unlock();
+
+  applyChunks(*stream, index, &data);
+}
+
+SeqULong*
+CorbaForwarder::offerChunks(::CORBA::Long id,
+                            ::CORBA::ULong first,
+                            const ::SeqOctet& digests) {
+  std::map< ::CORBA::Long, Stream*>::iterator it;
+  OperationStats::Call stats(mstats, "offerChunks", true);
+  SeqULong_var missing = new SeqULong;
+  ::CORBA::ULong count = 0;
+  Stream* stream;
+  bool start = false;
+
+  mstreamMutex.lock();
+  it = mstreams.find(id);
+  if (it == mstreams.end()) {
+    mstreamMutex.unlock();
+    throw ::CORBA::OBJECT_NOT_EXIST(0, ::CORBA::COMPLETED_NO);
+  }
+  stream = it->second;
+  if (first != stream->next || first >= stream->count
+      || !stream->digests.empty()
+      || digests.length()
+      != (stream->count - first) * Sha256::DIGEST_SIZE) {
+    mstreamMutex.unlock();
+    throw ::CORBA::BAD_PARAM(0, ::CORBA::COMPLETED_NO);
+  }
+  stream->lastUse = time(NULL);
+  stream->store = mchunkStore;
+  stream->digests.resize(stream->count);
+  missing->length(stream->count - first);
+  for (unsigned long i = first; i < stream->count; ++i) {
+    unsigned long begin = i * stream->chunkSize;
+    unsigned long expected =
+      std::min<unsigned long>(stream->chunkSize, stream->length - begin);
+    unsigned long length;
+    std::string& digest = stream->digests[i];
+
+    digest.assign(reinterpret_cast<const char*>(digests.get_buffer())
+                  + (i - first) * Sha256::DIGEST_SIZE, Sha256::DIGEST_SIZE);
+    if (mchunkStore != NULL && mchunkStore->acquire(digest, length)) {
+      if (length == expected) {
+        stream->stored[i] = digest;
+        continue;
+      }
+      mchunkStore->release(digest);
+    }
+    missing[count++] = i;
+  }
+  missing->length(count);
+  if (stream->error == NULL && !stream->applying
+      && stream->stored.count(stream->next) > 0) {
+    // No chunk will come before the ones held: made from here
+    stream->applying = true;
+    start = true;
+  }
+  mstreamMutex.unlock();
+
+  if (start) {
+    streamWorkers().submit(new StreamStart(*this, *stream, first));
+  }
+  stats.sent(payloadSize(missing.in()));
+  return missing._retn();
+}
+
+SeqULong*
+CorbaForwarder::missingChunks(::CORBA::Long id) {
+  std::map< ::CORBA::Long, Stream*>::iterator it;
+  OperationStats::Call stats(mstats, "missingChunks", true);
+  SeqULong_var missing = new SeqULong;
+  ::CORBA::ULong count = 0;
+  Stream* stream;
+
+  mstreamMutex.lock();
+  it = mstreams.find(id);
+  if (it == mstreams.end()) {
+    mstreamMutex.unlock();
+    throw ::CORBA::OBJECT_NOT_EXIST(0, ::CORBA::COMPLETED_NO);
+  }
+  stream = it->second;
+  stream->lastUse = time(NULL);
+  // All the chunks were received: the ones made stop at the first one
+  // missing. Counted as a writer so that the stream is kept
+  ++stream->writers;
+  while (stream->error == NULL && stream->applying) {
+    mstreamCond.wait();
+  }
+  --stream->writers;
+  if (stream->error == NULL) {
+    missing->length(stream->count - stream->next);
+    for (unsigned long i = stream->next; i < stream->count; ++i) {
+      if (stream->pending.count(i) == 0 && stream->spooled.count(i) == 0
+          && stream->stored.count(i) == 0) {
+        missing[count++] = i;
+      }
+    }
+  }
+  missing->length(count);
+  mstreamCond.broadcast();
+  mstreamMutex.unlock();
+
+  stats.sent(payloadSize(missing.in()));
+  return missing._retn();
+}
+
+bool
+CorbaForwarder::spoolChunk(Stream& stream, unsigned long index,
+                           const ::SeqOctet& data) {
+  ::CORBA::Exception* error = NULL;
+
+  try {
+    stream.spool->write((index % stream.slots) * stream.chunkSize,
+                        reinterpret_cast<const char*>(data.get_buffer()),
+                        data.length());
+  } catch (const std::runtime_error&) {
+    error = new ::CORBA::NO_RESOURCES(0, ::CORBA::COMPLETED_NO);
+  }
+
+  mstreamMutex.lock();
+  --stream.writers;
+  if (error != NULL && stream.error == NULL) {
+    stream.error = error;
+  } else {
+    delete error;
+  }
+  if (stream.error != NULL || index < stream.next) {
+    mstreamCond.broadcast();
+    mstreamMutex.unlock();
+    return false;
+  }
+  if (index != stream.next || stream.applying) {
+    // Read back from the spool file on its turn
+    stream.spooled.insert(index);
+    mstreamCond.broadcast();
+    mstreamMutex.unlock();
+    return false;
+  }
+  // Its turn came meanwhile: made from the received data, still locked
+  return true;
+}
+
+void
+CorbaForwarder::applyChunks(Stream& stream, unsigned long index,
+                            const ::SeqOctet* data) {
+  std::map<unsigned long, SeqOctet*>::iterator it;
+  std::map<unsigned long, std::string>::iterator held;
+  const SeqOctet* chunk = data;
+  SeqOctet* owned = NULL;
+  SeqOctet view;
+  bool mapped = false;
+  std::string stored;
+
+  if (chunk == NULL) {
+    mstreamMutex.lock();
+    held = stream.stored.find(index);
+    stored = held->second;
+    stream.stored.erase(held);
+    mstreamMutex.unlock();
+  }
+
+  for (;;) {
+    // After the first chunk, recordData writes at the next offset and
+    // writeFile appends
+    ::CORBA::Boolean replace = stream.replace && index == 0;
+    ::CORBA::Exception* error = NULL;
+    unsigned long checksum = 0;
+    std::string digest;
+    bool lost = false;
+
+    if (!stored.empty()) {
+      // Held by the chunk store, read instead of received. The store
+      // checks it against the offered digest and drops it if corrupted
+      unsigned long begin = index * stream.chunkSize;
+      unsigned long length =
+        std::min<unsigned long>(stream.chunkSize, stream.length - begin);
+      ::CORBA::Octet* buffer = SeqOctet::allocbuf(length);
+      owned = new SeqOctet(length, length, buffer, true);
+      chunk = owned;
+      // Dropped from the store if lost or corrupted: sent again
+      lost = !stream.store->read(stored, buffer, length);
+      stream.store->release(stored);
+      stored.clear();
+    } else if (mchunkStore != NULL) {
+      // Received: checked against the offered digest, then stored
+      digest = Sha256::digest(chunk->get_buffer(), chunk->length());
+      if (!stream.digests.empty() && digest != stream.digests[index]) {
+        error = new ::CORBA::MARSHAL(0, ::CORBA::COMPLETED_NO);
+      }
+    }
+    if (error == NULL && !lost && stream.journal != NULL) {
+      checksum = StreamJournal::checksum(chunk->get_buffer(),
+                                         chunk->length());
+      if (checksum != stream.checksums[index]) {
+        error = new ::CORBA::MARSHAL(0, ::CORBA::COMPLETED_NO);
+      }
+    }
+    try {
+      if (error != NULL || lost) {
+        // Corrupted or missing chunk, not made
+      } else if (stream.record) {
+        stream.result =
+          recordDataOctets(*chunk, stream.desc, replace,
+                           stream.offset + index * stream.chunkSize,
+                           stream.objName.c_str());
+      } else {
+        stream.result =
+          writeFileOctets(*chunk, stream.basename.c_str(), replace,
+                          stream.objName.c_str());
+      }
+    } catch (const ::CORBA::Exception& err) {
+      error = err._NP_duplicate();
+    }
+    if (error == NULL && !lost && stream.journal != NULL) {
+      try {
+        stream.journal->commit(index, checksum);
+      } catch (const std::runtime_error&) {
+        // Not journaled: made again if the transfer is resumed
+      }
+    }
+    if (error == NULL && !digest.empty()) {
+      mchunkStore->put(digest, chunk->get_buffer(), chunk->length());
+    }
+    delete owned;
+    owned = NULL;
+    if (mapped) {
+      // The chunk was read back from the spool file: drop its pages
+      stream.spool->release((index % stream.slots) * stream.chunkSize,
+                            chunk->length());
+      mapped = false;
+    }
+
+    mstreamMutex.lock();
+    if (lost) {
+      // Made by writeChunk, when asked by missingChunks
+      stream.applying = false;
+      mstreamCond.broadcast();
+      mstreamMutex.unlock();
+      return;
+    }
+    ++stream.next;
+    // Room for a chunk waiting in writeChunk
+    mstreamCond.broadcast();
+    if (error != NULL && stream.error == NULL) {
+      stream.error = error;
+    } else {
+      delete error;
+    }
+    index = stream.next;
+    it = stream.pending.find(index);
+    if (stream.error == NULL && it != stream.pending.end()) {
+      owned = it->second;
+      chunk = owned;
+      stream.pending.erase(it);
+    } else if (stream.error == NULL && stream.spooled.erase(index) > 0) {
+      unsigned long begin = index * stream.chunkSize;
+      unsigned long length =
+        std::min<unsigned long>(stream.chunkSize, stream.length - begin);
+      const char* slot =
+        stream.mapping + (index % stream.slots) * stream.chunkSize;
+      // A view of the slot of the mapping, without copy
+      view.replace(length, length,
+                   reinterpret_cast< ::CORBA::Octet*>(
+                     const_cast<char*>(slot)), false);
+      chunk = &view;
+      mapped = true;
+    } else if (stream.error == NULL
+               && (held = stream.stored.find(index)) != stream.stored.end()) {
+      stored = held->second;
+      stream.stored.erase(held);
+    } else {
+      stream.applying = false;
+      mstreamCond.broadcast();
+      mstreamMutex.unlock();
+      return;
+    }
+    mstreamMutex.unlock();
+  }
+}
+
+char*
+CorbaForwarder::commitStream(::CORBA::Long id) {
+  std::map< ::CORBA::Long, Stream*>::iterator it;
+  OperationStats::Call stats(mstats, "commitStream", true);
+  Stream* stream;
+
+  mstreamMutex.lock();
+  it = mstreams.find(id);
+  if (it == mstreams.end()) {
+    mstreamMutex.unlock();
+    throw ::CORBA::OBJECT_NOT_EXIST(0, ::CORBA::COMPLETED_NO);
+  }
+  stream = it->second;
+  stream->committing = true;
+  // All the chunks were received, wait for their calls
+  while (stream->applying || stream->writers > 0
+         || (stream->error == NULL && stream->next < stream->count)) {
+    mstreamCond.wait();
+  }
+  mstreams.erase(id);
+  if (stream->journal != NULL && stream->error == NULL) {
+    // The transfer ended, there is nothing left to resume
+    mjournals.erase(stream->key);
+    stream->journal->remove();
+    delete stream->journal;
+    stream->journal = NULL;
+  }
+  mstreamMutex.unlock();
+
+  std::auto_ptr<Stream> owner(stream);
+  if (stream->error != NULL) {
+    stream->error->_raise();
+  }
+  if (stream->result.in() == NULL) {
+    return ::CORBA::string_dup("");
+  }
+  return stream->result._retn();
+}
+
+void
+CorbaForwarder::abortStream(::CORBA::Long id) {
+  OperationStats::Call stats(mstats, "abortStream", true);
+
+  // The journal of a resumable stream is kept
+  mstreamMutex.lock();
+  stopStream(id);
+  mstreamMutex.unlock();
+}
@@ -0,0 +1,44 @@
+/**
+ * @file OctetView.cc
+ *
+ * @brief  Views of the Dagda data as octets or as chars, without copy
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "OctetView.hh"
+
+const SeqOctet&
+octetView(const SeqChar& data, SeqOctet& view) {
+  // A char and an octet have the same size: the buffer is shared as is,
+  // without release by the view
+  const CORBA::Char* buffer = data.get_buffer();
+  view.replace(data.maximum(), data.length(),
+               reinterpret_cast<CORBA::Octet*>(
+                 const_cast<CORBA::Char*>(buffer)), false);
+  return view;
+}
+
+const SeqChar&
+charView(const SeqOctet& data, SeqChar& view) {
+  const CORBA::Octet* buffer = data.get_buffer();
+  view.replace(data.maximum(), data.length(),
+               reinterpret_cast<CORBA::Char*>(
+                 const_cast<CORBA::Octet*>(buffer)), false);
+  return view;
+}
+
+const corba_octet_data_t&
+octetView(const corba_data_t& data, corba_octet_data_t& view) {
+  view.desc = data.desc;
+  octetView(data.value, view.value);
+  return view;
+}
+
+const corba_data_t&
+charView(const corba_octet_data_t& data, corba_data_t& view) {
+  view.desc = data.desc;
+  charView(data.value, view.value);
+  return view;
+}
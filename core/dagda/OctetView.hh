@@ -0,0 +1,55 @@
+/**
+ * @file OctetView.hh
+ *
+ * @brief  Views of the Dagda data as octets or as chars, without copy
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef _OCTETVIEW_HH_
+#define _OCTETVIEW_HH_
+
+#include "common_types.hh"
+
+/**
+ * @brief Make an octet sequence sharing the buffer of a char sequence.
+ * The view does not own the buffer: it must not outlive the data and
+ * must not be modified.
+ * @param data The char sequence
+ * @param view The sequence made a view of the data
+ * @return The view
+ */
+const SeqOctet&
+octetView(const SeqChar& data, SeqOctet& view);
+
+/**
+ * @brief Make a char sequence sharing the buffer of an octet sequence.
+ * @param data The octet sequence
+ * @param view The sequence made a view of the data
+ * @return The view
+ */
+const SeqChar&
+charView(const SeqOctet& data, SeqChar& view);
+
+/**
+ * @brief Make an octet data sharing the value of a char data. The
+ * description is copied.
+ * @param data The char data
+ * @param view The data made a view of the data
+ * @return The view
+ */
+const corba_octet_data_t&
+octetView(const corba_data_t& data, corba_octet_data_t& view);
+
+/**
+ * @brief Make a char data sharing the value of an octet data. The
+ * description is copied.
+ * @param data The octet data
+ * @param view The data made a view of the data
+ * @return The view
+ */
+const corba_data_t&
+charView(const corba_octet_data_t& data, corba_data_t& view);
+
+#endif
@@ -15,6 +15,7 @@
 #include <string>
 #include <iostream>
 #include <stdio.h>
+#include <boost/bind.hpp>
 
 ::CORBA::Long
 CorbaForwarder::agentSubscribe(const char* agentName,
@@ -22,15 +23,17 @@ CorbaForwarder::agentSubscribe(const char* agentName,
                               const ::SeqCorbaProfileDesc_t& services,
                               const char* objName)
 {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "agentSubscribe", route.remote());
+  servicesChanged(route);
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->agentSubscribe(agentName, hostname,
-                                     services, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->agentSubscribe(agentName, hostname,
+                                            services, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -41,14 +44,16 @@ CorbaForwarder::agentSubscribe(const char* agentName,
 CorbaForwarder::serverSubscribe(const char* seDName, const char* hostname,
                                const ::SeqCorbaProfileDesc_t& services,
                                const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "serverSubscribe", route.remote());
+  servicesChanged(route);
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->serverSubscribe(seDName, hostname,
-                                      services, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->serverSubscribe(seDName, hostname,
+                                             services, route.peerName());
   }
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -59,14 +64,17 @@ CorbaForwarder::serverSubscribe(const char* seDName, const char* hostname,
 CorbaForwarder::childUnsubscribe(::CORBA::ULong childID,
                                 const ::SeqCorbaProfileDesc_t& services,
                                 const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "childUnsubscribe", route.remote());
+  servicesChanged(route);
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->childUnsubscribe(childID, services, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->childUnsubscribe(childID, services,
+                                                   route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -77,14 +85,17 @@ CorbaForwarder::childUnsubscribe(::CORBA::ULong childID,
 CorbaForwarder::childRemoveService(::CORBA::ULong childID,
                                   const ::corba_profile_desc_t& profile,
                                   const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "childRemoveService", route.remote());
+  servicesChanged(route);
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->childRemoveService(childID, profile, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->childRemoveService(childID, profile,
+                                                     route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -95,14 +106,16 @@ CorbaForwarder::childRemoveService(::CORBA::ULong childID,
 CorbaForwarder::addServices(::CORBA::ULong myID,
                            const ::SeqCorbaProfileDesc_t& services,
                            const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "addServices", route.remote());
+  servicesChanged(route);
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->addServices(myID, services, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->addServices(myID, services, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -112,14 +125,19 @@ CorbaForwarder::addServices(::CORBA::ULong myID,
 void
 CorbaForwarder::getResponse(const ::corba_response_t& resp,
                            const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::getResponse, this, resp,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getResponse", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getResponse(resp, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getResponse(resp, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -128,14 +146,21 @@ CorbaForwarder::getResponse(const ::corba_response_t& resp,
 
 char*
 CorbaForwarder::getDataManager(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getDataManager", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getDataManager(objString.c_str());
+  if (!route.remote()) {
+    char* result = findString(routeKey(route), "getDataManager");
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getDataManager(route.peerName());
+      cacheString(routeKey(route), "getDataManager", result, generation);
+    }
+    return result;
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -146,14 +171,15 @@ SeqString*
 CorbaForwarder::searchData(const char* request,
                           const char* objName)
 {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "searchData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->searchData(request, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->searchData(request, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Agent_var agent =
     ORBMgr::getMgr()->resolve<Agent, Agent_var>(AGENTCTXT, name, this->mname);
@@ -33,41 +33,40 @@ extern unsigned int TRACE_LEVEL;
 #define MAX_HOSTNAME_LENGTH  256
 
 // Forwarder part
-AgentFwdrImpl::AgentFwdrImpl(Forwarder_ptr fwdr, const char* objName) {
+AgentFwdrImpl::AgentFwdrImpl(Forwarder_ptr fwdr) {
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 CORBA::Long
 AgentFwdrImpl::agentSubscribe(const char* me, const char* hostName,
                               const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->agentSubscribe(me, hostName, services, mobjName);
+  return mforwarder->agentSubscribe(me, hostName, services, objName());
 }
 
 CORBA::Long
 AgentFwdrImpl::serverSubscribe(const char* me, const char* hostName,
                                const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->serverSubscribe(me, hostName, services, mobjName);
+  return mforwarder->serverSubscribe(me, hostName, services, objName());
 }
 
 CORBA::Long
 AgentFwdrImpl::childUnsubscribe(CORBA::ULong childID,
                                 const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->childUnsubscribe(childID, services, mobjName);
+  return mforwarder->childUnsubscribe(childID, services, objName());
 }
 
 CORBA::Long
 AgentFwdrImpl::removeElement(bool recursive) {
-  return mforwarder->removeElement(recursive, mobjName);
+  return mforwarder->removeElement(recursive, objName());
 }
 
 CORBA::Long
 AgentFwdrImpl::bindParent(const char* parent) {
-  return mforwarder->bindParent(parent, mobjName);
+  return mforwarder->bindParent(parent, objName());
 }
 CORBA::Long
 AgentFwdrImpl::disconnect() {
-  return mforwarder->disconnect(mobjName);
+  return mforwarder->disconnect(objName());
 }
 
 
@@ -75,32 +74,32 @@ AgentFwdrImpl::disconnect() {
 CORBA::Long
 AgentFwdrImpl::childRemoveService(CORBA::ULong childID,
                                   const corba_profile_desc_t& profile) {
-  return mforwarder->childRemoveService(childID, profile, mobjName);
+  return mforwarder->childRemoveService(childID, profile, objName());
 }
 
 char* AgentFwdrImpl::getDataManager() {
-  return mforwarder->getDataManager(mobjName);
+  return mforwarder->getDataManager(objName());
 }
 
 SeqString*
 AgentFwdrImpl::searchData(const char* request) {
-  return mforwarder->searchData(request, mobjName);
+  return mforwarder->searchData(request, objName());
 }
 
 CORBA::Long
 AgentFwdrImpl::addServices(CORBA::ULong myID,
                            const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->addServices(myID, services, mobjName);
+  return mforwarder->addServices(myID, services, objName());
 }
 
 void AgentFwdrImpl::getResponse(const corba_response_t& resp) {
-  mforwarder->getResponse(resp, mobjName);
+  mforwarder->getResponse(resp, objName());
 }
 
 CORBA::Long AgentFwdrImpl::ping() {
-  return mforwarder->ping(mobjName);
+  return mforwarder->ping(objName());
 }
 
 char* AgentFwdrImpl::getHostname() {
-  return mforwarder->getHostname(mobjName);
+  return mforwarder->getHostname(objName());
 }
@@ -26,6 +26,7 @@
 
 // Forwarder part
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "AgentFwdr.hh"
 
 
@@ -36,9 +37,10 @@
  * @class AgentFwdrImpl
  */
 class AgentFwdrImpl : public POA_AgentFwdr,
-                      public PortableServer::RefCountServantBase {
+                      public PortableServer::RefCountServantBase,
+                      public ProxyServant {
 public:
-  AgentFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit AgentFwdrImpl(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   agentSubscribe(const char* me, const char* hostName,
@@ -84,6 +86,5 @@ public:
 
 protected:
   Forwarder_ptr mforwarder;
-  char* mobjName;
 };
 #endif  // _AGENTIMPL_HH_
@@ -17,14 +17,16 @@
 ::CORBA::Long
 CorbaForwarder::notifyResults(const char* path, const ::corba_profile_t& pb,
                              ::CORBA::Long reqID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "notifyResults", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->notifyResults(path, pb, reqID, objString.c_str());
+  if (!route.remote()) {
+    return getBulkPeer(route)->notifyResults(path, pb, reqID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Callback_var cb =
     ORBMgr::getMgr()->resolve<Callback, Callback_var>(CLIENTCTXT, name,
@@ -37,14 +39,17 @@ CorbaForwarder::solveResults(const ::corba_profile_t& pb,
                             ::CORBA::Long reqID,
                             ::CORBA::Long result,
                             const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  BulkCall bulk(*this, route);
+  OperationStats::Call stats(mstats, "solveResults", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->solveResults(pb, reqID, result, objString.c_str());
+  if (!route.remote()) {
+    return getBulkPeer(route)->solveResults(pb, reqID, result,
+                                            route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   Callback_var cb =
     ORBMgr::getMgr()->resolve<Callback, Callback_var>(CLIENTCTXT, name,
@@ -19,23 +19,22 @@ using namespace std;
 #include "CallbackFwdr.hh"
 
 
-CallbackFwdrImpl::CallbackFwdrImpl(Forwarder_ptr fwdr, const char* objName) {
+CallbackFwdrImpl::CallbackFwdrImpl(Forwarder_ptr fwdr) {
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 CORBA::Long CallbackFwdrImpl::ping() {
-  return mforwarder->ping(mobjName);
+  return mforwarder->ping(objName());
 }
 
 CORBA::Long CallbackFwdrImpl::notifyResults(const char * path,
                                             const corba_profile_t& pb,
                                             CORBA::Long reqID) {
-  return mforwarder->notifyResults(path, pb, reqID, mobjName);
+  return mforwarder->notifyResults(path, pb, reqID, objName());
 }
 
 CORBA::Long CallbackFwdrImpl::solveResults(const corba_profile_t& pb,
                                            CORBA::Long reqID,
                                            CORBA::Long solve_res) {
-  return mforwarder->solveResults(pb, reqID, solve_res, mobjName);
+  return mforwarder->solveResults(pb, reqID, solve_res, objName());
 }
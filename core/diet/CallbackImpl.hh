@@ -17,6 +17,7 @@
 #include "Callback.hh"
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "CallbackFwdr.hh"
 
 
@@ -27,9 +28,10 @@
  * @class CallbackFwdrImpl
  */
 class CallbackFwdrImpl : public POA_CallbackFwdr,
-                         public PortableServer::RefCountServantBase {
+                         public PortableServer::RefCountServantBase,
+                         public ProxyServant {
 public:
-  CallbackFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit CallbackFwdrImpl(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   ping();
@@ -46,7 +48,6 @@ public:
 
 private:
   Forwarder_ptr mforwarder;
-  char* mobjName;
 };
 
 #endif
@@ -21,15 +21,16 @@ CorbaForwarder::execNodeOnSed(const char* node_id,
                              ::CORBA::ULong reqID,
                              ::corba_estimation_t& ev,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "execNodeOnSed", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->execNodeOnSed(node_id, dag_id, seDName,
-                                    reqID, ev, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->execNodeOnSed(node_id, dag_id, seDName,
+                                           reqID, ev, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   CltMan_var clt =
     ORBMgr::getMgr()->resolve<CltMan, CltMan_var>(WFMGRCTXT, name, this->mname);
@@ -40,14 +41,15 @@ CorbaForwarder::execNodeOnSed(const char* node_id,
 CorbaForwarder::execNode(const char* node_id,
                         const char* dag_id,
                         const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "execNode", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->execNode(node_id, dag_id, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->execNode(node_id, dag_id, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   CltMan_var clt =
     ORBMgr::getMgr()->resolve<CltMan, CltMan_var>(WFMGRCTXT, name, this->mname);
@@ -58,14 +60,15 @@ char*
 CorbaForwarder::release(const char* dag_id,
                        ::CORBA::Boolean successful,
                        const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "release", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->release(dag_id, successful, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->release(dag_id, successful, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   CltMan_var clt =
     ORBMgr::getMgr()->resolve<CltMan, CltMan_var>(WFMGRCTXT, name, this->mname);
@@ -13,36 +13,35 @@
  */
 #include "CltWfMgrImpl.hh"
 
-/* Constructor takes the object name and the forwarder to use to
- * contact the object.
+/* Constructor takes the forwarder to use to contact the objects, the
+ * object name is the identifier of the request target.
  */
-CltWfMgrFwdr::CltWfMgrFwdr(Forwarder_ptr fwdr, const char *objName) {
+CltWfMgrFwdr::CltWfMgrFwdr(Forwarder_ptr fwdr) {
   this->forwarder = Forwarder::_duplicate(fwdr);
-  this->objName = CORBA::string_dup(objName);
 }
 
 /* Each method simply calls the forwarder correponding method. */
-/* i.e: fun(a, b, ...) => forwarder->fun(a, b, ..., objName) */
+/* i.e: fun(a, b, ...) => forwarder->fun(a, b, ..., objName()) */
 CORBA::Long
 CltWfMgrFwdr::execNodeOnSed(const char *node_id,
                             const char *dag_id,
                             const char *sed,
                             const CORBA::ULong reqID,
                             corba_estimation_t &ev) {
-  return forwarder->execNodeOnSed(node_id, dag_id, sed, reqID, ev, objName);
+  return forwarder->execNodeOnSed(node_id, dag_id, sed, reqID, ev, objName());
 }
 
 CORBA::Long
 CltWfMgrFwdr::execNode(const char *node_id, const char *dag_id) {
-  return forwarder->execNode(node_id, dag_id, objName);
+  return forwarder->execNode(node_id, dag_id, objName());
 }
 
 char *
 CltWfMgrFwdr::release(const char *dag_id, bool successful) {
-  return forwarder->release(dag_id, successful, objName);
+  return forwarder->release(dag_id, successful, objName());
 }
 
 CORBA::Long
 CltWfMgrFwdr::ping() {
-  return forwarder->ping(objName);
+  return forwarder->ping(objName());
 }
@@ -16,6 +16,7 @@
 #define __CLTWFMGRFWDR__HH__
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 /**
  * @brief The CltWfMgr forwarder class that implements all the workflows methods
  * throught the forwarder
@@ -24,9 +25,10 @@
  */
 /* Forwarder part. */
 class CltWfMgrFwdr : public POA_CltManFwdr,
-public PortableServer::RefCountServantBase {
+public PortableServer::RefCountServantBase,
+public ProxyServant {
 public:
-  CltWfMgrFwdr(Forwarder_ptr fwdr, const char *objName);
+  explicit CltWfMgrFwdr(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   execNodeOnSed(const char *node_id, const char *dag_id,
@@ -44,7 +46,6 @@ public:
 
 private:
   Forwarder_ptr forwarder;
-  char *objName;
 };
 
 #endif // __CLTWFMGRFWDR__HH__
@@ -14,6 +14,7 @@
 
 #include "Forwarder.hh"
 #include "ORBMgr.hh"
+#include "ProxyServant.hh"
 #include "common_types.hh"
 
 #include "AgentImpl.hh"
@@ -36,6 +37,7 @@
 #include <string>
 #include <cstring>
 #include <list>
+#include <map>
 #include <unistd.h>  // For gethostname()
 
 #ifdef MAXHOSTNAMELEN
@@ -49,315 +51,92 @@
 /* Corba object factory methods. */
 Agent_ptr
 CorbaForwarder::getAgent(const char* name) {
+  OperationStats::Call stats(mstats, "getAgent", true);
   std::string nm(name);
-  ::CORBA::Object_ptr object;
+  std::map<std::string, ProxyType>::const_iterator it;
+  ::CORBA::Object_var object;
 
   if (nm.find('/') == std::string::npos) {
     nm = std::string(AGENTCTXT)+"/"+nm;
   }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else
-      return Agent::_duplicate(Agent::_narrow(object));
-  }
-
-  AgentFwdrImpl * agent = new AgentFwdrImpl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(agent);
-
+  /* The local and master agents binded here keep their interface. */
   mcachesMutex.lock();
-  mservants[nm] = agent;
-  mobjectCache[nm] = CORBA::Object::_duplicate(agent->_this());
+  it = magents.find(nm);
+  ProxyType type = (it != magents.end()) ? it->second : PROXY_AGENT;
   mcachesMutex.unlock();
 
-  return Agent::_duplicate(agent->_this());
+  switch (type) {
+  case PROXY_LOCALAGENT:
+    object = getProxy(type, AGENTCTXT, nm.c_str(),
+                      newProxyServant<LocalAgentFwdrImpl>);
+    break;
+  case PROXY_MASTERAGENT:
+    object = getProxy(type, AGENTCTXT, nm.c_str(),
+                      newProxyServant<MasterAgentFwdrImpl>);
+    break;
+  default:
+    object = getProxy(type, AGENTCTXT, nm.c_str(),
+                      newProxyServant<AgentFwdrImpl>);
+  }
+  return Agent::_narrow(object);
 }
 
 Callback_ptr
 CorbaForwarder::getCallback(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(CLIENTCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else
-      return Callback::_duplicate(Callback::_narrow(object));
-  }
-
-  CallbackFwdrImpl * callback = new CallbackFwdrImpl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(callback);
-
-  mcachesMutex.lock();
-  mservants[nm] = callback;
-  mobjectCache[nm] = CORBA::Object::_duplicate(callback->_this());
-  mcachesMutex.unlock();
-
-  return Callback::_duplicate(callback->_this());
+  OperationStats::Call stats(mstats, "getCallback", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_CALLBACK, CLIENTCTXT, name,
+             newProxyServant<CallbackFwdrImpl>);
+  return Callback::_narrow(object);
 }
 
 LocalAgent_ptr
 CorbaForwarder::getLocalAgent(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(AGENTCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else
-      return LocalAgent::_duplicate(LocalAgent::_narrow(object));
-  }
-  LocalAgentFwdrImpl * agent = new LocalAgentFwdrImpl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(agent);
-
-  mcachesMutex.lock();
-  mservants[nm] = agent;
-  mobjectCache[nm] = CORBA::Object::_duplicate(agent->_this());
-  mcachesMutex.unlock();
-
-  return LocalAgent::_duplicate(agent->_this());
+  OperationStats::Call stats(mstats, "getLocalAgent", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_LOCALAGENT, AGENTCTXT, name,
+             newProxyServant<LocalAgentFwdrImpl>);
+  return LocalAgent::_narrow(object);
 }
 
 MasterAgent_ptr
 CorbaForwarder::getMasterAgent(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(AGENTCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else
-      return MasterAgent::_duplicate(MasterAgent::_narrow(object));
-  }
-  MasterAgentFwdrImpl *agent =
-    new MasterAgentFwdrImpl(this->_this(), nm.c_str());
-  ORBMgr::getMgr()->activate(agent);
-
-  mcachesMutex.lock();
-  mservants[nm] = agent;
-  mobjectCache[nm] = CORBA::Object::_duplicate(agent->_this());
-  mcachesMutex.unlock();
-
-  return MasterAgent::_duplicate(agent->_this());
+  OperationStats::Call stats(mstats, "getMasterAgent", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_MASTERAGENT, AGENTCTXT, name,
+             newProxyServant<MasterAgentFwdrImpl>);
+  return MasterAgent::_narrow(object);
 }
 
 SeD_ptr
 CorbaForwarder::getSeD(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') ==
-      std::string::npos) {
-    nm = std::string(SEDCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return SeD::_duplicate(SeD::_narrow(object));
-    }
-  }
-
-  SeDFwdrImpl * sed = new SeDFwdrImpl(this->_this(), nm.c_str());
-  ORBMgr::getMgr()->activate(sed);
-
-  mcachesMutex.lock();
-  mobjectCache[nm] = CORBA::Object::_duplicate(sed->_this());
-  mservants[nm] = sed;
-  mcachesMutex.unlock();
-
-  return SeD::_duplicate(sed->_this());
+  OperationStats::Call stats(mstats, "getSeD", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_SED, SEDCTXT, name, newProxyServant<SeDFwdrImpl>);
+  return SeD::_narrow(object);
 }
 
-//Dagda_ptr
-//CorbaForwarder::getDagda(const char* name) {
-//  std::string nm(name);
-//  ::CORBA::Object_ptr object;
-//
-//  if (nm.find('/') == std::string::npos) {
-//    nm = std::string(DAGDACTXT)+"/"+nm;
-//  }
-//  object = getObjectCache(nm);
-//  if (!CORBA::is_nil(object)) {
-//    if (object->_non_existent()) {
-//      removeObjectFromCache(name);
-//    } else
-//      return Dagda::_duplicate(Dagda::_narrow(object));
-//  }
-//  DagdaFwdrImpl * dagda = new DagdaFwdrImpl(this->_this(), nm.c_str());
-//  ORBMgr::getMgr()->activate(dagda);
-//
-//  mcachesMutex.lock();
-//  mservants[nm] = dagda;
-//  mobjectCache[nm] = CORBA::Object::_duplicate(dagda->_this());
-//  mcachesMutex.unlock();
-//
-//  return Dagda::_duplicate(dagda->_this());
-//}
-
 CltMan_ptr
 CorbaForwarder::getCltMan(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(WFMGRCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return CltManFwdr::_duplicate(CltManFwdr::_narrow(object));
-    }
-  }
-
-  CltWfMgrFwdr * mgr = new CltWfMgrFwdr(this->_this(), nm.c_str());
-  ORBMgr::getMgr()->activate(mgr);
-
-  mcachesMutex.lock();
-  mservants[nm] = mgr;
-  mobjectCache[nm] = CORBA::Object::_duplicate(mgr->_this());
-  mcachesMutex.unlock();
-
-  return CltManFwdr::_duplicate(mgr->_this());
+  OperationStats::Call stats(mstats, "getCltMan", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_CLTMAN, WFMGRCTXT, name, newProxyServant<CltWfMgrFwdr>);
+  return CltManFwdr::_narrow(object);
 }
 
 MaDag_ptr
 CorbaForwarder::getMaDag(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(AGENTCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return MaDag::_duplicate(MaDag::_narrow(object));
-    }
-  }
-
-  MaDagFwdrImpl * madag = new MaDagFwdrImpl(this->_this(), nm.c_str());
-  ORBMgr::getMgr()->activate(madag);
-
-  mcachesMutex.lock();
-  mservants[nm] = madag;
-  mobjectCache[nm] = CORBA::Object::_duplicate(madag->_this());
-  mcachesMutex.unlock();
-
-  return MaDag::_duplicate(madag->_this());
+  OperationStats::Call stats(mstats, "getMaDag", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_MADAG, AGENTCTXT, name, newProxyServant<MaDagFwdrImpl>);
+  return MaDag::_narrow(object);
 }
 
 WfLogService_ptr
 CorbaForwarder::getWfLogService(const char* name) {
-  std::string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == std::string::npos) {
-    nm = std::string(WFLOGCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return WfLogService::_duplicate(WfLogService::_narrow(object));
-    }
-  }
-
-  WfLogServiceFwdrImpl *wfl =
-    new WfLogServiceFwdrImpl(this->_this(), nm.c_str());
-  ORBMgr::getMgr()->activate(wfl);
-
-  mcachesMutex.lock();
-  mobjectCache[nm] = CORBA::Object::_duplicate(wfl->_this());
-  mservants[nm] = wfl;
-  mcachesMutex.unlock();
-
-  return WfLogService::_duplicate(wfl->_this());
+  OperationStats::Call stats(mstats, "getWfLogService", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_WFLOGSERVICE, WFLOGCTXT, name,
+             newProxyServant<WfLogServiceFwdrImpl>);
+  return WfLogService::_narrow(object);
 }
-
-
-//::CORBA::Long
-//CorbaForwarder::disconnect(const char* objName) {
-//  std::string objString(objName);
-//  std::string name;
-//  std::string ctxt;
-//
-//  if (!remoteCall(objString)) {
-//    return getPeer()->disconnect(objString.c_str());
-//  }
-//
-//  name = objString;
-//
-//  if (name.find('/') == std::string::npos)
-//    throw BadNameException(name.c_str(), __FUNCTION__, getName());
-//
-//  ctxt = getCtxt(objString);
-//  name = getName(objString);
-//
-//  if (ctxt == std::string(AGENTCTXT)) {
-//    LocalAgent_var agent =
-//      ORBMgr::getMgr()->resolve<LocalAgent, LocalAgent_var>(ctxt, name,
-//                                                            this->mname);
-//    return agent->disconnect();
-//  }
-//  if (ctxt == std::string(SEDCTXT)) {
-//    SeD_var sed = ORBMgr::getMgr()->resolve<SeD, SeD_var>(ctxt, name,
-//                                                          this->mname);
-//    return sed->disconnect();
-//  }
-//  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
-//}
-
-//::CORBA::Long
-//CorbaForwarder::removeElement(::CORBA::Boolean recursive, const char* objName) {
-//  std::string objString(objName);
-//  std::string name;
-//  std::string ctxt;
-//
-//  if (!remoteCall(objString)) {
-//    return getPeer()->removeElement(recursive, objString.c_str());
-//  }
-//
-//  name = objString;
-//
-//  if (name.find('/') == std::string::npos) {
-//    throw BadNameException(name.c_str(), __FUNCTION__, getName());
-//  }
-//
-//  ctxt = getCtxt(objString);
-//  name = getName(objString);
-//
-//  if (ctxt == std::string(AGENTCTXT)) {
-//    Agent_var agent = ORBMgr::getMgr()->resolve<Agent, Agent_var>(ctxt, name,
-//                                                                  this->mname);
-//    return agent->removeElement(recursive);
-//  }
-//  if (ctxt == std::string(SEDCTXT)) {
-//    SeD_var sed =
-//      ORBMgr::getMgr()->resolve<SeD, SeD_var>(ctxt, name, this->mname);
-//    return sed->removeElement();
-//  }
-//  throw BadNameException(objString.c_str(), __FUNCTION__, getName());
-//}
-
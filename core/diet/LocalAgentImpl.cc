@@ -24,81 +24,79 @@ extern unsigned int TRACE_LEVEL;
   TRACE_FUNCTION(TRACE_ALL_STEPS, formatted_text)
 
 
-LocalAgentFwdrImpl::LocalAgentFwdrImpl(Forwarder_ptr fwdr,
-                                       const char* objName) {
+LocalAgentFwdrImpl::LocalAgentFwdrImpl(Forwarder_ptr fwdr) {
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::agentSubscribe(const char* me, const char* hostName,
                                    const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->agentSubscribe(me, hostName, services, mobjName);
+  return mforwarder->agentSubscribe(me, hostName, services, objName());
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::serverSubscribe(const char* me, const char* hostName,
                                     const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->serverSubscribe(me, hostName, services, mobjName);
+  return mforwarder->serverSubscribe(me, hostName, services, objName());
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::childUnsubscribe(CORBA::ULong childID,
                                      const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->childUnsubscribe(childID, services, mobjName);
+  return mforwarder->childUnsubscribe(childID, services, objName());
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::bindParent(const char * parentName) {
-  return mforwarder->bindParent(parentName, mobjName);
+  return mforwarder->bindParent(parentName, objName());
 }
 
 CORBA::Long LocalAgentFwdrImpl::disconnect() {
-  return mforwarder->disconnect(mobjName);
+  return mforwarder->disconnect(objName());
 }
 
 CORBA::Long LocalAgentFwdrImpl::removeElement(bool recursive) {
-  return mforwarder->removeElement(recursive, mobjName);
+  return mforwarder->removeElement(recursive, objName());
 }
 
 SeqString*
 LocalAgentFwdrImpl::searchData(const char* request) {
-  return mforwarder->searchData(request, mobjName);
+  return mforwarder->searchData(request, objName());
 }
 
 void
 LocalAgentFwdrImpl::getRequest(const corba_request_t& req) {
-  mforwarder->getRequest(req, mobjName);
+  mforwarder->getRequest(req, objName());
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::addServices(CORBA::ULong myID,
                                 const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->addServices(myID, services, mobjName);
+  return mforwarder->addServices(myID, services, objName());
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::childRemoveService(CORBA::ULong childID,
                                        const corba_profile_desc_t& profile) {
-  return mforwarder->childRemoveService(childID, profile, mobjName);
+  return mforwarder->childRemoveService(childID, profile, objName());
 }
 
 char*
 LocalAgentFwdrImpl::getDataManager() {
-  return mforwarder->getDataManager(mobjName);
+  return mforwarder->getDataManager(objName());
 }
 
 void
 LocalAgentFwdrImpl::getResponse(const corba_response_t& resp) {
-  mforwarder->getResponse(resp, mobjName);
+  mforwarder->getResponse(resp, objName());
 }
 
 CORBA::Long
 LocalAgentFwdrImpl::ping() {
-  return mforwarder->ping(mobjName);
+  return mforwarder->ping(objName());
 }
 
 char*
 LocalAgentFwdrImpl::getHostname() {
-  return mforwarder->getHostname(mobjName);
+  return mforwarder->getHostname(objName());
 }
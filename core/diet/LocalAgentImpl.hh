@@ -19,6 +19,7 @@
 #include "Agent.hh"
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "LocalAgentFwdr.hh"
 
 
@@ -29,9 +30,10 @@
  * @class LocalAgentFwdrImpl
  */
 class LocalAgentFwdrImpl : public POA_LocalAgentFwdr,
-                           public PortableServer::RefCountServantBase {
+                           public PortableServer::RefCountServantBase,
+                           public ProxyServant {
 public:
-  LocalAgentFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit LocalAgentFwdrImpl(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   agentSubscribe(const char* me, const char* hostName,
@@ -80,7 +82,6 @@ public:
 
 private:
   Forwarder_ptr mforwarder;
-  char* mobjName;
 };
 
 #endif  // _LOCALAGENTIMPL_HH_
@@ -19,15 +19,16 @@ CorbaForwarder::processDagWf(const ::corba_wf_desc_t& dag_desc,
                             const char* cltMgrRef,
                             ::CORBA::Long wfReqId,
                             const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "processDagWf", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->processDagWf(dag_desc, cltMgrRef,
-                                   wfReqId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->processDagWf(dag_desc, cltMgrRef,
+                                          wfReqId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MaDag_var agent =
     ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
@@ -40,16 +41,17 @@ CorbaForwarder::processMultiDagWf(const ::corba_wf_desc_t& dag_desc,
                                  ::CORBA::Long wfReqId,
                                  ::CORBA::Boolean release,
                                  const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "processMultiDagWf", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->processMultiDagWf(dag_desc, cltMgrRef,
-                                        wfReqId, release,
-                                        objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->processMultiDagWf(dag_desc, cltMgrRef,
+                                               wfReqId, release,
+                                               route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MaDag_var agent =
     ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
@@ -58,14 +60,15 @@ CorbaForwarder::processMultiDagWf(const ::corba_wf_desc_t& dag_desc,
 
 ::CORBA::Long
 CorbaForwarder::getWfReqId(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getWfReqId", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getWfReqId(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getWfReqId(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MaDag_var agent =
     ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
@@ -74,14 +77,15 @@ CorbaForwarder::getWfReqId(const char* objName) {
 
 void
 CorbaForwarder::releaseMultiDag(::CORBA::Long wfReqId, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "releaseMultiDag", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->releaseMultiDag(wfReqId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->releaseMultiDag(wfReqId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MaDag_var agent =
     ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
@@ -90,14 +94,15 @@ CorbaForwarder::releaseMultiDag(::CORBA::Long wfReqId, const char* objName) {
 
 void
 CorbaForwarder::cancelDag(::CORBA::Long dagId, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "cancelDag", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->cancelDag(dagId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->cancelDag(dagId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MaDag_var agent =
     ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
@@ -107,14 +112,15 @@ CorbaForwarder::cancelDag(::CORBA::Long dagId, const char* objName) {
 void
 CorbaForwarder::setPlatformType(::MaDag::pfmType_t pfmType,
                                const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "setPlatformType", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->setPlatformType(pfmType, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->setPlatformType(pfmType, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MaDag_var agent =
     ORBMgr::getMgr()->resolve<MaDag, MaDag_var>(MADAGCTXT, name, this->mname);
@@ -16,6 +16,7 @@
 #define __MADAGFWDRIMPL__HH__
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "MaDag.hh"
 
 /**
@@ -25,9 +26,10 @@
  * For non documented methods, please see the workflow and its parents idl interfaces.
  */
 class MaDagFwdrImpl : public POA_MaDag,
-public PortableServer::RefCountServantBase {
+public PortableServer::RefCountServantBase,
+public ProxyServant {
 public:
-  MaDagFwdrImpl(Forwarder_ptr fwdr, const char *objName);
+  explicit MaDagFwdrImpl(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   processDagWf(const corba_wf_desc_t &dag_desc, const char *cltMgrRef,
@@ -54,7 +56,6 @@ public:
 
 protected:
   Forwarder_ptr forwarder;
-  char *objName;
 };
 
 #endif // __MADAGFWDRIMPL__HH__
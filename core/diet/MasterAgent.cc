@@ -15,6 +15,7 @@
 
 #include <string>
 #include <iostream>
+#include <boost/bind.hpp>
 
 #include "dadi/Logging/ConsoleChannel.hh"
 #include "dadi/Logging/Logger.hh"
@@ -30,18 +31,19 @@ CorbaForwarder::submit(const ::corba_pb_desc_t& pb_profile,
                              dadi::Message::PRIO_DEBUG));
 
 
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "submit", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
+  if (!route.remote()) {
     mlogger->log(dadi::Message("CorbaForwarder",
-                               "Forwarder remote call submit(pb_profile, ...  " + objString + ")\n",
+                               "Forwarder remote call submit(pb_profile, ...  " + std::string(route.peerName()) + ")\n",
                                dadi::Message::PRIO_DEBUG));
 
-    return getPeer()->submit(pb_profile, maxServers, objString.c_str());
+    return getPeer(route)->submit(pb_profile, maxServers, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
 
     mlogger->log(dadi::Message("CorbaForwarder",
@@ -61,14 +63,15 @@ CorbaForwarder::submit(const ::corba_pb_desc_t& pb_profile,
 
 ::CORBA::Long
 CorbaForwarder::get_session_num(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "get_session_num", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->get_session_num(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->get_session_num(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -79,14 +82,15 @@ CorbaForwarder::get_session_num(const char* objName) {
 
 char*
 CorbaForwarder::get_data_id(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "get_data_id", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->get_data_id(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->get_data_id(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -97,14 +101,15 @@ CorbaForwarder::get_data_id(const char* objName) {
 
 ::CORBA::ULong
 CorbaForwarder::dataLookUp(const char* id, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "dataLookUp", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->dataLookUp(id, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->dataLookUp(id, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -115,14 +120,15 @@ CorbaForwarder::dataLookUp(const char* id, const char* objName) {
 
 corba_data_desc_t*
 CorbaForwarder::get_data_arg(const char* argID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "get_data_arg", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->get_data_arg(argID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->get_data_arg(argID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -133,14 +139,15 @@ CorbaForwarder::get_data_arg(const char* argID, const char* objName) {
 
 ::CORBA::Long
 CorbaForwarder::diet_free_pdata(const char* argID, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "diet_free_pdata", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->diet_free_pdata(argID, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->diet_free_pdata(argID, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -151,33 +158,44 @@ CorbaForwarder::diet_free_pdata(const char* argID, const char* objName) {
 
 SeqCorbaProfileDesc_t*
 CorbaForwarder::getProfiles(::CORBA::Long& length, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getProfiles", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getProfiles(length, objString.c_str());
+  if (!route.remote()) {
+    SeqCorbaProfileDesc_t* result =
+      findSequence<SeqCorbaProfileDesc_t>(routeKey(route), "getProfiles",
+                                          &length);
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getProfiles(length, route.peerName());
+      cacheSequence(routeKey(route), "getProfiles", *result, generation,
+                    length);
+    }
+    return sent(stats, result);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
                                                             name,
                                                             this->mname);
-  return agent->getProfiles(length);
+  return sent(stats, agent->getProfiles(length));
 }
 
 wf_response_t*
 CorbaForwarder::submit_pb_set(const ::corba_pb_desc_seq_t& seq_pb,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "submit_pb_set", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->submit_pb_set(seq_pb, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->submit_pb_set(seq_pb, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -193,15 +211,16 @@ CorbaForwarder::submit_pb_seq(const ::corba_pb_desc_seq_t& pb_seq,
                              ::CORBA::Long& firstReqId,
                              ::CORBA::Long& seqReqId,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "submit_pb_seq", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->submit_pb_seq(pb_seq, reqCount, complete, firstReqId,
-                                    seqReqId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->submit_pb_seq(pb_seq, reqCount, complete, firstReqId,
+                                           seqReqId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -214,14 +233,15 @@ CorbaForwarder::submit_pb_seq(const ::corba_pb_desc_seq_t& pb_seq,
 CorbaForwarder::insertData(const char* key,
                           const ::SeqString& values,
                           const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "insertData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->insertData(key, values, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->insertData(key, values, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -234,14 +254,15 @@ CorbaForwarder::insertData(const char* key,
 CorbaForwarder::handShake(const char* masterAgentName,
                          const char* myName,
                          const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "handShake", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->handShake(masterAgentName, myName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->handShake(masterAgentName, myName, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -252,14 +273,21 @@ CorbaForwarder::handShake(const char* masterAgentName,
 
 char*
 CorbaForwarder::getBindName(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getBindName", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getBindName(objString.c_str());
+  if (!route.remote()) {
+    char* result = findString(routeKey(route), "getBindName");
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getBindName(route.peerName());
+      cacheString(routeKey(route), "getBindName", result, generation);
+    }
+    return result;
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -273,15 +301,22 @@ CorbaForwarder::searchService(const char* masterAgentName,
                              const char* myName,
                              const ::corba_request_t& request,
                              const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::searchService, this,
+                                 CORBA::String_var(masterAgentName),
+                                 CORBA::String_var(myName), request,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "searchService", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->searchService(masterAgentName, myName,
-                                    request, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->searchService(masterAgentName, myName,
+                                           request, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -294,14 +329,20 @@ void
 CorbaForwarder::stopFlooding(::CORBA::Long reqId,
                             const char* senderId,
                             const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::stopFlooding, this, reqId,
+                                 CORBA::String_var(senderId),
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "stopFlooding", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->stopFlooding(reqId, senderId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->stopFlooding(reqId, senderId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -314,14 +355,20 @@ void
 CorbaForwarder::serviceNotFound(::CORBA::Long reqId,
                                const char* senderId,
                                const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::serviceNotFound, this, reqId,
+                                 CORBA::String_var(senderId),
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "serviceNotFound", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->serviceNotFound(reqId, senderId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->serviceNotFound(reqId, senderId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -334,14 +381,20 @@ void
 CorbaForwarder::newFlood(::CORBA::Long reqId,
                         const char* senderId,
                         const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::newFlood, this, reqId,
+                                 CORBA::String_var(senderId),
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "newFlood", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->newFlood(reqId, senderId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->newFlood(reqId, senderId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -354,14 +407,20 @@ void
 CorbaForwarder::floodedArea(::CORBA::Long reqId,
                            const char* senderId,
                            const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::floodedArea, this, reqId,
+                                 CORBA::String_var(senderId),
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "floodedArea", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->floodedArea(reqId, senderId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->floodedArea(reqId, senderId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -374,14 +433,20 @@ void
 CorbaForwarder::alreadyContacted(::CORBA::Long reqId,
                                 const char* senderId,
                                 const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::alreadyContacted, this,
+                                 reqId, CORBA::String_var(senderId),
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "alreadyContacted", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->alreadyContacted(reqId, senderId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->alreadyContacted(reqId, senderId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -394,14 +459,19 @@ void
 CorbaForwarder::serviceFound(::CORBA::Long reqId,
                             const ::corba_response_t& decision,
                             const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::serviceFound, this, reqId,
+                                 decision, CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "serviceFound", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->serviceFound(reqId, decision, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->serviceFound(reqId, decision, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   MasterAgent_var agent =
     ORBMgr::getMgr()->resolve<MasterAgent, MasterAgent_var>(AGENTCTXT,
@@ -38,8 +38,7 @@ omni_mutex reqCount_mutex;
 //  TRACE_FUNCTION(TRACE_ALL_STEPS, formatted_text)
 
 
-MasterAgentFwdrImpl::MasterAgentFwdrImpl(Forwarder_ptr fwdr,
-                                         const char* objName) {
+MasterAgentFwdrImpl::MasterAgentFwdrImpl(Forwarder_ptr fwdr) {
 // Init logger
   mlogger = dadi::LoggerPtr(dadi::Logger::getLogger("org.dadicorba"));
   mlogger->setLevel(dadi::Message::PRIO_TRACE);
@@ -47,7 +46,6 @@ MasterAgentFwdrImpl::MasterAgentFwdrImpl(Forwarder_ptr fwdr,
   mlogger->setChannel(mcc);
 
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 corba_response_t*
@@ -57,98 +55,98 @@ MasterAgentFwdrImpl::submit(const corba_pb_desc_t& pb_profile,
                              std::string(__FILE__) + ": "
                              + " (" + __FUNCTION__ + ")"
                              + "submit("
-                             + std::string(mobjName) + ")\n",
+                             + std::string(objName()) + ")\n",
                              dadi::Message::PRIO_DEBUG));
 
-  return mforwarder->submit(pb_profile, maxServers, mobjName);
+  return mforwarder->submit(pb_profile, maxServers, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::get_session_num() {
-  return mforwarder->get_session_num(mobjName);
+  return mforwarder->get_session_num(objName());
 }
 
 char*
 MasterAgentFwdrImpl::get_data_id() {
-  return mforwarder->get_data_id(mobjName);
+  return mforwarder->get_data_id(objName());
 }
 
 CORBA::ULong
 MasterAgentFwdrImpl::dataLookUp(const char* argID) {
-  return mforwarder->dataLookUp(argID, mobjName);
+  return mforwarder->dataLookUp(argID, objName());
 }
 
 corba_data_desc_t*
 MasterAgentFwdrImpl::get_data_arg(const char* argID) {
-  return mforwarder->get_data_arg(argID, mobjName);
+  return mforwarder->get_data_arg(argID, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::diet_free_pdata(const char *argID) {
-  return mforwarder->diet_free_pdata(argID, mobjName);
+  return mforwarder->diet_free_pdata(argID, objName());
 }
 
 SeqCorbaProfileDesc_t*
 MasterAgentFwdrImpl::getProfiles(CORBA::Long& length) {
-  return mforwarder->getProfiles(length, mobjName);
+  return mforwarder->getProfiles(length, objName());
 }
 
 CORBA::Boolean
 MasterAgentFwdrImpl::handShake(const char* name,
                                const char* myName) {
-  return mforwarder->handShake(name, myName, mobjName);
+  return mforwarder->handShake(name, myName, objName());
 }
 
 char*
 MasterAgentFwdrImpl::getBindName() {
-  return mforwarder->getBindName(mobjName);
+  return mforwarder->getBindName(objName());
 }
 
 void
 MasterAgentFwdrImpl::searchService(const char* predecessor,
                                    const char* predecessorId,
                                    const corba_request_t& request) {
-  mforwarder->searchService(predecessor, predecessorId, request, mobjName);
+  mforwarder->searchService(predecessor, predecessorId, request, objName());
 }
 
 void
 MasterAgentFwdrImpl::stopFlooding(CORBA::Long reqId,
                                   const char* senderId) {
-  mforwarder->stopFlooding(reqId, senderId, mobjName);
+  mforwarder->stopFlooding(reqId, senderId, objName());
 }
 
 void
 MasterAgentFwdrImpl::serviceNotFound(CORBA::Long reqId,
                                      const char* senderId) {
-  mforwarder->serviceNotFound(reqId, senderId, mobjName);
+  mforwarder->serviceNotFound(reqId, senderId, objName());
 }
 
 void
 MasterAgentFwdrImpl::newFlood(CORBA::Long reqId,
                               const char* senderId) {
-  mforwarder->newFlood(reqId, senderId, mobjName);
+  mforwarder->newFlood(reqId, senderId, objName());
 }
 
 void
 MasterAgentFwdrImpl::floodedArea(CORBA::Long reqId,
                                  const char* senderId) {
-  mforwarder->floodedArea(reqId, senderId, mobjName);
+  mforwarder->floodedArea(reqId, senderId, objName());
 }
 
 void
 MasterAgentFwdrImpl::alreadyContacted(CORBA::Long reqId,
                                       const char* senderId) {
-  mforwarder->alreadyContacted(reqId, senderId, mobjName);
+  mforwarder->alreadyContacted(reqId, senderId, objName());
 }
 
 void
 MasterAgentFwdrImpl::serviceFound(CORBA::Long reqId,
                                   const corba_response_t& decision) {
-  mforwarder->serviceFound(reqId, decision, mobjName);
+  mforwarder->serviceFound(reqId, decision, objName());
 }
 wf_response_t*
 MasterAgentFwdrImpl::submit_pb_set(const corba_pb_desc_seq_t& seq_pb) {
-  return mforwarder->submit_pb_set(seq_pb, mobjName);
+  return mforwarder->submit_pb_set(seq_pb, objName());
 }
 
 response_seq_t*
@@ -158,80 +156,80 @@ MasterAgentFwdrImpl::submit_pb_seq(const corba_pb_desc_seq_t& pb_seq,
                                    CORBA::Long& firstReqId,
                                    CORBA::Long& seqReqId) {
   return mforwarder->submit_pb_seq(pb_seq, reqCount, complete,
-                                  firstReqId, seqReqId, mobjName);
+                                  firstReqId, seqReqId, objName());
 }
 
 SeqString* MasterAgentFwdrImpl::searchData(const char* request) {
-  return mforwarder->searchData(request, mobjName);
+  return mforwarder->searchData(request, objName());
 }
 
 CORBA::Long MasterAgentFwdrImpl::insertData(const char* key,
                                             const SeqString& values) {
-  return mforwarder->insertData(key, values, mobjName);
+  return mforwarder->insertData(key, values, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::agentSubscribe(const char* me, const char* hostName,
                                     const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->agentSubscribe(me, hostName, services, mobjName);
+  return mforwarder->agentSubscribe(me, hostName, services, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::serverSubscribe(const char* me, const char* hostName,
                                      const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->serverSubscribe(me, hostName, services, mobjName);
+  return mforwarder->serverSubscribe(me, hostName, services, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::childUnsubscribe(CORBA::ULong childID,
                                       const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->childUnsubscribe(childID, services, mobjName);
+  return mforwarder->childUnsubscribe(childID, services, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::bindParent(const char * parentName) {
-  return mforwarder->bindParent(parentName, mobjName);
+  return mforwarder->bindParent(parentName, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::disconnect() {
-  return mforwarder->disconnect(mobjName);
+  return mforwarder->disconnect(objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::removeElement(bool recursive) {
-  return mforwarder->removeElement(recursive, mobjName);
+  return mforwarder->removeElement(recursive, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::addServices(CORBA::ULong myID,
                                  const SeqCorbaProfileDesc_t& services) {
-  return mforwarder->addServices(myID, services, mobjName);
+  return mforwarder->addServices(myID, services, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::childRemoveService(CORBA::ULong childID,
                                         const corba_profile_desc_t& profile) {
-  return mforwarder->childRemoveService(childID, profile, mobjName);
+  return mforwarder->childRemoveService(childID, profile, objName());
 }
 
 char*
 MasterAgentFwdrImpl::getDataManager() {
-  return mforwarder->getDataManager(mobjName);
+  return mforwarder->getDataManager(objName());
 }
 
 void
 MasterAgentFwdrImpl::getResponse(const corba_response_t& resp) {
-  mforwarder->getResponse(resp, mobjName);
+  mforwarder->getResponse(resp, objName());
 }
 
 CORBA::Long
 MasterAgentFwdrImpl::ping() {
-  return mforwarder->ping(mobjName);
+  return mforwarder->ping(objName());
 }
 
 char*
 MasterAgentFwdrImpl::getHostname() {
-  return mforwarder->getHostname(mobjName);
+  return mforwarder->getHostname(objName());
 }
 
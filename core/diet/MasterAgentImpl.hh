@@ -22,6 +22,7 @@
 
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "MasterAgentFwdr.hh"
 
 #include "dadi/Logging/Logger.hh"
@@ -34,9 +35,10 @@
  * For non documented methods, please see the MasterAgent and its parents idl interfaces.
  */
 class MasterAgentFwdrImpl : public POA_MasterAgentFwdr,
-                            public PortableServer::RefCountServantBase {
+                            public PortableServer::RefCountServantBase,
+                            public ProxyServant {
 public:
-  MasterAgentFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit MasterAgentFwdrImpl(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   agentSubscribe(const char* me, const char* hostName,
@@ -147,6 +149,5 @@ protected:
   dadi::ChannelPtr mcc;
 
   Forwarder_ptr mforwarder;
-  char* mobjName;
 };
 #endif  // _MASTERAGENTIMPL_HH_
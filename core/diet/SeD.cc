@@ -13,19 +13,21 @@
 #include "CorbaForwarder.hh"
 #include "ORBMgr.hh"
 #include <string>
+#include <boost/bind.hpp>
 
 ::CORBA::Long
 CorbaForwarder::checkContract(::corba_estimation_t& estimation,
                              const ::corba_pb_desc_t& pb,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "checkContract", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->checkContract(estimation, pb, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->checkContract(estimation, pb, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   SeD_var sed =
     ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
@@ -34,14 +36,16 @@ CorbaForwarder::checkContract(::corba_estimation_t& estimation,
 
 void
 CorbaForwarder::updateTimeSinceLastSolve(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "updateTimeSinceLastSolve",
+                             route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->updateTimeSinceLastSolve(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->updateTimeSinceLastSolve(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   SeD_var sed =
     ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
@@ -53,14 +57,15 @@ CorbaForwarder::updateTimeSinceLastSolve(const char* objName) {
 CorbaForwarder::solve(const char* path,
                      ::corba_profile_t& pb,
                      const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "solve", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->solve(path, pb, objString.c_str());
+  if (!route.remote()) {
+    return getBulkPeer(route)->solve(path, pb, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   SeD_var sed =
     ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
@@ -72,14 +77,23 @@ CorbaForwarder::solveAsync(const char* path,
                           const ::corba_profile_t& pb,
                           const char* volatileclientPtr,
                           const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::solveAsync, this,
+                                 CORBA::String_var(path), pb,
+                                 CORBA::String_var(volatileclientPtr),
+                                 CORBA::String_var(objName)),
+            PeerLink::BULK_CALL)) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "solveAsync", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->solveAsync(path, pb, volatileclientPtr, objString.c_str());
+  if (!route.remote()) {
+    return getBulkPeer(route)->solveAsync(path, pb, volatileclientPtr,
+                                                 route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   SeD_var sed =
     ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
@@ -88,14 +102,21 @@ CorbaForwarder::solveAsync(const char* path,
 
 char*
 CorbaForwarder::getDataMgrID(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getDataMgrID", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getDataMgrID(objString.c_str());
+  if (!route.remote()) {
+    char* result = findString(routeKey(route), "getDataMgrID");
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getDataMgrID(route.peerName());
+      cacheString(routeKey(route), "getDataMgrID", result, generation);
+    }
+    return result;
   }
 
-  name = getName(objString);
+  name = route.name();
 
   SeD_var sed =
     ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
@@ -105,16 +126,26 @@ CorbaForwarder::getDataMgrID(const char* objName) {
 SeqCorbaProfileDesc_t*
 CorbaForwarder::getSeDProfiles(::CORBA::Long& length,
                               const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getSeDProfiles", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getSeDProfiles(length, objString.c_str());
+  if (!route.remote()) {
+    SeqCorbaProfileDesc_t* result =
+      findSequence<SeqCorbaProfileDesc_t>(routeKey(route), "getSeDProfiles",
+                                          &length);
+    if (result == NULL) {
+      unsigned long generation = mresults.generation();
+      result = getPeer(route)->getSeDProfiles(length, route.peerName());
+      cacheSequence(routeKey(route), "getSeDProfiles", *result, generation,
+                    length);
+    }
+    return sent(stats, result);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   SeD_var sed =
     ORBMgr::getMgr()->resolve<SeD, SeD_var>(SEDCTXT, name, this->mname);
-  return sed->getSeDProfiles(length);
+  return sent(stats, sed->getSeDProfiles(length));
 }
@@ -54,55 +54,54 @@
 /** The trace level. */
 extern unsigned int TRACE_LEVEL;
 
-SeDFwdrImpl::SeDFwdrImpl(Forwarder_ptr fwdr, const char* objName) {
+SeDFwdrImpl::SeDFwdrImpl(Forwarder_ptr fwdr) {
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 CORBA::Long SeDFwdrImpl::ping() {
-  return mforwarder->ping(mobjName);
+  return mforwarder->ping(objName());
 }
 
 CORBA::Long SeDFwdrImpl::bindParent(const char * parentName) {
-  return mforwarder->bindParent(parentName, mobjName);
+  return mforwarder->bindParent(parentName, objName());
 }
 
 CORBA::Long SeDFwdrImpl::disconnect() {
-  return mforwarder->disconnect(mobjName);
+  return mforwarder->disconnect(objName());
 }
 
 CORBA::Long SeDFwdrImpl::removeElement() {
-  return mforwarder->removeElement(false, mobjName);
+  return mforwarder->removeElement(false, objName());
 }
 
 void SeDFwdrImpl::getRequest(const corba_request_t& req) {
-  return mforwarder->getRequest(req, mobjName);
+  return mforwarder->getRequest(req, objName());
 }
 
 CORBA::Long SeDFwdrImpl::checkContract(corba_estimation_t& estimation,
                                        const corba_pb_desc_t& pb) {
-  return mforwarder->checkContract(estimation, pb, mobjName);
+  return mforwarder->checkContract(estimation, pb, objName());
 }
 
 void SeDFwdrImpl::updateTimeSinceLastSolve() {
-  mforwarder->updateTimeSinceLastSolve(mobjName);
+  mforwarder->updateTimeSinceLastSolve(objName());
 }
 
 CORBA::Long SeDFwdrImpl::solve(const char* pbName, corba_profile_t& pb) {
-  return mforwarder->solve(pbName, pb, mobjName);
+  return mforwarder->solve(pbName, pb, objName());
 }
 
 void SeDFwdrImpl::solveAsync(const char* pb_name, const corba_profile_t& pb,
                              const char * volatileclientIOR) {
-  mforwarder->solveAsync(pb_name, pb, volatileclientIOR, mobjName);
+  mforwarder->solveAsync(pb_name, pb, volatileclientIOR, objName());
 }
 
 char* SeDFwdrImpl::getDataMgrID() {
-  return mforwarder->getDataMgrID(mobjName);
+  return mforwarder->getDataMgrID(objName());
 }
 
 SeqCorbaProfileDesc_t*
 SeDFwdrImpl::getSeDProfiles(CORBA::Long& length) {
-  return mforwarder->getSeDProfiles(length, mobjName);
+  return mforwarder->getSeDProfiles(length, objName());
 }
 
@@ -36,6 +36,7 @@ extern "C" {
 #endif
 
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 #include "SeDFwdr.hh"
 
 
@@ -46,9 +47,10 @@ extern "C" {
  * For non documented methods, please see the SeD and its parents idl interfaces.
  */
 class SeDFwdrImpl : public POA_SeD,
-                    public PortableServer::RefCountServantBase {
+                    public PortableServer::RefCountServantBase,
+                    public ProxyServant {
 public:
-  SeDFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit SeDFwdrImpl(Forwarder_ptr fwdr);
 
   virtual CORBA::Long
   ping();
@@ -87,7 +89,6 @@ public:
 
 protected:
   Forwarder_ptr mforwarder;
-  char* mobjName;
 };
 
 #endif  // _SED_IMPL_HH_
@@ -13,19 +13,21 @@
 #include "CorbaForwarder.hh"
 #include "ORBMgr.hh"
 #include <string>
+#include <boost/bind.hpp>
 
 void
 CorbaForwarder::createDag(const char* dagId,
                          const char* wfId,
                          const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createDag", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createDag(dagId, wfId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createDag(dagId, wfId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -37,14 +39,15 @@ CorbaForwarder::createDag(const char* dagId,
 void
 CorbaForwarder::createDagNode(const char* dagNodeId, const char* dagId,
                              const char* wfId, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createDagNode", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createDagNode(dagNodeId, dagId, wfId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createDagNode(dagNodeId, dagId, wfId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -57,15 +60,16 @@ void
 CorbaForwarder::createDagNodeData(const char* dagNodeId, const char* wfId,
                                  const char* dagNodePortId, const char* dataId,
                                  const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createDagNodeData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createDagNodeData(dagNodeId, wfId, dagNodePortId,
-                                        dataId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createDagNodeData(dagNodeId, wfId, dagNodePortId,
+                                               dataId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -78,15 +82,16 @@ void
 CorbaForwarder::createDagNodeLink(const char* srcNodeId, const char* srcWfId,
                                  const char* destNodeId, const char* destWfId,
                                  const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createDagNodeLink", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createDagNodeLink(srcNodeId, srcWfId, destNodeId,
-                                        destWfId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createDagNodeLink(srcNodeId, srcWfId, destNodeId,
+                                               destWfId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -101,15 +106,16 @@ CorbaForwarder::createDagNodePort(const char* dagNodePortId,
                                  const char* dagNodeId,
                                  const char* wfId,
                                  const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createDagNodePort", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createDagNodePort(dagNodePortId, portDirection,
-                                        dagNodeId, wfId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createDagNodePort(dagNodePortId, portDirection,
+                                               dagNodeId, wfId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -122,14 +128,15 @@ void
 CorbaForwarder::createDataElements(const char* dataId,
                                   const char* elementIdList,
                                   const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createDataElements", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createDataElements(dataId, elementIdList, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createDataElements(dataId, elementIdList, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -141,14 +148,15 @@ CorbaForwarder::createDataElements(const char* dataId,
 void
 CorbaForwarder::createSinkData(const char* sinkId, const char* wfId,
                               const char* dataId, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createSinkData", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createSinkData(sinkId, wfId, dataId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createSinkData(sinkId, wfId, dataId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -162,15 +170,16 @@ CorbaForwarder::createSourceDataTree(const char* sourceId,
                                     const char* wfId,
                                     const char* dataIdTree,
                                     const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "createSourceDataTree", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->createSourceDataTree(sourceId, wfId,
-                                           dataIdTree, objName);
+  if (!route.remote()) {
+    return getPeer(route)->createSourceDataTree(sourceId, wfId,
+                                                  dataIdTree, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -182,14 +191,22 @@ CorbaForwarder::createSourceDataTree(const char* sourceId,
 void
 CorbaForwarder::initWorkflow(const char* wfId, const char* wfName,
                             const char* parentWfId, const char* objName) {
-  std::string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::initWorkflow, this,
+                                 CORBA::String_var(wfId),
+                                 CORBA::String_var(wfName),
+                                 CORBA::String_var(parentWfId),
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "initWorkflow", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->initWorkflow(wfId, wfName, parentWfId, objName);
+  if (!route.remote()) {
+    return getPeer(route)->initWorkflow(wfId, wfName, parentWfId, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -204,15 +221,16 @@ CorbaForwarder::setInPortDependencies(const char* dagNodePortId,
                                      const char* wfId,
                                      const char* dependencies,
                                      const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "setInPortDependencies", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->setInPortDependencies(dagNodePortId, dagNodeId,
-                                            wfId, dependencies, objName);
+  if (!route.remote()) {
+    return getPeer(route)->setInPortDependencies(dagNodePortId, dagNodeId,
+                                                   wfId, dependencies, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -226,14 +244,15 @@ void
 CorbaForwarder::updateDag(const char* dagId, const char* wfId,
                          const char* dagState, const char* data,
                          const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "updateDag", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->updateDag(dagId, wfId, dagState, data, objName);
+  if (!route.remote()) {
+    return getPeer(route)->updateDag(dagId, wfId, dagState, data, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -245,14 +264,15 @@ CorbaForwarder::updateDag(const char* dagId, const char* wfId,
 void
 CorbaForwarder::updateWorkflow(const char* wfId, const char* wfState,
                               const char* data, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "updateWorkflow", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->updateWorkflow(wfId, wfState, data, objName);
+  if (!route.remote()) {
+    return getPeer(route)->updateWorkflow(wfId, wfState, data, objName);
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -264,14 +284,15 @@ CorbaForwarder::updateWorkflow(const char* wfId, const char* wfState,
 void
 CorbaForwarder::nodeIsDone(const char* node_id, const char* wfId,
                           const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "nodeIsDone", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->nodeIsDone(node_id, wfId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->nodeIsDone(node_id, wfId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -283,14 +304,15 @@ CorbaForwarder::nodeIsDone(const char* node_id, const char* wfId,
 void
 CorbaForwarder::nodeIsFailed(const char* node_id, const char* wfId,
                             const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "nodeIsFailed", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->nodeIsFailed(node_id, wfId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->nodeIsFailed(node_id, wfId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -302,14 +324,15 @@ CorbaForwarder::nodeIsFailed(const char* node_id, const char* wfId,
 void
 CorbaForwarder::nodeIsReady(const char* node_id, const char* wfId,
                            const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "nodeIsReady", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->nodeIsReady(node_id, wfId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->nodeIsReady(node_id, wfId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -321,14 +344,15 @@ CorbaForwarder::nodeIsReady(const char* node_id, const char* wfId,
 void
 CorbaForwarder::nodeIsRunning(const char* node_id, const char* wfId,
                              const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "nodeIsRunning", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->nodeIsRunning(node_id, wfId, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->nodeIsRunning(node_id, wfId, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -342,16 +366,17 @@ void
 CorbaForwarder::nodeIsStarting(const char* node_id, const char* wfId,
                               const char* pbName, const char* hostname,
                               const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "nodeIsStarting", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->nodeIsStarting(node_id, wfId,
-                                     pbName, hostname,
-                                     objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->nodeIsStarting(node_id, wfId,
+                                            pbName, hostname,
+                                            route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   WfLogService_var wfls =
     ORBMgr::getMgr()->resolve<WfLogService, WfLogService_var>(WFLOGCTXT,
@@ -11,21 +11,19 @@
 
 #include "WfLogServiceImpl.hh"
 
-WfLogServiceFwdrImpl::WfLogServiceFwdrImpl(Forwarder_ptr fwdr,
-                                           const char* objName) {
+WfLogServiceFwdrImpl::WfLogServiceFwdrImpl(Forwarder_ptr fwdr) {
   this->forwarder = Forwarder::_duplicate(fwdr);
-  this->objName = CORBA::string_dup(objName);
 }
 
 void
 WfLogServiceFwdrImpl::createDag(const char* dagId, const char* wfId) {
-  forwarder->createDag(dagId, wfId, objName);
+  forwarder->createDag(dagId, wfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::createDagNode(const char* dagNodeId, const char* dagId,
                                     const char* wfId) {
-  forwarder->createDagNode(dagNodeId, dagId, wfId, objName);
+  forwarder->createDagNode(dagNodeId, dagId, wfId, objName());
 }
 
 void
@@ -35,7 +33,7 @@ WfLogServiceFwdrImpl::createDagNodeData(const char* dagNodeId,
                                         const char* dataId) {
   forwarder->createDagNodeData(dagNodeId, wfId,
                                dagNodePortId, dataId,
-                               objName);
+                               objName());
 }
 
 void
@@ -44,7 +42,7 @@ WfLogServiceFwdrImpl::createDagNodeLink(const char* srcNodeId,
                                         const char* destNodeId,
                                         const char* destWfId) {
   forwarder->createDagNodeLink(srcNodeId, srcWfId,
-                               destNodeId, destWfId, objName);
+                               destNodeId, destWfId, objName());
 }
 
 void
@@ -53,58 +51,58 @@ WfLogServiceFwdrImpl::createDagNodePort(const char* dagNodePortId,
                                         const char* dagNodeId,
                                         const char* wfId) {
   forwarder->createDagNodePort(dagNodePortId, portDirection,
-                               dagNodeId, wfId, objName);
+                               dagNodeId, wfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::createDataElements(const char* dataId,
                                          const char* elementIdList) {
-  forwarder->createDataElements(dataId, elementIdList, objName);
+  forwarder->createDataElements(dataId, elementIdList, objName());
 }
 
 void
 WfLogServiceFwdrImpl::createSinkData(const char* sinkId, const char* wfId,
                                      const char* dataId) {
-  forwarder->createSinkData(sinkId, wfId, dataId, objName);
+  forwarder->createSinkData(sinkId, wfId, dataId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::createSourceDataTree(const char* sourceId,
                                            const char* wfId,
                                            const char* dataIdTree) {
-  forwarder->createSourceDataTree(sourceId, wfId, dataIdTree, objName);
+  forwarder->createSourceDataTree(sourceId, wfId, dataIdTree, objName());
 }
 
 void
 WfLogServiceFwdrImpl::initWorkflow(const char* wfId, const char* name,
                                    const char* parentWfId) {
-  forwarder->initWorkflow(wfId, name, parentWfId, objName);
+  forwarder->initWorkflow(wfId, name, parentWfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::nodeIsDone(const char* dagNodeId, const char* wfId) {
-  forwarder->nodeIsDone(dagNodeId, wfId, objName);
+  forwarder->nodeIsDone(dagNodeId, wfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::nodeIsFailed(const char* dagNodeId, const char* wfId) {
-  forwarder->nodeIsFailed(dagNodeId, wfId, objName);
+  forwarder->nodeIsFailed(dagNodeId, wfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::nodeIsReady(const char* dagNodeId, const char* wfId) {
-  forwarder->nodeIsReady(dagNodeId, wfId, objName);
+  forwarder->nodeIsReady(dagNodeId, wfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::nodeIsRunning(const char* dagNodeId, const char* wfId) {
-  forwarder->nodeIsRunning(dagNodeId, wfId, objName);
+  forwarder->nodeIsRunning(dagNodeId, wfId, objName());
 }
 
 void
 WfLogServiceFwdrImpl::nodeIsStarting(const char* dagNodeId, const char* wfId,
                                      const char* pbName, const char* hostname) {
-  forwarder->nodeIsStarting(dagNodeId, wfId, pbName, hostname, objName);
+  forwarder->nodeIsStarting(dagNodeId, wfId, pbName, hostname, objName());
 }
 
 void
@@ -113,17 +111,17 @@ WfLogServiceFwdrImpl::setInPortDependencies(const char* dagNodePortId,
                                             const char* wfId,
                                             const char* dependencies) {
   forwarder->setInPortDependencies(dagNodePortId, dagNodeId,
-                                   wfId, dependencies, objName);
+                                   wfId, dependencies, objName());
 }
 
 void
 WfLogServiceFwdrImpl::updateDag(const char* dagId, const char* wfId,
                                 const char* dagState, const char* data) {
-  forwarder->updateDag(dagId, wfId, dagState, data, objName);
+  forwarder->updateDag(dagId, wfId, dagState, data, objName());
 }
 
 void
 WfLogServiceFwdrImpl::updateWorkflow(const char* wfId, const char* wfState,
                                      const char* data) {
-  forwarder->updateWorkflow(wfId, wfState, data, objName);
+  forwarder->updateWorkflow(wfId, wfState, data, objName());
 }
@@ -15,12 +15,14 @@
 
 //#include "WfLogService.hh"
 #include "Forwarder.hh"
+#include "ProxyServant.hh"
 //#include "WfLogServiceFwdr.hh"
 
 class WfLogServiceFwdrImpl : public POA_WfLogServiceFwdr,
-                             public PortableServer::RefCountServantBase {
+                             public PortableServer::RefCountServantBase,
+                             public ProxyServant {
 public:
-  WfLogServiceFwdrImpl(Forwarder_ptr fwdr, const char* objName);
+  explicit WfLogServiceFwdrImpl(Forwarder_ptr fwdr);
 
   virtual void
   initWorkflow(const char* wfId, const char* name, const char* parentWfId);
@@ -82,6 +84,5 @@ public:
 
 protected:
   Forwarder_ptr forwarder;
-  char* objName;
 };
 #endif
@@ -16,14 +16,15 @@
 
 void
 CorbaForwarder::setTagFilter(const ::tag_list_t& tagList, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "setTagFilter", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->setTagFilter(tagList, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->setTagFilter(tagList, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->
@@ -35,14 +36,15 @@ CorbaForwarder::setTagFilter(const ::tag_list_t& tagList, const char* objName) {
 
 void
 CorbaForwarder::addTagFilter(const ::tag_list_t& tagList, const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "addTagFilter", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->addTagFilter(tagList, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->addTagFilter(tagList, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->
@@ -55,14 +57,15 @@ CorbaForwarder::addTagFilter(const ::tag_list_t& tagList, const char* objName) {
 void
 CorbaForwarder::removeTagFilter(const ::tag_list_t& tagList,
                                const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "removeTagFilter", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->removeTagFilter(tagList, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->removeTagFilter(tagList, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->
@@ -74,14 +77,15 @@ CorbaForwarder::removeTagFilter(const ::tag_list_t& tagList,
 
 void
 CorbaForwarder::test(const char* objName) {
-  std::string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "test", route.remote());
   std::string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->test(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->test(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->
@@ -19,8 +19,10 @@
 #include <iostream>
 
 #include <unistd.h>  // For gethostname()
+#include <boost/bind.hpp>
 
 #include "ORBMgr.hh"
+#include "ProxyServant.hh"
 #include "common_types.hh"
 
 #include "monitor/LogCentralComponentFwdr_impl.hh"
@@ -37,120 +39,38 @@ using namespace std;
 
 LogCentralComponent_ptr
 CorbaForwarder::getLogCentralComponent(const char* name) {
-  string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == string::npos) {
-    nm = string(LOGCOMPCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return LogCentralComponent::_duplicate(
-        LogCentralComponent::_narrow(object));
-    }
-  }
-
-  LogCentralComponentFwdrImpl * comp =
-    new LogCentralComponentFwdrImpl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(comp);
-
-  mcachesMutex.lock();
-  mservants[nm] = comp;
-  mobjectCache[name] = CORBA::Object::_duplicate(comp->_this());
-  mcachesMutex.unlock();
-
-  return LogCentralComponent::_duplicate(comp->_this());
+  OperationStats::Call stats(mstats, "getLogCentralComponent", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_LOGCOMPONENT, LOGCOMPCTXT, name,
+             newProxyServant<LogCentralComponentFwdrImpl>);
+  return LogCentralComponent::_narrow(object);
 }
 
 LogCentralTool_ptr
 CorbaForwarder::getLogCentralTool(const char* name) {
-  string nm(name);
-  ::CORBA::Object_ptr object;
-  if (nm.find('/') == string::npos) {
-    nm = string(LOGTOOLCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return LogCentralTool::_duplicate(LogCentralTool::_narrow(object));
-    }
-  }
-
-  LogCentralToolFwdr_impl * comp =
-    new LogCentralToolFwdr_impl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(comp);
-
-  mcachesMutex.lock();
-  mservants[nm] = comp;
-  mobjectCache[name] = CORBA::Object::_duplicate(comp->_this());
-  mcachesMutex.unlock();
-  return LogCentralTool::_duplicate(comp->_this());
+  OperationStats::Call stats(mstats, "getLogCentralTool", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_LOGTOOL, LOGTOOLCTXT, name,
+             newProxyServant<LogCentralToolFwdr_impl>);
+  return LogCentralTool::_narrow(object);
 }
 
 ComponentConfigurator_ptr
 CorbaForwarder::getCompoConf(const char* name) {
-  string nm(name);
-  ::CORBA::Object_ptr object;
-
-  if (nm.find('/') == string::npos) {
-    nm = string(LOGCOMPCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return ComponentConfigurator::_duplicate(
-        ComponentConfigurator::_narrow(object));
-    }
-  }
-
-  ComponentConfiguratorFwdr_impl * comp =
-    new ComponentConfiguratorFwdr_impl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(comp);
-
-  mcachesMutex.lock();
-  mservants[nm] = comp;
-  mobjectCache[name] = CORBA::Object::_duplicate(comp->_this());
-  mcachesMutex.unlock();
-
-  return ComponentConfigurator::_duplicate(comp->_this());
+  OperationStats::Call stats(mstats, "getCompoConf", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_COMPOCONF, LOGCOMPCTXT, name,
+             newProxyServant<ComponentConfiguratorFwdr_impl>);
+  return ComponentConfigurator::_narrow(object);
 }
 
 ToolMsgReceiver_ptr
 CorbaForwarder::getToolMsgReceiver(const char* name) {
-  string nm(name);
-  ::CORBA::Object_ptr object;
-  if (nm.find('/') == string::npos) {
-    nm = string(LOGTOOLCTXT)+"/"+nm;
-  }
-  object = getObjectCache(nm);
-  if (!CORBA::is_nil(object)) {
-    if (object->_non_existent()) {
-      removeObjectFromCache(name);
-    } else {
-      return ToolMsgReceiver::_duplicate(ToolMsgReceiver::_narrow(object));
-    }
-  }
-
-  ToolMsgReceiverFwdr_impl * comp =
-    new ToolMsgReceiverFwdr_impl(this->_this(), nm.c_str());
-
-  ORBMgr::getMgr()->activate(comp);
-
-  mcachesMutex.lock();
-  mservants[nm] = comp;
-  mobjectCache[name] = CORBA::Object::_duplicate(comp->_this());
-  mcachesMutex.unlock();
-  return ToolMsgReceiver::_duplicate(comp->_this());
+  OperationStats::Call stats(mstats, "getToolMsgReceiver", true);
+  ::CORBA::Object_var object =
+    getProxy(PROXY_TOOLMSGRECEIVER, LOGTOOLCTXT, name,
+             newProxyServant<ToolMsgReceiverFwdr_impl>);
+  return ToolMsgReceiver::_narrow(object);
 }
 
 
@@ -159,14 +79,15 @@ CorbaForwarder::getToolMsgReceiver(const char* name) {
 void
 CorbaForwarder::setTagFilter(const ::tag_list_t& tagList,
                            const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "setTagFilter", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->setTagFilter(tagList, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->setTagFilter(tagList, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->resolve<ComponentConfigurator,
@@ -179,14 +100,15 @@ CorbaForwarder::setTagFilter(const ::tag_list_t& tagList,
 void
 CorbaForwarder::addTagFilter(const ::tag_list_t& tagList,
                            const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "addTagFilter", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->addTagFilter(tagList, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->addTagFilter(tagList, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->resolve<ComponentConfigurator,
@@ -199,14 +121,15 @@ CorbaForwarder::addTagFilter(const ::tag_list_t& tagList,
 void
 CorbaForwarder::removeTagFilter(const ::tag_list_t& tagList,
                               const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "removeTagFilter", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->removeTagFilter(tagList, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->removeTagFilter(tagList, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ComponentConfigurator_var cfg =
     ORBMgr::getMgr()->resolve<ComponentConfigurator,
@@ -218,14 +141,19 @@ CorbaForwarder::removeTagFilter(const ::tag_list_t& tagList,
 
 void
 CorbaForwarder::sendMsg(const log_msg_buf_t& msgBuf, const char*  objName) {
-  string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::sendMsg, this, msgBuf,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "sendMsg", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->sendMsg(msgBuf, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->sendMsg(msgBuf, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   ToolMsgReceiver_var cfg =
     ORBMgr::getMgr()->resolve<ToolMsgReceiver,
@@ -248,13 +176,14 @@ short
 CorbaForwarder::connectTool(char*& toolName,
                           const char* msgReceiver,
                           const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "connectTool", route.remote());
   string name;
-  if (!remoteCall(objString)) {
-    getPeer()->connectTool(toolName, msgReceiver, objString.c_str());
+  if (!route.remote()) {
+    getPeer(route)->connectTool(toolName, msgReceiver, route.peerName());
     return 1;
   }
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -273,14 +202,15 @@ CorbaForwarder::connectTool(char*& toolName,
  */
 short
 CorbaForwarder::disconnectTool(const char* toolName, const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "disconnectTool", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->disconnectTool(toolName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->disconnectTool(toolName, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -299,14 +229,15 @@ CorbaForwarder::disconnectTool(const char* toolName, const char* objName) {
  */
 tag_list_t*
 CorbaForwarder::getDefinedTags(const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getDefinedTags", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getDefinedTags(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getDefinedTags(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -324,14 +255,15 @@ CorbaForwarder::getDefinedTags(const char* objName) {
  */
 component_list_t*
 CorbaForwarder::getDefinedComponents(const char*  objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "getDefinedComponents", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->getDefinedComponents(objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->getDefinedComponents(route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -352,14 +284,15 @@ short
 CorbaForwarder::addFilter(const char* toolName,
                         const filter_t& filter,
                         const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "addFilter", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->addFilter(toolName, filter, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->addFilter(toolName, filter, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -378,14 +311,15 @@ short
 CorbaForwarder::removeFilter(const char* toolName,
                            const char* filterName,
                            const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "removeFilter", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->removeFilter(toolName, filterName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->removeFilter(toolName, filterName, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -400,14 +334,15 @@ CorbaForwarder::removeFilter(const char* toolName,
  */
 short
 CorbaForwarder::flushAllFilters(const char* toolName, const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "flushAllFilters", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->flushAllFilters(toolName, objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->flushAllFilters(toolName, route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralTool_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralTool,
@@ -426,18 +361,19 @@ CorbaForwarder::connectComponent(char*& componentName,
                                const log_time_t& componentTime,
                                tag_list_t& initialConfig,
                                const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "connectComponent", route.remote());
   string name;
-  if (!remoteCall(objString)) {
-    return getPeer()->connectComponent(componentName,
-                                       componentHostname,
-                                       message,
-                                       compConfigurator,
-                                       componentTime,
-                                       initialConfig,
-                                       objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->connectComponent(componentName,
+                                              componentHostname,
+                                              message,
+                                              compConfigurator,
+                                              componentTime,
+                                              initialConfig,
+                                              route.peerName());
   }
-  name = getName(objString);
+  name = route.name();
 
   LogCentralComponent_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralComponent,
@@ -458,16 +394,17 @@ short
 CorbaForwarder::disconnectComponent(const char* componentName,
                                   const char* message,
                                   const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "disconnectComponent", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->disconnectComponent(componentName,
-                                          message,
-                                          objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->disconnectComponent(componentName,
+                                                 message,
+                                                 route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralComponent_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralComponent,
@@ -483,15 +420,20 @@ CorbaForwarder::disconnectComponent(const char* componentName,
 void
 CorbaForwarder::sendBuffer(const log_msg_buf_t &buffer,
                          const char* objName) {
-  string objString(objName);
+  if (defer(objName, boost::bind(&CorbaForwarder::sendBuffer, this, buffer,
+                                 CORBA::String_var(objName)))) {
+    return;
+  }
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "sendBuffer", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->sendBuffer(buffer,
-                                 objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->sendBuffer(buffer,
+                                        route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralComponent_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralComponent,
@@ -506,16 +448,17 @@ void
 CorbaForwarder::synchronize(const char* componentName,
                           const log_time_t& componentTime,
                           const char* objName) {
-  string objString(objName);
+  ObjectRoute route(objName, mroutes);
+  OperationStats::Call stats(mstats, "synchronize", route.remote());
   string name;
 
-  if (!remoteCall(objString)) {
-    return getPeer()->synchronize(componentName,
-                                  componentTime,
-                                  objString.c_str());
+  if (!route.remote()) {
+    return getPeer(route)->synchronize(componentName,
+                                         componentTime,
+                                         route.peerName());
   }
 
-  name = getName(objString);
+  name = route.name();
 
   LogCentralComponent_var cfg =
     ORBMgr::getMgr()->resolve<LogCentralComponent,
@@ -37,11 +37,9 @@ using namespace std;
  * LogCentralComponent_impl inplementation
  ****************************************************************************/
 
-LogCentralComponentFwdrImpl::LogCentralComponentFwdrImpl(Forwarder_ptr fwdr,
-							 const char* objName)
+LogCentralComponentFwdrImpl::LogCentralComponentFwdrImpl(Forwarder_ptr fwdr)
 {
   this->forwarder = Forwarder::_duplicate(fwdr);
-  this->objName = CORBA::string_dup(objName);
 }
 
 LogCentralComponentFwdrImpl::~LogCentralComponentFwdrImpl()
@@ -58,20 +56,20 @@ LogCentralComponentFwdrImpl::connectComponent(
   tag_list_t& initialConfig)
 {
   return forwarder->connectComponent(componentName, componentHostname, message,
-				     compConfigurator, componentTime, initialConfig, objName);
+				     compConfigurator, componentTime, initialConfig, objName());
 }
 
 CORBA::Short
 LogCentralComponentFwdrImpl::disconnectComponent(const char* componentName,
 						 const char* message)
 {
-  return forwarder->disconnectComponent(componentName, message, objName);
+  return forwarder->disconnectComponent(componentName, message, objName());
 }
 
 void
 LogCentralComponentFwdrImpl::sendBuffer(const log_msg_buf_t& buffer)
 {
-  return forwarder->sendBuffer(buffer, objName);
+  return forwarder->sendBuffer(buffer, objName());
 }
 
 void
@@ -83,7 +81,7 @@ void
 LogCentralComponentFwdrImpl::synchronize(const char* componentName,
 					 const log_time_t& componentTime)
 {
-  return forwarder->synchronize(componentName, componentTime, objName);
+  return forwarder->synchronize(componentName, componentTime, objName());
 }
 
 void
@@ -91,10 +89,8 @@ LogCentralComponentFwdrImpl::test(){
 }
 
 
-ComponentConfiguratorFwdr_impl::ComponentConfiguratorFwdr_impl(Forwarder_ptr fwdr,
-							       const char* objName){
+ComponentConfiguratorFwdr_impl::ComponentConfiguratorFwdr_impl(Forwarder_ptr fwdr){
   this->forwarder = Forwarder::_duplicate(fwdr);
-  this->objName = CORBA::string_dup(objName);
 }
 
 ComponentConfiguratorFwdr_impl::~ComponentConfiguratorFwdr_impl(){
@@ -103,17 +99,17 @@ ComponentConfiguratorFwdr_impl::~ComponentConfiguratorFwdr_impl(){
 
 void
 ComponentConfiguratorFwdr_impl::setTagFilter(const tag_list_t& tagList){
-  return forwarder->setTagFilter (tagList, objName);
+  return forwarder->setTagFilter (tagList, objName());
 }
 
 void
 ComponentConfiguratorFwdr_impl::addTagFilter(const tag_list_t& tagList){
-  return forwarder->addTagFilter (tagList, objName);
+  return forwarder->addTagFilter (tagList, objName());
 }
 
 void
 ComponentConfiguratorFwdr_impl::removeTagFilter(const tag_list_t& tagList){
-  return forwarder->removeTagFilter (tagList, objName);
+  return forwarder->removeTagFilter (tagList, objName());
 }
 
 void
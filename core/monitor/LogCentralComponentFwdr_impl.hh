@@ -23,6 +23,7 @@
 #include "utils/FullLinkedList.hh"
 
 #include "CorbaForwarder.hh"
+#include "ProxyServant.hh"
 
 
 /**
@@ -41,10 +42,10 @@ const short LS_COMPONENT_DISCONNECT_NOTEXISTS
  * @class LogCentralComponentFwdrImpl
  */
 class LogCentralComponentFwdrImpl: public POA_LogCentralComponentFwdr,
-				   public PortableServer::RefCountServantBase {
+				   public PortableServer::RefCountServantBase,
+				   public ProxyServant {
 public:
-  LogCentralComponentFwdrImpl(Forwarder_ptr fwdr,
-			      const char *objName);
+  explicit LogCentralComponentFwdrImpl(Forwarder_ptr fwdr);
 
   ~LogCentralComponentFwdrImpl();
 
@@ -75,7 +76,6 @@ public:
 
 protected:
 	Forwarder_ptr forwarder;
-	char* objName;
 
 private:
 
@@ -87,10 +87,10 @@ private:
  * @class ComponentConfiguratorFwdr_impl
  */
 class ComponentConfiguratorFwdr_impl: public POA_ComponentConfiguratorFwdr,
-				   public PortableServer::RefCountServantBase {
+				   public PortableServer::RefCountServantBase,
+				   public ProxyServant {
 public:
-  ComponentConfiguratorFwdr_impl(Forwarder_ptr fwdr,
-				 const char* objName);
+  explicit ComponentConfiguratorFwdr_impl(Forwarder_ptr fwdr);
 
   ~ComponentConfiguratorFwdr_impl();
 
@@ -104,7 +104,6 @@ public:
 
 protected:
 	Forwarder_ptr forwarder;
-	char* objName;
 
 }; // end class LogCentralComponentFwdr_impl
 
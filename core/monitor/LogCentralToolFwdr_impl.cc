@@ -29,10 +29,8 @@ using namespace std;
 
 
 
-LogCentralToolFwdr_impl::LogCentralToolFwdr_impl(Forwarder_ptr fwdr,
-						 const char* objName){
+LogCentralToolFwdr_impl::LogCentralToolFwdr_impl(Forwarder_ptr fwdr){
   this->forwarder = Forwarder::_duplicate(fwdr);
-  this->objName = CORBA::string_dup(objName);
 }
 
 LogCentralToolFwdr_impl::~LogCentralToolFwdr_impl() {
@@ -60,7 +58,7 @@ LogCentralToolFwdr_impl::test(){
 CORBA::Short
 LogCentralToolFwdr_impl::connectTool(char*& toolName,
 				     const char* msgReceiver){
-  return forwarder->connectTool (toolName, msgReceiver, objName);
+  return forwarder->connectTool (toolName, msgReceiver, objName());
 }
 
   /**
@@ -72,7 +70,7 @@ LogCentralToolFwdr_impl::connectTool(char*& toolName,
    */
 CORBA::Short
 LogCentralToolFwdr_impl::disconnectTool(const char* toolName){
-  return forwarder->disconnectTool(toolName, objName);
+  return forwarder->disconnectTool(toolName, objName());
 }
 
   /**
@@ -82,7 +80,7 @@ LogCentralToolFwdr_impl::disconnectTool(const char* toolName){
    */
 tag_list_t*
 LogCentralToolFwdr_impl::getDefinedTags(){
-  return forwarder->getDefinedTags(objName);
+  return forwarder->getDefinedTags(objName());
 }
 
   /**
@@ -93,7 +91,7 @@ LogCentralToolFwdr_impl::getDefinedTags(){
    */
 component_list_t*
 LogCentralToolFwdr_impl::getDefinedComponents(){
-  return forwarder->getDefinedComponents(objName);
+  return forwarder->getDefinedComponents(objName());
 }
 
   /**
@@ -107,7 +105,7 @@ LogCentralToolFwdr_impl::getDefinedComponents(){
    */
 CORBA::Short
 LogCentralToolFwdr_impl::addFilter(const char* toolName, const filter_t& filter){
-  return forwarder->addFilter(toolName, filter, objName);
+  return forwarder->addFilter(toolName, filter, objName());
 }
 
   /**
@@ -119,7 +117,7 @@ LogCentralToolFwdr_impl::addFilter(const char* toolName, const filter_t& filter)
    */
 CORBA::Short
 LogCentralToolFwdr_impl::removeFilter(const char* toolName, const char* filterName){
-  return forwarder->removeFilter(toolName, filterName, objName);
+  return forwarder->removeFilter(toolName, filterName, objName());
 }
 
   /**
@@ -129,14 +127,12 @@ LogCentralToolFwdr_impl::removeFilter(const char* toolName, const char* filterNa
    */
 CORBA::Short
 LogCentralToolFwdr_impl::flushAllFilters(const char* toolName){
-  return forwarder->flushAllFilters(toolName, objName);
+  return forwarder->flushAllFilters(toolName, objName());
 }
 
 
-ToolMsgReceiverFwdr_impl::ToolMsgReceiverFwdr_impl(Forwarder_ptr fwdr,
-			  const char* objName){
+ToolMsgReceiverFwdr_impl::ToolMsgReceiverFwdr_impl(Forwarder_ptr fwdr){
   this->mforwarder = Forwarder::_duplicate(fwdr);
-  this->mobjName = CORBA::string_dup(objName);
 }
 
 
@@ -147,5 +143,5 @@ ToolMsgReceiverFwdr_impl::~ToolMsgReceiverFwdr_impl(){
 
 void
 ToolMsgReceiverFwdr_impl::sendMsg(const log_msg_buf_t& msgBuf){
-  return mforwarder->sendMsg(msgBuf, mobjName);
+  return mforwarder->sendMsg(msgBuf, objName());
 }
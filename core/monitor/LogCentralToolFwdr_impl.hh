@@ -21,6 +21,7 @@
 #include "StateManager.hh"
 
 #include "CorbaForwarder.hh"
+#include "ProxyServant.hh"
 
 /**
  * Errorlevel constants for connectComponent (defined in the idl)
@@ -37,12 +38,12 @@ const short LS_TOOL_REMOVEFILTER_NOTEXISTS
  * @class LogCentralToolFwdr_impl
  */
 class LogCentralToolFwdr_impl: public POA_LogCentralToolFwdr,
-			       public PortableServer::RefCountServantBase
+			       public PortableServer::RefCountServantBase,
+			       public ProxyServant
 {
 public:
 
-  LogCentralToolFwdr_impl(Forwarder_ptr fwdr,
-			  const char* objName);
+  explicit LogCentralToolFwdr_impl(Forwarder_ptr fwdr);
 
   ~LogCentralToolFwdr_impl();
 
@@ -127,7 +128,6 @@ public:
 
 protected :
   Forwarder_ptr forwarder;
-  char* objName;
 
 };
 
@@ -140,12 +140,12 @@ protected :
  * @class ToolMsgReceiverFwdr_impl
  */
 class ToolMsgReceiverFwdr_impl: public POA_ToolMsgReceiverFwdr,
-				public PortableServer::RefCountServantBase
+				public PortableServer::RefCountServantBase,
+				public ProxyServant
 {
 public:
 
-  ToolMsgReceiverFwdr_impl(Forwarder_ptr fwdr,
-			  const char* objName);
+  explicit ToolMsgReceiverFwdr_impl(Forwarder_ptr fwdr);
 
   ~ToolMsgReceiverFwdr_impl();
 
@@ -153,7 +153,6 @@ public:
 
 protected :
   Forwarder_ptr mforwarder;
-  char* mobjName;
 
 };
 
@@ -106,6 +106,142 @@ BOOST_AUTO_TEST_CASE(listctxt)
   BOOST_REQUIRE(ORBMgr::getMgr()->contextList().size()==2);
 }
 
+BOOST_AUTO_TEST_CASE(listbindings)
+{
+  int argc = 1;
+  char** argv = (char **) malloc (sizeof (char*));
+  std::string prog = "test";
+  argv[0] = (char *) malloc (sizeof(char)*prog.length());
+  memcpy(argv[0], prog.c_str(), prog.length());
+  ORBMgr::init(argc, argv);
+
+  BOOST_REQUIRE(ORBMgr::getMgr()!=0);
+  std::vector<ORBMgr::Binding> bindings = ORBMgr::getMgr()->bindings("dietAgent");
+  BOOST_REQUIRE(bindings.size()==ORBMgr::getMgr()->list("dietAgent").size());
+  for (unsigned int i = 0; i < bindings.size(); ++i) {
+    BOOST_REQUIRE(!CORBA::is_nil(bindings[i].second));
+  }
+  BOOST_REQUIRE(ORBMgr::getMgr()->bindings("noSuchContext").empty());
+}
+
+BOOST_AUTO_TEST_CASE(localObjects)
+{
+  int argc = 1;
+  char** argv = (char **) malloc (sizeof (char*));
+  std::string prog = "test";
+  argv[0] = (char *) malloc (sizeof(char)*prog.length());
+  memcpy(argv[0], prog.c_str(), prog.length());
+  ORBMgr::init(argc, argv);
+
+  BOOST_REQUIRE(ORBMgr::getMgr()!=0);
+  BOOST_REQUIRE(ORBMgr::getMgr()->localObjects("dietAgent").size()==1);
+  BOOST_REQUIRE(ORBMgr::getMgr()->forwarderObjects("noSuchFwdr", "dietAgent").empty());
+}
+
+BOOST_AUTO_TEST_CASE(cacheLease)
+{
+  int argc = 1;
+  char** argv = (char **) malloc (sizeof (char*));
+  std::string prog = "test";
+  argv[0] = (char *) malloc (sizeof(char)*prog.length());
+  memcpy(argv[0], prog.c_str(), prog.length());
+  ORBMgr::init(argc, argv);
+
+  BOOST_REQUIRE(ORBMgr::getMgr()!=0);
+  BOOST_REQUIRE(ORBMgr::getMgr()->getCacheLease(SEDCTXT)==0);
+  ORBMgr::getMgr()->setCacheLease(30);
+  ORBMgr::getMgr()->setCacheLease(SEDCTXT, 5);
+  BOOST_REQUIRE(ORBMgr::getMgr()->getCacheLease(SEDCTXT)==5);
+  BOOST_REQUIRE(ORBMgr::getMgr()->getCacheLease(AGENTCTXT)==30);
+  ORBMgr::getMgr()->setCacheLease(0);
+  ORBMgr::getMgr()->setCacheLease(SEDCTXT, 0);
+}
+
+BOOST_AUTO_TEST_CASE(notFoundLease)
+{
+  int argc = 1;
+  char** argv = (char **) malloc (sizeof (char*));
+  std::string prog = "test";
+  argv[0] = (char *) malloc (sizeof(char)*prog.length());
+  memcpy(argv[0], prog.c_str(), prog.length());
+  ORBMgr::init(argc, argv);
+
+  ORBMgr* mgr = ORBMgr::getMgr();
+  BOOST_REQUIRE(mgr!=0);
+  mgr->setNotFoundLease(60);
+  BOOST_REQUIRE(mgr->getNotFoundLease()==60);
+  BOOST_REQUIRE_THROW(mgr->resolveObject("dietAgent", "notYetBound"),
+                      std::runtime_error);
+  /* Reported missing again without the naming service. */
+  BOOST_REQUIRE_THROW(mgr->resolveObject("dietAgent", "notYetBound"),
+                      std::runtime_error);
+  /* Binding the name ends its not found lease. */
+  std::vector<ORBMgr::Binding> bindings = mgr->bindings("dietAgent");
+  BOOST_REQUIRE(!bindings.empty());
+  mgr->bind("dietAgent", "notYetBound", bindings[0].second, true);
+  CORBA::Object_var object = mgr->resolveObject("dietAgent", "notYetBound");
+  BOOST_REQUIRE(!CORBA::is_nil(object));
+  mgr->unbind("dietAgent", "notYetBound");
+  mgr->removeObjectFromCache("dietAgent", "notYetBound");
+  mgr->setNotFoundLease(2);
+}
+
+BOOST_AUTO_TEST_CASE(proxyReference)
+{
+  int argc = 1;
+  char** argv = (char **) malloc (sizeof (char*));
+  std::string prog = "test";
+  argv[0] = (char *) malloc (sizeof(char)*prog.length());
+  memcpy(argv[0], prog.c_str(), prog.length());
+  ORBMgr::init(argc, argv);
+
+  ORBMgr* mgr = ORBMgr::getMgr();
+  BOOST_REQUIRE(mgr!=0);
+  ToolMsgReceiverFwdr_impl* servant =
+    new ToolMsgReceiverFwdr_impl(Forwarder::_nil());
+  const char* repoId = servant->_mostDerivedRepoId();
+  PortableServer::POA_var poa = mgr->createProxyPOA("testProxy", servant);
+  /* One servant for any number of objects, told apart by their id. */
+  CORBA::Object_var tool1 =
+    mgr->proxyReference(poa, std::string(LOGTOOLCTXT)+"/tool1", repoId);
+  CORBA::Object_var tool2 =
+    mgr->proxyReference(poa, std::string(LOGTOOLCTXT)+"/tool2", repoId);
+  BOOST_REQUIRE(!tool1->_is_equivalent(tool2));
+  BOOST_REQUIRE(mgr->getTypeID(mgr->getIOR(tool1))==repoId);
+  PortableServer::ObjectId_var oid = poa->reference_to_id(tool2);
+  CORBA::String_var name = PortableServer::ObjectId_to_string(oid);
+  BOOST_REQUIRE(std::string(name.in())==std::string(LOGTOOLCTXT)+"/tool2");
+  poa->destroy(false, true);
+}
+
+BOOST_AUTO_TEST_CASE(localObject)
+{
+  int argc = 1;
+  char** argv = (char **) malloc (sizeof (char*));
+  std::string prog = "test";
+  argv[0] = (char *) malloc (sizeof(char)*prog.length());
+  memcpy(argv[0], prog.c_str(), prog.length());
+  ORBMgr::init(argc, argv);
+
+  ORBMgr* mgr = ORBMgr::getMgr();
+  BOOST_REQUIRE(mgr!=0);
+  ToolMsgReceiverFwdr_impl* servant =
+    new ToolMsgReceiverFwdr_impl(Forwarder::_nil());
+  const char* repoId = servant->_mostDerivedRepoId();
+  PortableServer::POA_var poa = mgr->createProxyPOA("testLocal", servant);
+  CORBA::Object_var proxy =
+    mgr->proxyReference(poa, std::string(LOGTOOLCTXT)+"/tool", repoId);
+  bool active = false;
+  /* A proxy is active as long as its POA. */
+  BOOST_REQUIRE(mgr->localObject(proxy, active));
+  BOOST_REQUIRE(active);
+  /* The naming service objects live in another process. */
+  std::vector<ORBMgr::Binding> bindings = mgr->bindings("dietAgent");
+  BOOST_REQUIRE(!bindings.empty());
+  BOOST_REQUIRE(!mgr->localObject(bindings[0].second, active));
+  poa->destroy(false, true);
+}
+
 
 BOOST_AUTO_TEST_SUITE_END()
 
@@ -0,0 +1,173 @@
+/**
+ * @file automtest_cachesweeper.cc
+ * @brief This file implements the libdadicorba tests for the cache sweeper
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "CacheSweeper.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <set>
+#include <string>
+
+#include <omnithread.h>
+
+/* Considers dead the keys of a set and counts the probes in flight. */
+class TestSweeper : public CacheSweeper {
+public:
+  TestSweeper(ObjectCache& cache, const unsigned int nbProbes)
+    : CacheSweeper(cache, nbProbes), minFlight(0), mmaxInFlight(0),
+      mprobes(0) {}
+
+  ~TestSweeper() { stop(); }
+
+  void
+  kill(const std::string& key) {
+    mmutex.lock();
+    mdead.insert(key);
+    mmutex.unlock();
+  }
+
+  unsigned int
+  maxInFlight() {
+    unsigned int result;
+    mmutex.lock();
+    result = mmaxInFlight;
+    mmutex.unlock();
+    return result;
+  }
+
+  unsigned int
+  probes() {
+    unsigned int result;
+    mmutex.lock();
+    result = mprobes;
+    mmutex.unlock();
+    return result;
+  }
+
+protected:
+  bool
+  alive(const ObjectCache::Item& item) {
+    bool result;
+
+    mmutex.lock();
+    ++mprobes;
+    if (++minFlight > mmaxInFlight) {
+      mmaxInFlight = minFlight;
+    }
+    result = (mdead.find(item.first) == mdead.end());
+    mmutex.unlock();
+
+    omni_thread::sleep(0, 20000000);
+
+    mmutex.lock();
+    --minFlight;
+    mmutex.unlock();
+    return result;
+  }
+
+private:
+  omni_mutex mmutex;
+  std::set<std::string> mdead;
+  unsigned int minFlight;
+  unsigned int mmaxInFlight;
+  unsigned int mprobes;
+};
+
+static ObjectCache::Entry
+makeEntry(const unsigned int lease, const time_t expiry) {
+  ObjectCache::Entry entry;
+  entry.object = CORBA::Object::_nil();
+  entry.lease = lease;
+  entry.expiry = expiry;
+  return entry;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(sweepEvicts)
+{
+  ObjectCache cache;
+  TestSweeper sweeper(cache, 4);
+  CacheSweeper::Stats stats;
+
+  cache.put("dietSeD/SeD1", makeEntry(0, 0));
+  cache.put("dietSeD/SeD2", makeEntry(0, 0));
+  cache.put("dietAgent/MA1", makeEntry(0, 0));
+  sweeper.kill("dietSeD/SeD2");
+
+  stats = sweeper.sweep();
+  BOOST_REQUIRE(stats.sweeps==1);
+  BOOST_REQUIRE(stats.probed==3);
+  BOOST_REQUIRE(stats.evicted==1);
+  BOOST_REQUIRE(stats.totalEvicted==1);
+  BOOST_REQUIRE(cache.size()==2);
+
+  stats = sweeper.sweep();
+  BOOST_REQUIRE(stats.sweeps==2);
+  BOOST_REQUIRE(stats.probed==2);
+  BOOST_REQUIRE(stats.evicted==0);
+  BOOST_REQUIRE(stats.totalEvicted==1);
+  BOOST_REQUIRE(stats.totalProbed==5);
+}
+
+BOOST_AUTO_TEST_CASE(boundedProbes)
+{
+  ObjectCache cache;
+  TestSweeper sweeper(cache, 3);
+
+  for (char c = 'a'; c <= 'p'; ++c) {
+    cache.put(std::string("dietSeD/") + c, makeEntry(0, 0));
+  }
+  sweeper.sweep();
+  BOOST_REQUIRE(sweeper.probes()==16);
+  BOOST_REQUIRE(sweeper.maxInFlight()<=3);
+  BOOST_REQUIRE(sweeper.maxInFlight()>1);
+}
+
+BOOST_AUTO_TEST_CASE(revalidateRenews)
+{
+  ObjectCache cache;
+  TestSweeper sweeper(cache, 2);
+  ObjectCache::Entry entry;
+  time_t now = time(NULL);
+
+  cache.put("dietSeD/near", makeEntry(8, now + 1));
+  cache.put("dietSeD/far", makeEntry(100, now + 100));
+  cache.put("dietSeD/dead", makeEntry(8, now));
+  cache.put("dietSeD/unleased", makeEntry(0, 0));
+  sweeper.kill("dietSeD/dead");
+  sweeper.kill("dietSeD/unleased");
+
+  BOOST_REQUIRE(sweeper.revalidate()==1);
+  BOOST_REQUIRE(sweeper.probes()==2);
+  BOOST_REQUIRE(cache.find("dietSeD/near", entry));
+  BOOST_REQUIRE(entry.expiry>=now + 8);
+  BOOST_REQUIRE(!cache.find("dietSeD/dead", entry));
+  BOOST_REQUIRE(cache.find("dietSeD/unleased", entry));
+  /* Revalidations are not full sweeps. */
+  BOOST_REQUIRE(sweeper.stats().sweeps==0);
+  BOOST_REQUIRE(sweeper.stats().totalEvicted==1);
+}
+
+BOOST_AUTO_TEST_CASE(periodicSweep)
+{
+  ObjectCache cache;
+  TestSweeper sweeper(cache, 2);
+
+  cache.put("dietSeD/SeD1", makeEntry(0, 0));
+  sweeper.kill("dietSeD/SeD1");
+  sweeper.setPeriod(1);
+  BOOST_REQUIRE(sweeper.getPeriod()==1);
+  sweeper.start();
+  for (int i = 0; i < 50 && cache.size() > 0; ++i) {
+    omni_thread::sleep(0, 100000000);
+  }
+  sweeper.stop();
+  BOOST_REQUIRE(cache.size()==0);
+  BOOST_REQUIRE(sweeper.stats().sweeps>=1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
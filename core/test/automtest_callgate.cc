@@ -0,0 +1,121 @@
+/**
+ * @file automtest_callgate.cc
+ * @brief This file implements the libdadicorba tests for the call gate
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "CallGate.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <omnithread.h>
+
+/* Takes a slot of the gate, then releases it. */
+static void
+enterAndLeave(void* arg) {
+  CallGate* gate = static_cast<CallGate*>(arg);
+  if (gate->enter()) {
+    gate->leave();
+  }
+}
+
+static void
+waitWaiting(CallGate& gate, unsigned int count) {
+  for (unsigned int i = 0; i < 200 && gate.waiting() < count; ++i) {
+    omni_thread::sleep(0, 10000000);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(unlimited)
+{
+  CallGate gate;
+  for (unsigned int i = 0; i < 100; ++i) {
+    BOOST_REQUIRE(gate.enter());
+  }
+  BOOST_REQUIRE(gate.inProgress()==100);
+  BOOST_REQUIRE(gate.entered()==100);
+  BOOST_REQUIRE(gate.waitTime()==0);
+  for (unsigned int i = 0; i < 100; ++i) {
+    gate.leave();
+  }
+  BOOST_REQUIRE(gate.inProgress()==0);
+}
+
+BOOST_AUTO_TEST_CASE(queueFull)
+{
+  CallGate gate(1, 1);
+  BOOST_REQUIRE(gate.enter());
+
+  omni_thread::create(enterAndLeave, &gate);
+  waitWaiting(gate, 1);
+  BOOST_REQUIRE(gate.waiting()==1);
+
+  // One slot taken, one caller waiting: the next one is refused
+  BOOST_REQUIRE(!gate.enter());
+  BOOST_REQUIRE(gate.refused()==1);
+
+  gate.leave();
+  for (unsigned int i = 0;
+       i < 200 && (gate.waiting() > 0 || gate.inProgress() > 0); ++i) {
+    omni_thread::sleep(0, 10000000);
+  }
+  BOOST_REQUIRE(gate.waiting()==0);
+  BOOST_REQUIRE(gate.inProgress()==0);
+}
+
+BOOST_AUTO_TEST_CASE(raiseLimits)
+{
+  CallGate gate(1, 0);
+  BOOST_REQUIRE(gate.enter());
+
+  omni_thread::create(enterAndLeave, &gate);
+  waitWaiting(gate, 1);
+  BOOST_REQUIRE(gate.waiting()==1);
+
+  // A second slot lets the waiting caller through
+  gate.setLimits(2, 0);
+  for (unsigned int i = 0; i < 200 && gate.waiting() > 0; ++i) {
+    omni_thread::sleep(0, 10000000);
+  }
+  BOOST_REQUIRE(gate.waiting()==0);
+  gate.leave();
+}
+
+BOOST_AUTO_TEST_CASE(waitTime)
+{
+  CallGate gate(1, 0);
+  BOOST_REQUIRE(gate.enter());
+
+  omni_thread::create(enterAndLeave, &gate);
+  waitWaiting(gate, 1);
+  omni_thread::sleep(0, 200000000);
+  gate.leave();
+  for (unsigned int i = 0;
+       i < 200 && (gate.waiting() > 0 || gate.inProgress() > 0); ++i) {
+    omni_thread::sleep(0, 10000000);
+  }
+  BOOST_REQUIRE(gate.entered()==2);
+  // The second caller waited for the first one to leave
+  BOOST_REQUIRE(gate.waitTime() >= 0.15);
+  BOOST_REQUIRE(gate.maxWait()==gate.waitTime());
+}
+
+BOOST_AUTO_TEST_CASE(tryEnter)
+{
+  CallGate gate(1, 0);
+  BOOST_REQUIRE(gate.tryEnter());
+
+  // The slot is taken: refused without waiting nor counting
+  BOOST_REQUIRE(!gate.tryEnter());
+  BOOST_REQUIRE(gate.waiting()==0);
+  BOOST_REQUIRE(gate.refused()==0);
+
+  gate.leave();
+  BOOST_REQUIRE(gate.tryEnter());
+  BOOST_REQUIRE(gate.entered()==2);
+  gate.leave();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,224 @@
+/**
+ * @file automtest_chunkstore.cc
+ * @brief This file implements the libdadicorba tests for the chunk store
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "ChunkStore.hh"
+#include "Sha256.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <unistd.h>
+
+/* A chunk of data and its digest. */
+struct Chunk {
+  explicit Chunk(const unsigned char seed, const unsigned long length = 1000)
+    : data(length) {
+    for (unsigned long i = 0; i < length; ++i) {
+      data[i] = static_cast<unsigned char>(seed * 13 + i);
+    }
+    digest = Sha256::digest(&data[0], length);
+  }
+
+  std::vector<unsigned char> data;
+  std::string digest;
+};
+
+/* A fresh directory for the chunks. */
+static std::string
+makeDirectory() {
+  char path[] = "/tmp/chunks-XXXXXX";
+
+  BOOST_REQUIRE(mkdtemp(path) != NULL);
+  return path;
+}
+
+/* Removes a directory and its files. */
+static void
+removeDirectory(const std::string& directory) {
+  DIR* dir = opendir(directory.c_str());
+  struct dirent* entry;
+
+  while ((entry = readdir(dir)) != NULL) {
+    std::string name(entry->d_name);
+    if (name != "." && name != "..") {
+      unlink((directory + "/" + name).c_str());
+    }
+  }
+  closedir(dir);
+  BOOST_REQUIRE(rmdir(directory.c_str())==0);
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(putRead)
+{
+  std::string directory = makeDirectory();
+  ChunkStore store(directory, 10000);
+  Chunk chunk(1);
+  unsigned long length = 0;
+
+  BOOST_REQUIRE(!store.acquire(chunk.digest, length));
+  BOOST_REQUIRE(store.put(chunk.digest, &chunk.data[0], chunk.data.size()));
+  BOOST_REQUIRE(store.put(chunk.digest, &chunk.data[0], chunk.data.size()));
+  BOOST_REQUIRE(store.count()==1);
+  BOOST_REQUIRE(store.size()==1000);
+
+  BOOST_REQUIRE(store.acquire(chunk.digest, length));
+  BOOST_REQUIRE(length==1000);
+  std::vector<unsigned char> buffer(length);
+  BOOST_REQUIRE(store.read(chunk.digest, &buffer[0], length));
+  BOOST_REQUIRE(buffer==chunk.data);
+  store.release(chunk.digest);
+
+  // Larger than the whole store
+  Chunk big(2, 20000);
+  BOOST_REQUIRE(!store.put(big.digest, &big.data[0], big.data.size()));
+  removeDirectory(directory);
+}
+
+BOOST_AUTO_TEST_CASE(lru)
+{
+  std::string directory = makeDirectory();
+  ChunkStore store(directory, 3000);
+  Chunk a(1), b(2), c(3), d(4);
+  unsigned long length;
+
+  store.put(a.digest, &a.data[0], a.data.size());
+  store.put(b.digest, &b.data[0], b.data.size());
+  store.put(c.digest, &c.data[0], c.data.size());
+  // a is used again, b is now the least recently used
+  BOOST_REQUIRE(store.acquire(a.digest, length));
+  store.release(a.digest);
+  store.put(d.digest, &d.data[0], d.data.size());
+
+  BOOST_REQUIRE(store.count()==3);
+  BOOST_REQUIRE(store.size()==3000);
+  BOOST_REQUIRE(!store.acquire(b.digest, length));
+  BOOST_REQUIRE(store.acquire(a.digest, length));
+  store.release(a.digest);
+  removeDirectory(directory);
+}
+
+BOOST_AUTO_TEST_CASE(pinned)
+{
+  std::string directory = makeDirectory();
+  ChunkStore store(directory, 2000);
+  Chunk a(1), b(2), c(3);
+  unsigned long length;
+
+  store.put(a.digest, &a.data[0], a.data.size());
+  store.put(b.digest, &b.data[0], b.data.size());
+  BOOST_REQUIRE(store.acquire(a.digest, length));
+  BOOST_REQUIRE(store.acquire(b.digest, length));
+  // Both chunks are in use: no room
+  BOOST_REQUIRE(!store.put(c.digest, &c.data[0], c.data.size()));
+  store.release(a.digest);
+  BOOST_REQUIRE(store.put(c.digest, &c.data[0], c.data.size()));
+  BOOST_REQUIRE(!store.acquire(a.digest, length));
+  store.release(b.digest);
+  removeDirectory(directory);
+}
+
+BOOST_AUTO_TEST_CASE(corrupted)
+{
+  std::string directory = makeDirectory();
+  ChunkStore store(directory, 10000);
+  Chunk chunk(1);
+  unsigned long length;
+  DIR* dir;
+  struct dirent* entry;
+
+  store.put(chunk.digest, &chunk.data[0], chunk.data.size());
+  // The chunk file is damaged under its name
+  dir = opendir(directory.c_str());
+  while ((entry = readdir(dir)) != NULL) {
+    if (entry->d_name[0] != '.') {
+      FILE* file = fopen((directory + "/" + entry->d_name).c_str(), "r+");
+      fputs("damaged", file);
+      fclose(file);
+    }
+  }
+  closedir(dir);
+
+  BOOST_REQUIRE(store.acquire(chunk.digest, length));
+  std::vector<unsigned char> buffer(length);
+  BOOST_REQUIRE(!store.read(chunk.digest, &buffer[0], length));
+  store.release(chunk.digest);
+  // Removed from the store: received again next time
+  BOOST_REQUIRE(store.count()==0);
+  BOOST_REQUIRE(store.size()==0);
+  BOOST_REQUIRE(!store.acquire(chunk.digest, length));
+  removeDirectory(directory);
+}
+
+BOOST_AUTO_TEST_CASE(lost)
+{
+  std::string directory = makeDirectory();
+  ChunkStore store(directory, 10000);
+  Chunk chunk(1);
+  unsigned long length;
+  DIR* dir;
+  struct dirent* entry;
+
+  store.put(chunk.digest, &chunk.data[0], chunk.data.size());
+  // The chunk file is removed behind the store
+  dir = opendir(directory.c_str());
+  while ((entry = readdir(dir)) != NULL) {
+    if (entry->d_name[0] != '.') {
+      unlink((directory + "/" + entry->d_name).c_str());
+    }
+  }
+  closedir(dir);
+
+  BOOST_REQUIRE(store.acquire(chunk.digest, length));
+  std::vector<unsigned char> buffer(length);
+  BOOST_REQUIRE(!store.read(chunk.digest, &buffer[0], length));
+  store.release(chunk.digest);
+  BOOST_REQUIRE(store.count()==0);
+  BOOST_REQUIRE(store.size()==0);
+  BOOST_REQUIRE(!store.acquire(chunk.digest, length));
+  removeDirectory(directory);
+}
+
+BOOST_AUTO_TEST_CASE(reopen)
+{
+  std::string directory = makeDirectory();
+  Chunk a(1), b(2);
+  unsigned long length;
+
+  {
+    ChunkStore store(directory, 10000);
+    store.put(a.digest, &a.data[0], a.data.size());
+    store.put(b.digest, &b.data[0], b.data.size());
+  }
+  // A chunk half written by a crashed process
+  FILE* temp = fopen((directory + "/.tmp-7").c_str(), "w");
+  fputs("partial", temp);
+  fclose(temp);
+
+  ChunkStore store(directory, 10000);
+  BOOST_REQUIRE(store.count()==2);
+  BOOST_REQUIRE(store.size()==2000);
+  BOOST_REQUIRE(store.acquire(b.digest, length));
+  std::vector<unsigned char> buffer(length);
+  BOOST_REQUIRE(store.read(b.digest, &buffer[0], length));
+  BOOST_REQUIRE(buffer==b.data);
+  store.release(b.digest);
+
+  // Taken back with a lower limit
+  ChunkStore smaller(directory, 1000);
+  BOOST_REQUIRE(smaller.count()==1);
+  removeDirectory(directory);
+
+  BOOST_CHECK_THROW(ChunkStore(directory, 1000), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+/**
+ * @file automtest_chunkwindow.cc
+ * @brief This file implements the libdadicorba tests for the chunk window
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "ChunkWindow.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <omnithread.h>
+
+/* The state shared by the threads sending the chunks. */
+struct Sender {
+  ChunkWindow* window;
+  omni_mutex mutex;
+  unsigned int inFlight;
+  unsigned int maxInFlight;
+  std::vector<unsigned int> sent;
+};
+
+/* Sends chunks until none is left, each one taking some time. */
+static void
+sendChunks(void* arg) {
+  Sender* sender = static_cast<Sender*>(arg);
+  unsigned long index;
+
+  while (sender->window->next(index)) {
+    sender->mutex.lock();
+    ++sender->inFlight;
+    if (sender->inFlight > sender->maxInFlight) {
+      sender->maxInFlight = sender->inFlight;
+    }
+    ++sender->sent[index];
+    sender->mutex.unlock();
+
+    // The first chunks are the slowest
+    omni_thread::sleep(0, (index < 4 ? 20 : 1) * 1000000);
+
+    sender->mutex.lock();
+    --sender->inFlight;
+    sender->mutex.unlock();
+    sender->window->done(index);
+  }
+  sender->window->leave();
+}
+
+/* Takes a chunk, blocking while the window is full. */
+static void
+takeChunk(void* arg) {
+  ChunkWindow* window = static_cast<ChunkWindow*>(arg);
+  unsigned long index;
+
+  if (window->next(index)) {
+    window->done(index);
+  }
+  window->leave();
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(inOrder)
+{
+  ChunkWindow window(3, 2);
+  unsigned long index;
+
+  BOOST_REQUIRE(window.next(index) && index==0);
+  BOOST_REQUIRE(window.next(index) && index==1);
+  window.done(0);
+  BOOST_REQUIRE(window.next(index) && index==2);
+  BOOST_REQUIRE(!window.next(index));
+  window.done(2);
+  BOOST_REQUIRE(window.sent()==2);
+  window.done(1);
+  BOOST_REQUIRE(window.sent()==3);
+}
+
+BOOST_AUTO_TEST_CASE(windowFull)
+{
+  ChunkWindow window(10, 2);
+  unsigned long index;
+
+  BOOST_REQUIRE(window.next(index) && index==0);
+  BOOST_REQUIRE(window.next(index) && index==1);
+  // Chunk 1 is acknowledged, but 0 is not: the window does not move
+  window.done(1);
+  window.enter();
+  omni_thread::create(takeChunk, &window);
+  omni_thread::sleep(0, 100000000);
+  BOOST_REQUIRE(window.sent()==1);
+
+  window.done(0);
+  window.join();
+  BOOST_REQUIRE(window.sent()==3);
+}
+
+BOOST_AUTO_TEST_CASE(failure)
+{
+  ChunkWindow window(10, 1);
+  unsigned long index;
+
+  BOOST_REQUIRE(window.next(index) && index==0);
+  window.enter();
+  omni_thread::create(takeChunk, &window);
+  omni_thread::sleep(0, 50000000);
+  // The waiting thread gives up
+  window.fail();
+  window.join();
+  BOOST_REQUIRE(window.failed());
+  BOOST_REQUIRE(!window.next(index));
+}
+
+BOOST_AUTO_TEST_CASE(resume)
+{
+  ChunkWindow window(10, 4, 6);
+  unsigned long index;
+
+  // The chunks before the first one are not handed out again
+  BOOST_REQUIRE(window.sent()==6);
+  for (unsigned long i = 6; i < 10; ++i) {
+    BOOST_REQUIRE(window.next(index));
+    BOOST_REQUIRE(index==i);
+    window.done(index);
+  }
+  BOOST_REQUIRE(!window.next(index));
+  BOOST_REQUIRE(window.sent()==10);
+}
+
+BOOST_AUTO_TEST_CASE(lateSender)
+{
+  ChunkWindow window(1, 1);
+  unsigned long index;
+
+  BOOST_REQUIRE(window.enter());
+  BOOST_REQUIRE(window.next(index) && index==0);
+  window.done(index);
+  window.leave();
+  window.join();
+  // A thread coming after the end is turned away
+  BOOST_REQUIRE(!window.enter());
+}
+
+BOOST_AUTO_TEST_CASE(threads)
+{
+  const unsigned int count = 100;
+  ChunkWindow window(count, 4);
+  Sender sender;
+
+  sender.window = &window;
+  sender.inFlight = 0;
+  sender.maxInFlight = 0;
+  sender.sent.assign(count, 0);
+  for (unsigned int i = 0; i < 8; ++i) {
+    window.enter();
+    omni_thread::create(sendChunks, &sender);
+  }
+  window.join();
+
+  BOOST_REQUIRE(window.sent()==count);
+  BOOST_REQUIRE(sender.maxInFlight <= 4);
+  for (unsigned int i = 0; i < count; ++i) {
+    BOOST_REQUIRE(sender.sent[i]==1);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
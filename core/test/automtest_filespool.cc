@@ -0,0 +1,62 @@
+/**
+ * @file automtest_filespool.cc
+ * @brief This file implements the libdadicorba tests for the file spool
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "FileSpool.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(outOfOrder)
+{
+  const unsigned long chunk = 10000;
+  FileSpool spool("/tmp", 3 * chunk);
+  std::vector<char> data(3 * chunk);
+
+  for (unsigned long i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>(i * 7);
+  }
+  BOOST_REQUIRE(spool.size()==3 * chunk);
+  spool.write(2 * chunk, &data[2 * chunk], chunk);
+  spool.write(0, &data[0], chunk);
+
+  // The mapping sees the slices written before and after it
+  const char* mapping = spool.map();
+  BOOST_REQUIRE(mapping != NULL);
+  spool.write(chunk, &data[chunk], chunk);
+  BOOST_REQUIRE(memcmp(mapping, &data[0], data.size())==0);
+  BOOST_REQUIRE(spool.map()==mapping);
+}
+
+BOOST_AUTO_TEST_CASE(release)
+{
+  const unsigned long size = 1024 * 1024;
+  FileSpool spool("/tmp", size);
+  std::vector<char> data(size, 'x');
+
+  spool.write(0, &data[0], size);
+  const char* mapping = spool.map();
+  spool.release(0, size / 2);
+  // The released pages are read back from the file
+  BOOST_REQUIRE(mapping[0]=='x');
+  BOOST_REQUIRE(memcmp(mapping, &data[0], size)==0);
+}
+
+BOOST_AUTO_TEST_CASE(errors)
+{
+  BOOST_CHECK_THROW(FileSpool("/nonexistent-directory", 10),
+                    std::runtime_error);
+
+  FileSpool spool("/tmp", 10);
+  char data[20] = {0};
+  BOOST_CHECK_THROW(spool.write(5, data, 20), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
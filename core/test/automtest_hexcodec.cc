@@ -0,0 +1,171 @@
+/**
+ * @file automtest_hexcodec.cc
+ * @brief This file implements the libdadicorba tests and benchmark for the
+ * hexadecimal codec of the stringified IORs
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "HexCodec.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <omnithread.h>
+
+/* A forwarder IOR with three IIOP profiles (host, forwarder tag and
+ * address) carrying code set and ORB type components. */
+static const char multiProfileIOR[] =
+  "010000001200000049444c3a466f727761726465723a312e3000000003000000"
+  "00000000740000000101020012000000677261616c2e656e732d6c796f6e2e66"
+  "7200f90a20000000ff0000000001020304050607526f6f74504f410001010101"
+  "010101010101010102000000000000000c000000010000000000000001000105"
+  "0100000014000000010000000100010501000100010100010901010000000000"
+  "6c000000010102000a000000406677642d6c796f6e00000020000000ff000000"
+  "0001020304050607526f6f74504f410001010101010101010101010102000000"
+  "000000000c000000010000000000000001000105010000001400000001000000"
+  "010001050100010001010001090101000000000070000000010102000d000000"
+  "3139322e3136382e312e3132000085b420000000ff0000000001020304050607"
+  "526f6f74504f410001010101010101010101010102000000000000000c000000"
+  "0100000000000000010001050100000014000000010000000100010501000100"
+  "0101000109010100";
+
+/* The stream based decoding used before the codec. */
+static void
+streamDecode(const char* ptr, const size_t size,
+             std::vector<unsigned char>& bytes) {
+  std::stringstream ss;
+  int value;
+
+  for (unsigned int i = 0; i < size; i += 2) {
+    ss << ptr[i] << ptr[i+1];
+    ss >> std::hex >> value;
+    bytes.push_back(value);
+    ss.flush();
+    ss.clear();
+  }
+}
+
+/* The stream based encoding used before the codec. */
+static void
+streamEncode(const std::vector<unsigned char>& bytes, std::string& result) {
+  std::stringstream ss;
+
+  for (unsigned long i = 0; i < bytes.size(); ++i) {
+    std::string str;
+    unsigned char c = bytes[i];
+    if (c < 16) {
+      ss << '0';
+    }
+    ss << (unsigned short) c;
+    ss >> std::hex >> str;
+    ss.flush();
+    ss.clear();
+    result += str;
+  }
+}
+
+/* Elapsed time since (sec, nsec) in microseconds. */
+static unsigned long
+elapsed(const unsigned long sec, const unsigned long nsec) {
+  unsigned long now, nnow;
+
+  omni_thread::get_time(&now, &nnow);
+  return (now - sec) * 1000000
+    + (static_cast<long>(nnow) - static_cast<long>(nsec)) / 1000;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(decodeDigits)
+{
+  unsigned char bytes[4];
+
+  BOOST_REQUIRE(HexCodec::decode("00ff7Fa0", 8, bytes));
+  BOOST_REQUIRE(bytes[0]==0x00);
+  BOOST_REQUIRE(bytes[1]==0xff);
+  BOOST_REQUIRE(bytes[2]==0x7f);
+  BOOST_REQUIRE(bytes[3]==0xa0);
+  BOOST_REQUIRE(HexCodec::decode("", 0, bytes));
+  BOOST_REQUIRE(!HexCodec::decode("0", 1, bytes));
+  BOOST_REQUIRE(!HexCodec::decode("0g", 2, bytes));
+  BOOST_REQUIRE(!HexCodec::decode("0011223z", 8, bytes));
+  BOOST_REQUIRE(!HexCodec::decode("00112233 4", 10, bytes));
+}
+
+BOOST_AUTO_TEST_CASE(encodeDigits)
+{
+  const unsigned char bytes[] = {0x00, 0x0f, 0x10, 0xab, 0xff};
+  char digits[10];
+
+  HexCodec::encode(bytes, 5, digits);
+  BOOST_REQUIRE(std::string(digits, 10)=="000f10abff");
+}
+
+BOOST_AUTO_TEST_CASE(sameAsStreams)
+{
+  size_t size = strlen(multiProfileIOR);
+  std::vector<unsigned char> expected;
+  std::vector<unsigned char> bytes(size / 2);
+  std::string digits(size, ' ');
+  std::string streamDigits;
+
+  streamDecode(multiProfileIOR, size, expected);
+  BOOST_REQUIRE(HexCodec::decode(multiProfileIOR, size, &bytes[0]));
+  BOOST_REQUIRE(bytes==expected);
+
+  HexCodec::encode(&bytes[0], bytes.size(), &digits[0]);
+  streamEncode(bytes, streamDigits);
+  BOOST_REQUIRE(digits==multiProfileIOR);
+  BOOST_REQUIRE(digits==streamDigits);
+}
+
+BOOST_AUTO_TEST_CASE(benchmark)
+{
+  static const unsigned int loops = 2000;
+  size_t size = strlen(multiProfileIOR);
+  std::vector<unsigned char> bytes(size / 2);
+  std::string digits(size, ' ');
+  unsigned long sec, nsec;
+  unsigned long streamDec, codecDec, streamEnc, codecEnc;
+
+  omni_thread::get_time(&sec, &nsec);
+  for (unsigned int i = 0; i < loops; ++i) {
+    std::vector<unsigned char> result;
+    result.reserve(size / 2);
+    streamDecode(multiProfileIOR, size, result);
+  }
+  streamDec = elapsed(sec, nsec);
+
+  omni_thread::get_time(&sec, &nsec);
+  for (unsigned int i = 0; i < loops; ++i) {
+    HexCodec::decode(multiProfileIOR, size, &bytes[0]);
+  }
+  codecDec = elapsed(sec, nsec);
+
+  omni_thread::get_time(&sec, &nsec);
+  for (unsigned int i = 0; i < loops; ++i) {
+    std::string result;
+    streamEncode(bytes, result);
+  }
+  streamEnc = elapsed(sec, nsec);
+
+  omni_thread::get_time(&sec, &nsec);
+  for (unsigned int i = 0; i < loops; ++i) {
+    HexCodec::encode(&bytes[0], bytes.size(), &digits[0]);
+  }
+  codecEnc = elapsed(sec, nsec);
+
+  BOOST_TEST_MESSAGE(loops << " IORs of " << size / 2 << " bytes, decode: "
+                     << streamDec << " us with streams, " << codecDec
+                     << " us with the codec; encode: " << streamEnc
+                     << " us with streams, " << codecEnc
+                     << " us with the codec");
+  BOOST_REQUIRE(codecDec < streamDec);
+  BOOST_REQUIRE(codecEnc < streamEnc);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,84 @@
+/**
+ * @file automtest_objectcache.cc
+ * @brief This file implements the libdadicorba tests for the object cache
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "ObjectCache.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <sstream>
+
+static ObjectCache::Entry
+makeEntry(const unsigned int lease, const time_t expiry) {
+  ObjectCache::Entry entry;
+  entry.object = CORBA::Object::_nil();
+  entry.lease = lease;
+  entry.expiry = expiry;
+  entry.endpoint = "192.168.1.12:2809";
+  return entry;
+}
+
+static bool
+leased(const ObjectCache::Entry& entry, void* arg) {
+  return entry.lease != 0;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(hashFNV)
+{
+  BOOST_REQUIRE(ObjectCache::hash("")==2166136261U);
+  BOOST_REQUIRE(ObjectCache::hash("a")==0xe40c292cU);
+  BOOST_REQUIRE(ObjectCache::hash("dietSeD/SeD1")!=ObjectCache::hash("dietSeD/SeD2"));
+}
+
+BOOST_AUTO_TEST_CASE(putFind)
+{
+  ObjectCache cache(4);
+  ObjectCache::Entry entry;
+
+  BOOST_REQUIRE(!cache.find("dietSeD/SeD1", entry));
+  cache.put("dietSeD/SeD1", makeEntry(0, 0));
+  BOOST_REQUIRE(cache.find("dietSeD/SeD1", entry));
+  BOOST_REQUIRE(entry.endpoint=="192.168.1.12:2809");
+  cache.put("dietSeD/SeD1", makeEntry(10, 42));
+  BOOST_REQUIRE(cache.size()==1);
+  BOOST_REQUIRE(cache.find("dietSeD/SeD1", entry));
+  BOOST_REQUIRE(entry.expiry==42);
+}
+
+BOOST_AUTO_TEST_CASE(renewErase)
+{
+  ObjectCache cache;
+  ObjectCache::Entry entry;
+
+  cache.put("dietAgent/MA1", makeEntry(10, 42));
+  BOOST_REQUIRE(cache.renew("dietAgent/MA1", CORBA::Object::_nil(), 84));
+  BOOST_REQUIRE(cache.find("dietAgent/MA1", entry));
+  BOOST_REQUIRE(entry.expiry==84);
+  BOOST_REQUIRE(!cache.renew("dietAgent/MA2", CORBA::Object::_nil(), 84));
+  BOOST_REQUIRE(cache.erase("dietAgent/MA1", CORBA::Object::_nil()));
+  BOOST_REQUIRE(!cache.erase("dietAgent/MA1"));
+  BOOST_REQUIRE(cache.size()==0);
+}
+
+BOOST_AUTO_TEST_CASE(selectShards)
+{
+  ObjectCache cache(8);
+
+  for (unsigned int i = 0; i < 100; ++i) {
+    std::ostringstream key;
+    key << "dietSeD/SeD" << i;
+    cache.put(key.str(), makeEntry(i % 2, 0));
+  }
+  BOOST_REQUIRE(cache.size()==100);
+  BOOST_REQUIRE(cache.select().size()==100);
+  BOOST_REQUIRE(cache.select(leased).size()==50);
+  BOOST_REQUIRE(cache.select(leased, NULL, 10).size()==10);
+  cache.clear();
+  BOOST_REQUIRE(cache.size()==0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
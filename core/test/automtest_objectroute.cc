@@ -0,0 +1,213 @@
+/**
+ * @file automtest_objectroute.cc
+ * @brief This file implements the libdadicorba tests and benchmark for the
+ * parsing of the forwarded object names
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "ObjectRoute.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <cstring>
+#include <string>
+
+#include <omnithread.h>
+
+enum {
+  AGENT = 1,
+  SED,
+  CLIENT,
+  WFMGR,
+  MADAG,
+  DAGDA
+};
+
+static void
+fillTable(ObjectRoute::Table& table) {
+  table.add("dietAgent", AGENT);
+  table.add("dietSeD", SED);
+  table.add("dietClient", CLIENT);
+  table.add("dietWfMgr", WFMGR);
+  table.add("dietMADag", MADAG);
+  table.add("Dagda", DAGDA);
+}
+
+/* The string based routing used before the routes. */
+static bool
+remoteCall(std::string& objName) {
+  if (objName.find("remote:") != 0) {
+    objName = "remote:" + objName;
+    return false;
+  }
+  objName = objName.substr(strlen("remote:"));
+  return true;
+}
+
+static std::string
+getName(const std::string& namectxt) {
+  size_t pos = namectxt.find('/');
+  if (pos == std::string::npos) {
+    return namectxt;
+  }
+  return namectxt.substr(pos+1);
+}
+
+static std::string
+getCtxt(const std::string& namectxt) {
+  size_t pos = namectxt.find('/');
+  if (pos == std::string::npos) {
+    return "";
+  }
+  return namectxt.substr(0, pos);
+}
+
+static int
+stringRoute(const char* objName) {
+  std::string objString(objName);
+  std::string name;
+  std::string ctxt;
+
+  if (!remoteCall(objString)) {
+    return objString.length();
+  }
+  name = getName(objString);
+  ctxt = getCtxt(objString);
+  if (ctxt == std::string("dietAgent")) {
+    return AGENT + name.length();
+  }
+  if (ctxt == std::string("dietClient")) {
+    return CLIENT + name.length();
+  }
+  if (ctxt == std::string("dietWfMgr")) {
+    return WFMGR + name.length();
+  }
+  if (ctxt == std::string("dietMADag")) {
+    return MADAG + name.length();
+  }
+  if (ctxt == std::string("dietSeD")) {
+    return SED + name.length();
+  }
+  return 0;
+}
+
+static int
+tableRoute(const char* objName, const ObjectRoute::Table& table) {
+  ObjectRoute route(objName, table);
+
+  if (!route.remote()) {
+    return strlen(route.peerName());
+  }
+  switch (route.context()) {
+  case AGENT:
+  case CLIENT:
+  case WFMGR:
+  case MADAG:
+  case SED:
+    return route.context() + strlen(route.name());
+  default:
+    return 0;
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(parseRemote)
+{
+  ObjectRoute::Table table;
+  fillTable(table);
+  ObjectRoute route("remote:dietSeD/SeD1", table);
+
+  BOOST_REQUIRE(route.remote());
+  BOOST_REQUIRE(route.hasContext());
+  BOOST_REQUIRE(route.context()==SED);
+  BOOST_REQUIRE(route.contextName()=="dietSeD");
+  BOOST_REQUIRE(std::string(route.name())=="SeD1");
+  BOOST_REQUIRE(std::string(route.path())=="dietSeD/SeD1");
+}
+
+BOOST_AUTO_TEST_CASE(parseLocal)
+{
+  ObjectRoute::Table table;
+  fillTable(table);
+  ObjectRoute route("dietAgent/MA1", table);
+
+  BOOST_REQUIRE(!route.remote());
+  BOOST_REQUIRE(route.context()==AGENT);
+  BOOST_REQUIRE(std::string(route.peerName())=="remote:dietAgent/MA1");
+
+  std::string longName = "Dagda/" + std::string(300, 'x');
+  ObjectRoute longRoute(longName.c_str(), table);
+  BOOST_REQUIRE(longRoute.context()==DAGDA);
+  BOOST_REQUIRE(std::string(longRoute.peerName())=="remote:" + longName);
+}
+
+BOOST_AUTO_TEST_CASE(parseUnknown)
+{
+  ObjectRoute::Table table;
+  fillTable(table);
+
+  ObjectRoute noContext("remote:SeD1", table);
+  BOOST_REQUIRE(!noContext.hasContext());
+  BOOST_REQUIRE(noContext.context()==ObjectRoute::UNKNOWN_CONTEXT);
+  BOOST_REQUIRE(noContext.contextName()=="");
+  BOOST_REQUIRE(std::string(noContext.name())=="SeD1");
+
+  ObjectRoute unknown("remote:LogServiceC/LC", table);
+  BOOST_REQUIRE(unknown.hasContext());
+  BOOST_REQUIRE(unknown.context()==ObjectRoute::UNKNOWN_CONTEXT);
+  BOOST_REQUIRE(unknown.contextName()=="LogServiceC");
+
+  ObjectRoute prefix("remote:dietSe/SeD1", table);
+  BOOST_REQUIRE(prefix.context()==ObjectRoute::UNKNOWN_CONTEXT);
+  ObjectRoute empty("", table);
+  BOOST_REQUIRE(!empty.remote());
+  BOOST_REQUIRE(std::string(empty.name())=="");
+}
+
+BOOST_AUTO_TEST_CASE(sameRoutes)
+{
+  ObjectRoute::Table table;
+  fillTable(table);
+  const char* names[] = {
+    "remote:dietSeD/SeD1", "remote:dietAgent/MA1", "dietAgent/MA1",
+    "remote:dietMADag/MADAG", "remote:Dagda/SeD1-dagda", "remote:SeD1"
+  };
+
+  for (unsigned int i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+    BOOST_REQUIRE(stringRoute(names[i])==tableRoute(names[i], table));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(benchmark)
+{
+  static const unsigned int loops = 200000;
+  ObjectRoute::Table table;
+  fillTable(table);
+  const char* objName = "remote:dietSeD/SeD-graal-12.lyon.grid5000.fr";
+  unsigned long sec, nsec, endSec, endNsec;
+  unsigned long stringTime, tableTime;
+  unsigned long check = 0;
+
+  omni_thread::get_time(&sec, &nsec);
+  for (unsigned int i = 0; i < loops; ++i) {
+    check += stringRoute(objName);
+  }
+  omni_thread::get_time(&endSec, &endNsec);
+  stringTime = (endSec - sec) * 1000000000UL + endNsec - nsec;
+
+  omni_thread::get_time(&sec, &nsec);
+  for (unsigned int i = 0; i < loops; ++i) {
+    check -= tableRoute(objName, table);
+  }
+  omni_thread::get_time(&endSec, &endNsec);
+  tableTime = (endSec - sec) * 1000000000UL + endNsec - nsec;
+
+  BOOST_TEST_MESSAGE("Routing of a forwarded call: "
+                     << stringTime / loops << " ns with strings, "
+                     << tableTime / loops << " ns with the route table");
+  BOOST_REQUIRE(check==0);
+  BOOST_REQUIRE(tableTime < stringTime);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
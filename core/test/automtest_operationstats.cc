@@ -0,0 +1,158 @@
+/**
+ * @file automtest_operationstats.cc
+ * @brief This file implements the libdadicorba tests for the operation
+ *        statistics
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "OperationStats.hh"
+#include "WorkerPool.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <omnithread.h>
+
+/* Outlives the worker threads, which give back their counters on exit. */
+static OperationStats threadStats;
+
+/* A call of the "work" operation. */
+class CallTask : public WorkerPool::Task {
+public:
+  void
+  run() {
+    OperationStats::Call call(threadStats, "work", true);
+    call.received(10);
+  }
+};
+
+static const OperationStats::Summary*
+find(const std::vector<OperationStats::Summary>& stats,
+     const std::string& operation, bool local) {
+  for (unsigned int i = 0; i < stats.size(); ++i) {
+    if (stats[i].operation == operation && stats[i].local == local) {
+      return &stats[i];
+    }
+  }
+  return NULL;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(buckets)
+{
+  BOOST_REQUIRE(OperationStats::bucket(0)==0);
+  BOOST_REQUIRE(OperationStats::bucket(0.5e-6)==0);
+  BOOST_REQUIRE(OperationStats::bucket(1e-6)==1);
+  BOOST_REQUIRE(OperationStats::bucket(1e6)==OperationStats::NB_BUCKETS-1);
+  for (double latency = 1e-6; latency < 100; latency *= 1.7) {
+    unsigned int bucket = OperationStats::bucket(latency);
+    BOOST_REQUIRE(OperationStats::bucketBound(bucket) >= latency);
+    BOOST_REQUIRE(OperationStats::bucketBound(bucket) < latency * 1.2);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(countsPerPath)
+{
+  OperationStats stats;
+
+  for (unsigned int i = 0; i < 10; ++i) {
+    OperationStats::Call call(stats, "ping", true);
+  }
+  {
+    OperationStats::Call call(stats, "ping", false);
+    call.received(100);
+    call.sent(20);
+  }
+  try {
+    OperationStats::Call call(stats, "bind", false);
+    throw 1;
+  } catch (int) {
+  }
+
+  std::vector<OperationStats::Summary> result = stats.snapshot();
+  BOOST_REQUIRE(result.size()==3);
+  const OperationStats::Summary* local = find(result, "ping", true);
+  const OperationStats::Summary* peer = find(result, "ping", false);
+  const OperationStats::Summary* failed = find(result, "bind", false);
+  BOOST_REQUIRE(local != NULL && peer != NULL && failed != NULL);
+  BOOST_REQUIRE(local->calls==10);
+  BOOST_REQUIRE(local->errors==0);
+  BOOST_REQUIRE(peer->calls==1);
+  BOOST_REQUIRE(peer->bytesIn==100);
+  BOOST_REQUIRE(peer->bytesOut==20);
+  BOOST_REQUIRE(failed->calls==1);
+  BOOST_REQUIRE(failed->errors==1);
+}
+
+BOOST_AUTO_TEST_CASE(percentiles)
+{
+  OperationStats stats;
+
+  for (unsigned int i = 0; i < 998; ++i) {
+    OperationStats::Call call(stats, "fast", true);
+  }
+  for (unsigned int i = 0; i < 2; ++i) {
+    OperationStats::Call call(stats, "fast", true);
+    omni_thread::sleep(0, 50000000);
+  }
+
+  std::vector<OperationStats::Summary> result = stats.snapshot();
+  BOOST_REQUIRE(result.size()==1);
+  BOOST_REQUIRE(result[0].calls==1000);
+  BOOST_REQUIRE(result[0].p50 < 0.01);
+  BOOST_REQUIRE(result[0].p99 < 0.01);
+  BOOST_REQUIRE(result[0].p999 >= 0.05);
+}
+
+BOOST_AUTO_TEST_CASE(threads)
+{
+  {
+    WorkerPool pool(4);
+    for (unsigned int i = 0; i < 200; ++i) {
+      pool.submit(new CallTask);
+    }
+    for (unsigned int i = 0; i < 300; ++i) {
+      std::vector<OperationStats::Summary> result = threadStats.snapshot();
+      if (!result.empty() && result[0].calls == 200) {
+        break;
+      }
+      omni_thread::sleep(0, 10000000);
+    }
+  }
+
+  std::vector<OperationStats::Summary> result = threadStats.snapshot();
+  BOOST_REQUIRE(result.size()==1);
+  BOOST_REQUIRE(result[0].calls==200);
+  BOOST_REQUIRE(result[0].bytesIn==2000);
+}
+
+BOOST_AUTO_TEST_CASE(dumpFile)
+{
+  const std::string path = "automtest_operationstats.dump";
+  OperationStats stats;
+  std::string line;
+
+  {
+    OperationStats::Call call(stats, "getName", true);
+  }
+  std::remove(path.c_str());
+  stats.startDump(path, 1);
+  omni_thread::sleep(1, 500000000);
+  stats.stopDump();
+
+  std::ifstream in(path.c_str());
+  BOOST_REQUIRE(in);
+  std::getline(in, line);
+  BOOST_REQUIRE(line[0]=='#');
+  std::getline(in, line);
+  BOOST_REQUIRE(line.find("getName local 1 0")==0);
+  in.close();
+  std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
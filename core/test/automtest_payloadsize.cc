@@ -0,0 +1,48 @@
+/**
+ * @file automtest_payloadsize.cc
+ * @brief This file implements the libdadicorba tests for the payload size
+ *        of the results counted by the operation statistics
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "PayloadSize.hh"
+#include "OperationStats.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(sequence)
+{
+  CORBA::ULongSeq empty;
+  CORBA::ULongSeq values;
+
+  values.length(3);
+  for (CORBA::ULong i = 0; i < values.length(); ++i) {
+    values[i] = i;
+  }
+  // The length, then the elements
+  BOOST_REQUIRE(payloadSize(empty)==4);
+  BOOST_REQUIRE(payloadSize(values)==16);
+}
+
+BOOST_AUTO_TEST_CASE(bytesOut)
+{
+  OperationStats stats;
+  CORBA::ULongSeq values;
+
+  values.length(10);
+  {
+    OperationStats::Call call(stats, "getValues", false);
+    call.sent(payloadSize(values));
+  }
+
+  std::vector<OperationStats::Summary> result = stats.snapshot();
+  BOOST_REQUIRE(result.size()==1);
+  BOOST_REQUIRE(result[0].bytesIn==0);
+  BOOST_REQUIRE(result[0].bytesOut==44);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,108 @@
+/**
+ * @file automtest_resultcache.cc
+ * @brief This file implements the libdadicorba tests for the result cache
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "ResultCache.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+#include <omnithread.h>
+
+typedef ResultCache<std::string> StringCache;
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(disabled)
+{
+  StringCache cache;
+  std::string value;
+
+  BOOST_REQUIRE(!cache.insert("MA1", "getHostname", "host",
+                              cache.generation()));
+  BOOST_REQUIRE(!cache.find("MA1", "getHostname", value));
+  BOOST_REQUIRE(cache.size()==0);
+}
+
+BOOST_AUTO_TEST_CASE(findInsert)
+{
+  StringCache cache(60);
+  std::string value;
+
+  BOOST_REQUIRE(!cache.find("MA1", "getHostname", value));
+  BOOST_REQUIRE(cache.insert("MA1", "getHostname", "host1",
+                             cache.generation()));
+  BOOST_REQUIRE(cache.insert("SeD1", "getHostname", "host2",
+                             cache.generation()));
+  BOOST_REQUIRE(cache.find("MA1", "getHostname", value));
+  BOOST_REQUIRE(value=="host1");
+  BOOST_REQUIRE(cache.find("SeD1", "getHostname", value));
+  BOOST_REQUIRE(value=="host2");
+  BOOST_REQUIRE(!cache.find("MA1", "getBindName", value));
+  BOOST_REQUIRE(cache.size()==2);
+}
+
+BOOST_AUTO_TEST_CASE(invalidate)
+{
+  StringCache cache(60);
+  std::string value;
+
+  cache.insert("MA1", "getHostname", "host1", cache.generation());
+  cache.insert("MA1", "getProfiles", "profiles1", cache.generation());
+  cache.insert("MA2", "getProfiles", "profiles2", cache.generation());
+
+  cache.invalidate("MA1");
+  BOOST_REQUIRE(!cache.find("MA1", "getHostname", value));
+  BOOST_REQUIRE(cache.find("MA2", "getProfiles", value));
+  BOOST_REQUIRE(cache.size()==1);
+
+  cache.insert("MA1", "getHostname", "host1", cache.generation());
+  cache.invalidateCall("getProfiles");
+  BOOST_REQUIRE(!cache.find("MA2", "getProfiles", value));
+  BOOST_REQUIRE(cache.find("MA1", "getHostname", value));
+  BOOST_REQUIRE(cache.size()==1);
+}
+
+BOOST_AUTO_TEST_CASE(staleResult)
+{
+  StringCache cache(60);
+  std::string value;
+
+  // The result was fetched while the target was rebound: not cached
+  unsigned long generation = cache.generation();
+  cache.invalidate("MA1");
+  BOOST_REQUIRE(!cache.insert("MA1", "getHostname", "old", generation));
+  BOOST_REQUIRE(!cache.find("MA1", "getHostname", value));
+}
+
+BOOST_AUTO_TEST_CASE(ttl)
+{
+  StringCache cache(1);
+  std::string value;
+
+  cache.insert("MA1", "getHostname", "host1", cache.generation());
+  BOOST_REQUIRE(cache.find("MA1", "getHostname", value));
+  omni_thread::sleep(2, 100000000);
+  BOOST_REQUIRE(!cache.find("MA1", "getHostname", value));
+  BOOST_REQUIRE(cache.size()==0);
+}
+
+BOOST_AUTO_TEST_CASE(maxSize)
+{
+  StringCache cache(60, 2);
+  std::string value;
+
+  BOOST_REQUIRE(cache.insert("A", "op", "a", cache.generation()));
+  BOOST_REQUIRE(cache.insert("B", "op", "b", cache.generation()));
+  BOOST_REQUIRE(!cache.insert("C", "op", "c", cache.generation()));
+  // A cached result can still be replaced
+  BOOST_REQUIRE(cache.insert("A", "op", "a2", cache.generation()));
+  BOOST_REQUIRE(cache.find("A", "op", value));
+  BOOST_REQUIRE(value=="a2");
+  BOOST_REQUIRE(cache.size()==2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
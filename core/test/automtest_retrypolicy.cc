@@ -0,0 +1,97 @@
+/**
+ * @file automtest_retrypolicy.cc
+ * @brief This file implements the libdadicorba tests for the retry policy
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "RetryPolicy.hh"
+#include <boost/test/unit_test.hpp>
+
+static const std::string peer = "192.168.1.12:2809";
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(maxRetries)
+{
+  RetryPolicy policy;
+  policy.setCircuit(0, 10);
+  policy.setMaxRetries(2);
+  BOOST_REQUIRE(policy.failure(peer, 0));
+  BOOST_REQUIRE(policy.failure(peer, 1));
+  BOOST_REQUIRE(!policy.failure(peer, 2));
+  BOOST_REQUIRE(policy.stats()[peer].failures==3);
+  BOOST_REQUIRE(policy.stats()[peer].retries==2);
+}
+
+BOOST_AUTO_TEST_CASE(backoff)
+{
+  RetryPolicy policy;
+  policy.setBackoff(100, 1000);
+  for (unsigned int i = 0; i < 20; ++i) {
+    unsigned long delay = policy.backoff(0);
+    BOOST_REQUIRE(delay >= 50 && delay <= 100);
+    delay = policy.backoff(2);
+    BOOST_REQUIRE(delay >= 200 && delay <= 400);
+    delay = policy.backoff(10);
+    BOOST_REQUIRE(delay >= 500 && delay <= 1000);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(circuitOpens)
+{
+  RetryPolicy policy;
+  policy.setCircuit(3, 60);
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::ADMIT);
+  policy.failure(peer, 0);
+  policy.failure(peer, 1);
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::ADMIT);
+  BOOST_REQUIRE(!policy.failure(peer, 2));
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::REJECT);
+  BOOST_REQUIRE(policy.admit("10.0.0.1:2809")==RetryPolicy::ADMIT);
+
+  std::map<std::string, RetryPolicy::EndpointStats> stats = policy.stats();
+  BOOST_REQUIRE(stats[peer].state==RetryPolicy::CIRCUIT_OPEN);
+  BOOST_REQUIRE(stats[peer].trips==1);
+  BOOST_REQUIRE(stats[peer].rejected==1);
+}
+
+BOOST_AUTO_TEST_CASE(successResets)
+{
+  RetryPolicy policy;
+  policy.setCircuit(3, 60);
+  policy.failure(peer, 0);
+  policy.failure(peer, 1);
+  /* A call in between succeeded: the next failures start again. */
+  policy.success(peer);
+  BOOST_REQUIRE(policy.failure(peer, 0));
+  BOOST_REQUIRE(policy.failure(peer, 1));
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::ADMIT);
+  BOOST_REQUIRE(policy.stats()[peer].trips==0);
+}
+
+BOOST_AUTO_TEST_CASE(circuitHalfOpen)
+{
+  RetryPolicy policy;
+  policy.setCircuit(1, 0);
+  policy.failure(peer, 0);
+  /* The open time elapsed: one probe is let through. */
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::PROBE);
+  BOOST_REQUIRE(policy.stats()[peer].state==RetryPolicy::CIRCUIT_HALF_OPEN);
+  policy.success(peer);
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::ADMIT);
+  BOOST_REQUIRE(policy.stats()[peer].state==RetryPolicy::CIRCUIT_CLOSED);
+}
+
+BOOST_AUTO_TEST_CASE(probeFails)
+{
+  RetryPolicy policy;
+  policy.setCircuit(1, 0);
+  policy.failure(peer, 0);
+  BOOST_REQUIRE(policy.admit(peer)==RetryPolicy::PROBE);
+  BOOST_REQUIRE(!policy.failure(peer, 0));
+  BOOST_REQUIRE(policy.stats()[peer].state==RetryPolicy::CIRCUIT_OPEN);
+  BOOST_REQUIRE(policy.stats()[peer].trips==2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
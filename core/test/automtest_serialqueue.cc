@@ -0,0 +1,128 @@
+/**
+ * @file automtest_serialqueue.cc
+ * @brief This file implements the libdadicorba tests for the serial queue
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "SerialQueue.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+#include <omnithread.h>
+
+/* Appends its id to a shared vector, after a pause. */
+class RecordTask : public WorkerPool::Task {
+public:
+  RecordTask(omni_mutex* mutex, std::vector<int>* done, int id,
+             unsigned long pause)
+    : mmutex(mutex), mdone(done), mid(id), mpause(pause) {}
+
+  void
+  run() {
+    omni_thread::sleep(0, mpause);
+    mmutex->lock();
+    mdone->push_back(mid);
+    mmutex->unlock();
+  }
+
+private:
+  omni_mutex* mmutex;
+  std::vector<int>* mdone;
+  int mid;
+  unsigned long mpause;
+};
+
+/* Tells whether it runs on a worker of the pool. */
+class WorkerTask : public WorkerPool::Task {
+public:
+  WorkerTask(WorkerPool* pool, int* result) : mpool(pool), mresult(result) {}
+
+  void
+  run() {
+    *mresult = mpool->isWorker() ? 1 : 0;
+  }
+
+private:
+  WorkerPool* mpool;
+  int* mresult;
+};
+
+static void
+waitFor(SerialQueue& queue) {
+  for (unsigned int i = 0; i < 300 && queue.pending() > 0; ++i) {
+    omni_thread::sleep(0, 10000000);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(orderPerKey)
+{
+  omni_mutex mutex;
+  std::vector<int> done;
+  WorkerPool pool(4);
+  SerialQueue queue(pool);
+
+  // The first task is the slowest: the others must wait for it
+  queue.submit("a", new RecordTask(&mutex, &done, 0, 50000000));
+  for (int i = 1; i < 10; ++i) {
+    queue.submit("a", new RecordTask(&mutex, &done, i, 0));
+  }
+  waitFor(queue);
+  BOOST_REQUIRE(done.size()==10);
+  for (int i = 0; i < 10; ++i) {
+    BOOST_REQUIRE(done[i]==i);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(keysConcurrent)
+{
+  omni_mutex mutex;
+  std::vector<int> done;
+  WorkerPool pool(2);
+  SerialQueue queue(pool);
+
+  // A slow key does not delay the other one
+  queue.submit("slow", new RecordTask(&mutex, &done, 0, 300000000));
+  queue.submit("fast", new RecordTask(&mutex, &done, 1, 0));
+  waitFor(queue);
+  BOOST_REQUIRE(done.size()==2);
+  BOOST_REQUIRE(done[0]==1);
+  BOOST_REQUIRE(done[1]==0);
+}
+
+BOOST_AUTO_TEST_CASE(isWorker)
+{
+  int result = -1;
+  WorkerPool pool(1);
+  SerialQueue queue(pool);
+
+  BOOST_REQUIRE(!pool.isWorker());
+  queue.submit("a", new WorkerTask(&pool, &result));
+  waitFor(queue);
+  BOOST_REQUIRE(result==1);
+}
+
+BOOST_AUTO_TEST_CASE(limit)
+{
+  omni_mutex mutex;
+  std::vector<int> done;
+  WorkerPool pool(1);
+  SerialQueue queue(pool, 2);
+
+  // The first task holds the worker while the queue fills
+  BOOST_REQUIRE(queue.submit("a", new RecordTask(&mutex, &done, 0,
+                                                 50000000)));
+  BOOST_REQUIRE(queue.submit("b", new RecordTask(&mutex, &done, 1, 0)));
+  RecordTask refused(&mutex, &done, 2, 0);
+  BOOST_REQUIRE(!queue.submit("a", &refused));
+  waitFor(queue);
+  BOOST_REQUIRE(done.size()==2);
+  BOOST_REQUIRE(queue.submit("a", new RecordTask(&mutex, &done, 3, 0)));
+  waitFor(queue);
+  BOOST_REQUIRE(done.size()==3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,61 @@
+/**
+ * @file automtest_sha256.cc
+ * @brief This file implements the libdadicorba tests for the SHA-256
+ * digests
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "Sha256.hh"
+#include "HexCodec.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <vector>
+
+/* The digest of a string, in hexadecimal. */
+static std::string
+hexDigest(const std::string& data) {
+  unsigned char digest[Sha256::DIGEST_SIZE];
+  char hex[2 * Sha256::DIGEST_SIZE];
+
+  Sha256::digest(reinterpret_cast<const unsigned char*>(data.data()),
+                 data.size(), digest);
+  HexCodec::encode(digest, sizeof(digest), hex);
+  return std::string(hex, sizeof(hex));
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(vectors)
+{
+  BOOST_REQUIRE(hexDigest("")=="e3b0c44298fc1c149afbf4c8996fb924"
+                "27ae41e4649b934ca495991b7852b855");
+  BOOST_REQUIRE(hexDigest("abc")=="ba7816bf8f01cfea414140de5dae2223"
+                "b00361a396177a9cb410ff61f20015ad");
+  BOOST_REQUIRE(hexDigest("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomn"
+                          "opnopq")
+                =="248d6a61d20638b8e5c026930c3e6039"
+                "a33ce45964ff2167f6ecedd419db06c1");
+  BOOST_REQUIRE(hexDigest(std::string(1000000, 'a'))
+                =="cdc76e5c9914fb9281a1c7e284d73e67"
+                "f1809a48a497200e046d39ccc7112cd0");
+}
+
+BOOST_AUTO_TEST_CASE(padding)
+{
+  // Lengths around the block boundaries give distinct digests
+  std::vector<std::string> digests;
+
+  for (unsigned int length = 54; length <= 66; ++length) {
+    digests.push_back(hexDigest(std::string(length, 'x')));
+    for (unsigned int i = 0; i + 1 < digests.size(); ++i) {
+      BOOST_REQUIRE(digests[i]!=digests.back());
+    }
+  }
+  BOOST_REQUIRE(Sha256::digest(
+                  reinterpret_cast<const unsigned char*>("abc"), 3).size()
+                ==Sha256::DIGEST_SIZE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,163 @@
+/**
+ * @file automtest_streamjournal.cc
+ * @brief This file implements the libdadicorba tests for the journal of
+ * the resumable transfers
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "StreamJournal.hh"
+#include "ChunkWindow.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* The chunks of a transfer and their checksums. */
+static std::vector<unsigned long>
+makeChunks(std::vector<std::vector<unsigned char> >& chunks,
+           const unsigned long count, const unsigned char seed) {
+  std::vector<unsigned long> checksums;
+
+  chunks.assign(count, std::vector<unsigned char>(4096 + 3));
+  for (unsigned long i = 0; i < count; ++i) {
+    for (unsigned long j = 0; j < chunks[i].size(); ++j) {
+      chunks[i][j] = static_cast<unsigned char>(seed + i * 31 + j);
+    }
+    checksums.push_back(StreamJournal::checksum(&chunks[i][0],
+                                                chunks[i].size()));
+  }
+  return checksums;
+}
+
+/* A fresh directory for the journal files. */
+static std::string
+makeDirectory() {
+  char path[] = "/tmp/journal-XXXXXX";
+
+  BOOST_REQUIRE(mkdtemp(path) != NULL);
+  return path;
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(checksum)
+{
+  const char* check = "123456789";
+
+  BOOST_REQUIRE(StreamJournal::checksum(
+                  reinterpret_cast<const unsigned char*>(check), 9)
+                ==0xCBF43926UL);
+  BOOST_REQUIRE(StreamJournal::checksum(NULL, 0)==0);
+}
+
+BOOST_AUTO_TEST_CASE(memory)
+{
+  StreamJournal journal("", "MA1/id 0 100 10");
+  std::vector<unsigned long> checksums;
+
+  checksums.push_back(1);
+  checksums.push_back(2);
+  checksums.push_back(3);
+  BOOST_REQUIRE(journal.resumePoint(checksums)==0);
+  journal.commit(0, 1);
+  journal.commit(1, 2);
+  BOOST_REQUIRE(journal.committed()==2);
+  BOOST_REQUIRE(journal.resumePoint(checksums)==2);
+
+  // The data of the second chunk changed meanwhile
+  checksums[1] = 5;
+  BOOST_REQUIRE(journal.resumePoint(checksums)==1);
+  journal.commit(1, 5);
+  BOOST_REQUIRE(journal.resumePoint(checksums)==2);
+  BOOST_CHECK_THROW(journal.commit(4, 1), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(killedReceiver)
+{
+  const unsigned long count = 10;
+  const unsigned long killedAfter = 6;
+  const std::string key = "SeD1/dagda-id 0 41030 4099";
+  std::string directory = makeDirectory();
+  std::vector<std::vector<unsigned char> > chunks;
+  std::vector<unsigned long> checksums = makeChunks(chunks, count, 7);
+  int status;
+
+  // The receiver commits the first chunks, then is killed midway
+  pid_t pid = fork();
+  BOOST_REQUIRE(pid >= 0);
+  if (pid == 0) {
+    StreamJournal journal(directory, key);
+    for (unsigned long i = 0; i < killedAfter; ++i) {
+      journal.commit(i, StreamJournal::checksum(&chunks[i][0],
+                                                chunks[i].size()));
+    }
+    kill(getpid(), SIGKILL);
+    _exit(1);
+  }
+  BOOST_REQUIRE(waitpid(pid, &status, 0)==pid);
+  BOOST_REQUIRE(WIFSIGNALED(status) && WTERMSIG(status)==SIGKILL);
+
+  // The restarted receiver finds the committed chunks
+  StreamJournal journal(directory, key);
+  BOOST_REQUIRE(journal.committed()==killedAfter);
+  unsigned long first = journal.resumePoint(checksums);
+  BOOST_REQUIRE(first==killedAfter);
+
+  // Only the remainder is sent again
+  ChunkWindow window(count, 4, first);
+  unsigned long index;
+  unsigned long resent = 0;
+  while (window.next(index)) {
+    journal.commit(index, StreamJournal::checksum(&chunks[index][0],
+                                                  chunks[index].size()));
+    window.done(index);
+    ++resent;
+  }
+  BOOST_REQUIRE(resent==count - killedAfter);
+  BOOST_REQUIRE(window.sent()==count);
+  BOOST_REQUIRE(journal.resumePoint(checksums)==count);
+
+  journal.remove();
+  BOOST_REQUIRE(StreamJournal(directory, key).committed()==0);
+  StreamJournal::purge(directory, -1);
+  BOOST_REQUIRE(rmdir(directory.c_str())==0);
+}
+
+BOOST_AUTO_TEST_CASE(replay)
+{
+  const std::string key = "SeD1/dagda-id 0 100 10";
+  std::string directory = makeDirectory();
+
+  {
+    StreamJournal journal(directory, key);
+    journal.commit(0, 10);
+    journal.commit(1, 11);
+    journal.commit(2, 12);
+    // Resumed from the second chunk, whose data changed
+    journal.commit(1, 21);
+  }
+  {
+    StreamJournal journal(directory, key);
+    std::vector<unsigned long> checksums;
+    checksums.push_back(10);
+    checksums.push_back(21);
+    checksums.push_back(12);
+    BOOST_REQUIRE(journal.committed()==2);
+    BOOST_REQUIRE(journal.resumePoint(checksums)==2);
+  }
+
+  // Another transfer whose key has the same file name starts afresh
+  BOOST_REQUIRE(StreamJournal(directory, key + " ").committed()==0);
+
+  StreamJournal::purge(directory, 3600);
+  BOOST_REQUIRE(rmdir(directory.c_str())!=0);
+  StreamJournal::purge(directory, -1);
+  BOOST_REQUIRE(rmdir(directory.c_str())==0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,136 @@
+/**
+ * @file automtest_workerpool.cc
+ * @brief This file implements the libdadicorba tests for the worker pool
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include "WorkerPool.hh"
+#include <boost/test/unit_test.hpp>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <omnithread.h>
+
+/* Appends its id to a shared vector. */
+class RecordTask : public WorkerPool::Task {
+public:
+  RecordTask(omni_mutex* mutex, std::vector<int>* done, int id)
+    : mmutex(mutex), mdone(done), mid(id) {}
+
+  void
+  run() {
+    mmutex->lock();
+    mdone->push_back(mid);
+    mmutex->unlock();
+  }
+
+private:
+  omni_mutex* mmutex;
+  std::vector<int>* mdone;
+  int mid;
+};
+
+/* Counts its destructions, to check the pool ownership. */
+class CountedTask : public WorkerPool::Task {
+public:
+  explicit CountedTask(int* deleted) : mdeleted(deleted) {}
+  ~CountedTask() { ++(*mdeleted); }
+
+  void
+  run() {}
+
+private:
+  int* mdeleted;
+};
+
+/* Throws when run. */
+class FailingTask : public WorkerPool::Task {
+public:
+  void
+  run() {
+    throw std::runtime_error("failed");
+  }
+};
+
+/* Records the failures reported by the pool. */
+static void
+recordFailure(const std::string& failure, void* arg) {
+  static_cast<std::vector<std::string>*>(arg)->push_back(failure);
+}
+
+static void
+waitFor(omni_mutex& mutex, std::vector<int>& done, unsigned int size) {
+  for (unsigned int i = 0; i < 200; ++i) {
+    mutex.lock();
+    bool ok = (done.size() >= size);
+    mutex.unlock();
+    if (ok) {
+      return;
+    }
+    omni_thread::sleep(0, 10000000);
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(test_suite)
+
+BOOST_AUTO_TEST_CASE(runAll)
+{
+  omni_mutex mutex;
+  std::vector<int> done;
+  WorkerPool pool(4);
+
+  for (int i = 0; i < 50; ++i) {
+    pool.submit(new RecordTask(&mutex, &done, i));
+  }
+  waitFor(mutex, done, 50);
+  BOOST_REQUIRE(done.size()==50);
+}
+
+BOOST_AUTO_TEST_CASE(delayedOrder)
+{
+  omni_mutex mutex;
+  std::vector<int> done;
+  WorkerPool pool(1);
+
+  pool.submit(new RecordTask(&mutex, &done, 2), 300);
+  pool.submit(new RecordTask(&mutex, &done, 1), 100);
+  pool.submit(new RecordTask(&mutex, &done, 0));
+  waitFor(mutex, done, 3);
+  BOOST_REQUIRE(done.size()==3);
+  BOOST_REQUIRE(done[0]==0);
+  BOOST_REQUIRE(done[1]==1);
+  BOOST_REQUIRE(done[2]==2);
+}
+
+BOOST_AUTO_TEST_CASE(dropPending)
+{
+  int deleted = 0;
+  {
+    WorkerPool pool(1);
+    pool.submit(new CountedTask(&deleted), 60000);
+    BOOST_REQUIRE(pool.pending()==1);
+  }
+  BOOST_REQUIRE(deleted==1);
+}
+
+BOOST_AUTO_TEST_CASE(failureReport)
+{
+  omni_mutex mutex;
+  std::vector<int> done;
+  std::vector<std::string> failures;
+  WorkerPool pool(1);
+
+  pool.setFailureReport(recordFailure, &failures);
+  pool.submit(new FailingTask);
+  // Run after the failing task by the single worker
+  pool.submit(new RecordTask(&mutex, &done, 0));
+  waitFor(mutex, done, 1);
+  BOOST_REQUIRE(done.size()==1);
+  BOOST_REQUIRE(failures.size()==1);
+  BOOST_REQUIRE(failures[0]=="failed");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,142 @@
+/**
+ * @file benchRecordData.cc
+ * @brief Benchmark of the Dagda transfers through a forwarder pair: the
+ * recordData throughput, with or without the forwarders relays, with the
+ * data as chars or as octets. Built with -DENABLE_BENCHMARKS=ON.
+ *
+ * Usage, with a forwarder pair between the two sides:
+ *   benchRecordData sink <name>                          (first side)
+ *   benchRecordData client <name> <KB> <count> [octets]  (other side)
+ * The sink binds a Dagda object receiving the data, the client sends
+ * <count> blocks of <KB> kilobytes to it and prints the throughput. With
+ * "octets", the client calls recordDataOctets instead of recordData.
+ * To compare the paths, run the client from 1024 KB to 1048576 KB with
+ * the forwarders launched with --octets yes, then with --octets no (the
+ * char path). Blocks over 2 MB need a larger -ORBgiopMaxMsgSize on all
+ * the processes.
+ * @section Licence
+ *  |LICENCE|
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/time.h>
+
+#include "ORBMgr.hh"
+#include "RelayServant.hh"
+#include "Dagda.hh"
+#include "common_types.hh"
+
+/* Dagda object only implementing recordData, as chars and as octets,
+   without decoding the data. */
+class RecordSink : public RelayServant {
+public:
+  RecordSink() : RelayServant(DagdaBulk::_PD_repoId, false) {
+    mtable["recordData"]
+      .in(_tc_SeqChar).in(_tc_corba_data_desc_t).in(CORBA::_tc_boolean)
+      .in(CORBA::_tc_long).returns(CORBA::_tc_string);
+    mtable["recordDataOctets"]
+      .in(_tc_SeqOctet).in(_tc_corba_data_desc_t).in(CORBA::_tc_boolean)
+      .in(CORBA::_tc_long).returns(CORBA::_tc_string);
+  }
+
+protected:
+  void
+  relay(CORBA::ServerRequest_ptr request, const RelaySignature& signature,
+        CORBA::NVList_ptr args) {
+    CORBA::Any result;
+    result <<= "bench";
+    request->set_result(result);
+  }
+};
+
+static double
+now() {
+  struct timeval tv;
+  gettimeofday(&tv, NULL);
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+static int
+sink(const std::string& name) {
+  ORBMgr* mgr = ORBMgr::getMgr();
+  RecordSink* servant = new RecordSink;
+
+  mgr->activate(servant);
+  CORBA::Object_var object = mgr->reference(servant);
+  mgr->bind(DAGDACTXT, name, object, true);
+  mgr->fwdsBind(DAGDACTXT, name, mgr->getIOR(object));
+  std::cout << "Sink " << name << " ready" << std::endl;
+  mgr->wait();
+  return EXIT_SUCCESS;
+}
+
+static int
+client(const std::string& name, unsigned int size, unsigned int count,
+       bool octets) {
+  DagdaBulk_var dagda =
+    ORBMgr::getMgr()->resolve<DagdaBulk, DagdaBulk_var>(DAGDACTXT, name);
+  SeqChar data;
+  SeqOctet octetData;
+  corba_data_desc_t desc;
+  corba_container_specific_t cont;
+
+  // Only the sent sequence is allocated, the blocks may be large
+  if (octets) {
+    octetData.length(size * 1024);
+    for (CORBA::ULong i = 0; i < octetData.length(); ++i) {
+      octetData[i] = static_cast<CORBA::Octet>(i);
+    }
+  } else {
+    data.length(size * 1024);
+    for (CORBA::ULong i = 0; i < data.length(); ++i) {
+      data[i] = static_cast<CORBA::Char>(i);
+    }
+  }
+  cont.size = 0;
+  desc.specific.cont(cont);
+  desc.id.idNumber = CORBA::string_dup("bench");
+  desc.dataManager = CORBA::string_dup("");
+
+  // The first call opens the connections
+  CORBA::String_var id = dagda->recordData(SeqChar(), desc, true, 0);
+
+  double start = now();
+  for (unsigned int i = 0; i < count; ++i) {
+    if (octets) {
+      id = dagda->recordDataOctets(octetData, desc, true, i * size * 1024);
+    } else {
+      id = dagda->recordData(data, desc, true, i * size * 1024);
+    }
+  }
+  double elapsed = now() - start;
+
+  std::cout << (octets ? "octets: " : "chars: ")
+            << count << " x " << size << " KB in " << elapsed << " s: "
+            << (count * size / 1024.0) / elapsed << " MB/s" << std::endl;
+  return EXIT_SUCCESS;
+}
+
+int
+main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " sink <name>" << std::endl
+              << "       " << argv[0]
+              << " client <name> <KB> <count> [octets]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  std::string mode(argv[1]);
+  std::string name(argv[2]);
+
+  ORBMgr::init(argc, argv);
+  if (mode == "sink") {
+    return sink(name);
+  }
+  if (argc < 5) {
+    std::cerr << "Missing block size or count" << std::endl;
+    return EXIT_FAILURE;
+  }
+  bool octets = (argc > 5 && std::string(argv[5]) == "octets");
+  return client(name, atoi(argv[3]), atoi(argv[4]), octets);
+}
@@ -0,0 +1,316 @@
+/**
+ * @file CacheSweeper.cc
+ *
+ * @brief  Background sweeper probing the object cache entries concurrently
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "CacheSweeper.hh"
+
+/**
+ * @brief Completion count of a set of probes.
+ * @class CacheSweeper::Batch
+ */
+class CacheSweeper::Batch {
+public:
+  explicit Batch(const unsigned long remaining)
+    : mcond(&mmutex), mremaining(remaining), mevicted(0) {}
+
+  void
+  done(const bool evicted) {
+    mmutex.lock();
+    if (evicted) {
+      ++mevicted;
+    }
+    if (--mremaining == 0) {
+      mcond.broadcast();
+    }
+    mmutex.unlock();
+  }
+
+  unsigned long
+  wait() {
+    unsigned long evicted;
+
+    mmutex.lock();
+    while (mremaining > 0) {
+      mcond.wait();
+    }
+    evicted = mevicted;
+    mmutex.unlock();
+    return evicted;
+  }
+
+private:
+  omni_mutex mmutex;
+  omni_condition mcond;
+  unsigned long mremaining;
+  unsigned long mevicted;
+};
+
+/**
+ * @brief Probe of one entry, run by the sweeper workers.
+ * @class CacheSweeper::Probe
+ */
+class CacheSweeper::Probe : public WorkerPool::Task {
+public:
+  Probe(CacheSweeper* sweeper, Batch* batch, const ObjectCache::Item& item)
+    : msweeper(sweeper), mbatch(batch), mitem(item), mevicted(false) {}
+
+  ~Probe() {
+    /* Also reached when the pool drops the probe before running it. */
+    mbatch->done(mevicted);
+  }
+
+  void
+  run() {
+    bool alive;
+
+    try {
+      alive = msweeper->alive(mitem);
+    } catch (...) {
+      alive = false;
+    }
+
+    /* The entry may have been replaced during the probe. */
+    if (!alive) {
+      mevicted = msweeper->mcache.erase(mitem.first, mitem.second.object);
+    } else if (mitem.second.lease > 0) {
+      msweeper->mcache.renew(mitem.first, mitem.second.object,
+                             time(NULL) + mitem.second.lease);
+    }
+  }
+
+private:
+  CacheSweeper* msweeper;
+  Batch* mbatch;
+  ObjectCache::Item mitem;
+  bool mevicted;
+};
+
+/* Select the leased entries near expiry (last quarter of their lease). */
+static bool
+nearExpiry(const ObjectCache::Entry& entry, void* now) {
+  if (entry.lease == 0) {
+    return false;
+  }
+  time_t margin = (entry.lease < 4) ? 1 : entry.lease / 4;
+  return entry.expiry - *static_cast<time_t*>(now) <= margin;
+}
+
+CacheSweeper::CacheSweeper(ObjectCache& cache, const unsigned int nbProbes,
+                           const unsigned long probeTimeout)
+  : mcache(cache), mprobeTimeout(probeTimeout),
+    mprobes(nbProbes > 0 ? nbProbes : 1), mcond(&mmutex), mperiod(0),
+    mreport(NULL), mreportArg(NULL), mlocalCheck(NULL),
+    mlocalCheckArg(NULL), mrunning(false), mstop(false) {
+  mstats.sweeps = mstats.duration = mstats.probed = mstats.evicted = 0;
+  mstats.totalProbed = mstats.totalEvicted = 0;
+}
+
+CacheSweeper::~CacheSweeper() {
+  stop();
+}
+
+void
+CacheSweeper::setPeriod(const unsigned int period) {
+  mmutex.lock();
+  mperiod = period;
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+unsigned int
+CacheSweeper::getPeriod() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mperiod;
+  mmutex.unlock();
+  return result;
+}
+
+void
+CacheSweeper::setReport(Report report, void* arg) {
+  mmutex.lock();
+  mreport = report;
+  mreportArg = arg;
+  mmutex.unlock();
+}
+
+void
+CacheSweeper::setLocalCheck(LocalCheck check, void* arg) {
+  mmutex.lock();
+  mlocalCheck = check;
+  mlocalCheckArg = arg;
+  mmutex.unlock();
+}
+
+void
+CacheSweeper::start() {
+  mmutex.lock();
+  if (!mrunning) {
+    mrunning = true;
+    mstop = false;
+    omni_thread::create(sweeperThread, this);
+  }
+  mmutex.unlock();
+}
+
+void
+CacheSweeper::stop() {
+  mmutex.lock();
+  mstop = true;
+  mcond.broadcast();
+  while (mrunning) {
+    mcond.wait();
+  }
+  mmutex.unlock();
+}
+
+bool
+CacheSweeper::alive(const ObjectCache::Item& item) {
+  LocalCheck check;
+  void* arg;
+  bool active;
+
+  if (CORBA::is_nil(item.second.object)) {
+    return false;
+  }
+  mmutex.lock();
+  check = mlocalCheck;
+  arg = mlocalCheckArg;
+  mmutex.unlock();
+  if (check != NULL && check(item.second.object, active, arg)) {
+    return active;
+  }
+  omniORB::setClientThreadCallTimeout(mprobeTimeout);
+  return !item.second.object->_non_existent();
+}
+
+void
+CacheSweeper::probe(const std::vector<ObjectCache::Item>& items,
+                    unsigned long& evicted) {
+  std::vector<ObjectCache::Item>::const_iterator it;
+
+  if (items.empty()) {
+    evicted = 0;
+    return;
+  }
+  Batch batch(items.size());
+  for (it = items.begin(); it != items.end(); ++it) {
+    mprobes.submit(new Probe(this, &batch, *it));
+  }
+  evicted = batch.wait();
+}
+
+CacheSweeper::Stats
+CacheSweeper::sweep() {
+  std::vector<ObjectCache::Item> items;
+  unsigned long evicted;
+  unsigned long sec, nsec, endSec, endNsec;
+  Stats result;
+
+  msweepMutex.lock();
+  omni_thread::get_time(&sec, &nsec);
+  items = mcache.select();
+  probe(items, evicted);
+  omni_thread::get_time(&endSec, &endNsec);
+  msweepMutex.unlock();
+
+  mmutex.lock();
+  ++mstats.sweeps;
+  mstats.duration = (endSec - sec) * 1000
+    + (static_cast<long>(endNsec) - static_cast<long>(nsec)) / 1000000;
+  mstats.probed = items.size();
+  mstats.evicted = evicted;
+  mstats.totalProbed += items.size();
+  mstats.totalEvicted += evicted;
+  result = mstats;
+  mmutex.unlock();
+  return result;
+}
+
+unsigned long
+CacheSweeper::revalidate(const size_t max) {
+  std::vector<ObjectCache::Item> items;
+  unsigned long evicted;
+  time_t now = time(NULL);
+
+  msweepMutex.lock();
+  items = mcache.select(nearExpiry, &now, max);
+  probe(items, evicted);
+  msweepMutex.unlock();
+
+  mmutex.lock();
+  mstats.totalProbed += items.size();
+  mstats.totalEvicted += evicted;
+  mmutex.unlock();
+  return evicted;
+}
+
+CacheSweeper::Stats
+CacheSweeper::stats() const {
+  Stats result;
+
+  mmutex.lock();
+  result = mstats;
+  mmutex.unlock();
+  return result;
+}
+
+void
+CacheSweeper::run() {
+  /* Period between two revalidations of the leased entries (seconds). */
+  static const unsigned long tick = 1;
+  /* Number of leased entries checked by a revalidation. */
+  static const size_t batchSize = 32;
+  time_t nextSweep = 0;
+  unsigned long sec, nsec;
+
+  mmutex.lock();
+  while (!mstop) {
+    omni_thread::get_time(&sec, &nsec, tick, 0);
+    mcond.timedwait(sec, nsec);
+    if (mstop) {
+      break;
+    }
+    time_t now = time(NULL);
+    bool full = false;
+    if (mperiod == 0) {
+      nextSweep = 0;
+    } else if (nextSweep == 0) {
+      nextSweep = now + mperiod;
+    } else if (now >= nextSweep) {
+      full = true;
+      nextSweep = now + mperiod;
+    }
+    mmutex.unlock();
+    try {
+      if (full) {
+        Stats result = sweep();
+        mmutex.lock();
+        Report report = mreport;
+        void* arg = mreportArg;
+        mmutex.unlock();
+        if (report != NULL) {
+          report(result, arg);
+        }
+      } else {
+        revalidate(batchSize);
+      }
+    } catch (...) {
+    }
+    mmutex.lock();
+  }
+  mrunning = false;
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+void
+CacheSweeper::sweeperThread(void* sweeper) {
+  static_cast<CacheSweeper*>(sweeper)->run();
+}
@@ -0,0 +1,210 @@
+/**
+ * @file CacheSweeper.hh
+ *
+ * @brief  Background sweeper probing the object cache entries concurrently
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef CACHESWEEPER_HH
+#define CACHESWEEPER_HH
+
+#include <ctime>
+
+#include <omnithread.h>
+
+#include "ObjectCache.hh"
+#include "WorkerPool.hh"
+
+/**
+ * @brief Probes the entries of an object cache and evicts the dead ones.
+ * The entries are copied out of the cache and probed by a bounded number
+ * of workers, each probe with a short call timeout: the cache stays
+ * available during a sweep. An entry is evicted only if it still holds
+ * the probed object, and the alive leased entries are renewed.
+ * Once started, a background thread revalidates the leased entries near
+ * expiry every second and sweeps the whole cache at the configured period.
+ * @class CacheSweeper
+ */
+class CacheSweeper {
+public:
+  /**
+   * @brief Counters of the sweeper.
+   */
+  struct Stats {
+    /** @brief Number of full sweeps */
+    unsigned long sweeps;
+    /** @brief Duration of the last full sweep (ms) */
+    unsigned long duration;
+    /** @brief Entries probed by the last full sweep */
+    unsigned long probed;
+    /** @brief Entries evicted by the last full sweep */
+    unsigned long evicted;
+    /** @brief Entries probed since the creation of the sweeper */
+    unsigned long totalProbed;
+    /** @brief Entries evicted since the creation of the sweeper */
+    unsigned long totalEvicted;
+  };
+
+  /**
+   * @brief Called by the background thread after each full sweep.
+   */
+  typedef void (*Report)(const Stats& stats, void* arg);
+
+  /**
+   * @brief Tells if an object is served by this process and, if so, sets
+   * its activation state. The local objects are not probed.
+   */
+  typedef bool (*LocalCheck)(CORBA::Object_ptr object, bool& active,
+                             void* arg);
+
+  /**
+   * @brief Constructor
+   * @param cache The swept cache
+   * @param nbProbes The maximum number of probes in flight
+   * @param probeTimeout The call timeout of a probe (ms)
+   */
+  CacheSweeper(ObjectCache& cache, const unsigned int nbProbes = 8,
+               const unsigned long probeTimeout = 1000);
+
+  /**
+   * @brief Destructor, stops the background thread. A derived class
+   *   overriding alive() must call stop() in its own destructor.
+   */
+  virtual ~CacheSweeper();
+
+  /**
+   * @brief Set the period of the full sweeps.
+   * @param period The period (s), 0 disables the full sweeps
+   */
+  void
+  setPeriod(const unsigned int period);
+
+  /**
+   * @brief Get the period of the full sweeps.
+   * @return The period (s)
+   */
+  unsigned int
+  getPeriod() const;
+
+  /**
+   * @brief Set the function called after each background full sweep.
+   * @param report The function, NULL for none
+   * @param arg The function argument
+   */
+  void
+  setReport(Report report, void* arg);
+
+  /**
+   * @brief Set the function telling the local objects apart.
+   * @param check The function, NULL to probe all the objects
+   * @param arg The function argument
+   */
+  void
+  setLocalCheck(LocalCheck check, void* arg);
+
+  /**
+   * @brief Start the background thread if it is not running.
+   */
+  void
+  start();
+
+  /**
+   * @brief Stop the background thread and wait for its end.
+   */
+  void
+  stop();
+
+  /**
+   * @brief Probe all the entries of the cache.
+   * @return The counters after the sweep
+   */
+  Stats
+  sweep();
+
+  /**
+   * @brief Probe the leased entries in the last quarter of their lease.
+   * @param max The maximum number of entries probed, 0 for no limit
+   * @return The number of evicted entries
+   */
+  unsigned long
+  revalidate(const size_t max = 0);
+
+  /**
+   * @brief Get the counters.
+   * @return The counters
+   */
+  Stats
+  stats() const;
+
+protected:
+  /**
+   * @brief Probe an entry. Called by the workers without any lock held.
+   * @param item The entry
+   * @return true if the object is alive
+   */
+  virtual bool
+  alive(const ObjectCache::Item& item);
+
+private:
+  class Probe;
+  class Batch;
+
+  /**
+   * @brief Probe a set of entries and wait for the end of the probes.
+   * @param items The entries
+   * @param evicted The number of evicted entries
+   */
+  void
+  probe(const std::vector<ObjectCache::Item>& items, unsigned long& evicted);
+
+  /**
+   * @brief Background thread main loop.
+   */
+  void
+  run();
+
+  /**
+   * @brief Background thread entry point.
+   * @param sweeper The sweeper
+   */
+  static void
+  sweeperThread(void* sweeper);
+
+  /**
+   * @brief Copies are not allowed.
+   */
+  CacheSweeper(const CacheSweeper&);
+  CacheSweeper&
+  operator=(const CacheSweeper&);
+
+  ObjectCache& mcache;
+  unsigned long mprobeTimeout;
+  /**
+   * @brief The probing workers.
+   */
+  WorkerPool mprobes;
+  /**
+   * @brief Serializes the sweeps.
+   */
+  omni_mutex msweepMutex;
+  /**
+   * @brief Protects the fields below.
+   */
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Used to wake up and to stop the background thread.
+   */
+  omni_condition mcond;
+  unsigned int mperiod;
+  Report mreport;
+  void* mreportArg;
+  LocalCheck mlocalCheck;
+  void* mlocalCheckArg;
+  Stats mstats;
+  bool mrunning;
+  bool mstop;
+};
+
+#endif
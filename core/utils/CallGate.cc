@@ -0,0 +1,142 @@
+/**
+ * @file CallGate.cc
+ *
+ * @brief  Bound on the concurrent calls through a link, with a bounded
+ *         queue of waiting callers
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "CallGate.hh"
+
+CallGate::CallGate(const unsigned int slots, const unsigned int queue)
+  : mslots(slots), mqueue(queue), minProgress(0), mwaiting(0), mrefused(0),
+    mentered(0), mwaitTotal(0), mwaitMax(0), mcond(&mmutex) {
+}
+
+void
+CallGate::setLimits(const unsigned int slots, const unsigned int queue) {
+  mmutex.lock();
+  mslots = slots;
+  mqueue = queue;
+  // A larger limit may free some waiting callers
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+bool
+CallGate::enter() {
+  mmutex.lock();
+  if (mslots != 0 && minProgress >= mslots) {
+    if (mqueue != 0 && mwaiting >= mqueue) {
+      ++mrefused;
+      mmutex.unlock();
+      return false;
+    }
+    unsigned long sec, nsec, endSec, endNsec;
+    double wait;
+
+    omni_thread::get_time(&sec, &nsec);
+    ++mwaiting;
+    while (mslots != 0 && minProgress >= mslots) {
+      mcond.wait();
+    }
+    --mwaiting;
+    omni_thread::get_time(&endSec, &endNsec);
+    wait = (endSec - sec) + (static_cast<double>(endNsec) - nsec) / 1e9;
+    mwaitTotal += wait;
+    if (wait > mwaitMax) {
+      mwaitMax = wait;
+    }
+  }
+  ++minProgress;
+  ++mentered;
+  mmutex.unlock();
+  return true;
+}
+
+bool
+CallGate::tryEnter() {
+  bool result = false;
+
+  mmutex.lock();
+  // The waiting callers come first
+  if (mwaiting == 0 && (mslots == 0 || minProgress < mslots)) {
+    ++minProgress;
+    ++mentered;
+    result = true;
+  }
+  mmutex.unlock();
+  return result;
+}
+
+void
+CallGate::leave() {
+  mmutex.lock();
+  if (minProgress > 0) {
+    --minProgress;
+  }
+  mcond.signal();
+  mmutex.unlock();
+}
+
+unsigned int
+CallGate::inProgress() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = minProgress;
+  mmutex.unlock();
+  return result;
+}
+
+unsigned int
+CallGate::waiting() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mwaiting;
+  mmutex.unlock();
+  return result;
+}
+
+unsigned long
+CallGate::refused() const {
+  unsigned long result;
+
+  mmutex.lock();
+  result = mrefused;
+  mmutex.unlock();
+  return result;
+}
+
+unsigned long
+CallGate::entered() const {
+  unsigned long result;
+
+  mmutex.lock();
+  result = mentered;
+  mmutex.unlock();
+  return result;
+}
+
+double
+CallGate::waitTime() const {
+  double result;
+
+  mmutex.lock();
+  result = mwaitTotal;
+  mmutex.unlock();
+  return result;
+}
+
+double
+CallGate::maxWait() const {
+  double result;
+
+  mmutex.lock();
+  result = mwaitMax;
+  mmutex.unlock();
+  return result;
+}
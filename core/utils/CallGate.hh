@@ -0,0 +1,146 @@
+/**
+ * @file CallGate.hh
+ *
+ * @brief  Bound on the concurrent calls through a link, with a bounded
+ *         queue of waiting callers
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef CALLGATE_HH
+#define CALLGATE_HH
+
+#include <omnithread.h>
+
+/**
+ * @brief Limits the number of calls in progress through a link. A caller
+ * finding all the slots taken waits for a free one, unless the queue of
+ * waiting callers is full: the call is then refused, so that a slow link
+ * holds a bounded number of threads. A limit of 0 means no limit.
+ * The gate also measures the time the callers wait for a slot.
+ * @class CallGate
+ */
+class CallGate {
+public:
+  /**
+   * @brief Constructor
+   * @param slots The maximum number of calls in progress (0: no limit)
+   * @param queue The maximum number of waiting callers (0: no limit)
+   */
+  explicit CallGate(const unsigned int slots = 0,
+                    const unsigned int queue = 0);
+
+  /**
+   * @brief Change the limits. Already admitted calls are not affected.
+   * @param slots The maximum number of calls in progress (0: no limit)
+   * @param queue The maximum number of waiting callers (0: no limit)
+   */
+  void
+  setLimits(const unsigned int slots, const unsigned int queue);
+
+  /**
+   * @brief Take a slot, waiting for one if needed. Each successful call
+   * must be followed by a call to leave().
+   * @return false if the queue is full and the call is refused
+   */
+  bool
+  enter();
+
+  /**
+   * @brief Take a slot only if one is free, without waiting. Each
+   * successful call must be followed by a call to leave().
+   * @return false if all the slots are taken
+   */
+  bool
+  tryEnter();
+
+  /**
+   * @brief Release a slot taken by enter().
+   */
+  void
+  leave();
+
+  /**
+   * @brief Get the number of calls in progress.
+   * @return The number of taken slots
+   */
+  unsigned int
+  inProgress() const;
+
+  /**
+   * @brief Get the number of callers waiting for a slot.
+   * @return The number of waiting callers
+   */
+  unsigned int
+  waiting() const;
+
+  /**
+   * @brief Get the number of calls refused since the creation.
+   * @return The number of refused calls
+   */
+  unsigned long
+  refused() const;
+
+  /**
+   * @brief Get the number of calls admitted since the creation.
+   * @return The number of admitted calls
+   */
+  unsigned long
+  entered() const;
+
+  /**
+   * @brief Get the time spent by the admitted calls waiting for a slot.
+   * @return The total waiting time (s)
+   */
+  double
+  waitTime() const;
+
+  /**
+   * @brief Get the longest time an admitted call waited for a slot.
+   * @return The longest waiting time (s)
+   */
+  double
+  maxWait() const;
+
+private:
+  /**
+   * @brief Maximum number of calls in progress.
+   */
+  unsigned int mslots;
+  /**
+   * @brief Maximum number of waiting callers.
+   */
+  unsigned int mqueue;
+  /**
+   * @brief Calls in progress.
+   */
+  unsigned int minProgress;
+  /**
+   * @brief Waiting callers.
+   */
+  unsigned int mwaiting;
+  /**
+   * @brief Refused calls.
+   */
+  unsigned long mrefused;
+  /**
+   * @brief Admitted calls.
+   */
+  unsigned long mentered;
+  /**
+   * @brief Total and longest waiting times (s).
+   */
+  double mwaitTotal;
+  double mwaitMax;
+  /**
+   * @brief Gate mutex.
+   */
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Signals the released slots.
+   */
+  omni_condition mcond;
+};
+
+#endif
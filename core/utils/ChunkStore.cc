@@ -0,0 +1,270 @@
+/**
+ * @file ChunkStore.cc
+ *
+ * @brief  Content addressed store of the chunks of the transfers, on
+ *         disk, bounded in size with a least recently used eviction
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "ChunkStore.hh"
+#include "HexCodec.hh"
+#include "Sha256.hh"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/* The prefix of the temporary files of the chunks being written. */
+static const char TEMP_PREFIX[] = ".tmp-";
+
+ChunkStore::ChunkStore(const std::string& directory,
+                       const unsigned long maxSize)
+  : mdirectory(directory), mmaxSize(maxSize), msize(0), mnextTemp(0) {
+  std::vector<std::pair<time_t, std::pair<std::string, unsigned long> > >
+    found;
+  unsigned char digest[Sha256::DIGEST_SIZE];
+  DIR* dir = opendir(directory.c_str());
+  struct dirent* entry;
+
+  if (dir == NULL) {
+    throw std::runtime_error("Unable to open the chunk store " + directory
+                             + ": " + strerror(errno));
+  }
+  while ((entry = readdir(dir)) != NULL) {
+    std::string name(entry->d_name);
+    std::string file = directory + "/" + name;
+    struct stat info;
+
+    if (name.compare(0, sizeof(TEMP_PREFIX) - 1, TEMP_PREFIX) == 0) {
+      // Left by a crash while a chunk was written
+      unlink(file.c_str());
+    } else if (name.size() == 2 * Sha256::DIGEST_SIZE
+               && HexCodec::decode(name.c_str(), name.size(), digest)
+               && stat(file.c_str(), &info) == 0 && S_ISREG(info.st_mode)) {
+      found.push_back(std::make_pair(info.st_mtime, std::make_pair(
+        std::string(reinterpret_cast<char*>(digest), sizeof(digest)),
+        static_cast<unsigned long>(info.st_size))));
+    }
+  }
+  closedir(dir);
+
+  std::sort(found.begin(), found.end());
+  mmutex.lock();
+  for (unsigned int i = 0; i < found.size(); ++i) {
+    insert(found[i].second.first, found[i].second.second);
+  }
+  // The limit may have been lowered since
+  evict(0);
+  mmutex.unlock();
+}
+
+bool
+ChunkStore::acquire(const std::string& digest, unsigned long& length) {
+  std::map<std::string, Entry>::iterator it;
+  bool result = false;
+
+  mmutex.lock();
+  it = mentries.find(digest);
+  if (it != mentries.end()) {
+    ++it->second.pins;
+    mlru.splice(mlru.end(), mlru, it->second.position);
+    length = it->second.length;
+    result = true;
+  }
+  mmutex.unlock();
+  if (result) {
+    // The order survives a restart
+    utimes(path(digest).c_str(), NULL);
+  }
+  return result;
+}
+
+void
+ChunkStore::release(const std::string& digest) {
+  std::map<std::string, Entry>::iterator it;
+
+  mmutex.lock();
+  it = mentries.find(digest);
+  if (it != mentries.end() && it->second.pins > 0) {
+    --it->second.pins;
+  }
+  mmutex.unlock();
+}
+
+bool
+ChunkStore::read(const std::string& digest, unsigned char* buffer,
+                 const unsigned long length) {
+  int fd = open(path(digest).c_str(), O_RDONLY);
+  unsigned long done = 0;
+
+  if (fd < 0) {
+    // Lost, by a crash or by hand
+    remove(digest);
+    return false;
+  }
+  while (done < length) {
+    ssize_t count = ::read(fd, buffer + done, length - done);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      break;
+    }
+    done += count;
+  }
+  close(fd);
+  if (done != length) {
+    remove(digest);
+    return false;
+  }
+  // The files are not synced: a crash may leave a wrong one
+  if (Sha256::digest(buffer, length) != digest) {
+    remove(digest);
+    return false;
+  }
+  return true;
+}
+
+bool
+ChunkStore::put(const std::string& digest, const unsigned char* data,
+                const unsigned long length) {
+  std::string temp;
+  char suffix[32];
+  unsigned long done = 0;
+  bool result;
+  int fd;
+
+  mmutex.lock();
+  if (mentries.count(digest) > 0) {
+    mmutex.unlock();
+    return true;
+  }
+  if (length > mmaxSize) {
+    mmutex.unlock();
+    return false;
+  }
+  snprintf(suffix, sizeof(suffix), "%lu", mnextTemp++);
+  mmutex.unlock();
+
+  // Written aside then renamed: the store never holds a partial chunk
+  temp = mdirectory + "/" + TEMP_PREFIX + suffix;
+  fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0) {
+    // Lost, by a crash or by hand
+    remove(digest);
+    return false;
+  }
+  while (done < length) {
+    ssize_t count = write(fd, data + done, length - done);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      break;
+    }
+    done += count;
+  }
+  if (close(fd) != 0 || done != length) {
+    unlink(temp.c_str());
+    return false;
+  }
+
+  mmutex.lock();
+  result = mentries.count(digest) > 0;
+  if (!result && evict(length)
+      && rename(temp.c_str(), path(digest).c_str()) == 0) {
+    insert(digest, length);
+    result = true;
+  } else {
+    unlink(temp.c_str());
+  }
+  mmutex.unlock();
+  return result;
+}
+
+unsigned long
+ChunkStore::size() const {
+  unsigned long result;
+
+  mmutex.lock();
+  result = msize;
+  mmutex.unlock();
+  return result;
+}
+
+unsigned long
+ChunkStore::count() const {
+  unsigned long result;
+
+  mmutex.lock();
+  result = mentries.size();
+  mmutex.unlock();
+  return result;
+}
+
+std::string
+ChunkStore::path(const std::string& digest) const {
+  char hex[2 * Sha256::DIGEST_SIZE];
+
+  HexCodec::encode(reinterpret_cast<const unsigned char*>(digest.data()),
+                   std::min<size_t>(digest.size(), Sha256::DIGEST_SIZE),
+                   hex);
+  return mdirectory + "/"
+    + std::string(hex, 2 * std::min<size_t>(digest.size(),
+                                            Sha256::DIGEST_SIZE));
+}
+
+void
+ChunkStore::insert(const std::string& digest, const unsigned long length) {
+  Entry& entry = mentries[digest];
+
+  entry.length = length;
+  entry.pins = 0;
+  entry.position = mlru.insert(mlru.end(), digest);
+  msize += length;
+}
+
+void
+ChunkStore::remove(const std::string& digest) {
+  std::map<std::string, Entry>::iterator it;
+
+  mmutex.lock();
+  it = mentries.find(digest);
+  if (it != mentries.end()) {
+    unlink(path(digest).c_str());
+    msize -= it->second.length;
+    mlru.erase(it->second.position);
+    mentries.erase(it);
+  }
+  mmutex.unlock();
+}
+
+bool
+ChunkStore::evict(const unsigned long length) {
+  std::list<std::string>::iterator it = mlru.begin();
+
+  while (msize + length > mmaxSize && it != mlru.end()) {
+    std::map<std::string, Entry>::iterator entry = mentries.find(*it);
+    if (entry->second.pins > 0) {
+      // In use by a transfer
+      ++it;
+      continue;
+    }
+    unlink(path(*it).c_str());
+    msize -= entry->second.length;
+    mentries.erase(entry);
+    mlru.erase(it++);
+  }
+  return msize + length <= mmaxSize;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file ChunkStore.hh
+ *
+ * @brief  Content addressed store of the chunks of the transfers, on
+ *         disk, bounded in size with a least recently used eviction
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef CHUNKSTORE_HH
+#define CHUNKSTORE_HH
+
+#include <list>
+#include <map>
+#include <string>
+
+#include <omnithread.h>
+
+/**
+ * @brief Chunks of data addressed by their SHA-256 digest, one file per
+ * chunk in a directory. The total size of the chunks is bounded: the
+ * least recently used chunks are evicted to make room for the new ones.
+ * A chunk in use is pinned and never evicted. The store outlives the
+ * process: the chunks found in the directory are taken back, the least
+ * recently used order following their modification time.
+ * @class ChunkStore
+ */
+class ChunkStore {
+public:
+  /**
+   * @brief Constructor, takes back the chunks of the directory.
+   * @param directory The directory of the chunks
+   * @param maxSize The maximum total size of the chunks (bytes)
+   * @throw std::runtime_error if the directory cannot be read
+   */
+  ChunkStore(const std::string& directory, const unsigned long maxSize);
+
+  /**
+   * @brief Pin a chunk, if held, and mark it as recently used.
+   * @param digest The chunk digest (binary)
+   * @param length The chunk length, if held
+   * @return true if the chunk is held, it must then be released
+   */
+  bool
+  acquire(const std::string& digest, unsigned long& length);
+
+  /**
+   * @brief Unpin a chunk.
+   * @param digest The chunk digest
+   */
+  void
+  release(const std::string& digest);
+
+  /**
+   * @brief Read a pinned chunk and check it against its digest. A chunk
+   *   whose file is lost or found corrupted, by a crash or by the disk,
+   *   is removed from the store.
+   * @param digest The chunk digest
+   * @param buffer The output buffer
+   * @param length The chunk length, as given by acquire
+   * @return false if the chunk file cannot be read or is corrupted
+   */
+  bool
+  read(const std::string& digest, unsigned char* buffer,
+       const unsigned long length);
+
+  /**
+   * @brief Store a chunk, unless it is already held or cannot fit.
+   * @param digest The chunk digest
+   * @param data The chunk data
+   * @param length The chunk length
+   * @return true if the chunk is now held
+   */
+  bool
+  put(const std::string& digest, const unsigned char* data,
+      const unsigned long length);
+
+  /**
+   * @brief Get the total size of the chunks.
+   * @return The size (bytes)
+   */
+  unsigned long
+  size() const;
+
+  /**
+   * @brief Get the number of chunks.
+   * @return The number of chunks
+   */
+  unsigned long
+  count() const;
+
+private:
+  /**
+   * @brief A held chunk.
+   */
+  struct Entry {
+    unsigned long length;
+    unsigned int pins;
+    /**
+     * @brief The place of the chunk in the least recently used order.
+     */
+    std::list<std::string>::iterator position;
+  };
+
+  ChunkStore(const ChunkStore&);
+  ChunkStore&
+  operator=(const ChunkStore&);
+
+  /**
+   * @brief Get the file of a chunk.
+   * @param digest The chunk digest
+   * @return The file path
+   */
+  std::string
+  path(const std::string& digest) const;
+
+  /**
+   * @brief Hold a chunk, as the most recently used. Called with the lock
+   *   held.
+   * @param digest The chunk digest
+   * @param length The chunk length
+   */
+  void
+  insert(const std::string& digest, const unsigned long length);
+
+  /**
+   * @brief Remove a chunk, even if pinned: releasing it is then a no-op.
+   * @param digest The chunk digest
+   */
+  void
+  remove(const std::string& digest);
+
+  /**
+   * @brief Evict the least recently used chunks not pinned, until a size
+   *   fits. Called with the lock held.
+   * @param length The size to fit
+   * @return true if the size fits
+   */
+  bool
+  evict(const unsigned long length);
+
+  std::string mdirectory;
+  unsigned long mmaxSize;
+  unsigned long msize;
+  /**
+   * @brief The chunks, per digest.
+   */
+  std::map<std::string, Entry> mentries;
+  /**
+   * @brief The digests of the chunks, least recently used first.
+   */
+  std::list<std::string> mlru;
+  /**
+   * @brief Names the temporary files of the chunks being written.
+   */
+  unsigned long mnextTemp;
+  /**
+   * @brief Protects the fields above.
+   */
+  mutable omni_mutex mmutex;
+};
+
+#endif
@@ -0,0 +1,106 @@
+/**
+ * @file ChunkWindow.cc
+ *
+ * @brief  Sliding window over the chunks of a transfer sent by several
+ *         threads at once
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "ChunkWindow.hh"
+
+ChunkWindow::ChunkWindow(const unsigned long count,
+                         const unsigned int window, const unsigned long first)
+  : mcount(count), mwindow(window == 0 ? 1 : window), mnext(first),
+    mlow(first), mfailed(false), mjoined(false), msenders(0),
+    mcond(&mmutex) {
+}
+
+bool
+ChunkWindow::next(unsigned long& index) {
+  bool result = false;
+
+  mmutex.lock();
+  while (!mfailed && mnext < mcount && mnext >= mlow + mwindow) {
+    mcond.wait();
+  }
+  if (!mfailed && mnext < mcount) {
+    index = mnext++;
+    result = true;
+  }
+  mmutex.unlock();
+  return result;
+}
+
+void
+ChunkWindow::done(const unsigned long index) {
+  mmutex.lock();
+  macked.insert(index);
+  // Slide the window over the acknowledged chunks
+  while (!macked.empty() && *macked.begin() == mlow) {
+    macked.erase(macked.begin());
+    ++mlow;
+  }
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+void
+ChunkWindow::fail() {
+  mmutex.lock();
+  mfailed = true;
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+bool
+ChunkWindow::failed() const {
+  bool result;
+
+  mmutex.lock();
+  result = mfailed;
+  mmutex.unlock();
+  return result;
+}
+
+bool
+ChunkWindow::enter() {
+  bool result = false;
+
+  mmutex.lock();
+  if (!mjoined) {
+    ++msenders;
+    result = true;
+  }
+  mmutex.unlock();
+  return result;
+}
+
+void
+ChunkWindow::leave() {
+  mmutex.lock();
+  --msenders;
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+void
+ChunkWindow::join() {
+  mmutex.lock();
+  mjoined = true;
+  while (msenders > 0) {
+    mcond.wait();
+  }
+  mmutex.unlock();
+}
+
+unsigned long
+ChunkWindow::sent() const {
+  unsigned long result;
+
+  mmutex.lock();
+  result = mlow + macked.size();
+  mmutex.unlock();
+  return result;
+}
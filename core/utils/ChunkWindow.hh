@@ -0,0 +1,134 @@
+/**
+ * @file ChunkWindow.hh
+ *
+ * @brief  Sliding window over the chunks of a transfer sent by several
+ *         threads at once
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef CHUNKWINDOW_HH
+#define CHUNKWINDOW_HH
+
+#include <set>
+
+#include <omnithread.h>
+
+/**
+ * @brief Hands out the chunks of a transfer, in order, to the threads
+ * sending them. A chunk is only handed out when it is within the window
+ * counted from the first chunk not yet sent: the receiver, which applies
+ * the chunks in order, never holds more than a window of chunks. Once a
+ * send fails, no more chunks are handed out.
+ * The window also counts the threads sending the chunks, so that the
+ * transfer can wait for all of them before ending. A thread coming once
+ * the transfer waits is turned away.
+ * @class ChunkWindow
+ */
+class ChunkWindow {
+public:
+  /**
+   * @brief Constructor
+   * @param count The number of chunks
+   * @param window The maximum number of chunks sent and not yet
+   *   acknowledged, at least 1
+   * @param first The first chunk to send, the ones before it are already
+   *   acknowledged
+   */
+  ChunkWindow(const unsigned long count, const unsigned int window,
+              const unsigned long first = 0);
+
+  /**
+   * @brief Take the next chunk to send, waiting for it to enter the
+   *   window.
+   * @param index The chunk index, if any
+   * @return false if all the chunks are taken or if a send failed
+   */
+  bool
+  next(unsigned long& index);
+
+  /**
+   * @brief Acknowledge a sent chunk.
+   * @param index The chunk index
+   */
+  void
+  done(const unsigned long index);
+
+  /**
+   * @brief Stop handing out the chunks, after a failed send.
+   */
+  void
+  fail();
+
+  /**
+   * @brief Did a send fail?
+   * @return true if fail() was called
+   */
+  bool
+  failed() const;
+
+  /**
+   * @brief Count a thread sending chunks.
+   * @return false if the transfer already waits for the end of its
+   *   threads: the thread must not send any chunk
+   */
+  bool
+  enter();
+
+  /**
+   * @brief Uncount a thread sending chunks, when it ends.
+   */
+  void
+  leave();
+
+  /**
+   * @brief Wait for the end of the threads sending chunks. No thread may
+   *   enter afterwards.
+   */
+  void
+  join();
+
+  /**
+   * @brief Get the number of acknowledged chunks.
+   * @return The number of chunks sent
+   */
+  unsigned long
+  sent() const;
+
+private:
+  ChunkWindow(const ChunkWindow&);
+  ChunkWindow&
+  operator=(const ChunkWindow&);
+
+  unsigned long mcount;
+  unsigned int mwindow;
+  /**
+   * @brief The next chunk to hand out.
+   */
+  unsigned long mnext;
+  /**
+   * @brief The first chunk not yet acknowledged.
+   */
+  unsigned long mlow;
+  /**
+   * @brief The chunks acknowledged after mlow.
+   */
+  std::set<unsigned long> macked;
+  bool mfailed;
+  /**
+   * @brief Has join() been called?
+   */
+  bool mjoined;
+  /**
+   * @brief Number of threads sending chunks.
+   */
+  unsigned int msenders;
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Signals the window moves and the threads ends.
+   */
+  omni_condition mcond;
+};
+
+#endif
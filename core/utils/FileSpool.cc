@@ -0,0 +1,110 @@
+/**
+ * @file FileSpool.cc
+ *
+ * @brief  Preallocated file holding the data of a transfer out of the
+ *         heap, written by slices and read through a memory mapping
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "FileSpool.hh"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+FileSpool::FileSpool(const std::string& directory, const unsigned long size)
+  : mfd(-1), msize(size), mmapping(NULL) {
+  std::string pattern = directory + "/dagda-spool-XXXXXX";
+  std::vector<char> path(pattern.begin(), pattern.end());
+  int error;
+
+  path.push_back('\0');
+  mfd = mkstemp(&path[0]);
+  if (mfd < 0) {
+    throw std::runtime_error("Unable to create a spool file in "
+                             + directory + ": " + strerror(errno));
+  }
+  unlink(&path[0]);
+
+  // Allocate the blocks now: a full disk fails here and not midway
+  error = posix_fallocate(mfd, 0, size);
+  if (error == EINVAL || error == EOPNOTSUPP) {
+    // Not supported by the file system, at least size the file
+    error = (ftruncate(mfd, size) == 0) ? 0 : errno;
+  }
+  if (error != 0) {
+    close(mfd);
+    throw std::runtime_error("Unable to allocate a spool file in "
+                             + directory + ": " + strerror(error));
+  }
+}
+
+FileSpool::~FileSpool() {
+  if (mmapping != NULL) {
+    munmap(mmapping, msize);
+  }
+  close(mfd);
+}
+
+void
+FileSpool::write(const unsigned long offset, const char* data,
+                 const unsigned long length) {
+  unsigned long written = 0;
+
+  if (offset > msize || length > msize - offset) {
+    throw std::runtime_error("Slice out of the spool file");
+  }
+  while (written < length) {
+    ssize_t count = pwrite(mfd, data + written, length - written,
+                           offset + written);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw std::runtime_error(std::string("Unable to write the spool file: ")
+                               + strerror(errno));
+    }
+    written += count;
+  }
+}
+
+const char*
+FileSpool::map() {
+  if (mmapping == NULL && msize > 0) {
+    void* mapping = mmap(NULL, msize, PROT_READ, MAP_SHARED, mfd, 0);
+    if (mapping == MAP_FAILED) {
+      throw std::runtime_error(std::string("Unable to map the spool file: ")
+                               + strerror(errno));
+    }
+    mmapping = static_cast<char*>(mapping);
+    // The slices are read back in order
+    madvise(mmapping, msize, MADV_SEQUENTIAL);
+  }
+  return mmapping;
+}
+
+void
+FileSpool::release(const unsigned long offset, const unsigned long length) {
+  unsigned long page = sysconf(_SC_PAGESIZE);
+  unsigned long begin = (offset + page - 1) / page * page;
+  unsigned long end = (offset + length) / page * page;
+
+  if (mmapping == NULL || end <= begin) {
+    return;
+  }
+  madvise(mmapping + begin, end - begin, MADV_DONTNEED);
+  // The written pages need not stay in the page cache either
+  posix_fadvise(mfd, begin, end - begin, POSIX_FADV_DONTNEED);
+}
+
+unsigned long
+FileSpool::size() const {
+  return msize;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file FileSpool.hh
+ *
+ * @brief  Preallocated file holding the data of a transfer out of the
+ *         heap, written by slices and read through a memory mapping
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef FILESPOOL_HH
+#define FILESPOOL_HH
+
+#include <string>
+
+/**
+ * @brief A temporary file of a fixed size, allocated on creation, which
+ * holds the data of a transfer instead of the heap. The slices are
+ * written with pwrite at their offset, in any order and from several
+ * threads at once, and read through a read-only mapping of the whole
+ * file. The pages of a slice read back can be released, so that the
+ * resident memory does not grow with the size of the transfer.
+ * The file is unlinked as soon as it is created: it disappears with the
+ * spool, or with the process.
+ * @class FileSpool
+ */
+class FileSpool {
+public:
+  /**
+   * @brief Constructor, creates and allocates the file.
+   * @param directory The directory of the file
+   * @param size The file size (bytes)
+   * @throw std::runtime_error if the file cannot be created or allocated
+   */
+  FileSpool(const std::string& directory, const unsigned long size);
+
+  /**
+   * @brief Destructor, unmaps and closes the file.
+   */
+  ~FileSpool();
+
+  /**
+   * @brief Write a slice.
+   * @param offset The slice offset
+   * @param data The slice data
+   * @param length The slice length
+   * @throw std::runtime_error on a write error or out of the file
+   */
+  void
+  write(const unsigned long offset, const char* data,
+        const unsigned long length);
+
+  /**
+   * @brief Map the file, the first time it is called. Not thread-safe.
+   * @return The mapping of the whole file
+   * @throw std::runtime_error if the file cannot be mapped
+   */
+  const char*
+  map();
+
+  /**
+   * @brief Release the pages of a slice read back from the mapping. Only
+   *   the pages entirely in the slice are released.
+   * @param offset The slice offset
+   * @param length The slice length
+   */
+  void
+  release(const unsigned long offset, const unsigned long length);
+
+  /**
+   * @brief Get the file size.
+   * @return The size (bytes)
+   */
+  unsigned long
+  size() const;
+
+private:
+  FileSpool(const FileSpool&);
+  FileSpool&
+  operator=(const FileSpool&);
+
+  int mfd;
+  unsigned long msize;
+  /**
+   * @brief The mapping, NULL until map() is called.
+   */
+  char* mmapping;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file HexCodec.cc
+ *
+ * @brief  Table driven conversions between bytes and hexadecimal strings
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "HexCodec.hh"
+
+#include <cstring>
+
+/* Value of each hexadecimal digit, 0x10 for the other chars. */
+static const unsigned char hexValues[256] = {
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+  0x08, 0x09, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+};
+
+/* The two digits of each byte value. */
+static const char hexPairs[] =
+  "000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f"
+  "202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f"
+  "404142434445464748494a4b4c4d4e4f505152535455565758595a5b5c5d5e5f"
+  "606162636465666768696a6b6c6d6e6f707172737475767778797a7b7c7d7e7f"
+  "808182838485868788898a8b8c8d8e8f909192939495969798999a9b9c9d9e9f"
+  "a0a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+  "c0c1c2c3c4c5c6c7c8c9cacbcccdcecfd0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+  "e0e1e2e3e4e5e6e7e8e9eaebecedeeeff0f1f2f3f4f5f6f7f8f9fafbfcfdfeff";
+
+bool
+HexCodec::decode(const char* src, const size_t size, unsigned char* dst) {
+  const unsigned char* in = reinterpret_cast<const unsigned char*>(src);
+  const unsigned char* end = in + size;
+  /* Bad digits are accumulated and checked once per block. */
+  unsigned char bad = 0;
+
+  if (size % 2 != 0) {
+    return false;
+  }
+  /* Four bytes per iteration. */
+  while (end - in >= 8) {
+    unsigned char h0 = hexValues[in[0]], l0 = hexValues[in[1]];
+    unsigned char h1 = hexValues[in[2]], l1 = hexValues[in[3]];
+    unsigned char h2 = hexValues[in[4]], l2 = hexValues[in[5]];
+    unsigned char h3 = hexValues[in[6]], l3 = hexValues[in[7]];
+    bad |= h0 | l0 | h1 | l1 | h2 | l2 | h3 | l3;
+    dst[0] = (h0 << 4) | l0;
+    dst[1] = (h1 << 4) | l1;
+    dst[2] = (h2 << 4) | l2;
+    dst[3] = (h3 << 4) | l3;
+    in += 8;
+    dst += 4;
+  }
+  while (in < end) {
+    unsigned char h = hexValues[in[0]], l = hexValues[in[1]];
+    bad |= h | l;
+    *dst++ = (h << 4) | l;
+    in += 2;
+  }
+  return (bad & 0x10) == 0;
+}
+
+void
+HexCodec::encode(const unsigned char* src, const size_t size, char* dst) {
+  const unsigned char* end = src + size;
+
+  /* Four bytes per iteration. */
+  while (end - src >= 4) {
+    memcpy(dst, hexPairs + 2 * src[0], 2);
+    memcpy(dst + 2, hexPairs + 2 * src[1], 2);
+    memcpy(dst + 4, hexPairs + 2 * src[2], 2);
+    memcpy(dst + 6, hexPairs + 2 * src[3], 2);
+    src += 4;
+    dst += 8;
+  }
+  while (src < end) {
+    memcpy(dst, hexPairs + 2 * *src++, 2);
+    dst += 2;
+  }
+}
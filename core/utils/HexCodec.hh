@@ -0,0 +1,44 @@
+/**
+ * @file HexCodec.hh
+ *
+ * @brief  Table driven conversions between bytes and hexadecimal strings
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef HEXCODEC_HH
+#define HEXCODEC_HH
+
+#include <cstddef>
+
+/**
+ * @brief Encodes and decodes the hexadecimal strings of the stringified
+ * IORs. Both directions use lookup tables and handle several bytes per
+ * iteration, without any per character stream or branch on the digit case.
+ * @class HexCodec
+ */
+class HexCodec {
+public:
+  /**
+   * @brief Decode a hexadecimal string (upper or lower case digits).
+   * @param src The hexadecimal digits
+   * @param size The number of digits, must be even
+   * @param dst The output buffer, of at least size / 2 bytes
+   * @return false if the string has an odd size or a bad digit
+   */
+  static bool
+  decode(const char* src, const size_t size, unsigned char* dst);
+
+  /**
+   * @brief Encode bytes in lower case hexadecimal digits.
+   * @param src The bytes
+   * @param size The number of bytes
+   * @param dst The output buffer, of at least 2 * size chars (not
+   *   terminated)
+   */
+  static void
+  encode(const unsigned char* src, const size_t size, char* dst);
+};
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * @file ObjectCache.cc
+ *
+ * @brief  Sharded cache of CORBA object references
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "ObjectCache.hh"
+
+ObjectCache::ObjectCache(const unsigned int nbShards)
+  : mnbShards(nbShards > 0 ? nbShards : 1) {
+  mshards = new Shard[mnbShards];
+}
+
+ObjectCache::~ObjectCache() {
+  delete [] mshards;
+}
+
+unsigned int
+ObjectCache::hash(const std::string& key) {
+  unsigned int result = 2166136261U;
+
+  for (std::string::const_iterator it = key.begin(); it != key.end(); ++it) {
+    result ^= static_cast<unsigned char>(*it);
+    result *= 16777619U;
+  }
+  return result;
+}
+
+ObjectCache::Shard&
+ObjectCache::shard(const std::string& key) const {
+  return mshards[hash(key) % mnbShards];
+}
+
+bool
+ObjectCache::find(const std::string& key, Entry& entry) const {
+  Shard& sh = shard(key);
+  std::map<std::string, Entry>::const_iterator it;
+  bool result = false;
+
+  sh.mutex.lock();
+  if ((it = sh.entries.find(key)) != sh.entries.end()) {
+    entry = it->second;
+    result = true;
+  }
+  sh.mutex.unlock();
+  return result;
+}
+
+void
+ObjectCache::put(const std::string& key, const Entry& entry) {
+  Shard& sh = shard(key);
+  /* The replaced reference is released outside the lock. */
+  Entry old;
+
+  sh.mutex.lock();
+  Entry& current = sh.entries[key];
+  old = current;
+  current = entry;
+  sh.mutex.unlock();
+}
+
+bool
+ObjectCache::erase(const std::string& key) {
+  Shard& sh = shard(key);
+  std::map<std::string, Entry>::iterator it;
+  Entry old;
+  bool result = false;
+
+  sh.mutex.lock();
+  if ((it = sh.entries.find(key)) != sh.entries.end()) {
+    old = it->second;
+    sh.entries.erase(it);
+    result = true;
+  }
+  sh.mutex.unlock();
+  return result;
+}
+
+bool
+ObjectCache::erase(const std::string& key, CORBA::Object_ptr object) {
+  Shard& sh = shard(key);
+  std::map<std::string, Entry>::iterator it;
+  Entry old;
+  bool result = false;
+
+  sh.mutex.lock();
+  if ((it = sh.entries.find(key)) != sh.entries.end()
+      && it->second.object.in() == object) {
+    old = it->second;
+    sh.entries.erase(it);
+    result = true;
+  }
+  sh.mutex.unlock();
+  return result;
+}
+
+bool
+ObjectCache::renew(const std::string& key, CORBA::Object_ptr object,
+                   const time_t expiry) {
+  Shard& sh = shard(key);
+  std::map<std::string, Entry>::iterator it;
+  bool result = false;
+
+  sh.mutex.lock();
+  if ((it = sh.entries.find(key)) != sh.entries.end()
+      && it->second.object.in() == object) {
+    it->second.expiry = expiry;
+    result = true;
+  }
+  sh.mutex.unlock();
+  return result;
+}
+
+std::vector<ObjectCache::Item>
+ObjectCache::select(Filter filter, void* arg, const size_t max) const {
+  std::vector<Item> result;
+  std::map<std::string, Entry>::const_iterator it;
+
+  for (unsigned int i = 0; i < mnbShards; ++i) {
+    Shard& sh = mshards[i];
+    sh.mutex.lock();
+    for (it = sh.entries.begin(); it != sh.entries.end(); ++it) {
+      if (max != 0 && result.size() >= max) {
+        break;
+      }
+      if (filter == NULL || filter(it->second, arg)) {
+        result.push_back(*it);
+      }
+    }
+    sh.mutex.unlock();
+  }
+  return result;
+}
+
+void
+ObjectCache::clear() {
+  for (unsigned int i = 0; i < mnbShards; ++i) {
+    std::map<std::string, Entry> old;
+    mshards[i].mutex.lock();
+    old.swap(mshards[i].entries);
+    mshards[i].mutex.unlock();
+  }
+}
+
+size_t
+ObjectCache::size() const {
+  size_t result = 0;
+
+  for (unsigned int i = 0; i < mnbShards; ++i) {
+    mshards[i].mutex.lock();
+    result += mshards[i].entries.size();
+    mshards[i].mutex.unlock();
+  }
+  return result;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file ObjectCache.hh
+ *
+ * @brief  Sharded cache of CORBA object references
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef OBJECTCACHE_HH
+#define OBJECTCACHE_HH
+
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <omniORB4/CORBA.h>
+#include <omnithread.h>
+
+/**
+ * @brief Cache of object references keyed by "context/name". The keys are
+ * spread by hash over independent shards, each with its own mutex, so that
+ * concurrent lookups seldom contend and never wait for a network call: the
+ * cache never calls an object while holding a shard lock.
+ * @class ObjectCache
+ */
+class ObjectCache {
+public:
+  /**
+   * @brief A cached object.
+   */
+  struct Entry {
+    CORBA::Object_var object;
+    /** @brief Lease length, 0 if the entry is not leased */
+    unsigned int lease;
+    /** @brief End of the lease */
+    time_t expiry;
+    /** @brief The object endpoint ("host:port") */
+    std::string endpoint;
+  };
+
+  /**
+   * @brief A copy of a cached entry with its key.
+   */
+  typedef std::pair<std::string, Entry> Item;
+
+  /**
+   * @brief Selection predicate for select().
+   */
+  typedef bool (*Filter)(const Entry& entry, void* arg);
+
+  /**
+   * @brief Constructor
+   * @param nbShards The number of shards
+   */
+  explicit ObjectCache(const unsigned int nbShards = 16);
+
+  /**
+   * @brief Destructor
+   */
+  ~ObjectCache();
+
+  /**
+   * @brief Hash a key (32 bits FNV-1a).
+   * @param key The key
+   * @return The hash
+   */
+  static unsigned int
+  hash(const std::string& key);
+
+  /**
+   * @brief Look up an entry.
+   * @param key The key
+   * @param entry The copy of the entry, if found
+   * @return true if the key is cached
+   */
+  bool
+  find(const std::string& key, Entry& entry) const;
+
+  /**
+   * @brief Add or replace an entry.
+   * @param key The key
+   * @param entry The entry
+   */
+  void
+  put(const std::string& key, const Entry& entry);
+
+  /**
+   * @brief Remove an entry.
+   * @param key The key
+   * @return true if the key was cached
+   */
+  bool
+  erase(const std::string& key);
+
+  /**
+   * @brief Remove an entry if it still holds the given object.
+   * @param key The key
+   * @param object The object
+   * @return true if the entry was removed
+   */
+  bool
+  erase(const std::string& key, CORBA::Object_ptr object);
+
+  /**
+   * @brief Set the end of the lease of an entry if it still holds the
+   *   given object.
+   * @param key The key
+   * @param object The object
+   * @param expiry The new end of the lease
+   * @return true if the entry was updated
+   */
+  bool
+  renew(const std::string& key, CORBA::Object_ptr object,
+        const time_t expiry);
+
+  /**
+   * @brief Copy the entries matching a predicate, one shard at a time.
+   * @param filter The predicate, NULL to select all the entries
+   * @param arg The predicate argument
+   * @param max The maximum number of entries, 0 for no limit
+   * @return The selected entries
+   */
+  std::vector<Item>
+  select(Filter filter = NULL, void* arg = NULL, const size_t max = 0) const;
+
+  /**
+   * @brief Remove all the entries.
+   */
+  void
+  clear();
+
+  /**
+   * @brief Get the number of cached entries.
+   * @return The number of entries
+   */
+  size_t
+  size() const;
+
+private:
+  /**
+   * @brief A part of the cache with its lock.
+   */
+  struct Shard {
+    std::map<std::string, Entry> entries;
+    omni_mutex mutex;
+  };
+
+  /**
+   * @brief Get the shard of a key.
+   * @param key The key
+   * @return The shard
+   */
+  Shard&
+  shard(const std::string& key) const;
+
+  /**
+   * @brief Copies are not allowed.
+   */
+  ObjectCache(const ObjectCache&);
+  ObjectCache&
+  operator=(const ObjectCache&);
+
+  /**
+   * @brief The shards.
+   */
+  Shard* mshards;
+  unsigned int mnbShards;
+};
+
+#endif
@@ -0,0 +1,143 @@
+/**
+ * @file ObjectRoute.cc
+ *
+ * @brief  Parsing of the object names received by the forwarders
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "ObjectRoute.hh"
+
+#include <cstring>
+#include <stdexcept>
+
+/* Prefix of the names sent to the peer forwarder. */
+static const char remotePrefix[] = "remote:";
+static const size_t remotePrefixLength = sizeof(remotePrefix) - 1;
+
+ObjectRoute::Table::Table() {
+  for (unsigned int i = 0; i < nbSlots; ++i) {
+    mslots[i].id = UNKNOWN_CONTEXT;
+  }
+}
+
+unsigned int
+ObjectRoute::Table::hash(const char* ctxt, const size_t length) {
+  unsigned int result = 2166136261U;
+
+  for (size_t i = 0; i < length; ++i) {
+    result ^= static_cast<unsigned char>(ctxt[i]);
+    result *= 16777619U;
+  }
+  return result;
+}
+
+void
+ObjectRoute::Table::add(const std::string& ctxt, const ContextId id) {
+  unsigned int slot = hash(ctxt.data(), ctxt.length()) & (nbSlots - 1);
+
+  /* Linear probing, the table is kept at most half full. */
+  for (unsigned int i = 0; i < nbSlots / 2; ++i) {
+    Slot& current = mslots[(slot + i) & (nbSlots - 1)];
+    if (current.id == UNKNOWN_CONTEXT || current.ctxt == ctxt) {
+      current.ctxt = ctxt;
+      current.id = id;
+      return;
+    }
+  }
+  throw std::runtime_error("Too many contexts in the route table");
+}
+
+ObjectRoute::ContextId
+ObjectRoute::Table::find(const char* ctxt, const size_t length,
+                         const unsigned int hash) const {
+  unsigned int slot = hash & (nbSlots - 1);
+
+  for (unsigned int i = 0; i < nbSlots / 2; ++i) {
+    const Slot& current = mslots[(slot + i) & (nbSlots - 1)];
+    if (current.id == UNKNOWN_CONTEXT) {
+      break;
+    }
+    if (current.ctxt.length() == length
+        && memcmp(current.ctxt.data(), ctxt, length) == 0) {
+      return current.id;
+    }
+  }
+  return UNKNOWN_CONTEXT;
+}
+
+ObjectRoute::ObjectRoute(const char* objName, const Table& table)
+  : mpath(objName), mname(objName), mcontextLength(0),
+    mcontext(UNKNOWN_CONTEXT), mremote(false) {
+  unsigned int hash = 2166136261U;
+  const char* it;
+
+  mshortName[0] = '\0';
+  if (strncmp(objName, remotePrefix, remotePrefixLength) == 0) {
+    mremote = true;
+    mpath += remotePrefixLength;
+  }
+
+  /* Hash the context while looking for its end. */
+  for (it = mpath; *it != '\0' && *it != '/'; ++it) {
+    hash ^= static_cast<unsigned char>(*it);
+    hash *= 16777619U;
+  }
+  if (*it == '/') {
+    mcontextLength = it - mpath;
+    mname = it + 1;
+    mcontext = table.find(mpath, mcontextLength, hash);
+  } else {
+    mname = mpath;
+  }
+}
+
+bool
+ObjectRoute::remote() const {
+  return mremote;
+}
+
+bool
+ObjectRoute::hasContext() const {
+  return mname != mpath;
+}
+
+ObjectRoute::ContextId
+ObjectRoute::context() const {
+  return mcontext;
+}
+
+std::string
+ObjectRoute::contextName() const {
+  return std::string(mpath, mcontextLength);
+}
+
+const char*
+ObjectRoute::name() const {
+  return mname;
+}
+
+const char*
+ObjectRoute::path() const {
+  return mpath;
+}
+
+const char*
+ObjectRoute::peerName() {
+  size_t length;
+
+  /* A name from the peer is sent back as it was received. */
+  if (mremote) {
+    return mpath - remotePrefixLength;
+  }
+  length = strlen(mpath);
+  if (remotePrefixLength + length < sizeof(mshortName)) {
+    memcpy(mshortName, remotePrefix, remotePrefixLength);
+    memcpy(mshortName + remotePrefixLength, mpath, length + 1);
+    return mshortName;
+  }
+  mlongName = remotePrefix;
+  mlongName += mpath;
+  return mlongName.c_str();
+}
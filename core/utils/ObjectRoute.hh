@@ -0,0 +1,172 @@
+/**
+ * @file ObjectRoute.hh
+ *
+ * @brief  Parsing of the object names received by the forwarders
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef OBJECTROUTE_HH
+#define OBJECTROUTE_HH
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief An object name as received by a forwarder: "[remote:]ctxt/name".
+ * The name is parsed once, in place: the "remote:" prefix becomes a flag,
+ * the context is identified through a table of known contexts and the
+ * object name points into the received string. Nothing is allocated
+ * unless the name has to be forwarded with a long prefixed name.
+ * The parsed string must outlive the route.
+ * @class ObjectRoute
+ */
+class ObjectRoute {
+public:
+  /**
+   * @brief Identifier of an interned context.
+   */
+  typedef unsigned int ContextId;
+
+  /**
+   * @brief Identifier of the contexts missing from the table.
+   */
+  static const ContextId UNKNOWN_CONTEXT = 0;
+
+  /**
+   * @brief Hashed table of the known contexts. It is filled once, then
+   * only read and may be shared by concurrent calls.
+   * @class Table
+   */
+  class Table {
+  public:
+    /**
+     * @brief Constructor, with an empty table.
+     */
+    Table();
+
+    /**
+     * @brief Register a context.
+     * @param ctxt The context name
+     * @param id The context identifier, not UNKNOWN_CONTEXT
+     */
+    void
+    add(const std::string& ctxt, const ContextId id);
+
+    /**
+     * @brief Look up a context.
+     * @param ctxt The context name, not terminated
+     * @param length The length of the context name
+     * @param hash The hash of the context name
+     * @return The context identifier, UNKNOWN_CONTEXT if not registered
+     */
+    ContextId
+    find(const char* ctxt, const size_t length,
+         const unsigned int hash) const;
+
+    /**
+     * @brief Hash a context name, as done while parsing (32 bits FNV-1a).
+     * @param ctxt The context name
+     * @param length The length of the context name
+     * @return The hash
+     */
+    static unsigned int
+    hash(const char* ctxt, const size_t length);
+
+  private:
+    /**
+     * @brief Number of slots, a power of 2 greater than the number of
+     *   contexts.
+     */
+    static const unsigned int nbSlots = 64;
+
+    struct Slot {
+      std::string ctxt;
+      ContextId id;
+    };
+
+    Slot mslots[nbSlots];
+  };
+
+  /**
+   * @brief Parse an object name.
+   * @param objName The received name
+   * @param table The known contexts
+   */
+  ObjectRoute(const char* objName, const Table& table);
+
+  /**
+   * @brief Was the name prefixed by "remote:"? Such calls come from the
+   *   peer forwarder and are served locally, the others are forwarded.
+   * @return true if the call comes from the peer
+   */
+  bool
+  remote() const;
+
+  /**
+   * @brief Does the name contain a context ("ctxt/name")?
+   * @return true if there is a context
+   */
+  bool
+  hasContext() const;
+
+  /**
+   * @brief Get the context identifier.
+   * @return The identifier, UNKNOWN_CONTEXT if there is no context or if it
+   *   is not in the table
+   */
+  ContextId
+  context() const;
+
+  /**
+   * @brief Get a copy of the context name.
+   * @return The context, empty if there is none
+   */
+  std::string
+  contextName() const;
+
+  /**
+   * @brief Get the object name, after the context.
+   * @return The object name, or the whole name if there is no context
+   */
+  const char*
+  name() const;
+
+  /**
+   * @brief Get the name without the "remote:" prefix.
+   * @return The name
+   */
+  const char*
+  path() const;
+
+  /**
+   * @brief Get the name to send to the peer forwarder, with the "remote:"
+   *   prefix.
+   * @return The prefixed name, valid as long as the route
+   */
+  const char*
+  peerName();
+
+private:
+  /**
+   * @brief Copies are not allowed.
+   */
+  ObjectRoute(const ObjectRoute&);
+  ObjectRoute&
+  operator=(const ObjectRoute&);
+
+  const char* mpath;
+  const char* mname;
+  size_t mcontextLength;
+  ContextId mcontext;
+  bool mremote;
+  /**
+   * @brief Storage of the prefixed name, mlongName being used when it does
+   *   not fit in mshortName.
+   */
+  char mshortName[128];
+  std::string mlongName;
+};
+
+#endif
@@ -0,0 +1,367 @@
+/**
+ * @file OperationStats.cc
+ *
+ * @brief  Counts, payload sizes and latency histograms of the calls
+ *         served by a forwarder, per operation
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "OperationStats.hh"
+
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+
+/**
+ * @brief The counters of an operation on a path, written by one thread.
+ */
+struct OperationStats::Counters {
+  Counters() : calls(0), errors(0), bytesIn(0), bytesOut(0) {
+    for (unsigned int i = 0; i < NB_BUCKETS; ++i) {
+      latency[i] = 0;
+    }
+  }
+
+  unsigned long calls;
+  unsigned long errors;
+  unsigned long bytesIn;
+  unsigned long bytesOut;
+  unsigned long latency[NB_BUCKETS];
+};
+
+/**
+ * @brief Thread-specific holder of the counters of a thread, deleted by
+ * omnithread at the end of the thread.
+ * @class OperationStats::Holder
+ */
+class OperationStats::Holder : public omni_thread::value_t {
+public:
+  Holder(OperationStats* stats, Slots* slots)
+    : mstats(stats), mslots(slots) {}
+
+  ~Holder() {
+    mstats->release(mslots);
+  }
+
+  Slots*
+  slots() const {
+    return mslots;
+  }
+
+private:
+  OperationStats* mstats;
+  Slots* mslots;
+};
+
+/* Sums the counters of an operation into a total. */
+static void
+add(std::vector<unsigned long>& total, const unsigned long* latency,
+    const unsigned int size) {
+  for (unsigned int i = 0; i < size; ++i) {
+    total[i] += latency[i];
+  }
+}
+
+/* The latency under which a fraction of the calls completed (s). */
+static double
+percentile(const std::vector<unsigned long>& latency,
+           const unsigned long calls, const double fraction) {
+  unsigned long rank = static_cast<unsigned long>(std::ceil(calls * fraction));
+  unsigned long seen = 0;
+
+  if (calls == 0) {
+    return 0;
+  }
+  for (unsigned int i = 0; i < latency.size(); ++i) {
+    seen += latency[i];
+    if (seen >= rank) {
+      return OperationStats::bucketBound(i);
+    }
+  }
+  return OperationStats::bucketBound(latency.size() - 1);
+}
+
+OperationStats::Call::Call(OperationStats& stats, const char* operation,
+                           const bool local)
+  : mstats(stats), mbytesIn(0), mbytesOut(0) {
+  mcounters = mstats.counters(operation, local, mshared);
+  omni_thread::get_time(&msec, &mnsec);
+}
+
+OperationStats::Call::~Call() {
+  unsigned long sec, nsec;
+  double elapsed;
+
+  omni_thread::get_time(&sec, &nsec);
+  elapsed = (sec - msec)
+    + (static_cast<long>(nsec) - static_cast<long>(mnsec)) / 1e9;
+
+  if (mshared) {
+    mstats.mmutex.lock();
+  }
+  ++mcounters->calls;
+  if (std::uncaught_exception()) {
+    ++mcounters->errors;
+  }
+  mcounters->bytesIn += mbytesIn;
+  mcounters->bytesOut += mbytesOut;
+  ++mcounters->latency[bucket(elapsed)];
+  if (mshared) {
+    mstats.mmutex.unlock();
+  }
+}
+
+void
+OperationStats::Call::received(const unsigned long bytes) {
+  mbytesIn += bytes;
+}
+
+void
+OperationStats::Call::sent(const unsigned long bytes) {
+  mbytesOut += bytes;
+}
+
+OperationStats::OperationStats()
+  : mkey(omni_thread::allocate_key()), mdumpCond(&mdumpMutex),
+    mdumpPeriod(0), mrunning(false), mstop(false) {
+}
+
+OperationStats::~OperationStats() {
+  std::map<const char*, Counters*, NameLess>::iterator it;
+
+  stopDump();
+  mslots.push_back(&mshared);
+  for (unsigned int i = 0; i < mslots.size(); ++i) {
+    for (unsigned int path = 0; path < 2; ++path) {
+      for (it = mslots[i]->ops[path].begin();
+           it != mslots[i]->ops[path].end(); ++it) {
+        delete it->second;
+      }
+    }
+    if (mslots[i] != &mshared) {
+      delete mslots[i];
+    }
+  }
+}
+
+OperationStats::Counters*
+OperationStats::counters(const char* operation, const bool local,
+                         bool& shared) {
+  std::map<const char*, Counters*, NameLess>::const_iterator it;
+  omni_thread* self = omni_thread::self();
+  Slots* slots;
+  Counters* result;
+
+  shared = (self == NULL);
+  if (shared) {
+    slots = &mshared;
+    mmutex.lock();
+  } else {
+    Holder* holder = static_cast<Holder*>(self->get_value(mkey));
+    if (holder == NULL) {
+      mmutex.lock();
+      if (mfree.empty()) {
+        slots = new Slots;
+        mslots.push_back(slots);
+      } else {
+        slots = mfree.back();
+        mfree.pop_back();
+      }
+      mmutex.unlock();
+      holder = new Holder(this, slots);
+      self->set_value(mkey, holder);
+    }
+    slots = holder->slots();
+    // Only this thread changes its maps: it may read them without lock
+    it = slots->ops[local].find(operation);
+    if (it != slots->ops[local].end()) {
+      return it->second;
+    }
+    mmutex.lock();
+  }
+
+  // The operation is new to this thread
+  it = slots->ops[local].find(operation);
+  if (it != slots->ops[local].end()) {
+    result = it->second;
+  } else {
+    result = new Counters;
+    slots->ops[local][mnames.insert(operation).first->c_str()] = result;
+  }
+  mmutex.unlock();
+  return result;
+}
+
+void
+OperationStats::release(Slots* slots) {
+  mmutex.lock();
+  mfree.push_back(slots);
+  mmutex.unlock();
+}
+
+std::vector<OperationStats::Summary>
+OperationStats::snapshot() const {
+  typedef std::pair<std::string, bool> Key;
+  std::map<Key, std::pair<Summary, std::vector<unsigned long> > > totals;
+  std::map<Key, std::pair<Summary, std::vector<unsigned long> > >::iterator
+    total;
+  std::map<const char*, Counters*, NameLess>::const_iterator it;
+  std::vector<const Slots*> slots;
+  std::vector<Summary> result;
+
+  mmutex.lock();
+  slots.assign(mslots.begin(), mslots.end());
+  slots.push_back(&mshared);
+  for (unsigned int i = 0; i < slots.size(); ++i) {
+    for (unsigned int path = 0; path < 2; ++path) {
+      for (it = slots[i]->ops[path].begin();
+           it != slots[i]->ops[path].end(); ++it) {
+        Key key(it->first, path == 1);
+        total = totals.find(key);
+        if (total == totals.end()) {
+          Summary summary;
+          summary.operation = it->first;
+          summary.local = (path == 1);
+          summary.calls = summary.errors = 0;
+          summary.bytesIn = summary.bytesOut = 0;
+          total = totals.insert(std::make_pair(key, std::make_pair(
+            summary, std::vector<unsigned long>(NB_BUCKETS, 0)))).first;
+        }
+        Summary& summary = total->second.first;
+        summary.calls += it->second->calls;
+        summary.errors += it->second->errors;
+        summary.bytesIn += it->second->bytesIn;
+        summary.bytesOut += it->second->bytesOut;
+        add(total->second.second, it->second->latency, NB_BUCKETS);
+      }
+    }
+  }
+  mmutex.unlock();
+
+  for (total = totals.begin(); total != totals.end(); ++total) {
+    Summary& summary = total->second.first;
+    summary.p50 = percentile(total->second.second, summary.calls, 0.5);
+    summary.p99 = percentile(total->second.second, summary.calls, 0.99);
+    summary.p999 = percentile(total->second.second, summary.calls, 0.999);
+    result.push_back(summary);
+  }
+  return result;
+}
+
+void
+OperationStats::dump(std::ostream& out) const {
+  std::vector<Summary> stats = snapshot();
+  std::vector<Summary>::const_iterator it;
+
+  out << "# operation path calls errors bytesIn bytesOut"
+      << " p50(ms) p99(ms) p999(ms)" << std::endl;
+  out << std::fixed << std::setprecision(3);
+  for (it = stats.begin(); it != stats.end(); ++it) {
+    out << it->operation << " " << (it->local ? "local" : "peer")
+        << " " << it->calls << " " << it->errors
+        << " " << it->bytesIn << " " << it->bytesOut
+        << " " << it->p50 * 1000 << " " << it->p99 * 1000
+        << " " << it->p999 * 1000 << std::endl;
+  }
+}
+
+void
+OperationStats::startDump(const std::string& path,
+                          const unsigned int period) {
+  if (period == 0) {
+    stopDump();
+    return;
+  }
+  mdumpMutex.lock();
+  mdumpPath = path;
+  mdumpPeriod = period;
+  if (!mrunning) {
+    mrunning = true;
+    mstop = false;
+    omni_thread::create(dumpThread, this);
+  }
+  mdumpCond.broadcast();
+  mdumpMutex.unlock();
+}
+
+void
+OperationStats::stopDump() {
+  mdumpMutex.lock();
+  mstop = true;
+  mdumpCond.broadcast();
+  while (mrunning) {
+    mdumpCond.wait();
+  }
+  mdumpMutex.unlock();
+}
+
+unsigned int
+OperationStats::bucket(const double seconds) {
+  double micros = seconds * 1e6;
+  double index;
+
+  if (micros < 1) {
+    return 0;
+  }
+  index = 1 + std::floor(4 * std::log(micros) / std::log(2.0));
+  if (index >= NB_BUCKETS - 1) {
+    return NB_BUCKETS - 1;
+  }
+  return static_cast<unsigned int>(index);
+}
+
+double
+OperationStats::bucketBound(const unsigned int bucket) {
+  return std::pow(2.0, bucket / 4.0) / 1e6;
+}
+
+void
+OperationStats::dumpFile() {
+  std::string path;
+
+  mdumpMutex.lock();
+  path = mdumpPath;
+  mdumpMutex.unlock();
+
+  // Written aside then renamed: the readers never see a partial dump
+  std::string tmp = path + ".tmp";
+  std::ofstream out(tmp.c_str());
+  if (!out) {
+    return;
+  }
+  dump(out);
+  out.close();
+  std::rename(tmp.c_str(), path.c_str());
+}
+
+void
+OperationStats::run() {
+  unsigned long sec, nsec;
+
+  mdumpMutex.lock();
+  while (!mstop) {
+    omni_thread::get_time(&sec, &nsec, mdumpPeriod, 0);
+    mdumpCond.timedwait(sec, nsec);
+    if (mstop) {
+      break;
+    }
+    mdumpMutex.unlock();
+    try {
+      dumpFile();
+    } catch (...) {
+    }
+    mdumpMutex.lock();
+  }
+  mrunning = false;
+  mdumpCond.broadcast();
+  mdumpMutex.unlock();
+}
+
+void
+OperationStats::dumpThread(void* stats) {
+  static_cast<OperationStats*>(stats)->run();
+}
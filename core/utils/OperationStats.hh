@@ -0,0 +1,271 @@
+/**
+ * @file OperationStats.hh
+ *
+ * @brief  Counts, payload sizes and latency histograms of the calls
+ *         served by a forwarder, per operation
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef OPERATIONSTATS_HH
+#define OPERATIONSTATS_HH
+
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <omnithread.h>
+
+/**
+ * @brief Statistics of the calls per operation and per path: the calls
+ * served by a local object and the calls forwarded to the peer.
+ * Each thread updates its own counters without any lock; a lock is only
+ * taken the first time a thread meets an operation, and to read the
+ * counters. The latencies are kept in logarithmic histograms, 4 buckets
+ * per power of 2 of microseconds, so that the percentiles are known
+ * within 19%. The counters of an ended thread are kept and reused by the
+ * next thread. The statistics must outlive the threads using them.
+ * @class OperationStats
+ */
+class OperationStats {
+  struct Counters;
+
+public:
+  /**
+   * @brief Number of buckets of the latency histograms. The first one
+   * holds the calls under 1 us, the last one the calls over 3 minutes.
+   */
+  static const unsigned int NB_BUCKETS = 112;
+
+  /**
+   * @brief The statistics of an operation on a path.
+   */
+  struct Summary {
+    /** @brief The operation name */
+    std::string operation;
+    /** @brief Served by a local object (true) or forwarded to the peer */
+    bool local;
+    /** @brief Number of calls */
+    unsigned long calls;
+    /** @brief Number of calls ended by an exception */
+    unsigned long errors;
+    /** @brief Bytes of sequence payload received with the calls */
+    unsigned long bytesIn;
+    /** @brief Bytes of sequence payload returned by the calls */
+    unsigned long bytesOut;
+    /** @brief Latency percentiles (s) */
+    double p50;
+    double p99;
+    double p999;
+  };
+
+  /**
+   * @brief A call in progress, timed from its creation to its
+   * destruction. A call left by an exception is counted as an error.
+   * @class Call
+   */
+  class Call {
+  public:
+    /**
+     * @brief Constructor, starts the timer.
+     * @param stats The statistics
+     * @param operation The operation name
+     * @param local true if the call is served by a local object
+     */
+    Call(OperationStats& stats, const char* operation, const bool local);
+
+    /**
+     * @brief Destructor, counts the call.
+     */
+    ~Call();
+
+    /**
+     * @brief Count the payload received with the call.
+     * @param bytes The payload size
+     */
+    void
+    received(const unsigned long bytes);
+
+    /**
+     * @brief Count the payload returned by the call.
+     * @param bytes The payload size
+     */
+    void
+    sent(const unsigned long bytes);
+
+  private:
+    Call(const Call&);
+    Call&
+    operator=(const Call&);
+
+    OperationStats& mstats;
+    /**
+     * @brief The counters of the operation, owned by the statistics.
+     */
+    Counters* mcounters;
+    /**
+     * @brief Are the counters shared by the threads unknown to omnithread?
+     */
+    bool mshared;
+    unsigned long msec;
+    unsigned long mnsec;
+    unsigned long mbytesIn;
+    unsigned long mbytesOut;
+  };
+
+  /**
+   * @brief Constructor
+   */
+  OperationStats();
+
+  /**
+   * @brief Destructor, stops the dumps.
+   */
+  ~OperationStats();
+
+  /**
+   * @brief Sum the counters of all the threads.
+   * @return The statistics, sorted by operation and path
+   */
+  std::vector<Summary>
+  snapshot() const;
+
+  /**
+   * @brief Write the statistics as a table, one line per operation and
+   * path, with the latencies in ms.
+   * @param out The output stream
+   */
+  void
+  dump(std::ostream& out) const;
+
+  /**
+   * @brief Dump the statistics to a file at a fixed period, from a
+   * background thread. The file is replaced as a whole at each dump.
+   * @param path The file path
+   * @param period The period (s), 0 stops the dumps
+   */
+  void
+  startDump(const std::string& path, const unsigned int period);
+
+  /**
+   * @brief Stop the dumps and wait for the end of the background thread.
+   */
+  void
+  stopDump();
+
+  /**
+   * @brief Get the histogram bucket of a latency.
+   * @param seconds The latency (s)
+   * @return The bucket
+   */
+  static unsigned int
+  bucket(const double seconds);
+
+  /**
+   * @brief Get the upper bound of a histogram bucket.
+   * @param bucket The bucket
+   * @return The bound (s)
+   */
+  static double
+  bucketBound(const unsigned int bucket);
+
+private:
+  class Holder;
+
+  struct NameLess {
+    bool
+    operator()(const char* name1, const char* name2) const {
+      return strcmp(name1, name2) < 0;
+    }
+  };
+
+  /**
+   * @brief The counters of a thread, per path and per operation.
+   */
+  struct Slots {
+    std::map<const char*, Counters*, NameLess> ops[2];
+  };
+
+  /**
+   * @brief Get the counters of an operation for the calling thread.
+   * @param operation The operation name
+   * @param local The path
+   * @param shared Set if the counters are shared and need the lock
+   * @return The counters
+   */
+  Counters*
+  counters(const char* operation, const bool local, bool& shared);
+
+  /**
+   * @brief Give the counters of an ended thread to the next thread.
+   * @param slots The counters
+   */
+  void
+  release(Slots* slots);
+
+  /**
+   * @brief Write the statistics to the dump file.
+   */
+  void
+  dumpFile();
+
+  /**
+   * @brief Background thread main loop.
+   */
+  void
+  run();
+
+  /**
+   * @brief Background thread entry point.
+   * @param stats The statistics
+   */
+  static void
+  dumpThread(void* stats);
+
+  OperationStats(const OperationStats&);
+  OperationStats&
+  operator=(const OperationStats&);
+
+  /**
+   * @brief The thread-specific key of the counters.
+   */
+  omni_thread::key_t mkey;
+  /**
+   * @brief The counters of all the threads, owned.
+   */
+  std::vector<Slots*> mslots;
+  /**
+   * @brief The counters of the ended threads.
+   */
+  std::vector<Slots*> mfree;
+  /**
+   * @brief The counters of the threads unknown to omnithread.
+   */
+  Slots mshared;
+  /**
+   * @brief The operation names, keys of the maps of counters.
+   */
+  std::set<std::string> mnames;
+  /**
+   * @brief Protects the counters lists and the operations maps.
+   */
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Protects the dump fields below.
+   */
+  omni_mutex mdumpMutex;
+  /**
+   * @brief Used to wake up and to stop the background thread.
+   */
+  omni_condition mdumpCond;
+  std::string mdumpPath;
+  unsigned int mdumpPeriod;
+  bool mrunning;
+  bool mstop;
+};
+
+#endif
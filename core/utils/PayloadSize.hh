@@ -0,0 +1,31 @@
+/**
+ * @file PayloadSize.hh
+ *
+ * @brief  Size of the CORBA values carried by the calls
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef PAYLOADSIZE_HH
+#define PAYLOADSIZE_HH
+
+#include <omniORB4/CORBA.h>
+
+/**
+ * @brief Get the marshalled size of a CORBA value, the payload it adds to
+ * a call. The value is marshalled once in memory: meant for the results
+ * of the calls, not for the bulk data.
+ * @param value The value, a sequence or a structure
+ * @return The size (bytes)
+ */
+template <class T>
+unsigned long
+payloadSize(const T& value) {
+  cdrMemoryStream stream;
+
+  value >>= stream;
+  return stream.bufSize();
+}
+
+#endif
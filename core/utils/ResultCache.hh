@@ -0,0 +1,330 @@
+/**
+ * @file ResultCache.hh
+ *
+ * @brief  Cache of the results of the read-only calls, per target object
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef RESULTCACHE_HH
+#define RESULTCACHE_HH
+
+#include <ctime>
+#include <map>
+#include <string>
+
+#include <omnithread.h>
+
+/**
+ * @brief Results of read-only calls, keyed by the target object and by the
+ * call (operation and arguments). An entry lives until its time to live
+ * ends or until it is invalidated, by target or by call.
+ * A result obtained while an invalidation happened is not cached: the
+ * caller takes a generation before the call and gives it back with the
+ * result, which is dropped if the cache was invalidated meanwhile.
+ * @class ResultCache
+ */
+template <class Value>
+class ResultCache {
+public:
+  /**
+   * @brief Constructor
+   * @param ttl The time to live of the entries (s), 0 disables the cache
+   * @param maxSize The maximum number of entries
+   */
+  explicit ResultCache(const unsigned int ttl = 0,
+                       const size_t maxSize = 4096);
+
+  /**
+   * @brief Set the time to live of the new entries.
+   * @param ttl The time to live (s), 0 disables the cache
+   */
+  void
+  setTTL(const unsigned int ttl);
+
+  /**
+   * @brief Get the time to live of the entries.
+   * @return The time to live (s), 0 if the cache is disabled
+   */
+  unsigned int
+  getTTL() const;
+
+  /**
+   * @brief Get the current generation, to take before a call whose
+   *   result is to be cached.
+   * @return The generation
+   */
+  unsigned long
+  generation() const;
+
+  /**
+   * @brief Look up a result.
+   * @param target The target object
+   * @param call The call
+   * @param value The copy of the result, if found
+   * @return true if the result is cached and alive
+   */
+  bool
+  find(const std::string& target, const std::string& call, Value& value);
+
+  /**
+   * @brief Cache a result, unless the cache was invalidated since the
+   *   given generation.
+   * @param target The target object
+   * @param call The call
+   * @param value The result
+   * @param generation The generation taken before the call
+   * @return true if the result was cached
+   */
+  bool
+  insert(const std::string& target, const std::string& call,
+         const Value& value, const unsigned long generation);
+
+  /**
+   * @brief Remove the results of a target.
+   * @param target The target object
+   */
+  void
+  invalidate(const std::string& target);
+
+  /**
+   * @brief Remove the results of a call on all the targets.
+   * @param call The call
+   */
+  void
+  invalidateCall(const std::string& call);
+
+  /**
+   * @brief Remove all the results.
+   */
+  void
+  clear();
+
+  /**
+   * @brief Get the number of cached results, alive or not.
+   * @return The number of results
+   */
+  size_t
+  size() const;
+
+private:
+  struct Entry {
+    Value value;
+    time_t expiry;
+  };
+
+  typedef std::map<std::string, Entry> Results;
+  typedef std::map<std::string, Results> Targets;
+
+  /**
+   * @brief Remove the dead results. Called with the lock held.
+   * @param now The current time
+   */
+  void
+  purge(const time_t now);
+
+  /**
+   * @brief Copies are not allowed.
+   */
+  ResultCache(const ResultCache&);
+  ResultCache&
+  operator=(const ResultCache&);
+
+  /**
+   * @brief The results per target and per call.
+   */
+  Targets mtargets;
+  size_t msize;
+  size_t mmaxSize;
+  unsigned int mttl;
+  /**
+   * @brief Incremented by each invalidation.
+   */
+  unsigned long mgeneration;
+  /**
+   * @brief Protects the fields above.
+   */
+  mutable omni_mutex mmutex;
+};
+
+template <class Value>
+ResultCache<Value>::ResultCache(const unsigned int ttl, const size_t maxSize)
+  : msize(0), mmaxSize(maxSize), mttl(ttl), mgeneration(0) {
+}
+
+template <class Value>
+void
+ResultCache<Value>::setTTL(const unsigned int ttl) {
+  mmutex.lock();
+  mttl = ttl;
+  if (mttl == 0) {
+    mtargets.clear();
+    msize = 0;
+    ++mgeneration;
+  }
+  mmutex.unlock();
+}
+
+template <class Value>
+unsigned int
+ResultCache<Value>::getTTL() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mttl;
+  mmutex.unlock();
+  return result;
+}
+
+template <class Value>
+unsigned long
+ResultCache<Value>::generation() const {
+  unsigned long result;
+
+  mmutex.lock();
+  result = mgeneration;
+  mmutex.unlock();
+  return result;
+}
+
+template <class Value>
+bool
+ResultCache<Value>::find(const std::string& target, const std::string& call,
+                         Value& value) {
+  typename Targets::iterator it;
+  typename Results::iterator result;
+  bool found = false;
+
+  mmutex.lock();
+  it = mtargets.find(target);
+  if (it != mtargets.end()) {
+    result = it->second.find(call);
+    if (result != it->second.end()) {
+      if (result->second.expiry > time(NULL)) {
+        value = result->second.value;
+        found = true;
+      } else {
+        it->second.erase(result);
+        --msize;
+        if (it->second.empty()) {
+          mtargets.erase(it);
+        }
+      }
+    }
+  }
+  mmutex.unlock();
+  return found;
+}
+
+template <class Value>
+bool
+ResultCache<Value>::insert(const std::string& target,
+                           const std::string& call, const Value& value,
+                           const unsigned long generation) {
+  time_t now = time(NULL);
+  bool inserted = false;
+
+  mmutex.lock();
+  if (mttl > 0 && generation == mgeneration) {
+    if (msize >= mmaxSize) {
+      purge(now);
+    }
+    Results& results = mtargets[target];
+    typename Results::iterator it = results.find(call);
+    if (it != results.end()) {
+      it->second.value = value;
+      it->second.expiry = now + mttl;
+      inserted = true;
+    } else if (msize < mmaxSize) {
+      Entry& entry = results[call];
+      entry.value = value;
+      entry.expiry = now + mttl;
+      ++msize;
+      inserted = true;
+    } else if (results.empty()) {
+      mtargets.erase(target);
+    }
+  }
+  mmutex.unlock();
+  return inserted;
+}
+
+template <class Value>
+void
+ResultCache<Value>::invalidate(const std::string& target) {
+  typename Targets::iterator it;
+
+  mmutex.lock();
+  ++mgeneration;
+  it = mtargets.find(target);
+  if (it != mtargets.end()) {
+    msize -= it->second.size();
+    mtargets.erase(it);
+  }
+  mmutex.unlock();
+}
+
+template <class Value>
+void
+ResultCache<Value>::invalidateCall(const std::string& call) {
+  typename Targets::iterator it;
+
+  mmutex.lock();
+  ++mgeneration;
+  for (it = mtargets.begin(); it != mtargets.end(); ) {
+    msize -= it->second.erase(call);
+    if (it->second.empty()) {
+      mtargets.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+  mmutex.unlock();
+}
+
+template <class Value>
+void
+ResultCache<Value>::clear() {
+  mmutex.lock();
+  ++mgeneration;
+  mtargets.clear();
+  msize = 0;
+  mmutex.unlock();
+}
+
+template <class Value>
+size_t
+ResultCache<Value>::size() const {
+  size_t result;
+
+  mmutex.lock();
+  result = msize;
+  mmutex.unlock();
+  return result;
+}
+
+template <class Value>
+void
+ResultCache<Value>::purge(const time_t now) {
+  typename Targets::iterator it;
+  typename Results::iterator result;
+
+  for (it = mtargets.begin(); it != mtargets.end(); ) {
+    for (result = it->second.begin(); result != it->second.end(); ) {
+      if (result->second.expiry <= now) {
+        it->second.erase(result++);
+        --msize;
+      } else {
+        ++result;
+      }
+    }
+    if (it->second.empty()) {
+      mtargets.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,192 @@
+/**
+ * @file RetryPolicy.cc
+ *
+ * @brief  Retry decisions for failed CORBA calls: exponential backoff with
+ *         jitter and a circuit breaker per remote endpoint
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "RetryPolicy.hh"
+
+#include <cstdlib>
+#include <utility>
+#include <unistd.h>
+
+RetryPolicy::RetryPolicy()
+  : mmaxRetries(3), mbaseDelay(100), mmaxDelay(2000), mthreshold(5),
+    mopenTime(10), mseed(time(NULL) ^ getpid()) {
+}
+
+void
+RetryPolicy::setMaxRetries(const unsigned int maxRetries) {
+  mmutex.lock();
+  mmaxRetries = maxRetries;
+  mmutex.unlock();
+}
+
+unsigned int
+RetryPolicy::getMaxRetries() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mmaxRetries;
+  mmutex.unlock();
+  return result;
+}
+
+void
+RetryPolicy::setBackoff(const unsigned long baseDelay,
+                        const unsigned long maxDelay) {
+  mmutex.lock();
+  mbaseDelay = baseDelay;
+  mmaxDelay = (maxDelay < baseDelay) ? baseDelay : maxDelay;
+  mmutex.unlock();
+}
+
+void
+RetryPolicy::setCircuit(const unsigned int threshold,
+                        const unsigned int openTime) {
+  std::map<std::string, Endpoint>::iterator it;
+
+  mmutex.lock();
+  mthreshold = threshold;
+  mopenTime = openTime;
+  /* Disabling the circuit breaker closes all the circuits. */
+  if (threshold == 0) {
+    for (it = mendpoints.begin(); it != mendpoints.end(); ++it) {
+      it->second.stats.state = CIRCUIT_CLOSED;
+      it->second.consecutive = 0;
+    }
+  }
+  mmutex.unlock();
+}
+
+void
+RetryPolicy::open(Endpoint& endpoint, const time_t now) {
+  endpoint.stats.state = CIRCUIT_OPEN;
+  endpoint.openUntil = now + mopenTime;
+  ++endpoint.stats.trips;
+}
+
+bool
+RetryPolicy::failure(const std::string& endpoint,
+                     const unsigned int retries) {
+  time_t now = time(NULL);
+  bool result;
+
+  mmutex.lock();
+  result = (retries < mmaxRetries);
+  if (!endpoint.empty()) {
+    std::map<std::string, Endpoint>::iterator it = mendpoints.find(endpoint);
+    if (it == mendpoints.end()) {
+      Endpoint ep;
+      ep.stats.state = CIRCUIT_CLOSED;
+      ep.stats.failures = ep.stats.retries = 0;
+      ep.stats.trips = ep.stats.rejected = 0;
+      ep.consecutive = 0;
+      ep.lastFailure = ep.openUntil = 0;
+      it = mendpoints.insert(std::make_pair(endpoint, ep)).first;
+    }
+    Endpoint& ep = it->second;
+
+    ++ep.stats.failures;
+    if (now > ep.lastFailure + static_cast<time_t>(mopenTime)) {
+      ep.consecutive = 0;
+    }
+    ++ep.consecutive;
+    ep.lastFailure = now;
+
+    switch (mthreshold != 0 ? ep.stats.state : CIRCUIT_CLOSED) {
+    case CIRCUIT_CLOSED:
+      if (mthreshold != 0 && ep.consecutive >= mthreshold) {
+        open(ep, now);
+        result = false;
+      }
+      break;
+    case CIRCUIT_HALF_OPEN:
+      /* The probe failed. */
+      open(ep, now);
+      result = false;
+      break;
+    case CIRCUIT_OPEN:
+      result = false;
+      break;
+    }
+    if (result) {
+      ++ep.stats.retries;
+    }
+  }
+  mmutex.unlock();
+  return result;
+}
+
+void
+RetryPolicy::success(const std::string& endpoint) {
+  std::map<std::string, Endpoint>::iterator it;
+
+  mmutex.lock();
+  if ((it = mendpoints.find(endpoint)) != mendpoints.end()) {
+    it->second.stats.state = CIRCUIT_CLOSED;
+    it->second.consecutive = 0;
+  }
+  mmutex.unlock();
+}
+
+RetryPolicy::Admission
+RetryPolicy::admit(const std::string& endpoint) {
+  std::map<std::string, Endpoint>::iterator it;
+  Admission result = ADMIT;
+
+  mmutex.lock();
+  if ((it = mendpoints.find(endpoint)) != mendpoints.end()) {
+    Endpoint& ep = it->second;
+    time_t now = time(NULL);
+    /* A probe not reported in time is replaced by a new one. */
+    if (ep.stats.state != CIRCUIT_CLOSED && now >= ep.openUntil) {
+      ep.stats.state = CIRCUIT_HALF_OPEN;
+      ep.openUntil = now + mopenTime;
+      result = PROBE;
+    } else if (ep.stats.state != CIRCUIT_CLOSED) {
+      /* Open, or half-open with a probe in progress. */
+      ++ep.stats.rejected;
+      result = REJECT;
+    }
+  }
+  mmutex.unlock();
+  return result;
+}
+
+unsigned long
+RetryPolicy::backoff(const unsigned int retries) {
+  unsigned long delay;
+
+  mmutex.lock();
+  delay = mbaseDelay;
+  for (unsigned int i = 0; i < retries && delay < mmaxDelay; ++i) {
+    delay *= 2;
+  }
+  if (delay > mmaxDelay) {
+    delay = mmaxDelay;
+  }
+  /* Jitter: wait between half and all of the delay. */
+  if (delay > 1) {
+    delay = delay / 2 + rand_r(&mseed) % (delay - delay / 2 + 1);
+  }
+  mmutex.unlock();
+  return delay;
+}
+
+std::map<std::string, RetryPolicy::EndpointStats>
+RetryPolicy::stats() const {
+  std::map<std::string, EndpointStats> result;
+  std::map<std::string, Endpoint>::const_iterator it;
+
+  mmutex.lock();
+  for (it = mendpoints.begin(); it != mendpoints.end(); ++it) {
+    result[it->first] = it->second.stats;
+  }
+  mmutex.unlock();
+  return result;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file RetryPolicy.hh
+ *
+ * @brief  Retry decisions for failed CORBA calls: exponential backoff with
+ *         jitter and a circuit breaker per remote endpoint
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef RETRYPOLICY_HH
+#define RETRYPOLICY_HH
+
+#include <ctime>
+#include <map>
+#include <string>
+
+#include <omnithread.h>
+
+/**
+ * @brief Decides whether a failed call is retried and after which delay.
+ * Each endpoint ("host:port") has a circuit breaker: after a number of
+ * consecutive failures the circuit opens and the calls to the endpoint
+ * fail fast. Once the open time elapsed, one probe call is let through
+ * (half-open state); its outcome closes or opens again the circuit.
+ * The failures are consecutive until a success is reported, or until
+ * the open time passes without any failure: the calls whose success is
+ * not reported only count through this time window.
+ * The empty endpoint has no circuit breaker.
+ * @class RetryPolicy
+ */
+class RetryPolicy {
+public:
+  /**
+   * @brief State of the circuit breaker of an endpoint.
+   */
+  enum CircuitState {
+    CIRCUIT_CLOSED,
+    CIRCUIT_OPEN,
+    CIRCUIT_HALF_OPEN
+  };
+
+  /**
+   * @brief Admission of a new call to an endpoint.
+   */
+  enum Admission {
+    /** @brief Make the call */
+    ADMIT,
+    /** @brief Make the call as the half-open probe and report the outcome */
+    PROBE,
+    /** @brief Fail fast, the endpoint is known to be down */
+    REJECT
+  };
+
+  /**
+   * @brief Counters of an endpoint.
+   */
+  struct EndpointStats {
+    CircuitState state;
+    /** @brief Failed attempts */
+    unsigned long failures;
+    /** @brief Retries granted */
+    unsigned long retries;
+    /** @brief Number of times the circuit opened */
+    unsigned long trips;
+    /** @brief Calls failed fast while the circuit was open */
+    unsigned long rejected;
+  };
+
+  /**
+   * @brief Constructor, with 3 retries, a backoff from 100 ms to 2 s, and
+   *   a circuit opening for 10 s after 5 consecutive failures.
+   */
+  RetryPolicy();
+
+  /**
+   * @brief Set the maximum number of retries of a call.
+   * @param maxRetries The number of retries
+   */
+  void
+  setMaxRetries(const unsigned int maxRetries);
+
+  /**
+   * @brief Get the maximum number of retries of a call.
+   * @return The number of retries
+   */
+  unsigned int
+  getMaxRetries() const;
+
+  /**
+   * @brief Set the backoff delays. The nth retry waits between half and
+   *   all of min(maxDelay, baseDelay * 2^n).
+   * @param baseDelay The delay before the first retry (ms)
+   * @param maxDelay The maximum delay (ms)
+   */
+  void
+  setBackoff(const unsigned long baseDelay, const unsigned long maxDelay);
+
+  /**
+   * @brief Set the circuit breaker parameters.
+   * @param threshold Consecutive failures opening the circuit, 0 disables
+   *   the circuit breaker
+   * @param openTime Time the circuit stays open (s). Failures further
+   *   apart than this time are not consecutive.
+   */
+  void
+  setCircuit(const unsigned int threshold, const unsigned int openTime);
+
+  /**
+   * @brief Record a failed attempt and decide whether to retry.
+   * @param endpoint The endpoint of the call
+   * @param retries The number of retries already done for the call
+   * @return true if the call should be retried
+   */
+  bool
+  failure(const std::string& endpoint, const unsigned int retries);
+
+  /**
+   * @brief Record a successful call, closing the circuit of the endpoint
+   *   and resetting its consecutive failures.
+   * @param endpoint The endpoint of the call
+   */
+  void
+  success(const std::string& endpoint);
+
+  /**
+   * @brief Check whether a new call to an endpoint may be made.
+   * @param endpoint The endpoint
+   * @return The admission of the call
+   */
+  Admission
+  admit(const std::string& endpoint);
+
+  /**
+   * @brief Compute the delay before a retry.
+   * @param retries The number of retries already done
+   * @return The delay (ms)
+   */
+  unsigned long
+  backoff(const unsigned int retries);
+
+  /**
+   * @brief Get the counters of all the endpoints which failed once.
+   * @return The counters per endpoint
+   */
+  std::map<std::string, EndpointStats>
+  stats() const;
+
+private:
+  /**
+   * @brief State of an endpoint.
+   */
+  struct Endpoint {
+    EndpointStats stats;
+    /** @brief Consecutive failures */
+    unsigned int consecutive;
+    /** @brief Time of the last failure */
+    time_t lastFailure;
+    /** @brief End of the open state */
+    time_t openUntil;
+  };
+
+  /**
+   * @brief Open the circuit of an endpoint. The mutex must be held.
+   * @param endpoint The endpoint state
+   * @param now The current time
+   */
+  void
+  open(Endpoint& endpoint, const time_t now);
+
+  unsigned int mmaxRetries;
+  unsigned long mbaseDelay;
+  unsigned long mmaxDelay;
+  unsigned int mthreshold;
+  unsigned int mopenTime;
+  /**
+   * @brief Seed of the jitter.
+   */
+  unsigned int mseed;
+  /**
+   * @brief The endpoints which failed once.
+   */
+  std::map<std::string, Endpoint> mendpoints;
+  /**
+   * @brief Policy mutex.
+   */
+  mutable omni_mutex mmutex;
+};
+
+#endif
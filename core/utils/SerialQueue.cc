@@ -0,0 +1,122 @@
+/**
+ * @file SerialQueue.cc
+ *
+ * @brief  Tasks run in order per key on a worker pool
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "SerialQueue.hh"
+
+class SerialQueue::Runner : public WorkerPool::Task {
+public:
+  Runner(SerialQueue& queue, const std::string& key)
+    : mqueue(queue), mkey(key), mran(false) {}
+
+  ~Runner() {
+    /* Dropped by the pool before running: drop the tasks too. */
+    if (!mran) {
+      mqueue.mmutex.lock();
+      mqueue.mstop = true;
+      mqueue.mmutex.unlock();
+      mqueue.runKey(mkey);
+    }
+  }
+
+  void
+  run() {
+    mran = true;
+    mqueue.runKey(mkey);
+  }
+
+private:
+  SerialQueue& mqueue;
+  std::string mkey;
+  bool mran;
+};
+
+SerialQueue::SerialQueue(WorkerPool& pool, const unsigned int limit)
+  : mpool(pool), mpending(0), mlimit(limit), mrunners(0), mstop(false),
+    mcond(&mmutex) {
+}
+
+SerialQueue::~SerialQueue() {
+  mmutex.lock();
+  mstop = true;
+  while (mrunners > 0) {
+    mcond.wait();
+  }
+  mmutex.unlock();
+}
+
+bool
+SerialQueue::submit(const std::string& key, WorkerPool::Task* task) {
+  bool idle;
+
+  mmutex.lock();
+  if (mstop) {
+    mmutex.unlock();
+    delete task;
+    return true;
+  }
+  if (mlimit != 0 && mpending >= mlimit) {
+    mmutex.unlock();
+    return false;
+  }
+  std::list<WorkerPool::Task*>& tasks = mtasks[key];
+  tasks.push_back(task);
+  ++mpending;
+  // The first task of a key starts its runner
+  idle = (tasks.size() == 1);
+  if (idle) {
+    ++mrunners;
+  }
+  mmutex.unlock();
+
+  if (idle) {
+    mpool.submit(new Runner(*this, key));
+  }
+  return true;
+}
+
+unsigned int
+SerialQueue::pending() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mpending;
+  mmutex.unlock();
+  return result;
+}
+
+void
+SerialQueue::runKey(const std::string& key) {
+  std::list<WorkerPool::Task*>::iterator it;
+  WorkerPool::Task* task;
+
+  mmutex.lock();
+  std::list<WorkerPool::Task*>& tasks = mtasks[key];
+  while (!tasks.empty()) {
+    if (mstop) {
+      for (it = tasks.begin(); it != tasks.end(); ++it) {
+        delete *it;
+        --mpending;
+      }
+      tasks.clear();
+      break;
+    }
+    // The running task stays first: the new ones wait behind it
+    task = tasks.front();
+    mmutex.unlock();
+    mpool.runTask(*task);
+    delete task;
+    mmutex.lock();
+    tasks.pop_front();
+    --mpending;
+  }
+  mtasks.erase(key);
+  --mrunners;
+  mcond.broadcast();
+  mmutex.unlock();
+}
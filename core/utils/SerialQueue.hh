@@ -0,0 +1,108 @@
+/**
+ * @file SerialQueue.hh
+ *
+ * @brief  Tasks run in order per key on a worker pool
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef SERIALQUEUE_HH
+#define SERIALQUEUE_HH
+
+#include <list>
+#include <map>
+#include <string>
+#include <omnithread.h>
+#include "WorkerPool.hh"
+
+/**
+ * @brief Runs the tasks on a worker pool, the tasks of a same key one after
+ * the other in their submission order, and the tasks of distinct keys
+ * concurrently. A key takes at most one worker at a time. The number of
+ * tasks queued may be bounded: the caller of a refused task runs it.
+ * @class SerialQueue
+ */
+class SerialQueue {
+public:
+  /**
+   * @brief Constructor
+   * @param pool The pool running the tasks, outliving the queue
+   * @param limit The number of tasks queued or running above which the
+   *   tasks are refused, 0 for no limit
+   */
+  explicit SerialQueue(WorkerPool& pool, const unsigned int limit = 0);
+
+  /**
+   * @brief Destructor. Deletes the tasks not started yet.
+   */
+  ~SerialQueue();
+
+  /**
+   * @brief Queue a task. The queue takes its ownership, unless it is full.
+   * @param key The key ordering the task
+   * @param task The task
+   * @return false if the queue is full, the task is then left to the caller
+   */
+  bool
+  submit(const std::string& key, WorkerPool::Task* task);
+
+  /**
+   * @brief Get the number of tasks queued or running.
+   * @return The number of tasks
+   */
+  unsigned int
+  pending() const;
+
+private:
+  SerialQueue(const SerialQueue&);
+  SerialQueue&
+  operator=(const SerialQueue&);
+
+  /**
+   * @brief Runs the tasks of a key, submitted to the pool.
+   */
+  class Runner;
+
+  /**
+   * @brief Run the tasks of a key until there is none left.
+   * @param key The key
+   */
+  void
+  runKey(const std::string& key);
+
+  /**
+   * @brief The pool.
+   */
+  WorkerPool& mpool;
+  /**
+   * @brief The tasks of each active key, the first one is running.
+   */
+  std::map<std::string, std::list<WorkerPool::Task*> > mtasks;
+  /**
+   * @brief Number of tasks queued or running.
+   */
+  unsigned int mpending;
+  /**
+   * @brief Maximum number of tasks queued or running, 0 for no limit.
+   */
+  unsigned int mlimit;
+  /**
+   * @brief Number of runners submitted to the pool and not finished.
+   */
+  unsigned int mrunners;
+  /**
+   * @brief Has the queue been destroyed?
+   */
+  bool mstop;
+  /**
+   * @brief Queue mutex.
+   */
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Signals the runners end.
+   */
+  omni_condition mcond;
+};
+
+#endif
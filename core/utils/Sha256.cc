@@ -0,0 +1,134 @@
+/**
+ * @file Sha256.cc
+ *
+ * @brief  SHA-256 digests, the content addresses of the chunk store
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "Sha256.hh"
+
+#include <cstring>
+
+static const unsigned long K[64] = {
+  0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL,
+  0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+  0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL,
+  0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+  0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL,
+  0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+  0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL,
+  0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+  0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL,
+  0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+  0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL,
+  0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+  0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL,
+  0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+  0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL,
+  0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+/* Rotates a 32 bits word right. */
+static inline unsigned long
+rotr(const unsigned long x, const int n) {
+  return ((x >> n) | (x << (32 - n))) & 0xFFFFFFFFUL;
+}
+
+/* Processes a block of 64 bytes. */
+static void
+transform(unsigned long* state, const unsigned char* block) {
+  unsigned long w[64];
+  unsigned long a, b, c, d, e, f, g, h;
+
+  for (int i = 0; i < 16; ++i) {
+    w[i] = (static_cast<unsigned long>(block[4 * i]) << 24)
+      | (block[4 * i + 1] << 16) | (block[4 * i + 2] << 8)
+      | block[4 * i + 3];
+  }
+  for (int i = 16; i < 64; ++i) {
+    unsigned long s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18)
+      ^ (w[i - 15] >> 3);
+    unsigned long s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19)
+      ^ (w[i - 2] >> 10);
+    w[i] = (w[i - 16] + s0 + w[i - 7] + s1) & 0xFFFFFFFFUL;
+  }
+
+  a = state[0]; b = state[1]; c = state[2]; d = state[3];
+  e = state[4]; f = state[5]; g = state[6]; h = state[7];
+  for (int i = 0; i < 64; ++i) {
+    unsigned long s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+    unsigned long ch = (e & f) ^ (~e & g);
+    unsigned long t1 = (h + s1 + ch + K[i] + w[i]) & 0xFFFFFFFFUL;
+    unsigned long s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+    unsigned long maj = (a & b) ^ (a & c) ^ (b & c);
+    unsigned long t2 = (s0 + maj) & 0xFFFFFFFFUL;
+    h = g; g = f; f = e;
+    e = (d + t1) & 0xFFFFFFFFUL;
+    d = c; c = b; b = a;
+    a = (t1 + t2) & 0xFFFFFFFFUL;
+  }
+  state[0] = (state[0] + a) & 0xFFFFFFFFUL;
+  state[1] = (state[1] + b) & 0xFFFFFFFFUL;
+  state[2] = (state[2] + c) & 0xFFFFFFFFUL;
+  state[3] = (state[3] + d) & 0xFFFFFFFFUL;
+  state[4] = (state[4] + e) & 0xFFFFFFFFUL;
+  state[5] = (state[5] + f) & 0xFFFFFFFFUL;
+  state[6] = (state[6] + g) & 0xFFFFFFFFUL;
+  state[7] = (state[7] + h) & 0xFFFFFFFFUL;
+}
+
+void
+Sha256::digest(const unsigned char* data, const unsigned long length,
+               unsigned char* digest) {
+  unsigned long state[8] = {
+    0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+    0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL
+  };
+  unsigned char last[128];
+  unsigned long done = 0;
+  unsigned long rest;
+  unsigned long blocks;
+
+  for (; done + 64 <= length; done += 64) {
+    transform(state, data + done);
+  }
+
+  // Padding: a 1 bit, zeros, then the length in bits on 64 bits
+  rest = length - done;
+  blocks = (rest + 9 <= 64) ? 1 : 2;
+  memset(last, 0, sizeof(last));
+  if (rest > 0) {
+    memcpy(last, data + done, rest);
+  }
+  last[rest] = 0x80;
+  for (unsigned int i = 0; i < 8; ++i) {
+    // The byte i of length * 8, whatever the size of the unsigned longs
+    unsigned long bits = 0;
+    if (i == 0) {
+      bits = length << 3;
+    } else if (8 * i - 3 < 8 * sizeof(length)) {
+      bits = length >> (8 * i - 3);
+    }
+    last[64 * blocks - 1 - i] = static_cast<unsigned char>(bits & 0xFF);
+  }
+  for (unsigned long i = 0; i < blocks; ++i) {
+    transform(state, last + 64 * i);
+  }
+
+  for (int i = 0; i < 8; ++i) {
+    digest[4 * i] = static_cast<unsigned char>(state[i] >> 24);
+    digest[4 * i + 1] = static_cast<unsigned char>(state[i] >> 16);
+    digest[4 * i + 2] = static_cast<unsigned char>(state[i] >> 8);
+    digest[4 * i + 3] = static_cast<unsigned char>(state[i]);
+  }
+}
+
+std::string
+Sha256::digest(const unsigned char* data, const unsigned long length) {
+  unsigned char result[DIGEST_SIZE];
+
+  digest(data, length, result);
+  return std::string(reinterpret_cast<char*>(result), DIGEST_SIZE);
+}
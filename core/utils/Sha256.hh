@@ -0,0 +1,48 @@
+/**
+ * @file Sha256.hh
+ *
+ * @brief  SHA-256 digests, the content addresses of the chunk store
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef SHA256_HH
+#define SHA256_HH
+
+#include <string>
+
+/**
+ * @brief Computes the SHA-256 digest of a buffer (FIPS 180-4), used as
+ * the address of a chunk of data: two chunks with the same digest are
+ * taken as the same chunk.
+ * @class Sha256
+ */
+class Sha256 {
+public:
+  /**
+   * @brief Size of a digest (bytes).
+   */
+  static const unsigned int DIGEST_SIZE = 32;
+
+  /**
+   * @brief Compute the digest of a buffer.
+   * @param data The buffer
+   * @param length The buffer length
+   * @param digest The output digest, of DIGEST_SIZE bytes
+   */
+  static void
+  digest(const unsigned char* data, const unsigned long length,
+         unsigned char* digest);
+
+  /**
+   * @brief Compute the digest of a buffer.
+   * @param data The buffer
+   * @param length The buffer length
+   * @return The digest, of DIGEST_SIZE bytes
+   */
+  static std::string
+  digest(const unsigned char* data, const unsigned long length);
+};
+
+#endif
@@ -0,0 +1,247 @@
+/**
+ * @file StreamJournal.cc
+ *
+ * @brief  Journal of the chunks of a transfer already committed by the
+ *         receiver, with their checksums, to resume the transfer
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "StreamJournal.hh"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief The CRC-32 tables, to handle 4 bytes per iteration.
+ */
+struct CrcTables {
+  CrcTables() {
+    for (unsigned int i = 0; i < 256; ++i) {
+      unsigned long crc = i;
+      for (int bit = 0; bit < 8; ++bit) {
+        crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320UL : crc >> 1;
+      }
+      table[0][i] = crc;
+    }
+    for (unsigned int i = 0; i < 256; ++i) {
+      for (int t = 1; t < 4; ++t) {
+        table[t][i] = (table[t - 1][i] >> 8)
+          ^ table[0][table[t - 1][i] & 0xFF];
+      }
+    }
+  }
+
+  unsigned long table[4][256];
+};
+
+static const CrcTables crcTables;
+
+/* Writes a whole buffer, retrying the interrupted and partial writes. */
+static bool
+writeAll(int fd, const char* data, size_t length) {
+  while (length > 0) {
+    ssize_t count = write(fd, data, length);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    data += count;
+    length -= count;
+  }
+  return true;
+}
+
+/* The file name of a transfer, a hash of its key (FNV-1a, twice). */
+static std::string
+journalName(const std::string& key) {
+  unsigned long low = 2166136261UL;
+  unsigned long high = 84696351UL;
+  char name[32];
+
+  for (std::string::const_iterator it = key.begin(); it != key.end(); ++it) {
+    low = ((low ^ static_cast<unsigned char>(*it)) * 16777619UL)
+      & 0xFFFFFFFFUL;
+    high = ((high ^ static_cast<unsigned char>(*it)) * 16777619UL)
+      & 0xFFFFFFFFUL;
+  }
+  snprintf(name, sizeof(name), "%08lx%08lx.journal", high, low);
+  return name;
+}
+
+StreamJournal::StreamJournal(const std::string& directory,
+                             const std::string& key)
+  : mkey(key), mfd(-1), mlastUse(time(NULL)) {
+  std::string content;
+  std::string header = key + "\n";
+  char buffer[4096];
+  ssize_t count;
+
+  if (directory.empty()) {
+    return;
+  }
+  mpath = directory + "/" + journalName(key);
+  mfd = open(mpath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0600);
+  if (mfd < 0) {
+    throw std::runtime_error("Unable to open the journal " + mpath + ": "
+                             + strerror(errno));
+  }
+  while ((count = read(mfd, buffer, sizeof(buffer))) != 0) {
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    content.append(buffer, count);
+  }
+
+  size_t end = 0;
+  if (content.compare(0, header.size(), header) == 0) {
+    // Replay the commits, up to the last complete line
+    size_t pos = header.size();
+    size_t eol;
+    end = pos;
+    while ((eol = content.find('\n', pos)) != std::string::npos) {
+      char* next;
+      unsigned long index = strtoul(content.c_str() + pos, &next, 10);
+      unsigned long sum = strtoul(next, NULL, 10);
+      if (index > mchecksums.size()) {
+        break;
+      }
+      mchecksums.resize(index);
+      mchecksums.push_back(sum);
+      pos = end = eol + 1;
+    }
+  }
+  if (end == 0 || end != content.size()) {
+    // A new file, another transfer with the same hash, or a line cut by
+    // a crash
+    if (ftruncate(mfd, end) != 0
+        || (end == 0 && !writeAll(mfd, header.c_str(), header.size()))) {
+      close(mfd);
+      throw std::runtime_error("Unable to write the journal " + mpath
+                               + ": " + strerror(errno));
+    }
+  }
+}
+
+StreamJournal::~StreamJournal() {
+  if (mfd >= 0) {
+    close(mfd);
+  }
+}
+
+const std::string&
+StreamJournal::key() const {
+  return mkey;
+}
+
+unsigned long
+StreamJournal::committed() const {
+  return mchecksums.size();
+}
+
+unsigned long
+StreamJournal::resumePoint(const std::vector<unsigned long>& checksums)
+  const {
+  unsigned long index = 0;
+
+  while (index < mchecksums.size() && index < checksums.size()
+         && mchecksums[index] == checksums[index]) {
+    ++index;
+  }
+  return index;
+}
+
+void
+StreamJournal::commit(const unsigned long index,
+                      const unsigned long checksum) {
+  char line[64];
+  int length;
+
+  if (index > mchecksums.size()) {
+    throw std::runtime_error("Chunk committed out of order");
+  }
+  mchecksums.resize(index);
+  mchecksums.push_back(checksum);
+  mlastUse = time(NULL);
+  if (mfd < 0) {
+    return;
+  }
+  length = snprintf(line, sizeof(line), "%lu %lu\n", index, checksum);
+  if (!writeAll(mfd, line, length)) {
+    throw std::runtime_error("Unable to write the journal " + mpath + ": "
+                             + strerror(errno));
+  }
+}
+
+void
+StreamJournal::remove() {
+  if (mfd >= 0) {
+    close(mfd);
+    mfd = -1;
+    unlink(mpath.c_str());
+  }
+  mchecksums.clear();
+}
+
+time_t
+StreamJournal::lastUse() const {
+  return mlastUse;
+}
+
+unsigned long
+StreamJournal::checksum(const unsigned char* data,
+                        const unsigned long length) {
+  const unsigned long (*table)[256] = crcTables.table;
+  unsigned long crc = 0xFFFFFFFFUL;
+  unsigned long i = 0;
+
+  for (; i + 4 <= length; i += 4) {
+    crc ^= data[i] | (data[i + 1] << 8) | (data[i + 2] << 16)
+      | (static_cast<unsigned long>(data[i + 3]) << 24);
+    crc = table[3][crc & 0xFF] ^ table[2][(crc >> 8) & 0xFF]
+      ^ table[1][(crc >> 16) & 0xFF] ^ table[0][(crc >> 24) & 0xFF];
+  }
+  for (; i < length; ++i) {
+    crc = table[0][(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc ^ 0xFFFFFFFFUL;
+}
+
+void
+StreamJournal::purge(const std::string& directory, const time_t maxAge) {
+  static const std::string suffix(".journal");
+  DIR* dir = opendir(directory.c_str());
+  struct dirent* entry;
+  time_t now = time(NULL);
+
+  if (dir == NULL) {
+    return;
+  }
+  while ((entry = readdir(dir)) != NULL) {
+    std::string name(entry->d_name);
+    std::string path = directory + "/" + name;
+    struct stat info;
+
+    if (name.size() > suffix.size()
+        && name.compare(name.size() - suffix.size(), suffix.size(),
+                        suffix) == 0
+        && stat(path.c_str(), &info) == 0
+        && info.st_mtime + maxAge < now) {
+      unlink(path.c_str());
+    }
+  }
+  closedir(dir);
+}
@@ -0,0 +1,129 @@
+/**
+ * @file StreamJournal.hh
+ *
+ * @brief  Journal of the chunks of a transfer already committed by the
+ *         receiver, with their checksums, to resume the transfer
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef STREAMJOURNAL_HH
+#define STREAMJOURNAL_HH
+
+#include <ctime>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The chunks of a transfer committed by the receiver, with their
+ * checksum. The chunks are committed in order, so the journal holds the
+ * checksums of the first chunks. A transfer which breaks can be resumed
+ * from the first chunk whose checksum is missing or differs from the one
+ * of the sender.
+ * The journal is kept in memory, and in a file of a directory when one is
+ * given, so that it outlives the process. The file is an append-only log,
+ * one line per committed chunk, read back when the journal is opened; a
+ * chunk committed again drops the chunks after it. The file is not synced:
+ * it survives the death of the process, not the one of the host.
+ * A journal is used by one thread at a time.
+ * @class StreamJournal
+ */
+class StreamJournal {
+public:
+  /**
+   * @brief Constructor, opens the journal of a transfer.
+   * @param directory The directory of the journal files, empty to keep
+   *   the journal in memory only
+   * @param key The transfer key, on a single line
+   * @throw std::runtime_error if the journal file cannot be opened
+   */
+  StreamJournal(const std::string& directory, const std::string& key);
+
+  /**
+   * @brief Destructor, closes the journal file, which is kept.
+   */
+  ~StreamJournal();
+
+  /**
+   * @brief Get the transfer key.
+   * @return The key
+   */
+  const std::string&
+  key() const;
+
+  /**
+   * @brief Get the number of committed chunks.
+   * @return The number of chunks
+   */
+  unsigned long
+  committed() const;
+
+  /**
+   * @brief Get the chunk to resume the transfer from: the first chunk not
+   *   committed, or committed with another checksum than the sender one.
+   * @param checksums The checksums of the chunks of the sender
+   * @return The chunk index
+   */
+  unsigned long
+  resumePoint(const std::vector<unsigned long>& checksums) const;
+
+  /**
+   * @brief Record a committed chunk, dropping the chunks after it.
+   * @param index The chunk index, at most committed()
+   * @param checksum The chunk checksum
+   * @throw std::runtime_error if the journal file cannot be written
+   */
+  void
+  commit(const unsigned long index, const unsigned long checksum);
+
+  /**
+   * @brief Forget the transfer, once ended, and delete the journal file.
+   */
+  void
+  remove();
+
+  /**
+   * @brief Get the time of the last use of the journal.
+   * @return The time of the opening or of the last commit
+   */
+  time_t
+  lastUse() const;
+
+  /**
+   * @brief Compute the checksum of a chunk (CRC-32).
+   * @param data The chunk data
+   * @param length The chunk length
+   * @return The checksum
+   */
+  static unsigned long
+  checksum(const unsigned char* data, const unsigned long length);
+
+  /**
+   * @brief Delete the journal files of a directory unused for a time, left
+   *   by transfers never resumed.
+   * @param directory The directory of the journal files
+   * @param maxAge The time after which a file is deleted (s)
+   */
+  static void
+  purge(const std::string& directory, const time_t maxAge);
+
+private:
+  StreamJournal(const StreamJournal&);
+  StreamJournal&
+  operator=(const StreamJournal&);
+
+  std::string mkey;
+  /**
+   * @brief The journal file path, empty in memory only.
+   */
+  std::string mpath;
+  int mfd;
+  /**
+   * @brief The checksums of the committed chunks.
+   */
+  std::vector<unsigned long> mchecksums;
+  time_t mlastUse;
+};
+
+#endif
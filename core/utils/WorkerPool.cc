@@ -0,0 +1,144 @@
+/**
+ * @file WorkerPool.cc
+ *
+ * @brief  Bounded pool of worker threads running queued tasks
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#include "WorkerPool.hh"
+
+#include <exception>
+
+WorkerPool::WorkerPool(const unsigned int nbWorkers)
+  : mrunning(0), mstop(false), mreport(NULL), mreportArg(NULL),
+    mcond(&mmutex) {
+  mmutex.lock();
+  for (unsigned int i = 0; i < nbWorkers; ++i) {
+    omni_thread::create(workerThread, this);
+    ++mrunning;
+  }
+  mmutex.unlock();
+}
+
+WorkerPool::~WorkerPool() {
+  std::multimap<DueTime, Task*>::iterator it;
+
+  mmutex.lock();
+  mstop = true;
+  mcond.broadcast();
+  while (mrunning > 0) {
+    mcond.wait();
+  }
+  for (it = mtasks.begin(); it != mtasks.end(); ++it) {
+    delete it->second;
+  }
+  mtasks.clear();
+  mmutex.unlock();
+}
+
+void
+WorkerPool::submit(Task* task, const unsigned long delay) {
+  unsigned long sec, nsec;
+
+  omni_thread::get_time(&sec, &nsec, delay / 1000, (delay % 1000) * 1000000);
+
+  mmutex.lock();
+  if (mstop) {
+    mmutex.unlock();
+    delete task;
+    return;
+  }
+  mtasks.insert(std::make_pair(DueTime(sec, nsec), task));
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+unsigned int
+WorkerPool::pending() const {
+  unsigned int result;
+
+  mmutex.lock();
+  result = mtasks.size();
+  mmutex.unlock();
+  return result;
+}
+
+bool
+WorkerPool::isWorker() const {
+  bool result;
+
+  mmutex.lock();
+  result = (mworkers.count(omni_thread::self()) > 0);
+  mmutex.unlock();
+  return result;
+}
+
+void
+WorkerPool::setFailureReport(FailureReport report, void* arg) {
+  mmutex.lock();
+  mreport = report;
+  mreportArg = arg;
+  mmutex.unlock();
+}
+
+void
+WorkerPool::runTask(Task& task) const {
+  std::string failure;
+  FailureReport report;
+  void* arg;
+
+  try {
+    task.run();
+    return;
+  } catch (const std::exception& err) {
+    failure = err.what();
+  } catch (...) {
+    failure = "unknown exception";
+  }
+  mmutex.lock();
+  report = mreport;
+  arg = mreportArg;
+  mmutex.unlock();
+  if (report != NULL) {
+    report(failure, arg);
+  }
+}
+
+void
+WorkerPool::runWorker() {
+  std::multimap<DueTime, Task*>::iterator it;
+  unsigned long sec, nsec;
+  Task* task;
+
+  mmutex.lock();
+  mworkers.insert(omni_thread::self());
+  while (!mstop) {
+    if (mtasks.empty()) {
+      mcond.wait();
+      continue;
+    }
+    it = mtasks.begin();
+    omni_thread::get_time(&sec, &nsec);
+    if (DueTime(sec, nsec) < it->first) {
+      mcond.timedwait(it->first.first, it->first.second);
+      continue;
+    }
+    task = it->second;
+    mtasks.erase(it);
+    mmutex.unlock();
+    runTask(*task);
+    delete task;
+    mmutex.lock();
+  }
+  mworkers.erase(omni_thread::self());
+  --mrunning;
+  mcond.broadcast();
+  mmutex.unlock();
+}
+
+void
+WorkerPool::workerThread(void* pool) {
+  static_cast<WorkerPool*>(pool)->runWorker();
+}
@@ -0,0 +1,148 @@
+/**
+ * @file WorkerPool.hh
+ *
+ * @brief  Bounded pool of worker threads running queued tasks
+ *
+ * @section Licence
+ *   |LICENSE|
+ */
+
+#ifndef WORKERPOOL_HH
+#define WORKERPOOL_HH
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+
+#include <omnithread.h>
+
+/**
+ * @brief A fixed set of threads running the submitted tasks. A task may be
+ * delayed, the tasks are then run in the order of their due time.
+ * @class WorkerPool
+ */
+class WorkerPool {
+public:
+  /**
+   * @brief A unit of work for the pool.
+   * @class Task
+   */
+  class Task {
+  public:
+    /**
+     * @brief Destructor
+     */
+    virtual ~Task() {}
+
+    /**
+     * @brief Do the work. Exceptions are caught by the pool and given to
+     *   its failure report.
+     */
+    virtual void
+    run() = 0;
+  };
+
+  /**
+   * @brief Called by a worker when a task throws.
+   */
+  typedef void (*FailureReport)(const std::string& failure, void* arg);
+
+  /**
+   * @brief Constructor, starts the worker threads.
+   * @param nbWorkers The number of worker threads
+   */
+  explicit WorkerPool(const unsigned int nbWorkers);
+
+  /**
+   * @brief Destructor. Waits for the running tasks and deletes the
+   *   pending ones without running them.
+   */
+  ~WorkerPool();
+
+  /**
+   * @brief Queue a task. The pool takes its ownership.
+   * @param task The task
+   * @param delay The time to wait before running the task (ms)
+   */
+  void
+  submit(Task* task, const unsigned long delay = 0);
+
+  /**
+   * @brief Get the number of tasks waiting for a worker.
+   * @return The number of queued tasks
+   */
+  unsigned int
+  pending() const;
+
+  /**
+   * @brief Is the calling thread a worker of this pool?
+   * @return true when called from a task of the pool
+   */
+  bool
+  isWorker() const;
+
+  /**
+   * @brief Set the function called when a task throws.
+   * @param report The function, NULL to ignore the failures
+   * @param arg The function argument
+   */
+  void
+  setFailureReport(FailureReport report, void* arg);
+
+  /**
+   * @brief Run a task, giving its failure to the failure report. Used by
+   *   the workers and by the queues running their own tasks on them.
+   * @param task The task
+   */
+  void
+  runTask(Task& task) const;
+
+private:
+  /**
+   * @brief Due time of a task (seconds, nanoseconds).
+   */
+  typedef std::pair<unsigned long, unsigned long> DueTime;
+
+  /**
+   * @brief Worker main loop.
+   */
+  void
+  runWorker();
+
+  /**
+   * @brief Worker thread entry point.
+   * @param pool The pool
+   */
+  static void
+  workerThread(void* pool);
+
+  /**
+   * @brief The queued tasks, by due time.
+   */
+  std::multimap<DueTime, Task*> mtasks;
+  /**
+   * @brief The worker threads.
+   */
+  std::set<omni_thread*> mworkers;
+  /**
+   * @brief Number of running worker threads.
+   */
+  unsigned int mrunning;
+  /**
+   * @brief Has the pool been asked to stop?
+   */
+  bool mstop;
+  FailureReport mreport;
+  void* mreportArg;
+  /**
+   * @brief Pool mutex.
+   */
+  mutable omni_mutex mmutex;
+  /**
+   * @brief Signals new tasks and the workers end.
+   */
+  omni_condition mcond;
+};
+
+#endif